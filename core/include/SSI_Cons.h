@@ -111,7 +111,6 @@ extern ssi_char_t *SSI_FILE_TYPE_EVENTS;
 
 // factory
 
-#define SSI_FACTORY_STRINGS_MAX 1024
 #define SSI_FACTORY_STRINGS_INVALID_ID -1
 #define SSI_FACTORY_UNIQUE_INVALID_ID 0
 
@@ -32,11 +32,14 @@
 #include "base/IObject.h"
 #include "base/IMessage.h"
 #include "base/String.h"
+#include "base/StringTable.h"
 #include "base/ITheEventBoard.h"
 #include "base/ITheFramework.h"
 #include "base/IWindowManager.h"
 #include "base/Array1D.h"
 #include "thread/Mutex.h"
+
+#include <unordered_map>
 #if __ANDROID__
 #define HEADLESS 1
 #include "base/AndroidApp.h"
@@ -209,6 +212,10 @@ protected:
 	typedef std::pair<String, IObject *> object_id_pair_t;
 	object_id_map_t _object_id_map;
 
+	// reverse lookup, points to the keys of _object_id_map
+	typedef std::unordered_map<IObject *, const ssi_char_t *> object_ptr_map_t;
+	object_ptr_map_t _object_ptr_map;
+
 	typedef std::map<String, IObject::create_fptr_t> object_create_map_t;
 	typedef std::pair<String, IObject::create_fptr_t> object_create_pair_t;
 	object_create_map_t _object_create_map;
@@ -236,8 +243,7 @@ protected:
 
 	Mutex _mutex;
 	ssi_size_t _id_counter;
-	ssi_char_t *_strings[SSI_FACTORY_STRINGS_MAX];
-	ssi_size_t _strings_counter;
+	StringTable _strings;
 
 	// print function
 	void print(FILE *file = ssiout);
@@ -53,6 +53,16 @@ public:
 
 	ssi_object_t getType () { return SSI_FILTER; };
 
+	/**
+	 * \brief Tells if a frame may be passed in consecutive parts.
+	 *
+	 * Return true if output sample n only depends on input samples up to n
+	 * and on state kept between calls, i.e. two calls with both halves of a
+	 * frame give the same result as a single call. Such filters are run
+	 * block by block by FilterFusion.
+	 */
+	virtual bool isSampleWise () { return false; };
+
 };
 
 }
@@ -55,7 +55,36 @@ public:
 	virtual bool isTrained () = 0;
 	virtual bool forward (ssi_stream_t &stream,
 		ssi_size_t n_probs,
-		ssi_real_t *probs) = 0;	
+		ssi_real_t *probs) = 0;
+
+	// scores n_samples feature vectors stored row-wise in a contiguous
+	// n_samples x n_features matrix and writes a n_samples x n_probs matrix
+	// (default implementation calls forward() for each row)
+	virtual bool forward_batch (ssi_size_t n_samples,
+		ssi_size_t n_features,
+		ssi_real_t *features,
+		ssi_size_t n_probs,
+		ssi_real_t *probs) {
+
+		ssi_stream_t stream;
+		stream.num = stream.num_real = 1;
+		stream.dim = n_features;
+		stream.byte = sizeof (ssi_real_t);
+		stream.tot = stream.tot_real = n_features * sizeof (ssi_real_t);
+		stream.sr = 0;
+		stream.time = 0;
+		stream.type = SSI_REAL;
+
+		for (ssi_size_t i = 0; i < n_samples; i++) {
+			stream.ptr = ssi_pcast (ssi_byte_t, features + i * n_features);
+			if (!forward (stream, n_probs, probs + i * n_probs)) {
+				return false;
+			}
+		}
+
+		return true;
+	};
+
 	virtual void release () = 0;
 
 	virtual bool save (const ssi_char_t *filepath) = 0;	
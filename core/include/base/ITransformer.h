@@ -146,6 +146,16 @@ public:
 	 */ 
 	virtual ssi_type_t getSampleTypeOut (ssi_type_t sample_type_in) = 0;
 
+	/**
+	 * \brief Tells whether additional input streams should be resampled to the sample rate of the main input stream.
+	 *
+	 * If true, each additional stream of type SSI_REAL is passed with the sample rate and the number of samples
+	 * of the main input stream. The conversion uses a polyphase filter that keeps its state between frames.
+	 *
+	 * @return True if additional streams are aligned to the main input stream.
+	 */
+	virtual bool alignXtraStreams () { return false; };
+
 	ssi_object_t getType () { return SSI_TRANSFORMER; };
 
 };
@@ -0,0 +1,101 @@
+// StringTable.h
+// created: 2026/10/19
+// Copyright (C) University of Augsburg, Lab for Human Centered Multimedia
+//
+// *************************************************************************************************
+//
+// This file is part of Social Signal Interpretation (SSI) developed at the
+// Lab for Human Centered Multimedia of the University of Augsburg
+//
+// This library is free software; you can redistribute itand/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 3 of the License, or any laterversion.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FORA PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along withthis library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+//
+//*************************************************************************************************
+
+#pragma once
+
+#ifndef SSI_BASE_STRINGTABLE_H
+#define SSI_BASE_STRINGTABLE_H
+
+#include "SSI_Cons.h"
+#include "thread/Mutex.h"
+
+#include <atomic>
+
+namespace ssi {
+
+//! \brief Interns strings and assigns them stable, consecutive ids.
+//
+// Lookups (find() and get()) do not lock and may run concurrently with add().
+// Strings are stored in chunks of growing size that are never moved, so an id
+// remains valid until clear() is called. The hash index is rebuilt when it gets
+// too full, the old index is kept alive until clear(), so a reader that still
+// uses it at worst misses a string that has just been added. add() therefore
+// repeats the lookup under the lock before it inserts a string.
+//
+class StringTable {
+
+public:
+
+	static const ssi_size_t INVALID_ID = SSI_FACTORY_STRINGS_INVALID_ID;
+
+	StringTable ();
+	virtual ~StringTable ();
+
+	// returns id of the string, adds the string if necessary
+	ssi_size_t add (const ssi_char_t *str);
+	// returns id of the string or INVALID_ID
+	ssi_size_t find (const ssi_char_t *str);
+	// returns string with the id or 0
+	const ssi_char_t *get (ssi_size_t id);
+	ssi_size_t size ();
+
+	// must not be called while other threads access the table
+	void clear ();
+
+protected:
+
+	// chunk k holds 2^(CHUNK_BITS + k) entries
+	static const ssi_size_t CHUNK_BITS = 6;
+	static const ssi_size_t CHUNK_MAX = 32 - CHUNK_BITS;
+
+	struct entry_t {
+		ssi_char_t *str;
+		ssi_size_t hash;
+	};
+
+	// open addressing, a slot stores id + 1 or 0 if it is empty
+	struct index_t {
+		ssi_size_t mask;
+		std::atomic<ssi_size_t> *slots;
+		index_t *retired;
+	};
+
+	static ssi_size_t Hash (const ssi_char_t *str);
+	static void Locate (ssi_size_t id, ssi_size_t &chunk, ssi_size_t &offset);
+	entry_t *entry (ssi_size_t id);
+	ssi_size_t lookup (index_t *index, const ssi_char_t *str, ssi_size_t hash);
+	void insert (index_t *index, ssi_size_t id, ssi_size_t hash);
+	void grow ();
+	void release ();
+
+	Mutex _mutex;
+	std::atomic<ssi_size_t> _size;
+	std::atomic<entry_t *> _chunks[CHUNK_MAX];
+	std::atomic<index_t *> _index;
+};
+
+}
+
+#endif
@@ -0,0 +1,89 @@
+// AsciiNumber.h
+// created: 2026/10/19
+// Copyright (C) University of Augsburg, Lab for Human Centered Multimedia
+//
+// *************************************************************************************************
+//
+// This file is part of Social Signal Interpretation (SSI) developed at the
+// Lab for Human Centered Multimedia of the University of Augsburg
+//
+// This library is free software; you can redistribute itand/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 3 of the License, or any laterversion.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FORA PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along withthis library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+//
+//*************************************************************************************************
+
+#pragma once
+
+#ifndef SSI_IOPUT_ASCIINUMBER_H
+#define SSI_IOPUT_ASCIINUMBER_H
+
+#include "SSI_Cons.h"
+
+namespace ssi {
+
+//! \brief Converts numbers from and to text without going through the c library.
+//
+// Parse() reads a number starting at str and never reads beyond end, on success
+// str points to the first character after the number. Leading white space is not
+// skipped. Decimal numbers with up to 19 significant digits and an exponent within
+// +/-22 are converted exactly, anything else (e.g. inf, nan or long mantissas) is
+// passed on to strtod().
+//
+// Print() writes a representation that reads back to exactly the same value, e.g.
+// 0.1f becomes "0.1", and returns the number of characters. It is usually the
+// shortest one, but not always, values at exact decimal midpoints may get a digit
+// more. The buffer has to
+// hold at least MAX_CHARS characters, no terminating zero is written.
+//
+class AsciiNumber {
+
+public:
+
+	static const ssi_size_t MAX_CHARS = 32;
+
+	static bool Parse (const ssi_char_t *&str, const ssi_char_t *end, int16_t &value);
+	static bool Parse (const ssi_char_t *&str, const ssi_char_t *end, uint16_t &value);
+	static bool Parse (const ssi_char_t *&str, const ssi_char_t *end, int32_t &value);
+	static bool Parse (const ssi_char_t *&str, const ssi_char_t *end, uint32_t &value);
+	static bool Parse (const ssi_char_t *&str, const ssi_char_t *end, int64_t &value);
+	static bool Parse (const ssi_char_t *&str, const ssi_char_t *end, uint64_t &value);
+	static bool Parse (const ssi_char_t *&str, const ssi_char_t *end, float &value);
+	static bool Parse (const ssi_char_t *&str, const ssi_char_t *end, double &value);
+
+	static ssi_size_t Print (int16_t value, ssi_char_t *str);
+	static ssi_size_t Print (uint16_t value, ssi_char_t *str);
+	static ssi_size_t Print (int32_t value, ssi_char_t *str);
+	static ssi_size_t Print (uint32_t value, ssi_char_t *str);
+	static ssi_size_t Print (int64_t value, ssi_char_t *str);
+	static ssi_size_t Print (uint64_t value, ssi_char_t *str);
+	static ssi_size_t Print (float value, ssi_char_t *str);
+	static ssi_size_t Print (double value, ssi_char_t *str);
+
+	// true for types handled by Parse() and Print()
+	static bool IsSupported (ssi_type_t type);
+
+protected:
+
+	static bool ParseInteger (const ssi_char_t *&str, const ssi_char_t *end, int64_t &value);
+	static bool ParseDecimal (const ssi_char_t *&str, const ssi_char_t *end, double &value, bool single);
+	static bool Compose (uint64_t mantissa, int exponent, bool single, double &value);
+	static bool Fallback (const ssi_char_t *&str, const ssi_char_t *end, double &value, bool single);
+	static bool RoundTrips (uint64_t mantissa, int exponent, double value, bool single);
+	static ssi_size_t PrintInteger (uint64_t magnitude, bool negative, ssi_char_t *str);
+	static ssi_size_t PrintDecimal (double value, bool single, ssi_char_t *str);
+};
+
+}
+
+#endif
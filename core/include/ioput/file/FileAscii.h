@@ -34,6 +34,7 @@
 namespace ssi {
 
 #define SSI_FILEASCII_MAX_FORMAT	20 
+#define SSI_FILEASCII_BUFFER_SIZE	4096
 
 class FileAscii : public File {
 
@@ -68,11 +69,17 @@ protected:
 	static ssi_size_t read_h (FILE *file, const ssi_char_t *format_with_delim, const ssi_char_t *format_with_newline, void *ptr, ssi_size_t elements_per_line, ssi_size_t count);
 	template<class T>
 	static ssi_size_t write_h (FILE *file, const ssi_char_t *format_with_delim, const ssi_char_t *format_with_newline, const void *ptr, ssi_size_t elements_per_line, ssi_size_t count);
+	// used if no flags are set, see AsciiNumber
+	template<class T>
+	static ssi_size_t read_fast (FILE *file, const ssi_char_t *delim, void *ptr, ssi_size_t elements_per_line, ssi_size_t count);
+	template<class T>
+	static ssi_size_t write_fast (FILE *file, const ssi_char_t *delim, const void *ptr, ssi_size_t elements_per_line, ssi_size_t count);
 
 	ssi_type_t _type;
 	char _format[SSI_FILEASCII_MAX_FORMAT+1];
 	char *_format_with_delim, *_format_with_newline;
 	char _delim[SSI_FILEASCII_MAX_FORMAT], _flags[SSI_FILEASCII_MAX_FORMAT];
+	bool _fast;
 };
 
 }
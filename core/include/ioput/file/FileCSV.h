@@ -61,6 +61,21 @@ public:
 
 protected:
 
+	// minimum number of bytes before lines are parsed in parallel
+	static const ssi_size_t PARALLEL_MIN_SIZE = 1 << 20;
+
+	struct chunk_t {
+		const ssi_char_t *begin;
+		const ssi_char_t *end;
+		ssi_char_t delim;
+		ssi_size_t n_columns;
+		ssi_size_t n_rows;
+		std::vector<ssi_char_t *> tokens; // n_rows x n_columns
+		std::vector<ssi_size_t> invalid; // #tokens of skipped lines
+	};
+	static void ParseChunkTask(ssi_size_t index, void *arg);
+	static void ParseChunk(chunk_t &chunk);
+
 	bool _has_header;
 	ssi_size_t _n_rows;
 	ssi_size_t _n_columns;
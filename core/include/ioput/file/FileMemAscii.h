@@ -68,12 +68,18 @@ protected:
 	static int read_h (ssi_size_t pos, ssi_size_t n_memory, ssi_byte_t *memory, const ssi_char_t *format_with_delim, const ssi_char_t *format_with_newline, void *ptr, ssi_size_t elements_per_line, ssi_size_t count);
 	template<class T>
 	static int write_h (ssi_size_t pos, ssi_size_t n_memory, ssi_byte_t *memory, const ssi_char_t *format_with_delim, const ssi_char_t *format_with_newline, const void *ptr, ssi_size_t elements_per_line, ssi_size_t count);
+	// used if no flags are set, see AsciiNumber
+	template<class T>
+	static int read_fast (ssi_size_t pos, ssi_size_t n_memory, ssi_byte_t *memory, const ssi_char_t *delim, void *ptr, ssi_size_t elements_per_line, ssi_size_t count);
+	template<class T>
+	static int write_fast (ssi_size_t pos, ssi_size_t n_memory, ssi_byte_t *memory, const ssi_char_t *delim, const void *ptr, ssi_size_t elements_per_line, ssi_size_t count);
 
 	ssi_type_t _type;
 	char _format[FILEASCII_MAX_FORMAT+1];
 	char *_format_with_delim, *_format_with_newline;
 	char *_format_with_delim_read, *_format_with_newline_read;
 	char _delim[FILEASCII_MAX_FORMAT], _flags[FILEASCII_MAX_FORMAT];
+	bool _fast;
 };
 
 }
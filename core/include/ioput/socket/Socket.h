@@ -95,6 +95,8 @@ public:
 	virtual int recv (void *ptr, ssi_size_t size, long timeout_in_ms = INFINITE_TIMEOUT) = 0;
 	virtual int send (const void *ptr, ssi_size_t size) = 0;
 	virtual int sendTo (const void *ptr, ssi_size_t size, const char* host = 0, int port = IpEndpointName::ANY_PORT) = 0;
+	// sends several buffers as one message (default copies them into a single buffer)
+	virtual int sendv (ssi_size_t n_buffers, const void *ptrs[], const ssi_size_t sizes[]);
 	virtual const char *getRecvAddress () = 0;
 
 	bool sendFile (const ssi_char_t *filepath);
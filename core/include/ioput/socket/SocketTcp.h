@@ -68,6 +68,7 @@ public:
 	bool disconnect ();
 	int recv (void *ptr, ssi_size_t size, long timeout_in_ms = INFINITE_TIMEOUT);
 	int send (const void *ptr, ssi_size_t size);
+	int sendv (ssi_size_t n_buffers, const void *ptrs[], const ssi_size_t sizes[]);
 	int sendTo (const void *ptr, ssi_size_t size, const char* host = 0, int port = IpEndpointName::ANY_PORT);
 	const char *getRecvAddress();
 
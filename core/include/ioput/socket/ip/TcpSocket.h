@@ -75,6 +75,7 @@ public:
 	int recv      (void *buf, int num_bytes, long timeout = INFINITE);
 	int recv_exact(void *buf, int num_bytes, long timeout = INFINITE);
 	int send	  (const void *buf, int num_bytes);
+	int sendv	  (int num_bufs, const void *bufs[], const ssi_size_t sizes[]);
 
 	bool connected();
 
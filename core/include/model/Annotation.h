@@ -33,6 +33,15 @@
 
 namespace ssi {
 
+//! \brief Labeled segments, stored in an array sorted by start (and stop) time.
+//
+// New entries are appended and the array is sorted the next time it is read,
+// so loading is O(n log n), or O(n) if entries arrive in order. Entries with the
+// same start and stop time are only kept once. The maximum stop time below each
+// node of the array, read as an implicit binary search tree, answers overlap
+// queries in O(log n + k). Pointers to entries are valid until the annotation is
+// changed.
+//
 class Annotation {
 
 public:
@@ -50,6 +59,8 @@ public:
 		ssi_time_t stop,
 		const ssi_char_t *label);
 	void add (Annotation::Entry &entry);
+	// adds n entries at once, labels have to be added before
+	void add (ssi_size_t n, const Annotation::Entry *entries);
 
 	void reset ();
 	Annotation::Entry *next ();
@@ -73,23 +84,39 @@ public:
 	 */
 	Annotation::Entry *getEntryAt(ssi_time_t time, ssi_time_t max_delay = 0);
 
+	/**
+	 * Collects all entries that overlap the interval [from, to), i.e. start < to and stop > from
+	 * @param from start of the interval (in seconds)
+	 * @param to end of the interval (in seconds)
+	 * @param result matched entries are appended in order of their start time
+	 * @return number of matched entries
+	 */
+	ssi_size_t getEntries(ssi_time_t from, ssi_time_t to, std::vector<Annotation::Entry *> &result);
+
         void trim(ssi_size_t offset, ssi_size_t size);
 
 protected:
 
 	struct entry_compare {
-		bool operator() (const Annotation::Entry *lhs, const Annotation::Entry *rhs) const {
-			if (lhs->start == rhs->start) {
-				return lhs->stop < rhs->stop;
+		bool operator() (const Annotation::Entry &lhs, const Annotation::Entry &rhs) const {
+			if (lhs.start == rhs.start) {
+				return lhs.stop < rhs.stop;
 			} else {
-				return lhs->start < rhs->start;
+				return lhs.start < rhs.start;
 			}
 		}
 	};
 
-	typedef std::set<Annotation::Entry *,entry_compare> entries_set_t;
-	entries_set_t entries;
-	entries_set_t::iterator entries_iter;
+	// sorts new entries and rebuilds the index
+	void update ();
+	ssi_time_t build (ssi_size_t lo, ssi_size_t hi);
+	Annotation::Entry *find (ssi_size_t lo, ssi_size_t hi, ssi_time_t time, ssi_time_t max_delay);
+	void collect (ssi_size_t lo, ssi_size_t hi, ssi_time_t from, ssi_time_t to, std::vector<Annotation::Entry *> &result);
+
+	std::vector<Annotation::Entry> entries;
+	std::vector<ssi_time_t> max_stops; // maximum stop time in the subtree of each entry
+	bool dirty;
+	ssi_size_t entries_iter;
 	std::vector<ssi_char_t *> labels;
 	ssi_size_t counter;
 };
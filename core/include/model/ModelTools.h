@@ -32,10 +32,12 @@
 #include "model/SampleList.h"
 #include "Annotation.h"
 #include "base/ITransformer.h"
+#include "base/IModel.h"
 #include "ioput/file/StringList.h"
 #include "ioput/file/File.h"
 #include "ioput/file/FileSamplesIn.h"
 #include "ioput/file/FileSamplesOut.h"
+#include "thread/Mutex.h"
 
 namespace ssi {
 
@@ -156,6 +158,24 @@ public:
 		ssi_size_t frame_size = 0,
 		ssi_size_t delta_size = 0,
 		ModelTools::CALL_ENTER_AND_FLUSH call_enter_and_flush = CALL_ALWAYS);
+	// same as TransformSampleList() with CALL_ALWAYS, but samples are distributed on the
+	// shared worker pool, each thread uses its own copy of the transformers, which is
+	// created through the Factory and gets the options of the original. Only use it with
+	// transformers that are fully described by their options, state set through other
+	// functions (e.g. Chain::set()) is not copied. Copies with a different output format, or
+	// a different result for the first sample, are detected and the samples are then
+	// transformed on the calling thread.
+	static void TransformSampleListParallel (ISamples &from, 
+		SampleList &to, 
+		ITransformer &transformer,		
+		ssi_size_t frame_size = 0,
+		ssi_size_t delta_size = 0);
+	static void TransformSampleListParallel (ISamples &from, 
+		SampleList &to,
+		ssi_size_t num,
+		ITransformer *transformers[],		
+		ssi_size_t frame_size = 0,
+		ssi_size_t delta_size = 0);
 
 	static void AlignStreams (ssi_size_t num,
 		ssi_stream_t *from[],
@@ -183,6 +203,9 @@ public:
 	static void ReleaseSampleMatrix (ssi_size_t n_samples, ssi_size_t *classes, ssi_real_t **matrix);
 	static void FromSampleMatrix(SampleList &samples, ssi_size_t n_samples, ssi_size_t n_features, ssi_size_t *classes, ssi_real_t **matrix);
 
+	// creates an untrained model of the same type and with the same options through the factory (0 if the model is not registered)
+	static IModel *CloneModel (IModel *model);
+
 	static void PrintInfo (ISamples &samples, FILE *file = stdout);
 	static void PrintSample (ISamples &samples, ssi_size_t index, FILE *file = stdout);
 	static void PrintSamples (ISamples &samples, FILE *file = stdout);
@@ -192,6 +215,49 @@ public:
 protected:
 
 	static ssi_char_t *ssi_log_name;
+
+	// samples per task when working in parallel
+	static const ssi_size_t PARALLEL_BLOCK_SIZE = 16;
+
+	static ssi_sample_t *TransformSample (const ssi_sample_t &sample,
+		ssi_size_t num,
+		ITransformer *transformers[],
+		ssi_size_t frame_size,
+		ssi_size_t delta_size,
+		bool call_enter,
+		bool call_flush,
+		ssi_size_t *label_map,
+		ssi_size_t *user_map);
+	static IObject *CloneObject (IObject *object);
+	static ITransformer *CloneTransformer (ITransformer *transformer);
+	static bool IsSameOutput (ISamples &samples, ssi_size_t num, ssi_size_t index, ITransformer *transformer, ITransformer *clone);
+	static bool IsSameSample (const ssi_sample_t &a, const ssi_sample_t &b);
+
+	struct transform_job_t {
+		ssi_size_t n_samples;
+		ssi_sample_t **from;
+		ssi_sample_t **to;
+		ssi_size_t num;
+		ssi_size_t frame_size;
+		ssi_size_t delta_size;
+		ssi_size_t *label_map;
+		ssi_size_t *user_map;
+		ITransformer ***sets; // one set of num transformers per thread
+		ssi_size_t *free_sets;
+		ssi_size_t n_free_sets;
+		Mutex mutex;
+	};
+	static void TransformTask (ssi_size_t index, void *arg);
+
+	struct load_job_t {
+		ssi_size_t n_entries;
+		Annotation::Entry **entries;
+		ssi_size_t num;
+		ssi_stream_t **streams;
+		ssi_stream_t ***chops; // 0 if no stream could be extracted
+		bool *invalid; // n_entries x num
+	};
+	static void LoadTask (ssi_size_t index, void *arg);
 };
 
 }
@@ -0,0 +1,90 @@
+// FilterFusion.h
+// created: 2026/10/19
+// Copyright (C) University of Augsburg, Lab for Human Centered Multimedia
+//
+// *************************************************************************************************
+//
+// This file is part of Social Signal Interpretation (SSI) developed at the
+// Lab for Human Centered Multimedia of the University of Augsburg
+//
+// This library is free software; you can redistribute itand/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 3 of the License, or any laterversion.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FORA PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along withthis library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+//
+//*************************************************************************************************
+
+#pragma once
+
+#ifndef SSI_SIGNAL_FILTERFUSION_H
+#define SSI_SIGNAL_FILTERFUSION_H
+
+#include "base/IFilter.h"
+
+namespace ssi {
+
+//! \brief Runs a series of filters on a stream.
+//
+// Consecutive filters that are sample wise (see IFilter::isSampleWise()) are fused:
+// the frame is cut into small blocks and each block passes all filters of the run
+// before the next block is processed. Between fused filters only a single block is
+// buffered, so the data stays in the first level cache. All other filters process
+// the whole frame and write to a full intermediate stream as usual.
+//
+class FilterFusion {
+
+public:
+
+	// bytes of all streams of a run per block
+	static const ssi_size_t DEFAULT_BLOCK_BYTES = 16384;
+
+	FilterFusion ();
+	virtual ~FilterFusion ();
+
+	// filters are not owned, calls transform_enter() of each filter
+	void enter (ssi_size_t n_filters,
+		IFilter **filters,
+		ssi_stream_t &stream_in,
+		ssi_stream_t &stream_out,
+		bool fuse = true,
+		ssi_size_t block_bytes = DEFAULT_BLOCK_BYTES);
+	void transform (ITransformer::info info,
+		ssi_stream_t &stream_in,
+		ssi_stream_t &stream_out);
+	// calls transform_flush() of each filter
+	void flush (ssi_stream_t &stream_in,
+		ssi_stream_t &stream_out);
+
+	// output stream of the i'th filter, available for i < number of filters - 1
+	ssi_stream_t &getStream (ssi_size_t index) { return _streams[index]; };
+	ssi_size_t getBlockNum () { return _block_num; };
+	ssi_size_t getFusedNum ();
+
+protected:
+
+	static void View (ssi_stream_t &view, ssi_stream_t &stream, ssi_size_t offset, ssi_size_t num);
+	void release ();
+
+	ssi_size_t _n_filters;
+	IFilter **_filters;
+	bool *_fused;
+
+	// _streams[i] is the output of filter i, holds a single block if filter i and i + 1 are fused
+	ssi_stream_t *_streams;
+	ssi_size_t _block_num;
+
+	ssi_stream_t _view_in, _view_out;
+};
+
+}
+
+#endif
@@ -0,0 +1,100 @@
+// Resampler.h
+// created: 2026/10/19
+// Copyright (C) University of Augsburg, Lab for Human Centered Multimedia
+//
+// *************************************************************************************************
+//
+// This file is part of Social Signal Interpretation (SSI) developed at the
+// Lab for Human Centered Multimedia of the University of Augsburg
+//
+// This library is free software; you can redistribute itand/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 3 of the License, or any laterversion.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FORA PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along withthis library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+//
+//*************************************************************************************************
+
+#pragma once
+
+#ifndef SSI_SIGNAL_RESAMPLER_H
+#define SSI_SIGNAL_RESAMPLER_H
+
+#include "SSI_Cons.h"
+#include "signal/SignalCons.h"
+
+namespace ssi {
+
+//! \brief Streaming polyphase FIR resampler for a rational factor up/down.
+//
+// Input and output are interleaved ssi_real_t samples. The filter state is kept
+// between calls, so a signal can be pushed frame by frame. Samples are addressed
+// by absolute position: output n corresponds to input position n * down / up.
+// With compensation enabled the group delay of the lowpass is removed, i.e. the
+// output is aligned in time to the input but needs taps / 2 input samples ahead.
+//
+class Resampler {
+
+public:
+
+	Resampler ();
+	virtual ~Resampler ();
+
+	// finds up/down with up/down ~ rate_out/rate_in and both <= max_factor
+	static void Ratio (ssi_time_t rate_in, ssi_time_t rate_out, ssi_size_t &up, ssi_size_t &down, ssi_size_t max_factor = 1000);
+
+	// taps is the filter length per phase
+	void init (ssi_size_t dim, ssi_size_t up, ssi_size_t down, ssi_size_t taps = 16, bool compensate = false);
+	void release ();
+
+	// restarts the filter so that the next output is at position out_pos
+	void reset (ssi_lsize_t out_pos = 0);
+
+	// position of the next input sample expected by push()
+	ssi_lsize_t getInputPos ();
+	// position of the next output sample returned by pull()
+	ssi_lsize_t getOutputPos () { return _out_pos; };
+	// number of input samples that have to be pushed before all outputs up to out_end (exclusive) are available
+	ssi_lsize_t getInputEnd (ssi_lsize_t out_end);
+
+	void push (ssi_size_t num, const ssi_real_t *ptr);
+	// returns up to num output samples, less if more input is needed
+	ssi_size_t pull (ssi_size_t num, ssi_real_t *ptr);
+
+	ssi_size_t getUp () { return _up; };
+	ssi_size_t getDown () { return _down; };
+	ssi_size_t getDim () { return _dim; };
+
+protected:
+
+	void design ();
+	void reserve (ssi_size_t num);
+
+	ssi_size_t _dim;
+	ssi_size_t _up, _down;
+	ssi_size_t _taps;
+	ssi_size_t _delay;
+
+	// one row of taps per phase, stored in reverse order
+	ssi_real_t *_coefs;
+
+	// one row of _capacity samples per dimension
+	ssi_real_t *_buffer;
+	ssi_size_t _capacity;
+	ssi_size_t _num;
+	int64_t _base;
+
+	ssi_lsize_t _out_pos;
+};
+
+}
+
+#endif
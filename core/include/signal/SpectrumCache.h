@@ -0,0 +1,107 @@
+// SpectrumCache.h
+// created: 2026/10/19
+// Copyright (C) University of Augsburg, Lab for Human Centered Multimedia
+//
+// *************************************************************************************************
+//
+// This file is part of Social Signal Interpretation (SSI) developed at the
+// Lab for Human Centered Multimedia of the University of Augsburg
+//
+// This library is free software; you can redistribute itand/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 3 of the License, or any laterversion.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FORA PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along withthis library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+//
+//*************************************************************************************************
+
+#pragma once
+
+#ifndef SSI_SIGNAL_SPECTRUMCACHE_H
+#define SSI_SIGNAL_SPECTRUMCACHE_H
+
+#include "SSI_Cons.h"
+#include "base/StringTable.h"
+#include "thread/Mutex.h"
+
+#include <atomic>
+
+namespace ssi {
+
+//! \brief Spectra of recent frames, shared between components that compute the same front-end.
+//
+// Components that window and transform the same audio frames (e.g. MFCC, PLP
+// and pitch chains connected to the same source) store their spectra under a
+// key that describes the front-end (fft size, window, scaling). Frames are
+// compared by content, so a hit returns exactly what the caller would have
+// computed. The cache keeps a fixed number of frames and replaces the oldest.
+// As long as a single component uses a key, get() and put() return at once,
+// so the cache costs nothing unless spectra can actually be shared.
+//
+class SpectrumCache {
+
+public:
+
+	static const ssi_size_t INVALID_KEY = StringTable::INVALID_ID;
+	static const ssi_size_t SLOTS = 64;
+	static const ssi_size_t MAX_KEYS = 64; // keys beyond are always cached
+
+	SpectrumCache ();
+	virtual ~SpectrumCache ();
+
+	// cache shared by all components, created on first use
+	static SpectrumCache *GetShared ();
+	static void ReleaseShared ();
+
+	// registers a component with a description of its front-end and returns the key
+	ssi_size_t attach (const ssi_char_t *config);
+	// unregisters a component
+	void detach (ssi_size_t key);
+	// true if more than one component uses the key
+	bool isShared (ssi_size_t key);
+
+	// copies spectrum of the frame to out, returns false if it is not cached
+	bool get (ssi_size_t key, ssi_size_t n_in, const ssi_real_t *in, ssi_size_t n_out, ssi_real_t *out);
+	// stores spectrum of the frame
+	void put (ssi_size_t key, ssi_size_t n_in, const ssi_real_t *in, ssi_size_t n_out, const ssi_real_t *out);
+
+	void clear ();
+
+protected:
+
+	struct slot_t {
+		ssi_size_t key;
+		ssi_size_t hash;
+		ssi_size_t n_in;
+		ssi_size_t n_out;
+		ssi_size_t capacity_in;
+		ssi_size_t capacity_out;
+		ssi_real_t *in;
+		ssi_real_t *out;
+	};
+
+	static ssi_size_t Hash (ssi_size_t n, const ssi_real_t *values);
+	ssi_size_t getKey (const ssi_char_t *config);
+	slot_t *find (ssi_size_t key, ssi_size_t hash, ssi_size_t n_in, const ssi_real_t *in, ssi_size_t n_out);
+
+	static std::atomic<SpectrumCache *> _shared;
+	static Mutex _shared_mutex;
+
+	Mutex _mutex;
+	StringTable _keys;
+	std::atomic<ssi_size_t> _users[MAX_KEYS];
+	slot_t _slots[SLOTS];
+	ssi_size_t _next;
+};
+
+}
+
+#endif
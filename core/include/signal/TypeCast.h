@@ -0,0 +1,76 @@
+// TypeCast.h
+// created: 2026/10/19
+// Copyright (C) University of Augsburg, Lab for Human Centered Multimedia
+//
+// *************************************************************************************************
+//
+// This file is part of Social Signal Interpretation (SSI) developed at the
+// Lab for Human Centered Multimedia of the University of Augsburg
+//
+// This library is free software; you can redistribute itand/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 3 of the License, or any laterversion.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FORA PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along withthis library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+//
+//*************************************************************************************************
+
+#pragma once
+
+#ifndef SSI_SIGNAL_TYPECAST_H
+#define SSI_SIGNAL_TYPECAST_H
+
+#include "SSI_Cons.h"
+
+namespace ssi {
+
+// converts n values from in to out, values are multiplied by scale before the cast
+typedef void (*ssi_cast_kernel_t) (ssi_size_t n, const void *in, void *out, ssi_real_t scale);
+
+//! \brief Type conversion kernels for sample streams.
+//
+// Resolve() picks a kernel for a pair of sample types once, e.g. in transform_enter(),
+// so the per frame call is a plain function call without any type switch. For
+// SHORT <-> FLOAT, UCHAR -> FLOAT and FLOAT <-> DOUBLE vectorized kernels are chosen
+// depending on the cpu features found at runtime (SSE2, SSE4.1, AVX2 or NEON).
+// FLOAT -> SHORT saturates at the limits of int16. All other pairs behave like
+// ssi_cast2type().
+//
+class TypeCast {
+
+public:
+
+	enum FEATURE {
+		SSE2 = 1,
+		SSE41 = 2,
+		AVX2 = 4,
+		NEON = 8
+	};
+
+	// features of the cpu, detected on first call
+	static ssi_size_t GetCpuFeatures ();
+	// restricts the features used by following calls to Resolve(), e.g. 0 for scalar kernels
+	static void SetCpuFeatures (ssi_size_t features);
+
+	static ssi_cast_kernel_t Resolve (ssi_type_t type_in, ssi_type_t type_out);
+	static void Cast (ssi_size_t n, const void *in, void *out, ssi_type_t type_in, ssi_type_t type_out, ssi_real_t scale = 1.0f);
+
+protected:
+
+	static ssi_size_t Detect ();
+
+	static bool _detected;
+	static ssi_size_t _features;
+};
+
+}
+
+#endif
@@ -45,6 +45,7 @@
 #include "thread/Timer.h"
 #include "thread/Condition.h"
 #include "thread/ThreadPool.h"
+#include "thread/TimerService.h"
 #include "thread/RunAsThread.h"
 
 #include "ioput/option/OptionList.h"
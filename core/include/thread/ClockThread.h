@@ -31,9 +31,16 @@
 
 #include "thread/Thread.h"
 #include "thread/Timer.h"
+#include "thread/TimerService.h"
 
 namespace ssi {
 
+//! \brief Calls clock () at a fixed rate.
+//
+// Does not run its own thread, clock () is called from the shared TimerService.
+// Ticks are not skipped, so clock () should return quickly. enter () is called
+// by start () and flush () by stop ().
+//
 class ClockThread : public Thread {
 
 public:
@@ -41,6 +48,9 @@ public:
 	ClockThread (ssi_size_t timeout_in_ms = 10000);
 	~ClockThread();
 
+	bool start ();
+	bool stop ();
+
 	void setClockS (ssi_time_t seconds);
 	void setClockMs(ssi_size_t milliseconds);
 	void setClockHz(ssi_time_t hz);
@@ -52,9 +62,11 @@ protected:
 
 	virtual void clock() = 0;
 
+	static void Tick (void *arg);
 	void run ();	
 
-	Timer _timer;
+	ssi_time_t _period;
+	ssi_size_t _id;
 };
 
 
@@ -65,6 +65,9 @@ public:
 	// wait for condition
 	void wait (Mutex *mutex);
 
+	// wait for condition until deadline (see Timer::Now), returns false on timeout
+	bool wait (Mutex *mutex, int64_t deadline);
+
 	// wakes up a single waiting thread
 	void wakeSingle ();
 
@@ -90,6 +93,8 @@ private:
 	// Signal and broadcast event HANDLEs
 	ssi_handle_t events[Condition::MAX_EVENTS];
 
+	bool waitEvents (Mutex *mutex, DWORD timeout);
+
 	#endif // hasCXX11threads
 };
 
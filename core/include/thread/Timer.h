@@ -47,20 +47,20 @@ public:
 	void setClockHz(ssi_time_t hz);
 
 	void reset ();
+	// sleeps until the next tick, ticks are absolute deadlines relative to reset()
 	void wait ();
 
+	// monotonic clock in microseconds
+	static int64_t Now ();
+	// sleeps until Now () reaches deadline
+	static void SleepUntil (int64_t deadline);
+
 protected:
 
 	bool _highprec;
 	ssi_time_t _delta;
 	ssi_time_t _next;
-	#if _WIN32|_WIN64
-	DWORD _now;
-	DWORD _init;
-	#else
-	uint32_t _now;
-	uint32_t _init;
-	#endif
+	int64_t _init;
 };
 
 }
@@ -0,0 +1,131 @@
+// TimerService.h
+// created: 2026/10/19
+// Copyright (C) University of Augsburg, Lab for Human Centered Multimedia
+//
+// *************************************************************************************************
+//
+// This file is part of Social Signal Interpretation (SSI) developed at the
+// Lab for Human Centered Multimedia of the University of Augsburg
+//
+// This library is free software; you can redistribute itand/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 3 of the License, or any laterversion.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FORA PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along withthis library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+//
+//*************************************************************************************************
+
+#pragma once
+
+#ifndef SSI_THREAD_TIMERSERVICE_H
+#define SSI_THREAD_TIMERSERVICE_H
+
+#include "thread/Thread.h"
+#include "thread/ThreadLibCons.h"
+#include "thread/Mutex.h"
+#include "thread/Condition.h"
+
+#include <vector>
+
+namespace ssi {
+
+//! \brief Calls periodic callbacks from a single thread.
+//
+// Components that only need to be woken up at a fixed rate register a callback
+// instead of running their own thread. Deadlines are absolute (see Timer::Now),
+// so ticks do not drift. Ticks that are missed because a callback took too long
+// are skipped, unless the callback asks to catch up, e.g. because it produces a
+// sample per tick. For each callback the delay between deadline and actual call
+// is measured, print() reports mean and maximum.
+//
+class TimerService {
+
+public:
+
+	typedef void (*callback_t) (void *arg);
+
+	static const ssi_size_t INVALID_ID = ~0u;
+
+	TimerService (const ssi_char_t *name);
+	virtual ~TimerService ();
+
+	// service shared by all components, created on first use
+	static TimerService *GetShared ();
+	static void ReleaseShared ();
+
+	// calls callback (arg) now and then every period seconds, with catchup missed ticks are called late
+	ssi_size_t add (const ssi_char_t *name, ssi_time_t period, callback_t callback, void *arg, bool catchup = false);
+	// returns after a running call has finished, must not be called from a callback
+	void remove (ssi_size_t id);
+
+	ssi_size_t size ();
+	void print (FILE *file = ssiout);
+
+	static void SetLogLevel (int level) {
+		ssi_log_level = level;
+	}
+
+protected:
+
+	class Worker : public Thread {
+
+	public:
+
+		Worker ();
+		void set (TimerService *service) { _service = service; };
+		void run ();
+
+	protected:
+
+		TimerService *_service;
+	};
+
+	struct entry_t {
+		ssi_size_t id;
+		ssi_char_t *name;
+		int64_t period; // microseconds
+		int64_t deadline; // microseconds
+		callback_t callback;
+		void *arg;
+		bool catchup;
+		ssi_size_t n_calls;
+		ssi_size_t n_skipped;
+		int64_t delay_sum;
+		int64_t delay_max;
+	};
+
+	// calls callbacks until the service is destroyed, _mutex has to be locked
+	void work ();
+	entry_t *next ();
+	void print (FILE *file, entry_t *entry);
+
+	static int ssi_log_level;
+	static ssi_char_t *ssi_log_name;
+
+	static TimerService *_shared;
+	static Mutex _shared_mutex;
+
+	ssi_char_t *_name;
+	Worker _worker;
+
+	Mutex _mutex;
+	Condition _wake;
+	Condition _done;
+	bool _stop;
+
+	std::vector<entry_t *> _entries;
+	ssi_size_t _next_id;
+	ssi_size_t _running;
+};
+
+}
+
+#endif
@@ -0,0 +1,113 @@
+// WorkerPool.h
+// created: 2026/10/19
+// Copyright (C) University of Augsburg, Lab for Human Centered Multimedia
+//
+// *************************************************************************************************
+//
+// This file is part of Social Signal Interpretation (SSI) developed at the
+// Lab for Human Centered Multimedia of the University of Augsburg
+//
+// This library is free software; you can redistribute itand/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 3 of the License, or any laterversion.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FORA PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along withthis library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+//
+//*************************************************************************************************
+
+#pragma once
+
+#ifndef SSI_THREAD_WORKERPOOL_H
+#define SSI_THREAD_WORKERPOOL_H
+
+#include "thread/Thread.h"
+#include "thread/ThreadLibCons.h"
+#include "thread/Mutex.h"
+#include "thread/Condition.h"
+
+namespace ssi {
+
+//! \brief Persistent threads that run the iterations of a loop in parallel.
+//
+// Unlike ThreadPool, which starts a thread per job, the workers are started once
+// and wait for work, so a call to run() is cheap enough to be issued per frame.
+// The calling thread takes part in the work and run() returns after all tasks have
+// finished. If the pool is already busy, e.g. when run() is called from inside a task,
+// the tasks are executed on the calling thread.
+//
+class WorkerPool {
+
+public:
+
+	typedef void (*task_t) (ssi_size_t index, void *arg);
+
+	// n_threads is the number of threads including the caller, 0 selects the number of cores
+	WorkerPool (const ssi_char_t *name, ssi_size_t n_threads = 0);
+	virtual ~WorkerPool ();
+
+	// calls task (i, arg) for i = 0..n-1
+	void run (ssi_size_t n, task_t task, void *arg);
+
+	ssi_size_t size () { return _n_worker + 1; };
+
+	// pool shared by all components, created on first use
+	static WorkerPool *GetShared ();
+	static void ReleaseShared ();
+
+	static ssi_size_t GetNumberOfCores ();
+
+	static void SetLogLevel (int level) {
+		ssi_log_level = level;
+	}
+
+protected:
+
+	class Worker : public Thread {
+
+	public:
+
+		Worker ();
+		void set (WorkerPool *pool) { _pool = pool; };
+		void run ();
+
+	protected:
+
+		WorkerPool *_pool;
+	};
+
+	// runs tasks until none is left, _mutex has to be locked
+	void work ();
+
+	static int ssi_log_level;
+	static ssi_char_t *ssi_log_name;
+
+	static WorkerPool *_shared;
+	static Mutex _shared_mutex;
+
+	ssi_char_t *_name;
+	ssi_size_t _n_worker;
+	Worker *_worker;
+
+	Mutex _mutex;
+	Condition _wake;
+	Condition _done;
+	bool _stop;
+
+	task_t _task;
+	void *_arg;
+	ssi_size_t _n;
+	ssi_size_t _next;
+	ssi_size_t _finished;
+};
+
+}
+
+#endif
@@ -65,7 +65,6 @@ Factory *Factory::_factory = 0;
 
 Factory::Factory()
 	: _id_counter(1),
-	_strings_counter(0),
 	_board(0),
 	_frame(0),
 	_wmanager(0) {
@@ -73,10 +72,6 @@ Factory::Factory()
 	#if __ANDROID__
 		android=new ssiAndroidApp();
 	#endif
-
-	for (ssi_size_t i = 0; i < SSI_FACTORY_STRINGS_MAX; i++) {
-		_strings[i] = 0;
-	}
 }
 
 Factory::~Factory () {
@@ -477,7 +472,8 @@ IObject *Factory::create(const ssi_char_t *name, const ssi_char_t *file, bool au
 	if (auto_free) {
 		ssi_char_t *uid = getUniqueObjectId(id);
 		ssi_msg(SSI_LOG_LEVEL_BASIC, "store instance of '%s' as '%s'", name, uid);
-		_object_id_map.insert(object_id_pair_t(String(uid), object));
+		std::pair<object_id_map_t::iterator, bool> ret = _object_id_map.insert(object_id_pair_t(String(uid), object));
+		_object_ptr_map[object] = ret.first->first.str();
 		delete[] uid;
 	} else {
 		if (id) {
@@ -520,11 +516,9 @@ const ssi_char_t *Factory::getObjectId(IObject *object) {
 		return 0;
 	}
 
-	object_id_map_t::iterator it;
-	for (it = _object_id_map.begin(); it != _object_id_map.end(); it++) {
-		if (it->second == object) {
-			return it->first.str();
-		}
+	object_ptr_map_t::iterator it = _object_ptr_map.find(object);
+	if (it != _object_ptr_map.end()) {
+		return it->second;
 	}
 
 	ssi_wrn("the requested object of type '%s' was not found", object->getName());
@@ -545,6 +539,7 @@ void Factory::clearObjects () {
 			delete it->second;
 		}
 		_object_id_map.clear ();
+		_object_ptr_map.clear ();
 	}
 }
 
@@ -607,15 +602,7 @@ void Factory::clear () {
 	delete android;
 	android=0;
 	#endif
-	{
-		Lock lock (_mutex);
-
-		for (ssi_size_t i = 0; i < _strings_counter; i++) {
-			delete[] _strings[i];
-			_strings[i] = 0;
-		}
-		_strings_counter = 0;
-	}
+	_strings.clear ();
 }
 
 ITheEventBoard *Factory::getEventBoard (const ssi_char_t *file) {
@@ -705,66 +692,38 @@ bool Factory::exportDlls (const ssi_char_t *target_dir) {
 
 ssi_size_t Factory::addString (const ssi_char_t *name) {
 
-	Lock lock (_mutex);
-
 	ssi_msg (SSI_LOG_LEVEL_DEBUG, "add string '%s'", name);
 
 	if (name == 0) {
 		return SSI_FACTORY_STRINGS_INVALID_ID;
 	}
 
-	// check if string is in list
-	const ssi_char_t *str = 0;
-	for (ssi_size_t i = 0; i < _strings_counter; i++) {
-		str = _strings[i];
-		if (strcmp (name, str) == 0) {
-			return i;
-		}
-	}
-
-	// otherwise add string
-	ssi_size_t index = 0;
-	{
-		index = _strings_counter;
-		if (_strings_counter == SSI_FACTORY_STRINGS_MAX) {
-			ssi_wrn ("#string exceeds available space '%u'", SSI_FACTORY_STRINGS_MAX);
-			return SSI_FACTORY_STRINGS_INVALID_ID;
-		} else {
-			_strings[_strings_counter++] = ssi_strcpy (name);
-		}
-	}
-
-	return index;
+	return _strings.add (name);
 }
 
 ssi_size_t Factory::getStringId (const ssi_char_t *name) {
 
-	Lock lock (_mutex);
+	ssi_size_t id = _strings.find (name);
 
-	for (ssi_size_t i = 0; i < _strings_counter; i++) {
-		if (strcmp (name, _strings[i]) == 0) {
-			return i;
-		}
+	if (id == SSI_FACTORY_STRINGS_INVALID_ID) {
+		ssi_wrn ("string '%s' does not exist", name);
 	}
 
-	ssi_wrn ("string '%s' does not exist", name);
-	return SSI_FACTORY_STRINGS_INVALID_ID;
+	return id;
 }
 
 const ssi_char_t *Factory::getString (ssi_size_t id) {
 
-	Lock lock (_mutex);
-
 	if (id == SSI_FACTORY_STRINGS_INVALID_ID) {
 		return "undef";
 	}
 
-	if (id >= _strings_counter) {
-		ssi_wrn ("id '%u' exceeds available #strings '%u'", id, _strings_counter);
-		return 0;
+	const ssi_char_t *str = _strings.get (id);
+	if (!str) {
+		ssi_wrn ("id '%u' exceeds available #strings '%u'", id, _strings.size ());
 	}
 
-	return _strings[id];
+	return str;
 }
 
 ssi_size_t Factory::getUniqueId () {
@@ -800,9 +759,8 @@ void Factory::print(FILE *file) {
 
 	{
 		ssi_fprint(file, "Strings:\n");
-		object_id_map_t::iterator it;
-		for (ssi_size_t i = 0; i < _strings_counter; i++) {
-			ssi_fprint(file, " > %s [ %u ]\n", _strings[i], i);
+		for (ssi_size_t i = 0; i < _strings.size(); i++) {
+			ssi_fprint(file, " > %s [ %u ]\n", _strings.get(i), i);
 		}
 	}
 
@@ -0,0 +1,239 @@
+// StringTable.cpp
+// created: 2026/10/19
+// Copyright (C) University of Augsburg, Lab for Human Centered Multimedia
+//
+// *************************************************************************************************
+//
+// This file is part of Social Signal Interpretation (SSI) developed at the
+// Lab for Human Centered Multimedia of the University of Augsburg
+//
+// This library is free software; you can redistribute itand/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 3 of the License, or any laterversion.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FORA PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along withthis library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+//
+//*************************************************************************************************
+
+#include "base/StringTable.h"
+#include "thread/Lock.h"
+
+#ifdef USE_SSI_LEAK_DETECTOR
+	#include "SSI_LeakWatcher.h"
+	#ifdef _DEBUG
+		#define new DEBUG_NEW
+		#undef THIS_FILE
+		static char THIS_FILE[] = __FILE__;
+	#endif
+#endif
+
+namespace ssi {
+
+StringTable::StringTable ()
+	: _size (0),
+	_index (0) {
+
+	for (ssi_size_t i = 0; i < CHUNK_MAX; i++) {
+		_chunks[i].store (0);
+	}
+}
+
+StringTable::~StringTable () {
+
+	release ();
+}
+
+ssi_size_t StringTable::Hash (const ssi_char_t *str) {
+
+	// FNV-1a
+	ssi_size_t hash = 2166136261u;
+	while (*str) {
+		hash ^= ssi_cast (unsigned char, *str++);
+		hash *= 16777619u;
+	}
+
+	return hash;
+}
+
+void StringTable::Locate (ssi_size_t id, ssi_size_t &chunk, ssi_size_t &offset) {
+
+	ssi_size_t pos = id + (1u << CHUNK_BITS);
+	ssi_size_t bit = CHUNK_BITS;
+	while ((pos >> (bit + 1)) != 0) {
+		bit++;
+	}
+
+	chunk = bit - CHUNK_BITS;
+	offset = pos - (1u << bit);
+}
+
+StringTable::entry_t *StringTable::entry (ssi_size_t id) {
+
+	ssi_size_t chunk, offset;
+	Locate (id, chunk, offset);
+
+	return _chunks[chunk].load (std::memory_order_acquire) + offset;
+}
+
+ssi_size_t StringTable::lookup (index_t *index, const ssi_char_t *str, ssi_size_t hash) {
+
+	if (!index) {
+		return INVALID_ID;
+	}
+
+	ssi_size_t n = _size.load (std::memory_order_acquire);
+	for (ssi_size_t pos = hash & index->mask;; pos = (pos + 1) & index->mask) {
+		ssi_size_t slot = index->slots[pos].load (std::memory_order_acquire);
+		if (slot == 0) {
+			return INVALID_ID;
+		}
+		ssi_size_t id = slot - 1;
+		if (id < n) {
+			entry_t *e = entry (id);
+			if (e->hash == hash && strcmp (e->str, str) == 0) {
+				return id;
+			}
+		}
+	}
+}
+
+void StringTable::insert (index_t *index, ssi_size_t id, ssi_size_t hash) {
+
+	ssi_size_t pos = hash & index->mask;
+	while (index->slots[pos].load (std::memory_order_relaxed) != 0) {
+		pos = (pos + 1) & index->mask;
+	}
+	index->slots[pos].store (id + 1, std::memory_order_release);
+}
+
+void StringTable::grow () {
+
+	index_t *old_index = _index.load (std::memory_order_relaxed);
+	ssi_size_t n = _size.load (std::memory_order_relaxed);
+
+	ssi_size_t capacity = old_index ? (old_index->mask + 1) * 2 : 64;
+	index_t *index = new index_t;
+	index->mask = capacity - 1;
+	index->slots = new std::atomic<ssi_size_t>[capacity];
+	for (ssi_size_t i = 0; i < capacity; i++) {
+		index->slots[i].store (0, std::memory_order_relaxed);
+	}
+	index->retired = old_index;
+
+	for (ssi_size_t id = 0; id < n; id++) {
+		insert (index, id, entry (id)->hash);
+	}
+
+	_index.store (index, std::memory_order_release);
+}
+
+ssi_size_t StringTable::find (const ssi_char_t *str) {
+
+	if (!str) {
+		return INVALID_ID;
+	}
+
+	return lookup (_index.load (std::memory_order_acquire), str, Hash (str));
+}
+
+ssi_size_t StringTable::add (const ssi_char_t *str) {
+
+	if (!str) {
+		return INVALID_ID;
+	}
+
+	ssi_size_t hash = Hash (str);
+	ssi_size_t id = lookup (_index.load (std::memory_order_acquire), str, hash);
+	if (id != INVALID_ID) {
+		return id;
+	}
+
+	Lock lock (_mutex);
+
+	// may have been added in the meantime
+	id = lookup (_index.load (std::memory_order_acquire), str, hash);
+	if (id != INVALID_ID) {
+		return id;
+	}
+
+	id = _size.load (std::memory_order_relaxed);
+	if (id >= INVALID_ID - (1u << CHUNK_BITS)) {
+		return INVALID_ID;
+	}
+
+	// allocate chunk when its first entry is requested
+	ssi_size_t chunk, offset;
+	Locate (id, chunk, offset);
+	if (offset == 0) {
+		_chunks[chunk].store (new entry_t[1u << (CHUNK_BITS + chunk)], std::memory_order_release);
+	}
+
+	entry_t *e = entry (id);
+	e->str = ssi_strcpy (str);
+	e->hash = hash;
+	_size.store (id + 1, std::memory_order_release);
+
+	// keep load factor below 1/2
+	index_t *index = _index.load (std::memory_order_relaxed);
+	if (!index || 2 * (id + 1) > index->mask + 1) {
+		grow ();
+	} else {
+		insert (index, id, hash);
+	}
+
+	return id;
+}
+
+const ssi_char_t *StringTable::get (ssi_size_t id) {
+
+	if (id >= _size.load (std::memory_order_acquire)) {
+		return 0;
+	}
+
+	return entry (id)->str;
+}
+
+ssi_size_t StringTable::size () {
+
+	return _size.load (std::memory_order_acquire);
+}
+
+void StringTable::clear () {
+
+	Lock lock (_mutex);
+
+	release ();
+}
+
+void StringTable::release () {
+
+	ssi_size_t n = _size.load (std::memory_order_relaxed);
+	for (ssi_size_t id = 0; id < n; id++) {
+		delete[] entry (id)->str;
+	}
+	_size.store (0, std::memory_order_release);
+
+	for (ssi_size_t i = 0; i < CHUNK_MAX; i++) {
+		delete[] _chunks[i].load (std::memory_order_relaxed);
+		_chunks[i].store (0, std::memory_order_relaxed);
+	}
+
+	index_t *index = _index.load (std::memory_order_relaxed);
+	while (index) {
+		index_t *retired = index->retired;
+		delete[] index->slots;
+		delete index;
+		index = retired;
+	}
+	_index.store (0, std::memory_order_release);
+}
+
+}
@@ -0,0 +1,534 @@
+// AsciiNumber.cpp
+// created: 2026/10/19
+// Copyright (C) University of Augsburg, Lab for Human Centered Multimedia
+//
+// *************************************************************************************************
+//
+// This file is part of Social Signal Interpretation (SSI) developed at the
+// Lab for Human Centered Multimedia of the University of Augsburg
+//
+// This library is free software; you can redistribute itand/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 3 of the License, or any laterversion.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FORA PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along withthis library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+//
+//*************************************************************************************************
+
+#include "ioput/file/AsciiNumber.h"
+
+#include <cmath>
+#include <cfloat>
+
+#ifdef USE_SSI_LEAK_DETECTOR
+	#include "SSI_LeakWatcher.h"
+	#ifdef _DEBUG
+		#define new DEBUG_NEW
+		#undef THIS_FILE
+		static char THIS_FILE[] = __FILE__;
+	#endif
+#endif
+
+namespace ssi {
+
+namespace {
+
+// powers of ten that fit into a double, 10^0..10^22 are exact
+const int POW10_MAX = 308;
+double pow10_table[POW10_MAX + 1];
+
+struct pow10_init_t {
+	pow10_init_t () {
+		for (int i = 0; i <= POW10_MAX; i++) {
+			ssi_char_t string[8];
+			ssi_sprint (string, "1e%d", i);
+			pow10_table[i] = strtod (string, 0);
+		}
+	}
+} pow10_init;
+
+// 2^53 and 2^24, above integers are no longer exact
+const uint64_t MAX_EXACT_DOUBLE = 9007199254740992ull;
+const uint64_t MAX_EXACT_FLOAT = 16777216ull;
+
+// enough to hold any number that has a chance to be valid
+const int FALLBACK_MAX = 64;
+
+inline bool is_digit (ssi_char_t c) {
+	return c >= '0' && c <= '9';
+}
+
+}
+
+bool AsciiNumber::IsSupported (ssi_type_t type) {
+
+	switch (type) {
+		case SSI_SHORT:
+		case SSI_USHORT:
+		case SSI_INT:
+		case SSI_UINT:
+		case SSI_LONG:
+		case SSI_ULONG:
+		case SSI_FLOAT:
+		case SSI_DOUBLE:
+			return true;
+		default:
+			return false;
+	}
+}
+
+bool AsciiNumber::ParseInteger (const ssi_char_t *&str, const ssi_char_t *end, int64_t &value) {
+
+	const ssi_char_t *s = str;
+	bool negative = false;
+	if (s < end && (*s == '-' || *s == '+')) {
+		negative = *s == '-';
+		s++;
+	}
+	if (s == end || !is_digit (*s)) {
+		return false;
+	}
+
+	uint64_t result = 0;
+	while (s < end && is_digit (*s)) {
+		result = result * 10 + (*s++ - '0');
+	}
+
+	// like scanf an unsigned number may be preceded by a minus
+	value = negative ? ssi_cast (int64_t, 0 - result) : ssi_cast (int64_t, result);
+	str = s;
+
+	return true;
+}
+
+bool AsciiNumber::Parse (const ssi_char_t *&str, const ssi_char_t *end, int16_t &value) {
+
+	int64_t v;
+	if (!ParseInteger (str, end, v)) {
+		return false;
+	}
+	value = ssi_cast (int16_t, v);
+	return true;
+}
+
+bool AsciiNumber::Parse (const ssi_char_t *&str, const ssi_char_t *end, uint16_t &value) {
+
+	int64_t v;
+	if (!ParseInteger (str, end, v)) {
+		return false;
+	}
+	value = ssi_cast (uint16_t, v);
+	return true;
+}
+
+bool AsciiNumber::Parse (const ssi_char_t *&str, const ssi_char_t *end, int32_t &value) {
+
+	int64_t v;
+	if (!ParseInteger (str, end, v)) {
+		return false;
+	}
+	value = ssi_cast (int32_t, v);
+	return true;
+}
+
+bool AsciiNumber::Parse (const ssi_char_t *&str, const ssi_char_t *end, uint32_t &value) {
+
+	int64_t v;
+	if (!ParseInteger (str, end, v)) {
+		return false;
+	}
+	value = ssi_cast (uint32_t, v);
+	return true;
+}
+
+bool AsciiNumber::Parse (const ssi_char_t *&str, const ssi_char_t *end, int64_t &value) {
+
+	return ParseInteger (str, end, value);
+}
+
+bool AsciiNumber::Parse (const ssi_char_t *&str, const ssi_char_t *end, uint64_t &value) {
+
+	int64_t v;
+	if (!ParseInteger (str, end, v)) {
+		return false;
+	}
+	value = ssi_cast (uint64_t, v);
+	return true;
+}
+
+bool AsciiNumber::Parse (const ssi_char_t *&str, const ssi_char_t *end, float &value) {
+
+	double v;
+	if (!ParseDecimal (str, end, v, true)) {
+		return false;
+	}
+	value = ssi_cast (float, v);
+	return true;
+}
+
+bool AsciiNumber::Parse (const ssi_char_t *&str, const ssi_char_t *end, double &value) {
+
+	return ParseDecimal (str, end, value, false);
+}
+
+bool AsciiNumber::Compose (uint64_t mantissa, int exponent, bool single, double &value) {
+
+	// a single rounding step gives the correctly rounded result (Clinger's fast path)
+	if (single) {
+		if (mantissa > MAX_EXACT_FLOAT || exponent < -10 || exponent > 10) {
+			return false;
+		}
+		float m = ssi_cast (float, mantissa);
+		float p = ssi_cast (float, pow10_table[exponent < 0 ? -exponent : exponent]);
+		value = exponent < 0 ? m / p : m * p;
+	} else {
+		if (mantissa > MAX_EXACT_DOUBLE || exponent < -22 || exponent > 22) {
+			return false;
+		}
+		double m = ssi_cast (double, mantissa);
+		value = exponent < 0 ? m / pow10_table[-exponent] : m * pow10_table[exponent];
+	}
+
+	return true;
+}
+
+bool AsciiNumber::Fallback (const ssi_char_t *&str, const ssi_char_t *end, double &value, bool single) {
+
+	ssi_char_t string[FALLBACK_MAX];
+	int n = 0;
+	for (const ssi_char_t *s = str; s < end && n < FALLBACK_MAX - 1; s++) {
+		ssi_char_t c = *s;
+		if (!(is_digit (c) || (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '.' || c == '+' || c == '-')) {
+			break;
+		}
+		string[n++] = c;
+	}
+	string[n] = '\0';
+
+	ssi_char_t *stop = 0;
+	value = single ? strtof (string, &stop) : strtod (string, &stop);
+	if (stop == string) {
+		return false;
+	}
+	str += stop - string;
+
+	return true;
+}
+
+bool AsciiNumber::ParseDecimal (const ssi_char_t *&str, const ssi_char_t *end, double &value, bool single) {
+
+	const ssi_char_t *s = str;
+	bool negative = false;
+	if (s < end && (*s == '-' || *s == '+')) {
+		negative = *s == '-';
+		s++;
+	}
+
+	uint64_t mantissa = 0;
+	int digits = 0; // significant digits
+	int exponent = 0;
+	bool any = false;
+
+	while (s < end && is_digit (*s)) {
+		any = true;
+		if (digits < 19) {
+			mantissa = mantissa * 10 + (*s - '0');
+			if (mantissa) {
+				digits++;
+			}
+		} else {
+			return Fallback (str, end, value, single);
+		}
+		s++;
+	}
+	if (s < end && *s == '.') {
+		s++;
+		while (s < end && is_digit (*s)) {
+			any = true;
+			if (digits < 19) {
+				mantissa = mantissa * 10 + (*s - '0');
+				if (mantissa) {
+					digits++;
+				}
+				exponent--;
+			} else {
+				return Fallback (str, end, value, single);
+			}
+			s++;
+		}
+	}
+	if (!any) {
+		// inf, nan, ...
+		return Fallback (str, end, value, single);
+	}
+
+	// an 'e' without digits is not part of the number
+	if (s < end && (*s == 'e' || *s == 'E')) {
+		const ssi_char_t *e = s + 1;
+		bool negative_exponent = false;
+		if (e < end && (*e == '-' || *e == '+')) {
+			negative_exponent = *e == '-';
+			e++;
+		}
+		if (e < end && is_digit (*e)) {
+			int n = 0;
+			while (e < end && is_digit (*e)) {
+				if (n < 10000) {
+					n = n * 10 + (*e - '0');
+				}
+				e++;
+			}
+			exponent += negative_exponent ? -n : n;
+			s = e;
+		}
+	}
+
+	if (mantissa == 0) {
+		value = negative ? -0.0 : 0.0;
+	} else if (!Compose (mantissa, exponent, single, value)) {
+		return Fallback (str, end, value, single);
+	} else if (negative) {
+		value = -value;
+	}
+	str = s;
+
+	return true;
+}
+
+ssi_size_t AsciiNumber::PrintInteger (uint64_t magnitude, bool negative, ssi_char_t *str) {
+
+	ssi_char_t digits[24];
+	ssi_size_t n = 0;
+	do {
+		digits[n++] = ssi_cast (ssi_char_t, '0' + magnitude % 10);
+		magnitude /= 10;
+	} while (magnitude);
+
+	ssi_char_t *s = str;
+	if (negative) {
+		*s++ = '-';
+	}
+	while (n > 0) {
+		*s++ = digits[--n];
+	}
+
+	return ssi_cast (ssi_size_t, s - str);
+}
+
+ssi_size_t AsciiNumber::Print (int16_t value, ssi_char_t *str) {
+	return Print (ssi_cast (int64_t, value), str);
+}
+
+ssi_size_t AsciiNumber::Print (uint16_t value, ssi_char_t *str) {
+	return PrintInteger (value, false, str);
+}
+
+ssi_size_t AsciiNumber::Print (int32_t value, ssi_char_t *str) {
+	return Print (ssi_cast (int64_t, value), str);
+}
+
+ssi_size_t AsciiNumber::Print (uint32_t value, ssi_char_t *str) {
+	return PrintInteger (value, false, str);
+}
+
+ssi_size_t AsciiNumber::Print (int64_t value, ssi_char_t *str) {
+	return PrintInteger (value < 0 ? 0 - ssi_cast (uint64_t, value) : ssi_cast (uint64_t, value), value < 0, str);
+}
+
+ssi_size_t AsciiNumber::Print (uint64_t value, ssi_char_t *str) {
+	return PrintInteger (value, false, str);
+}
+
+ssi_size_t AsciiNumber::Print (float value, ssi_char_t *str) {
+	return PrintDecimal (value, true, str);
+}
+
+ssi_size_t AsciiNumber::Print (double value, ssi_char_t *str) {
+	return PrintDecimal (value, false, str);
+}
+
+bool AsciiNumber::RoundTrips (uint64_t mantissa, int exponent, double value, bool single) {
+
+	double composed;
+	if (Compose (mantissa, exponent, false, composed)) {
+		if (!single) {
+			return composed == value;
+		}
+		// composed is the correctly rounded double, rounding it to float once more
+		// only goes wrong if it hits the midpoint between two floats
+		float f = ssi_cast (float, composed);
+		if (f != ssi_cast (float, value)) {
+			return false;
+		}
+		if (ssi_cast (double, f) == composed) {
+			return true;
+		}
+		float next = nextafterf (f, composed > f ? FLT_MAX : -FLT_MAX);
+		return composed != (ssi_cast (double, f) + ssi_cast (double, next)) / 2;
+	}
+
+	// for 16 and 17 digits compare mantissa - value * 10^-exponent against half the
+	// gap to the neighbours, value * 10^-exponent is split into hi + lo exactly
+	if (!single && exponent < 0 && exponent >= -22) {
+		double p = pow10_table[-exponent];
+		double hi = value * p;
+		if (hi >= MAX_EXACT_DOUBLE && hi < 9.2e18) {
+			// Dekker's product
+			const double split = 134217729.0; // 2^27 + 1
+			double t = split * value, vh = t - (t - value), vl = value - vh;
+			t = split * p;
+			double ph = t - (t - p), pl = p - ph;
+			double lo = ((vh * ph - hi) + vh * pl + vl * ph) + vl * pl;
+			double distance = ssi_cast (double, ssi_cast (int64_t, mantissa) - ssi_cast (int64_t, hi)) - lo;
+			int e2;
+			double f = frexp (value, &e2);
+			double half = ldexp (p, e2 - 54);
+			// the gap below a power of two is only half as wide
+			double bound = distance < 0 && f == 0.5 ? half / 2 : half;
+			double margin = fabs (distance) - bound;
+			if (margin < -1e-6) {
+				return true;
+			}
+			if (margin > 1e-6) {
+				return false;
+			}
+		}
+	}
+
+	ssi_char_t string[FALLBACK_MAX];
+	ssi_sprint (string, "%llue%d", ssi_cast (unsigned long long, mantissa), exponent);
+	if (single) {
+		return strtof (string, 0) == ssi_cast (float, value);
+	}
+	return strtod (string, 0) == value;
+}
+
+ssi_size_t AsciiNumber::PrintDecimal (double value, bool single, ssi_char_t *str) {
+
+	ssi_char_t *s = str;
+	if (value == 0) {
+		if (std::signbit (value)) {
+			*s++ = '-';
+		}
+		*s++ = '0';
+		return ssi_cast (ssi_size_t, s - str);
+	}
+
+	double a = value < 0 ? -value : value;
+
+	// nan, inf and the far ends of the double range are left to the c library
+	if (!(a >= 1e-290 && a <= 1e290)) {
+		int n = ssi_sprint (str, single ? "%.9g" : "%.17g", value);
+		return n > 0 ? ssi_cast (ssi_size_t, n) : 0;
+	}
+
+	// find the smallest number of digits that reads back to the same value
+	int max_digits = single ? 9 : 17;
+	int e10 = ssi_cast (int, floor (log10 (a)));
+	uint64_t mantissa = 0;
+	int digits = 0;
+	for (int p = 1; p <= max_digits && digits == 0; p++) {
+		double scaled = 0;
+		for (int attempt = 0; attempt < 2; attempt++) {
+			int k = p - 1 - e10;
+			scaled = k < 0 ? a / pow10_table[-k] : a * pow10_table[k];
+			// log10() may be off by one
+			if (scaled >= pow10_table[p] - 0.5) {
+				e10++;
+			} else if (scaled < pow10_table[p - 1] - 0.5) {
+				e10--;
+			} else {
+				break;
+			}
+		}
+		// scaled is rounded itself, so if it is close to a tie or above 2^52
+		// the neighbour of the nearest integer may be the better candidate
+		double lower = floor (scaled);
+		double fraction = scaled - lower;
+		uint64_t candidates[3];
+		ssi_size_t n_candidates = 0;
+		candidates[n_candidates++] = ssi_cast (uint64_t, fraction >= 0.5 ? lower + 1 : lower);
+		if (scaled >= MAX_EXACT_DOUBLE / 2) {
+			candidates[n_candidates++] = candidates[0] - 1;
+			candidates[n_candidates++] = candidates[0] + 1;
+		} else if (fabs (fraction - 0.5) <= scaled * DBL_EPSILON) {
+			candidates[n_candidates++] = ssi_cast (uint64_t, fraction >= 0.5 ? lower : lower + 1);
+		}
+		for (ssi_size_t i = 0; i < n_candidates; i++) {
+			if (candidates[i] >= pow10_table[p - 1] && candidates[i] < pow10_table[p]
+				&& RoundTrips (candidates[i], e10 - (p - 1), a, single)) {
+				mantissa = candidates[i];
+				digits = p;
+				break;
+			}
+		}
+	}
+	if (digits == 0) {
+		int n = ssi_sprint (str, single ? "%.9g" : "%.17g", value);
+		return n > 0 ? ssi_cast (ssi_size_t, n) : 0;
+	}
+
+	ssi_char_t d[24];
+	for (int i = digits - 1; i >= 0; i--) {
+		d[i] = ssi_cast (ssi_char_t, '0' + mantissa % 10);
+		mantissa /= 10;
+	}
+	while (digits > 1 && d[digits - 1] == '0') {
+		digits--;
+	}
+
+	if (value < 0) {
+		*s++ = '-';
+	}
+
+	if (e10 >= -5 && e10 < 16) {
+		if (e10 < 0) {
+			*s++ = '0';
+			*s++ = '.';
+			for (int i = -1; i > e10; i--) {
+				*s++ = '0';
+			}
+			for (int i = 0; i < digits; i++) {
+				*s++ = d[i];
+			}
+		} else {
+			for (int i = 0; i <= e10; i++) {
+				*s++ = i < digits ? d[i] : '0';
+			}
+			if (digits > e10 + 1) {
+				*s++ = '.';
+				for (int i = e10 + 1; i < digits; i++) {
+					*s++ = d[i];
+				}
+			}
+		}
+	} else {
+		*s++ = d[0];
+		if (digits > 1) {
+			*s++ = '.';
+			for (int i = 1; i < digits; i++) {
+				*s++ = d[i];
+			}
+		}
+		*s++ = 'e';
+		*s++ = e10 < 0 ? '-' : '+';
+		int e = e10 < 0 ? -e10 : e10;
+		if (e >= 100) {
+			*s++ = ssi_cast (ssi_char_t, '0' + e / 100);
+		}
+		*s++ = ssi_cast (ssi_char_t, '0' + (e / 10) % 10);
+		*s++ = ssi_cast (ssi_char_t, '0' + e % 10);
+	}
+
+	return ssi_cast (ssi_size_t, s - str);
+}
+
+}
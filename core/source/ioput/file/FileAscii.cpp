@@ -25,6 +25,7 @@
 //*************************************************************************************************
 
 #include "ioput/file/FileAscii.h"
+#include "ioput/file/AsciiNumber.h"
 
 #ifdef USE_SSI_LEAK_DETECTOR
 	#include "SSI_LeakWatcher.h"
@@ -35,12 +36,21 @@
 	#endif
 #endif
 
+#if _WIN32|_WIN64
+	#define ssi_getc_nolock _getc_nolock
+	#define ssi_ungetc_nolock _ungetc_nolock
+#else
+	#define ssi_getc_nolock getc_unlocked
+	#define ssi_ungetc_nolock ungetc
+#endif
+
 namespace ssi {
 
 FileAscii::FileAscii () 
-	: _format_with_delim (0),
+	: _type (SSI_CHAR),
+	_format_with_delim (0),
 	_format_with_newline (0),
-	_type (SSI_CHAR) {
+	_fast (false) {
 	
 	setFormat (0, 0); 
 };
@@ -84,22 +94,25 @@ void FileAscii::setFormat (const char *delim,
 			sprintf (_format, "%%%su", _flags);
 			break;
 		case SSI_LONG:
-			sprintf (_format, "%%%sld", _flags);
+			sprintf (_format, "%%%slld", _flags);
 			break;
 		case SSI_ULONG:
-			sprintf (_format, "%%%slu", _flags);
+			sprintf (_format, "%%%sllu", _flags);
 			break;
 		case SSI_FLOAT:
 			sprintf (_format, "%%%sf", _flags);
 			break;
 		case SSI_DOUBLE:
-			sprintf (_format, "%%%sLf", _flags);
+			sprintf (_format, "%%%slf", _flags);
 			break;
 		default:
 			ssi_err ("unsupported sample type");
 	}
 	_format_with_delim = ssi_strcat (_format, _delim);
 	_format_with_newline = ssi_strcat (_format, "\n");	
+
+	// without flags numbers are converted by AsciiNumber
+	_fast = _flags[0] == '\0' && AsciiNumber::IsSupported (_type);
 }
 
 FileAscii::~FileAscii () {
@@ -130,28 +143,28 @@ ssi_size_t FileAscii::read (void *ptr, ssi_size_t size, ssi_size_t count) {
 			result = FileAscii::read_h<unsigned char> (_file, _format_with_delim, _format_with_newline, ptr, size, count);
 			break;
 		case SSI_SHORT:
-            result = FileAscii::read_h<int16_t> (_file, _format_with_delim, _format_with_newline, ptr, size, count);
+            result = _fast ? FileAscii::read_fast<int16_t> (_file, _delim, ptr, size, count) : FileAscii::read_h<int16_t> (_file, _format_with_delim, _format_with_newline, ptr, size, count);
 			break;
 		case SSI_USHORT:
-            result = FileAscii::read_h<uint16_t> (_file, _format_with_delim, _format_with_newline, ptr, size, count);
+            result = _fast ? FileAscii::read_fast<uint16_t> (_file, _delim, ptr, size, count) : FileAscii::read_h<uint16_t> (_file, _format_with_delim, _format_with_newline, ptr, size, count);
 			break;
 		case SSI_INT:
-            result = FileAscii::read_h<int32_t> (_file, _format_with_delim, _format_with_newline, ptr, size, count);
+            result = _fast ? FileAscii::read_fast<int32_t> (_file, _delim, ptr, size, count) : FileAscii::read_h<int32_t> (_file, _format_with_delim, _format_with_newline, ptr, size, count);
 			break;
 		case SSI_UINT:
-            result = FileAscii::read_h<uint32_t> (_file, _format_with_delim, _format_with_newline, ptr, size, count);
+            result = _fast ? FileAscii::read_fast<uint32_t> (_file, _delim, ptr, size, count) : FileAscii::read_h<uint32_t> (_file, _format_with_delim, _format_with_newline, ptr, size, count);
 			break;
 		case SSI_LONG:
-            result = FileAscii::read_h<int32_t> (_file, _format_with_delim, _format_with_newline, ptr, size, count);
+            result = _fast ? FileAscii::read_fast<int64_t> (_file, _delim, ptr, size, count) : FileAscii::read_h<int64_t> (_file, _format_with_delim, _format_with_newline, ptr, size, count);
 			break;
 		case SSI_ULONG:
-            result = FileAscii::read_h<uint32_t> (_file, _format_with_delim, _format_with_newline, ptr, size, count);
+            result = _fast ? FileAscii::read_fast<uint64_t> (_file, _delim, ptr, size, count) : FileAscii::read_h<uint64_t> (_file, _format_with_delim, _format_with_newline, ptr, size, count);
 			break;
 		case SSI_FLOAT:
-			result = FileAscii::read_h<float> (_file, _format_with_delim, _format_with_newline, ptr, size, count);
+			result = _fast ? FileAscii::read_fast<float> (_file, _delim, ptr, size, count) : FileAscii::read_h<float> (_file, _format_with_delim, _format_with_newline, ptr, size, count);
 			break;
 		case SSI_DOUBLE:
-			result = FileAscii::read_h<double> (_file, _format_with_delim, _format_with_newline, ptr, size, count);
+			result = _fast ? FileAscii::read_fast<double> (_file, _delim, ptr, size, count) : FileAscii::read_h<double> (_file, _format_with_delim, _format_with_newline, ptr, size, count);
 			break;
 		default:
 			ssi_err ("unsupported sample type");
@@ -189,6 +202,56 @@ SSI_INLINE ssi_size_t FileAscii::read_h (FILE *file, const ssi_char_t *format_wi
 	return rescount;
 }
 
+template<class T>
+SSI_INLINE ssi_size_t FileAscii::read_fast (FILE *file, const ssi_char_t *delim, void *ptr, ssi_size_t size, ssi_size_t count) {
+
+	// same as fscanf, i.e. leading white space is skipped, a white space
+	// in the delimiter matches any amount of white space and other characters
+	// have to match or are put back
+	ssi_char_t token[AsciiNumber::MAX_CHARS * 2];
+	T *ptrT = ssi_pcast (T, ptr);
+	for (ssi_size_t i = 0; i < count; ++i) {
+
+		int c = ssi_getc_nolock (file);
+		while (c != EOF && isspace (c)) {
+			c = ssi_getc_nolock (file);
+		}
+		ssi_size_t n = 0;
+		while (c != EOF && n < sizeof (token) && (isalnum (c) || c == '.' || c == '-' || c == '+')) {
+			token[n++] = ssi_cast (ssi_char_t, c);
+			c = ssi_getc_nolock (file);
+		}
+		if (c != EOF) {
+			ssi_ungetc_nolock (c, file);
+		}
+
+		const ssi_char_t *pos = token;
+		if (n == 0 || n == sizeof (token) || !AsciiNumber::Parse (pos, token + n, *ptrT++) || pos != token + n) {
+			return 0;
+		}
+
+		const ssi_char_t *d = size > 0 && !((i+1) % size) ? "\n" : delim;
+		for (; *d; d++) {
+			c = ssi_getc_nolock (file);
+			if (isspace (ssi_cast (unsigned char, *d))) {
+				while (c != EOF && isspace (c)) {
+					c = ssi_getc_nolock (file);
+				}
+			} else if (c == *d) {
+				continue;
+			}
+			if (c != EOF) {
+				ssi_ungetc_nolock (c, file);
+			}
+			if (!isspace (ssi_cast (unsigned char, *d))) {
+				break;
+			}
+		}
+	}
+
+	return count;
+}
+
 ssi_size_t FileAscii::write (const void *ptr, ssi_size_t size, ssi_size_t count) {
 
 	if (!_is_open) {
@@ -211,28 +274,28 @@ ssi_size_t FileAscii::write (const void *ptr, ssi_size_t size, ssi_size_t count)
 			result = FileAscii::write_h<unsigned char> (_file, _format_with_delim, _format_with_newline, ptr, size, count);
 			break;
 		case SSI_SHORT:
-            result = FileAscii::write_h<int16_t> (_file, _format_with_delim, _format_with_newline, ptr, size, count);
+            result = _fast ? FileAscii::write_fast<int16_t> (_file, _delim, ptr, size, count) : FileAscii::write_h<int16_t> (_file, _format_with_delim, _format_with_newline, ptr, size, count);
 			break;
 		case SSI_USHORT:
-            result = FileAscii::write_h<uint16_t> (_file, _format_with_delim, _format_with_newline, ptr, size, count);
+            result = _fast ? FileAscii::write_fast<uint16_t> (_file, _delim, ptr, size, count) : FileAscii::write_h<uint16_t> (_file, _format_with_delim, _format_with_newline, ptr, size, count);
 			break;
 		case SSI_INT:
-            result = FileAscii::write_h<int32_t> (_file, _format_with_delim, _format_with_newline, ptr, size, count);
+            result = _fast ? FileAscii::write_fast<int32_t> (_file, _delim, ptr, size, count) : FileAscii::write_h<int32_t> (_file, _format_with_delim, _format_with_newline, ptr, size, count);
 			break;
 		case SSI_UINT:
-            result = FileAscii::write_h<uint32_t> (_file, _format_with_delim, _format_with_newline, ptr, size, count);
+            result = _fast ? FileAscii::write_fast<uint32_t> (_file, _delim, ptr, size, count) : FileAscii::write_h<uint32_t> (_file, _format_with_delim, _format_with_newline, ptr, size, count);
 			break;
 		case SSI_LONG:
-            result = FileAscii::write_h<int32_t> (_file, _format_with_delim, _format_with_newline, ptr, size, count);
+            result = _fast ? FileAscii::write_fast<int64_t> (_file, _delim, ptr, size, count) : FileAscii::write_h<int64_t> (_file, _format_with_delim, _format_with_newline, ptr, size, count);
 			break;
 		case SSI_ULONG:
-            result = FileAscii::write_h<uint32_t> (_file, _format_with_delim, _format_with_newline, ptr, size, count);
+            result = _fast ? FileAscii::write_fast<uint64_t> (_file, _delim, ptr, size, count) : FileAscii::write_h<uint64_t> (_file, _format_with_delim, _format_with_newline, ptr, size, count);
 			break;
 		case SSI_FLOAT:
-			result = FileAscii::write_h<float> (_file, _format_with_delim, _format_with_newline, ptr, size, count);
+			result = _fast ? FileAscii::write_fast<float> (_file, _delim, ptr, size, count) : FileAscii::write_h<float> (_file, _format_with_delim, _format_with_newline, ptr, size, count);
 			break;
 		case SSI_DOUBLE:
-			result = FileAscii::write_h<double> (_file, _format_with_delim, _format_with_newline, ptr, size, count);
+			result = _fast ? FileAscii::write_fast<double> (_file, _delim, ptr, size, count) : FileAscii::write_h<double> (_file, _format_with_delim, _format_with_newline, ptr, size, count);
 			break;
 		default:
 			ssi_err ("unsupported sample type");
@@ -267,6 +330,39 @@ SSI_INLINE ssi_size_t FileAscii::write_h (FILE *file, const ssi_char_t *format_w
 	return (ssi_size_t) res;
 }
 
+template<class T>
+SSI_INLINE ssi_size_t FileAscii::write_fast (FILE *file, const ssi_char_t *delim, const void *ptr, ssi_size_t size, ssi_size_t count) {
+
+	// values are collected in a buffer and passed on in blocks
+	ssi_char_t buffer[SSI_FILEASCII_BUFFER_SIZE];
+	ssi_size_t delim_len = ssi_cast (ssi_size_t, strlen (delim));
+	ssi_size_t pos = 0;
+	ssi_size_t total = 0;
+	const T *ptrT = ssi_pcast (const T, ptr);
+	for (ssi_size_t i = 0; i < count; ++i) {
+		if (pos + AsciiNumber::MAX_CHARS + delim_len + 1 > SSI_FILEASCII_BUFFER_SIZE) {
+			if (fwrite (buffer, 1, pos, file) != pos) {
+				return 0;
+			}
+			total += pos;
+			pos = 0;
+		}
+		pos += AsciiNumber::Print (*ptrT++, buffer + pos);
+		if (size > 0 && !((i+1) % size)) {
+			buffer[pos++] = '\n';
+		} else {
+			memcpy (buffer + pos, delim, delim_len);
+			pos += delim_len;
+		}
+	}
+	if (pos > 0 && fwrite (buffer, 1, pos, file) != pos) {
+		return 0;
+	}
+	total += pos;
+
+	return total;
+}
+
 ssi_size_t FileAscii::writeLine (const ssi_char_t *string) {
 
 	if (!_is_open) {
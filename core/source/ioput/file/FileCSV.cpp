@@ -28,6 +28,7 @@
 
 #include "ioput/file/FileCSV.h"
 #include "ioput/file/FileTools.h"
+#include "thread/WorkerPool.h"
 
 namespace ssi {
 
@@ -146,48 +147,138 @@ bool FileCSV::parseString(const ssi_char_t *str, const ssi_char_t delim, bool ha
 		}
 	}
 
-	ssi_size_t n_tokens = 0;
-	ssi_char_t **tokens = 0;
+	// create dummy header from first non-empty line
+	if (_n_columns == 0) {
+		ssi_char_t *next = ptr;
+		while (ptr = nextLine(next, &line, n_line, n_max_line)) {
+			ssi_size_t n_tokens = ssi_split_string_count(line, delim);
+			if (n_tokens > 0) {
+				_n_columns = n_tokens;		
+				_column_names = new ssi_char_t *[_n_columns];
+				for (ssi_size_t i = 0; i < _n_columns; i++) {
+					_column_names[i] = new ssi_char_t[10];
+					ssi_sprint(_column_names[i], "%u", i);
+				}
+				_columns = new Column[_n_columns];
+				ptr = next;
+				break;
+			}
+			next = ptr;
+		}
+	}
+	delete[] line;
+
+	if (!ptr) {
+		return true;
+	}
 
-	if (_n_columns > 0) {
-		tokens = new ssi_char_t *[_n_columns];
-		for (ssi_size_t i = 0; i < _n_columns; i++) {
-			tokens[i] = 0;
+	// large files are split at line breaks and parsed in parallel
+	ssi_size_t n_str = ssi_strlen(ptr);
+	WorkerPool *pool = n_str >= PARALLEL_MIN_SIZE ? WorkerPool::GetShared() : 0;
+	ssi_size_t n_chunks = pool && pool->size() > 1 ? pool->size() * 4 : 1;
+
+	chunk_t *chunks = new chunk_t[n_chunks];
+	const ssi_char_t *begin = ptr;
+	const ssi_char_t *end = ptr + n_str;
+	for (ssi_size_t i = 0; i < n_chunks; i++) {
+		const ssi_char_t *stop = i == n_chunks - 1 ? end : begin + (end - begin) / (n_chunks - i);
+		while (stop < end && stop > begin && *(stop - 1) != '\n') {
+			stop++;
 		}
+		chunks[i].begin = begin;
+		chunks[i].end = stop;
+		chunks[i].delim = delim;
+		chunks[i].n_columns = _n_columns;
+		chunks[i].n_rows = 0;
+		begin = stop;
 	}
-	while (ptr = nextLine(ptr, &line, n_line, n_max_line)) {
-		n_tokens = ssi_split_string_count(line, delim);
-		if (n_tokens == 0) {
-			continue;
+
+	if (n_chunks > 1) {
+		pool->run(n_chunks, ParseChunkTask, chunks);
+	} else {
+		ParseChunk(chunks[0]);
+	}
+
+	ssi_size_t n_rows = 0;
+	for (ssi_size_t i = 0; i < n_chunks; i++) {
+		n_rows += chunks[i].n_rows;
+	}
+	for (ssi_size_t i = 0; i < _n_columns; i++) {
+		_columns[i].reserve(_columns[i].size() + n_rows);
+	}
+	for (ssi_size_t i = 0; i < n_chunks; i++) {
+		for (ssi_size_t j = 0; j < chunks[i].invalid.size(); j++) {
+			ssi_wrn("#tokens '%u' != #columns '%u'", chunks[i].invalid[j], _n_columns);
 		}
-		if (_n_columns == 0) { // create dummy header
-			_n_columns = n_tokens;		
-			_column_names = new ssi_char_t *[_n_columns];
-			for (ssi_size_t i = 0; i < _n_columns; i++) {
-				_column_names[i] = new ssi_char_t[10];
-				ssi_sprint(_column_names[i], "%u", i);
+		ssi_char_t **tokens = chunks[i].tokens.empty() ? 0 : &chunks[i].tokens[0];
+		for (ssi_size_t j = 0; j < chunks[i].n_rows; j++) {
+			for (ssi_size_t k = 0; k < _n_columns; k++) {
+				_columns[k].push_back(*tokens++);
 			}
-			tokens = new ssi_char_t *[_n_columns];
-			_columns = new Column[_n_columns];
 		}
-		if (_n_columns != n_tokens) {
-			ssi_wrn("#tokens '%u' != #columns '%u'", n_tokens, _n_columns);
+		_n_rows += chunks[i].n_rows;
+	}
+
+	delete[] chunks;
+
+	return true;
+
+}
+
+void FileCSV::ParseChunkTask(ssi_size_t index, void *arg) {
+
+	ParseChunk(ssi_pcast(chunk_t, arg)[index]);
+}
+
+void FileCSV::ParseChunk(chunk_t &chunk) {
+
+	// same as ssi_split_string(), i.e. consecutive delimiters count as one,
+	// but without strtok(), which is not thread-safe
+	const ssi_char_t *ptr = chunk.begin;
+	std::vector<const ssi_char_t *> starts;
+	std::vector<ssi_size_t> lengths;
+
+	while (ptr < chunk.end) {
+
+		starts.clear();
+		lengths.clear();
+		const ssi_char_t *token = 0;
+		while (ptr < chunk.end && *ptr != '\n') {
+			if (*ptr == chunk.delim) {
+				if (token) {
+					starts.push_back(token);
+					lengths.push_back(ssi_cast(ssi_size_t, ptr - token));
+					token = 0;
+				}
+			} else if (!token) {
+				token = ptr;
+			}
+			ptr++;
+		}
+		if (token) {
+			starts.push_back(token);
+			lengths.push_back(ssi_cast(ssi_size_t, ptr - token));
+		}
+		if (ptr < chunk.end) {
+			ptr++;
+		}
+
+		ssi_size_t n_tokens = ssi_cast(ssi_size_t, starts.size());
+		if (n_tokens == 0) {
 			continue;
 		}
-		if (!ssi_split_string(n_tokens, tokens, line, delim)) {
+		if (n_tokens != chunk.n_columns) {
+			chunk.invalid.push_back(n_tokens);
 			continue;
 		}
-		for (ssi_size_t i = 0; i < _n_columns; i++) {
-			_columns[i].push_back(tokens[i]);					
+		for (ssi_size_t i = 0; i < n_tokens; i++) {
+			ssi_char_t *str = new ssi_char_t[lengths[i] + 1];
+			memcpy(str, starts[i], lengths[i]);
+			str[lengths[i]] = '\0';
+			chunk.tokens.push_back(str);
 		}
-		_n_rows++;
+		chunk.n_rows++;
 	}
-
-	delete[] tokens;
-	delete[] line;
-
-	return true;
-
 }
 
 ssi_char_t *FileCSV::nextLine(ssi_char_t *str, ssi_char_t **line, ssi_size_t &n_line, ssi_size_t &n_line_max) {
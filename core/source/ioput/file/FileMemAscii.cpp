@@ -25,6 +25,7 @@
 //*************************************************************************************************
 
 #include "ioput/file/FileMemAscii.h"
+#include "ioput/file/AsciiNumber.h"
 
 #ifdef USE_SSI_LEAK_DETECTOR
 	#include "SSI_LeakWatcher.h"
@@ -40,11 +41,12 @@
 namespace ssi {
 
 FileMemAscii::FileMemAscii ()
-	: _format_with_delim (0),
+	: _type (SSI_CHAR),
+	_format_with_delim (0),
 	_format_with_newline (0),
 	_format_with_delim_read (0),
 	_format_with_newline_read (0),
-	_type (SSI_CHAR) {
+	_fast (false) {
 
 	ssi_strcpy (_delim, " ");
 	ssi_strcpy (_flags, "");
@@ -92,16 +94,16 @@ void FileMemAscii::setFormat (const char *delim,
 			sprintf (_format, "%%%su", _flags);
 			break;
 		case SSI_LONG:
-			sprintf (_format, "%%%sld", _flags);
+			sprintf (_format, "%%%slld", _flags);
 			break;
 		case SSI_ULONG:
-			sprintf (_format, "%%%slu", _flags);
+			sprintf (_format, "%%%sllu", _flags);
 			break;
 		case SSI_FLOAT:
 			sprintf (_format, "%%%sf", _flags);
 			break;
 		case SSI_DOUBLE:
-			sprintf (_format, "%%%sLf", _flags);
+			sprintf (_format, "%%%slf", _flags);
 			break;
 		default:
 			ssi_err ("unsupported sample type");
@@ -110,6 +112,9 @@ void FileMemAscii::setFormat (const char *delim,
 	_format_with_newline = ssi_strcat (_format, "\n");
 	_format_with_delim_read = ssi_strcat (_format_with_delim, "%n");
 	_format_with_newline_read = ssi_strcat (_format_with_newline, "%n");
+
+	// without flags numbers are converted by AsciiNumber
+	_fast = _flags[0] == '\0' && AsciiNumber::IsSupported (_type);
 }
 
 FileMemAscii::~FileMemAscii () {
@@ -142,28 +147,28 @@ ssi_size_t FileMemAscii::read (void *ptr, ssi_size_t size, ssi_size_t count) {
 			result = FileMemAscii::read_h<unsigned char> (_pos, _n_memory, _memory, _format_with_delim_read, _format_with_newline_read, ptr, size, count);
 			break;
 		case SSI_SHORT:
-            result = FileMemAscii::read_h<int16_t> (_pos, _n_memory, _memory, _format_with_delim_read, _format_with_newline_read, ptr, size, count);
+            result = _fast ? FileMemAscii::read_fast<int16_t> (_pos, _n_memory, _memory, _delim, ptr, size, count) : FileMemAscii::read_h<int16_t> (_pos, _n_memory, _memory, _format_with_delim_read, _format_with_newline_read, ptr, size, count);
 			break;
 		case SSI_USHORT:
-            result = FileMemAscii::read_h<uint16_t> (_pos, _n_memory, _memory, _format_with_delim_read, _format_with_newline_read, ptr, size, count);
+            result = _fast ? FileMemAscii::read_fast<uint16_t> (_pos, _n_memory, _memory, _delim, ptr, size, count) : FileMemAscii::read_h<uint16_t> (_pos, _n_memory, _memory, _format_with_delim_read, _format_with_newline_read, ptr, size, count);
 			break;
 		case SSI_INT:
-            result = FileMemAscii::read_h<int32_t> (_pos, _n_memory, _memory, _format_with_delim_read, _format_with_newline_read, ptr, size, count);
+            result = _fast ? FileMemAscii::read_fast<int32_t> (_pos, _n_memory, _memory, _delim, ptr, size, count) : FileMemAscii::read_h<int32_t> (_pos, _n_memory, _memory, _format_with_delim_read, _format_with_newline_read, ptr, size, count);
 			break;
 		case SSI_UINT:
-            result = FileMemAscii::read_h<uint32_t> (_pos, _n_memory, _memory, _format_with_delim_read, _format_with_newline_read, ptr, size, count);
+            result = _fast ? FileMemAscii::read_fast<uint32_t> (_pos, _n_memory, _memory, _delim, ptr, size, count) : FileMemAscii::read_h<uint32_t> (_pos, _n_memory, _memory, _format_with_delim_read, _format_with_newline_read, ptr, size, count);
 			break;
 		case SSI_LONG:
-            result = FileMemAscii::read_h<int32_t> (_pos, _n_memory, _memory, _format_with_delim_read, _format_with_newline_read, ptr, size, count);
+            result = _fast ? FileMemAscii::read_fast<int64_t> (_pos, _n_memory, _memory, _delim, ptr, size, count) : FileMemAscii::read_h<int64_t> (_pos, _n_memory, _memory, _format_with_delim_read, _format_with_newline_read, ptr, size, count);
 			break;
 		case SSI_ULONG:
-            result = FileMemAscii::read_h<uint32_t> (_pos, _n_memory, _memory, _format_with_delim_read, _format_with_newline_read, ptr, size, count);
+            result = _fast ? FileMemAscii::read_fast<uint64_t> (_pos, _n_memory, _memory, _delim, ptr, size, count) : FileMemAscii::read_h<uint64_t> (_pos, _n_memory, _memory, _format_with_delim_read, _format_with_newline_read, ptr, size, count);
 			break;
 		case SSI_FLOAT:
-			result = FileMemAscii::read_h<float> (_pos, _n_memory, _memory, _format_with_delim_read, _format_with_newline_read, ptr, size, count);
+			result = _fast ? FileMemAscii::read_fast<float> (_pos, _n_memory, _memory, _delim, ptr, size, count) : FileMemAscii::read_h<float> (_pos, _n_memory, _memory, _format_with_delim_read, _format_with_newline_read, ptr, size, count);
 			break;
 		case SSI_DOUBLE:
-			result = FileMemAscii::read_h<double> (_pos, _n_memory, _memory, _format_with_delim_read, _format_with_newline_read, ptr, size, count);
+			result = _fast ? FileMemAscii::read_fast<double> (_pos, _n_memory, _memory, _delim, ptr, size, count) : FileMemAscii::read_h<double> (_pos, _n_memory, _memory, _format_with_delim_read, _format_with_newline_read, ptr, size, count);
 			break;
 		default:
 			ssi_wrn ("unsupported sample type");
@@ -200,6 +205,39 @@ SSI_INLINE int FileMemAscii::read_h (ssi_size_t pos, ssi_size_t n_memory, ssi_by
 	return pos;
 }
 
+template<class T>
+SSI_INLINE int FileMemAscii::read_fast (ssi_size_t pos, ssi_size_t n_memory, ssi_byte_t *memory, const ssi_char_t *delim, void *ptr, ssi_size_t size, ssi_size_t count) {
+
+	// same as sscanf, see FileAscii::read_fast()
+	const ssi_char_t *str = memory + pos;
+	const ssi_char_t *end = memory + n_memory;
+	T *ptrT = ssi_pcast (T, ptr);
+	for (ssi_size_t i = 0; i < count; ++i) {
+		while (str < end && isspace (ssi_cast (unsigned char, *str))) {
+			str++;
+		}
+		if (!AsciiNumber::Parse (str, end, *ptrT++)) {
+			ssi_wrn ("skip read() since end of memory has been reached");
+			return pos;
+		}
+		const ssi_char_t *d = size > 0 && !((i+1) % size) ? "\n" : delim;
+		for (; *d; d++) {
+			if (isspace (ssi_cast (unsigned char, *d))) {
+				while (str < end && isspace (ssi_cast (unsigned char, *str))) {
+					str++;
+				}
+			} else if (str < end && *str == *d) {
+				str++;
+			} else {
+				break;
+			}
+		}
+		pos = ssi_cast (ssi_size_t, str - memory);
+	}
+
+	return pos;
+}
+
 ssi_size_t FileMemAscii::write (const void *ptr, ssi_size_t size, ssi_size_t count) {
 
 	if (!_memory) {
@@ -222,28 +260,28 @@ ssi_size_t FileMemAscii::write (const void *ptr, ssi_size_t size, ssi_size_t cou
 			result = FileMemAscii::write_h<unsigned char> (_pos, _n_memory, _memory, _format_with_delim, _format_with_newline, ptr, size, count);
 			break;
 		case SSI_SHORT:
-            result = FileMemAscii::write_h<int16_t> (_pos, _n_memory, _memory, _format_with_delim, _format_with_newline, ptr, size, count);
+            result = _fast ? FileMemAscii::write_fast<int16_t> (_pos, _n_memory, _memory, _delim, ptr, size, count) : FileMemAscii::write_h<int16_t> (_pos, _n_memory, _memory, _format_with_delim, _format_with_newline, ptr, size, count);
 			break;
 		case SSI_USHORT:
-            result = FileMemAscii::write_h<uint16_t> (_pos, _n_memory, _memory, _format_with_delim, _format_with_newline, ptr, size, count);
+            result = _fast ? FileMemAscii::write_fast<uint16_t> (_pos, _n_memory, _memory, _delim, ptr, size, count) : FileMemAscii::write_h<uint16_t> (_pos, _n_memory, _memory, _format_with_delim, _format_with_newline, ptr, size, count);
 			break;
 		case SSI_INT:
-            result = FileMemAscii::write_h<int32_t> (_pos, _n_memory, _memory, _format_with_delim, _format_with_newline, ptr, size, count);
+            result = _fast ? FileMemAscii::write_fast<int32_t> (_pos, _n_memory, _memory, _delim, ptr, size, count) : FileMemAscii::write_h<int32_t> (_pos, _n_memory, _memory, _format_with_delim, _format_with_newline, ptr, size, count);
 			break;
 		case SSI_UINT:
-            result = FileMemAscii::write_h<uint32_t> (_pos, _n_memory, _memory, _format_with_delim, _format_with_newline, ptr, size, count);
+            result = _fast ? FileMemAscii::write_fast<uint32_t> (_pos, _n_memory, _memory, _delim, ptr, size, count) : FileMemAscii::write_h<uint32_t> (_pos, _n_memory, _memory, _format_with_delim, _format_with_newline, ptr, size, count);
 			break;
 		case SSI_LONG:
-            result = FileMemAscii::write_h<int32_t> (_pos, _n_memory, _memory, _format_with_delim, _format_with_newline, ptr, size, count);
+            result = _fast ? FileMemAscii::write_fast<int64_t> (_pos, _n_memory, _memory, _delim, ptr, size, count) : FileMemAscii::write_h<int64_t> (_pos, _n_memory, _memory, _format_with_delim, _format_with_newline, ptr, size, count);
 			break;
 		case SSI_ULONG:
-            result = FileMemAscii::write_h<uint32_t> (_pos, _n_memory, _memory, _format_with_delim, _format_with_newline, ptr, size, count);
+            result = _fast ? FileMemAscii::write_fast<uint64_t> (_pos, _n_memory, _memory, _delim, ptr, size, count) : FileMemAscii::write_h<uint64_t> (_pos, _n_memory, _memory, _format_with_delim, _format_with_newline, ptr, size, count);
 			break;
 		case SSI_FLOAT:
-			result = FileMemAscii::write_h<float> (_pos, _n_memory, _memory, _format_with_delim, _format_with_newline, ptr, size, count);
+			result = _fast ? FileMemAscii::write_fast<float> (_pos, _n_memory, _memory, _delim, ptr, size, count) : FileMemAscii::write_h<float> (_pos, _n_memory, _memory, _format_with_delim, _format_with_newline, ptr, size, count);
 			break;
 		case SSI_DOUBLE:
-			result = FileMemAscii::write_h<double> (_pos, _n_memory, _memory, _format_with_delim, _format_with_newline, ptr, size, count);
+			result = _fast ? FileMemAscii::write_fast<double> (_pos, _n_memory, _memory, _delim, ptr, size, count) : FileMemAscii::write_h<double> (_pos, _n_memory, _memory, _format_with_delim, _format_with_newline, ptr, size, count);
 			break;
 		default:
 			ssi_wrn ("unsupported sample type");
@@ -279,6 +317,36 @@ SSI_INLINE int FileMemAscii::write_h (ssi_size_t pos, ssi_size_t n_memory, ssi_b
 	return pos;
 }
 
+template<class T>
+SSI_INLINE int FileMemAscii::write_fast (ssi_size_t pos, ssi_size_t n_memory, ssi_byte_t *memory, const ssi_char_t *delim, const void *ptr, ssi_size_t size, ssi_size_t count) {
+
+	ssi_char_t buffer[AsciiNumber::MAX_CHARS];
+	ssi_size_t delim_len = ssi_cast (ssi_size_t, strlen (delim));
+
+	const T *ptrT = ssi_pcast (const T, ptr);
+	for (ssi_size_t i = 0; i < count; ++i) {
+		bool newline = size > 0 && !((i+1) % size);
+		ssi_size_t n = AsciiNumber::Print (*ptrT++, buffer);
+		ssi_size_t n_delim = newline ? 1 : delim_len;
+		// keep one byte for the terminating zero
+		if (pos + n + n_delim + 1 > n_memory) {
+			ssi_wrn ("skip write() since end of memory has been reached");
+			return pos;
+		}
+		memcpy (memory + pos, buffer, n);
+		pos += n;
+		if (newline) {
+			memory[pos++] = '\n';
+		} else {
+			memcpy (memory + pos, delim, delim_len);
+			pos += delim_len;
+		}
+		memory[pos] = '\0';
+	}
+
+	return pos;
+}
+
 ssi_size_t FileMemAscii::writeLine (const ssi_char_t *string) {
 
 	if (!_memory) {
@@ -104,6 +104,25 @@ Socket::~Socket () {
 	ssi_msg (SSI_LOG_LEVEL_DETAIL, "destroyed socket (type=%d, mode=%d, ip=%s)", _type, _mode, _ipstr);
 }
 
+int Socket::sendv (ssi_size_t n_buffers, const void *ptrs[], const ssi_size_t sizes[]) {
+
+	ssi_size_t size = 0;
+	for (ssi_size_t i = 0; i < n_buffers; i++) {
+		size += sizes[i];
+	}
+
+	ssi_byte_t *buffer = new ssi_byte_t[size];
+	ssi_byte_t *ptr = buffer;
+	for (ssi_size_t i = 0; i < n_buffers; i++) {
+		memcpy (ptr, ptrs[i], sizes[i]);
+		ptr += sizes[i];
+	}
+
+	int result = send (buffer, size);
+	delete[] buffer;
+
+	return result;
+}
 
 bool Socket::sendFile (const ssi_char_t *filepath) {
 
@@ -239,6 +239,37 @@ int SocketTcp::send (const void *ptr, ssi_size_t size) {
 	return result;
 }
 
+int SocketTcp::sendv (ssi_size_t n_buffers, const void *ptrs[], const ssi_size_t sizes[]) {
+
+	if (!_is_connected) {
+		ssi_wrn ("socket not connected");
+		return -1;
+	}
+
+	int result = -1;
+	{
+		Lock lock (_send_mutex);
+
+		switch (_mode) {
+			case SocketTcp::CLIENT:
+				result = _socket->sendv(n_buffers, ptrs, sizes);
+				break;
+			case SocketTcp::SERVER:
+				result = _client->sendv(n_buffers, ptrs, sizes);
+				break;
+		}
+	}
+
+	if (result == SOCKET_ERROR) {
+		ssi_wrn("sendv() failed\n");
+		return -1;
+	} else {
+		SSI_DBG (SSI_LOG_LEVEL_DEBUG, "sent %d bytes", result);
+	}
+
+	return result;
+}
+
 int SocketTcp::sendTo(const void *ptr, ssi_size_t size, const char* host, int port)
 {
 	ssi_wrn("TCP socket can only send data to the connected client");
@@ -43,6 +43,7 @@
 #endif
 #include <unistd.h> 
 #include <sys/ioctl.h> 
+#include <sys/uio.h>
 
 #define closesocket ::close
 #define ioctlsocket ioctl
@@ -335,6 +336,98 @@ int TcpSocket::send (const void *buf, int num_bytes) {
 	return ::send (m_sock, (char *) buf, num_bytes, 0);	
 }
 
+int TcpSocket::sendv (int num_bufs, const void *bufs[], const ssi_size_t sizes[]) {
+
+	// gather buffers into a single system call, in chunks if there are many,
+	// after a partial write we continue with the first byte not sent yet
+	const int MAX_BUFS = 64;
+	int total = 0;
+	int index = 0; // first buffer not sent completely
+	ssi_size_t done = 0; // bytes of this buffer that have been sent
+
+	for (;;) {
+
+		// skip buffers that are sent completely
+		while (index < num_bufs && done == sizes[index]) {
+			index++;
+			done = 0;
+		}
+		if (index == num_bufs) {
+			break;
+		}
+
+		int n = num_bufs - index < MAX_BUFS ? num_bufs - index : MAX_BUFS;
+		int result = 0;
+		bool again = false;
+
+#if _WIN32||_WIN64
+		WSABUF wsabufs[MAX_BUFS];
+		for (int i = 0; i < n; i++) {
+			wsabufs[i].buf = (char *) bufs[index + i];
+			wsabufs[i].len = (ULONG) sizes[index + i];
+		}
+		wsabufs[0].buf += done;
+		wsabufs[0].len -= (ULONG) done;
+		DWORD sent = 0;
+		if (WSASend (m_sock, wsabufs, n, &sent, 0, NULL, NULL) == SOCKET_ERROR) {
+			int error = WSAGetLastError ();
+			if (error == WSAEINTR) {
+				continue;
+			}
+			if (error != WSAEWOULDBLOCK) {
+				return SOCKET_ERROR;
+			}
+			again = true;
+		}
+		result = (int) sent;
+#else
+		struct iovec iov[MAX_BUFS];
+		for (int i = 0; i < n; i++) {
+			iov[i].iov_base = (void *) bufs[index + i];
+			iov[i].iov_len = sizes[index + i];
+		}
+		iov[0].iov_base = (char *) iov[0].iov_base + done;
+		iov[0].iov_len -= done;
+		result = (int) ::writev (m_sock, iov, n);
+		if (result < 0) {
+			if (errno == EINTR) {
+				continue;
+			}
+			if (errno != EAGAIN && errno != EWOULDBLOCK) {
+				return SOCKET_ERROR;
+			}
+			again = true;
+			result = 0;
+		}
+#endif
+
+		if (again) {
+			// like send() a non-blocking socket fails if nothing could be sent,
+			// but once we have started we must not leave the receiver with half a message
+			if (total == 0) {
+				return SOCKET_ERROR;
+			}
+			fd_set send_set;
+			FD_ZERO (&send_set);
+			FD_SET (m_sock, &send_set);
+			::select ((int) m_sock + 1, 0, &send_set, 0, 0);
+			continue;
+		}
+
+		total += result;
+
+		// advance to the first byte not sent yet
+		while (index < num_bufs && (ssi_size_t) result >= sizes[index] - done) {
+			result -= (int) (sizes[index] - done);
+			index++;
+			done = 0;
+		}
+		done += (ssi_size_t) result;
+	}
+
+	return total;
+}
+
 bool TcpSocket::connected()
 {
 	return m_connected;
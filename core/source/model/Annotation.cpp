@@ -37,7 +37,10 @@
 
 namespace ssi {
 
-Annotation::Annotation () {
+Annotation::Annotation ()
+	: dirty (false),
+	entries_iter (0),
+	counter (0) {
 }
 
 Annotation::~Annotation () {
@@ -51,12 +54,9 @@ void Annotation::clear () {
 	}
 	labels.clear ();
 
-	reset ();
-	Annotation::Entry *entry;
-	while (entry = next ()) {
-		delete entry;
-	}
 	entries.clear ();
+	max_stops.clear ();
+	dirty = false;
 	reset ();
 }
 
@@ -70,15 +70,12 @@ void Annotation::add (ssi_time_t start,
 	ssi_size_t label_index = addLabel (label);
 
 	// add as new entry
-	Annotation::Entry *entry = new Annotation::Entry;
-	entry->start = start;
-	entry->stop = stop;
-	entry->label_index = label_index;
-	std::pair<entries_set_t::iterator,bool> ret;
-	ret = entries.insert (entry);
-	if (ret.second == false) {
-		delete entry;
-	}
+	Annotation::Entry entry;
+	entry.start = start;
+	entry.stop = stop;
+	entry.label_index = label_index;
+	entries.push_back (entry);
+	dirty = true;
 }
 
 void Annotation::add (Annotation::Entry &e) {
@@ -86,40 +83,103 @@ void Annotation::add (Annotation::Entry &e) {
 	SSI_DBG (SSI_LOG_LEVEL_DEBUG, "add new entry: %f %f %s\n", e.start, e.stop, getLabel (e.label_index));
 
 	// add as new entry
-	Annotation::Entry *entry = new Annotation::Entry;
-	entry->start = e.start;
-	entry->stop = e.stop;
-	entry->label_index = e.label_index;
-	std::pair<entries_set_t::iterator,bool> ret;
-	ret = entries.insert (entry);
-	if (ret.second == false) {
-		delete entry;
+	entries.push_back (e);
+	dirty = true;
+}
+
+void Annotation::add (ssi_size_t n, const Annotation::Entry *e) {
+
+	if (n > 0) {
+		entries.insert (entries.end (), e, e + n);
+		dirty = true;
+	}
+}
+
+void Annotation::update () {
+
+	if (!dirty) {
+		return;
+	}
+
+	// entries usually arrive in order
+	entry_compare compare;
+	bool sorted = true;
+	for (size_t i = 1; i < entries.size (); i++) {
+		if (!compare (entries[i-1], entries[i])) {
+			sorted = false;
+			break;
+		}
+	}
+	if (!sorted) {
+		std::stable_sort (entries.begin (), entries.end (), compare);
+		// of entries with same start and stop keep the one added first
+		size_t n = 1;
+		for (size_t i = 1; i < entries.size (); i++) {
+			if (compare (entries[n-1], entries[i])) {
+				entries[n++] = entries[i];
+			}
+		}
+		entries.resize (n);
+	}
+
+	max_stops.resize (entries.size ());
+	if (!entries.empty ()) {
+		build (0, ssi_cast (ssi_size_t, entries.size ()));
+	}
+
+	dirty = false;
+}
+
+ssi_time_t Annotation::build (ssi_size_t lo, ssi_size_t hi) {
+
+	// the middle entry is the root of [lo, hi)
+	ssi_size_t mid = lo + (hi - lo) / 2;
+	ssi_time_t max_stop = entries[mid].stop;
+	if (lo < mid) {
+		ssi_time_t stop = build (lo, mid);
+		if (stop > max_stop) {
+			max_stop = stop;
+		}
+	}
+	if (mid + 1 < hi) {
+		ssi_time_t stop = build (mid + 1, hi);
+		if (stop > max_stop) {
+			max_stop = stop;
+		}
 	}
+	max_stops[mid] = max_stop;
+
+	return max_stop;
 }
 
 void Annotation::reset () {
-	entries_iter = entries.begin ();
+	update ();
+	entries_iter = 0;
 }
 
 Annotation::Entry *Annotation::next () {
 
-	if (entries_iter == entries.end ()) {
+	update ();
+
+	if (entries_iter >= entries.size ()) {
 		return 0;
 	}
 	
-	return *entries_iter++;
+	return &entries[entries_iter++];
 }
 
 Annotation::Entry *Annotation::next (ssi_size_t label_index) {
 
-	while (entries_iter != entries.end () && (*entries_iter)->label_index != label_index)
+	update ();
+
+	while (entries_iter < entries.size () && entries[entries_iter].label_index != label_index)
 		entries_iter++;
 
-	if (entries_iter == entries.end ()) {
+	if (entries_iter >= entries.size ()) {
 		return 0;
 	}
 	
-	return *entries_iter++;
+	return &entries[entries_iter++];
 }
 
 const ssi_char_t *Annotation::getLabel (ssi_size_t index) {
@@ -133,6 +193,7 @@ const ssi_char_t *Annotation::getLabel (ssi_size_t index) {
 }
 
 ssi_size_t Annotation::size () {
+	update ();
 	return ssi_cast (ssi_size_t , entries.size ());
 }
 
@@ -162,8 +223,8 @@ ssi_size_t Annotation::addLabel (const ssi_char_t *label) {
 
 Annotation::Entry *Annotation::last () {
 	
-	entries_set_t::iterator i_end = entries.end();
-	return *(--i_end);
+	update ();
+	return entries.empty () ? 0 : &entries.back ();
 }
 
 ssi_size_t Annotation::labelSize () {
@@ -186,38 +247,79 @@ bool Annotation::entry_compare (Annotation::Entry *lhs, Annotation::Entry *rhs)
 
 Annotation::Entry *Annotation::getEntryAt(ssi_time_t time, ssi_time_t max_delay)
 {	
-	entries_set_t::iterator i = entries.begin();
-	entries_set_t::iterator i_end = entries.end();
-	while(i != i_end)
-	{
-		if(time >= (*i)->start && time < (*i)->stop + max_delay)			
-			return *i;
-		++i;
-	}
-	return 0;
+	update();
+	return find(0, ssi_cast(ssi_size_t, entries.size()), time, max_delay);
+}
+
+Annotation::Entry *Annotation::find(ssi_size_t lo, ssi_size_t hi, ssi_time_t time, ssi_time_t max_delay)
+{
+	if (lo >= hi)
+		return 0;
+
+	// no entry below this node lasts until time
+	ssi_size_t mid = lo + (hi - lo) / 2;
+	if (max_stops[mid] + max_delay <= time)
+		return 0;
+
+	// first match in order of start time
+	Annotation::Entry *entry = find(lo, mid, time, max_delay);
+	if (entry)
+		return entry;
+	if (entries[mid].start > time)
+		return 0;
+	if (time < entries[mid].stop + max_delay)
+		return &entries[mid];
+
+	return find(mid + 1, hi, time, max_delay);
+}
+
+ssi_size_t Annotation::getEntries(ssi_time_t from, ssi_time_t to, std::vector<Annotation::Entry *> &result)
+{
+	update();
+
+	size_t n = result.size();
+	collect(0, ssi_cast(ssi_size_t, entries.size()), from, to, result);
+
+	return ssi_cast(ssi_size_t, result.size() - n);
+}
+
+void Annotation::collect(ssi_size_t lo, ssi_size_t hi, ssi_time_t from, ssi_time_t to, std::vector<Annotation::Entry *> &result)
+{
+	if (lo >= hi)
+		return;
+
+	ssi_size_t mid = lo + (hi - lo) / 2;
+	if (max_stops[mid] <= from)
+		return;
+
+	collect(lo, mid, from, to, result);
+	// entries right of mid start even later
+	if (entries[mid].start >= to)
+		return;
+	if (entries[mid].stop > from)
+		result.push_back(&entries[mid]);
+	collect(mid + 1, hi, from, to, result);
 }
 
 void Annotation::trim(ssi_size_t cut_front, ssi_size_t cut_back)
 {
-	//trim front
-	{
-		entries_set_t::iterator i = entries.begin();
-		entries_set_t::iterator i_end = entries.end();
-		for (ssi_size_t k = 0; k < cut_front; k++)
-			i++;
+	update();
 
-		entries.erase(entries.begin(), i);
+	ssi_size_t n = ssi_cast(ssi_size_t, entries.size());
+	if (cut_front + cut_back >= n)
+	{
+		entries.clear();
 	}
-
-	//trim back
+	else
 	{
-		entries_set_t::iterator i = entries.end();
-		entries_set_t::iterator i_end = entries.begin();
-		for (ssi_size_t k = 0; k < cut_back; k++)
-			i--;
-
-		entries.erase(i, entries.end());
+		entries.erase(entries.end() - cut_back, entries.end());
+		entries.erase(entries.begin(), entries.begin() + cut_front);
 	}
+
+	max_stops.resize(entries.size());
+	if (!entries.empty())
+		build(0, ssi_cast(ssi_size_t, entries.size()));
+	reset();
 }
 
 }
@@ -31,6 +31,8 @@
 #include "ioput/file/FileTools.h"
 #include "ioput/file/FilePath.h"
 #include "base/Factory.h"
+#include "thread/WorkerPool.h"
+#include "thread/Lock.h"
 #include "graphic/PaintData.h"
 #if _WIN32||_WIN64
 #include "graphic/Window.h"
@@ -139,6 +141,12 @@ namespace ssi {
 			label_ids[n_labels] = to.addLabel(default_label);
 		}
 
+		if (from.size() == 0) {
+			ssi_wrn("empty annotation");
+			delete[] label_ids;
+			return;
+		}
+
 		ssi_time_t len = from.last()->stop;
 		ssi_size_t n_frames = ssi_cast(ssi_size_t, (len - (frame_len + delta_len)) / frame_len);
 
@@ -146,53 +154,54 @@ namespace ssi {
 		ssi_time_t frame_start = 0;
 		ssi_time_t frame_stop = frame_tot;
 
-		Annotation::Entry *entry = 0;
+		// sweep over entries in order of start time and keep those that overlap the current frame
+		std::vector<Annotation::Entry *> active;
+		from.reset();
+		Annotation::Entry *entry = from.next();
 		Annotation::Entry new_entry;
 		ssi_time_t *percent_per_label = new ssi_time_t[n_labels];
 		for (ssi_size_t i = 0; i < n_frames; i++) {
-			from.reset();
-
 			new_entry.start = frame_start;
 			new_entry.stop = frame_stop;
-			new_entry.label_index = label_ids[n_labels];
+			new_entry.label_index = default_label ? label_ids[n_labels] : 0;
 
 			for (ssi_size_t i = 0; i < n_labels; i++) {
 				percent_per_label[i] = 0;
 			}
 
-			while ((entry = from.next()) && entry->stop < frame_start) {
+			size_t n_active = 0;
+			for (size_t j = 0; j < active.size(); j++) {
+				if (active[j]->stop >= frame_start) {
+					active[n_active++] = active[j];
+				}
 			}
-
-			if (entry) {
-				bool found_at_least_one = false;
-
-				while (entry && entry->start < frame_stop) {
-					ssi_time_t dur = (min(frame_stop, entry->stop) - max(frame_start, entry->start)) / frame_tot;
-					percent_per_label[entry->label_index] += dur;
-					entry = from.next();
-					found_at_least_one = true;
+			active.resize(n_active);
+			while (entry && entry->start < frame_stop) {
+				if (entry->stop >= frame_start) {
+					active.push_back(entry);
 				}
+				entry = from.next();
+			}
 
-				if (found_at_least_one) {
-					ssi_time_t max_percent = percent_per_label[0];
-					ssi_size_t max_label_id = 0;
-					for (ssi_size_t i = 1; i < n_labels; i++) {
-						if (max_percent < percent_per_label[i]) {
-							max_label_id = i;
-							max_percent = percent_per_label[i];
-						}
-					}
+			for (size_t j = 0; j < active.size(); j++) {
+				ssi_time_t dur = (min(frame_stop, active[j]->stop) - max(frame_start, active[j]->start)) / frame_tot;
+				percent_per_label[active[j]->label_index] += dur;
+			}
 
-					if (max_percent > min_percent_per_frame) {
-						new_entry.start = frame_start;
-						new_entry.stop = frame_stop;
-						new_entry.label_index = label_ids[max_label_id];
-						to.add(new_entry);
-					}
-					else if (default_label) {
-						to.add(new_entry);
+			if (!active.empty()) {
+				ssi_time_t max_percent = percent_per_label[0];
+				ssi_size_t max_label_id = 0;
+				for (ssi_size_t i = 1; i < n_labels; i++) {
+					if (max_percent < percent_per_label[i]) {
+						max_label_id = i;
+						max_percent = percent_per_label[i];
 					}
 				}
+
+				if (max_percent > min_percent_per_frame) {
+					new_entry.label_index = label_ids[max_label_id];
+					to.add(new_entry);
+				}
 				else if (default_label) {
 					to.add(new_entry);
 				}
@@ -302,48 +311,91 @@ namespace ssi {
 		}
 
 		// walk through annoation list
+		std::vector<Annotation::Entry *> entries;
 		Annotation::Entry *entry;
 		annotation.reset();
 		while (entry = annotation.next()) {
-			ssi_sample_t *sample = new ssi_sample_t;
-			ssi_stream_t **chops = new ssi_stream_t *[num];
+			entries.push_back(entry);
+		}
 
-			bool success = false;
+		// extract samples in parallel
+		load_job_t job;
+		job.n_entries = ssi_cast(ssi_size_t, entries.size());
+		job.entries = entries.empty() ? 0 : &entries[0];
+		job.num = num;
+		job.streams = streams;
+		job.chops = new ssi_stream_t **[job.n_entries];
+		job.invalid = new bool[job.n_entries * num];
+
+		ssi_size_t n_blocks = (job.n_entries + PARALLEL_BLOCK_SIZE - 1) / PARALLEL_BLOCK_SIZE;
+		if (n_blocks > 1) {
+			WorkerPool::GetShared()->run(n_blocks, LoadTask, &job);
+		} else if (n_blocks == 1) {
+			LoadTask(0, &job);
+		}
+
+		// add samples in order of annotation
+		for (ssi_size_t i = 0; i < job.n_entries; i++) {
 			for (ssi_size_t j = 0; j < num; j++) {
+				if (job.invalid[i * num + j]) {
+					ssi_wrn("invalid interval [%lf..%lf]s (%s)", entries[i]->start, entries[i]->stop, user_name);
+				}
+			}
+			if (job.chops[i]) {
+				// create and add new sample
+				ssi_sample_t *sample = new ssi_sample_t;
+				sample->class_id = label_map[entries[i]->label_index];
+				sample->num = num;
+				sample->score = 0.0f;
+				sample->streams = job.chops[i];
+				sample->time = entries[i]->start;
+				sample->user_id = user_id;
+				sample_list.addSample(sample);
+			}
+		}
+
+		delete[] job.chops;
+		delete[] job.invalid;
+		delete[] label_map;
+	}
+
+	void ModelTools::LoadTask(ssi_size_t index, void *arg) {
+		load_job_t &job = *ssi_pcast(load_job_t, arg);
+
+		ssi_size_t from = index * PARALLEL_BLOCK_SIZE;
+		ssi_size_t to = min(from + PARALLEL_BLOCK_SIZE, job.n_entries);
+		for (ssi_size_t i = from; i < to; i++) {
+			Annotation::Entry *entry = job.entries[i];
+			ssi_stream_t **chops = new ssi_stream_t *[job.num];
+
+			bool success = false;
+			for (ssi_size_t j = 0; j < job.num; j++) {
+				ssi_stream_t *stream = job.streams[j];
+				chops[j] = 0;
+
 				// calculate start and stop index
-				ssi_size_t start_index = ssi_cast(ssi_size_t, entry->start * streams[j]->sr + 0.5);
-				ssi_size_t stop_index = ssi_cast(ssi_size_t, entry->stop * streams[j]->sr + 0.5);
+				ssi_size_t start_index = ssi_cast(ssi_size_t, entry->start * stream->sr + 0.5);
+				ssi_size_t stop_index = ssi_cast(ssi_size_t, entry->stop * stream->sr + 0.5);
 
 				// check if samples start index is smaller than the sto index and smaller than streams number of samples
-				if (!(start_index <= stop_index && stop_index < streams[j]->num)) {
-					ssi_wrn("invalid interval [%lf..%lf]s (%s)", entry->start, entry->stop, user_name);
+				job.invalid[i * job.num + j] = !(start_index <= stop_index && stop_index < stream->num);
+				if (job.invalid[i * job.num + j]) {
 					continue;
 				}
 
 				// extract sample
 				chops[j] = new ssi_stream_t;
-				ssi_stream_copy(*streams[j], *chops[j], start_index, stop_index);
+				ssi_stream_copy(*stream, *chops[j], start_index, stop_index);
 
 				success = true;
 			}
 
-			if (success) {
-				// create and add new sample
-				sample->class_id = label_map[entry->label_index];
-				sample->num = num;
-				sample->score = 0.0f;
-				sample->streams = chops;
-				sample->time = entry->start;
-				sample->user_id = user_id;
-				sample_list.addSample(sample);
-			}
-			else {
-				delete sample;
+			if (!success) {
 				delete[] chops;
+				chops = 0;
 			}
+			job.chops[i] = chops;
 		}
-
-		delete[] label_map;
 	}
 
 	void ModelTools::LoadSampleList(SampleList &sample_list, StringList &files) {
@@ -1143,7 +1195,6 @@ namespace ssi {
 		// transform samples
 		from.reset();
 		const ssi_sample_t *sample = 0;
-		ssi_sample_t *new_sample = 0;
 		ssi_size_t counter = 0;
 		ssi_size_t counter_max = from.getSize() - 1;
 		bool call_enter = false;
@@ -1159,37 +1210,299 @@ namespace ssi {
 			}
 			++counter;
 
-			ssi_stream_t **result = new ssi_stream_t *[num];
-			for (ssi_size_t i = 0; i < num; i++) {
-				result[i] = new ssi_stream_t;
-				if (transformers_h[i]) {
-					SignalTools::Transform(*sample->streams[i], *result[i], *transformers_h[i], frame_size, delta_size, call_enter, call_flush);
+			to.addSample(TransformSample(*sample, num, transformers_h, frame_size, delta_size, call_enter, call_flush, label_map, user_map));
+		}
+
+		// clean up
+		if (num == 1) {
+			delete[] transformers_h;
+		}
+
+		delete[] label_map;
+		delete[] user_map;
+	}
+
+	ssi_sample_t *ModelTools::TransformSample(const ssi_sample_t &sample,
+		ssi_size_t num,
+		ITransformer *transformers[],
+		ssi_size_t frame_size,
+		ssi_size_t delta_size,
+		bool call_enter,
+		bool call_flush,
+		ssi_size_t *label_map,
+		ssi_size_t *user_map) {
+		ssi_stream_t **result = new ssi_stream_t *[num];
+		for (ssi_size_t i = 0; i < num; i++) {
+			result[i] = new ssi_stream_t;
+			if (transformers[i]) {
+				SignalTools::Transform(*sample.streams[i], *result[i], *transformers[i], frame_size, delta_size, call_enter, call_flush);
+			}
+			else {
+				ssi_stream_clone(*sample.streams[i], *result[i]);
+			}
+		}
+
+		// create sample
+		ssi_sample_t *new_sample = new ssi_sample_t;
+		new_sample->class_id = sample.class_id == SSI_ISAMPLES_GARBAGE_CLASS_ID ? SSI_ISAMPLES_GARBAGE_CLASS_ID : label_map[sample.class_id];
+		new_sample->num = num;
+		new_sample->score = 0.0f;
+		new_sample->streams = result;
+		new_sample->time = sample.time;
+		new_sample->user_id = sample.user_id == SSI_ISAMPLES_GARBAGE_USER_ID ? SSI_ISAMPLES_GARBAGE_USER_ID : user_map[sample.user_id];
+
+		return new_sample;
+	}
+
+	IObject *ModelTools::CloneObject(IObject *object) {
+		IObject *clone = Factory::Create(object->getName(), 0, false);
+		if (!clone) {
+			return 0;
+		}
+
+		IOptions *from = object->getOptions();
+		IOptions *to = clone->getOptions();
+		if (from && to) {
+			for (ssi_size_t i = 0; i < from->getSize(); i++) {
+				ssi_option_t *option = from->getOption(i);
+				to->setOptionValue(option->name, option->ptr);
+			}
+		}
+
+		return clone;
+	}
+
+	ITransformer *ModelTools::CloneTransformer(ITransformer *transformer) {
+		return ssi_pcast(ITransformer, CloneObject(transformer));
+	}
+
+	bool ModelTools::IsSameOutput(ISamples &samples, ssi_size_t num, ssi_size_t index, ITransformer *transformer, ITransformer *clone) {
+
+		// a single transformer is applied to every stream
+		ssi_size_t first = num == 1 ? 0 : index;
+		ssi_size_t last = num == 1 ? samples.getStreamSize() : index + 1;
+		for (ssi_size_t i = first; i < last; i++) {
+			ssi_stream_t stream = samples.getStream(i);
+			if (transformer->getSampleDimensionOut(stream.dim) != clone->getSampleDimensionOut(stream.dim)
+				|| transformer->getSampleBytesOut(stream.byte) != clone->getSampleBytesOut(stream.byte)
+				|| transformer->getSampleTypeOut(stream.type) != clone->getSampleTypeOut(stream.type)) {
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	bool ModelTools::IsSameSample(const ssi_sample_t &a, const ssi_sample_t &b) {
+
+		if (a.num != b.num) {
+			return false;
+		}
+		for (ssi_size_t i = 0; i < a.num; i++) {
+			ssi_stream_t *sa = a.streams[i];
+			ssi_stream_t *sb = b.streams[i];
+			if (!sa || !sb) {
+				if (sa != sb) {
+					return false;
 				}
-				else {
-					ssi_stream_clone(*sample->streams[i], *result[i]);
+				continue;
+			}
+			if (sa->num != sb->num || sa->dim != sb->dim || sa->byte != sb->byte || sa->type != sb->type
+				|| memcmp(sa->ptr, sb->ptr, sa->tot) != 0) {
+				return false;
+			}
+		}
+
+		return true;
+	}
+
+	IModel *ModelTools::CloneModel(IModel *model) {
+		return ssi_pcast(IModel, CloneObject(model));
+	}
+
+	void ModelTools::TransformSampleListParallel(ISamples &from,
+		SampleList &to,
+		ITransformer &transformer,
+		ssi_size_t frame_size,
+		ssi_size_t delta_size) {
+		ITransformer *t = &transformer;
+		ModelTools::TransformSampleListParallel(from, to, 1, &t, frame_size, delta_size);
+	}
+
+	void ModelTools::TransformSampleListParallel(ISamples &from,
+		SampleList &to,
+		ssi_size_t num,
+		ITransformer *transformers[],
+		ssi_size_t frame_size,
+		ssi_size_t delta_size) {
+		if (from.getSize() == 0) {
+			return;
+		}
+
+		ssi_size_t n_streams = from.getStreamSize();
+
+		if (num != 1 && num != n_streams) {
+			ssi_err("number of streams in sample list not compatible with number of transformer");
+		}
+
+		// copy labels
+		ssi_size_t *label_map = new ssi_size_t[from.getClassSize()];
+		for (unsigned int i = 0; i < from.getClassSize(); i++) {
+			label_map[i] = to.addClassName(from.getClassName(i));
+		}
+
+		// copy ids
+		ssi_size_t *user_map = new ssi_size_t[from.getUserSize()];
+		for (unsigned int i = 0; i < from.getUserSize(); i++) {
+			user_map[i] = to.addUserName(from.getUserName(i));
+		}
+
+		// collect samples, copy them if the pointers do not stay valid
+		bool shallow = from.supportsShallowCopy();
+		std::vector<ssi_sample_t *> samples;
+		samples.reserve(from.getSize());
+		from.reset();
+		ssi_sample_t *sample = 0;
+		while (sample = from.next()) {
+			if (shallow) {
+				samples.push_back(sample);
+			} else {
+				ssi_sample_t *copy = new ssi_sample_t;
+				ssi_sample_clone(*sample, *copy);
+				samples.push_back(copy);
+			}
+		}
+
+		// first thread uses the original transformers, the others get a copy
+		WorkerPool *pool = WorkerPool::GetShared();
+		ssi_size_t n_sets = pool->size();
+		ITransformer ***sets = new ITransformer **[n_sets];
+		sets[0] = transformers;
+		for (ssi_size_t i = 1; i < n_sets; i++) {
+			sets[i] = new ITransformer *[num];
+			for (ssi_size_t j = 0; j < num; j++) {
+				sets[i][j] = 0;
+			}
+		}
+		bool cloned = true;
+		for (ssi_size_t i = 1; i < n_sets && cloned; i++) {
+			for (ssi_size_t j = 0; j < num && cloned; j++) {
+				if (!transformers[j]) {
+					continue;
+				}
+				ssi_size_t k = 0;
+				while (transformers[k] != transformers[j]) {
+					k++;
+				}
+				if (k < j) {
+					sets[i][j] = sets[i][k];
+				} else if (!(sets[i][j] = CloneTransformer(transformers[j]))) {
+					ssi_wrn("could not create a copy of '%s', transform samples on calling thread", transformers[j]->getName());
+					cloned = false;
+				} else if (!IsSameOutput(from, num, j, transformers[j], sets[i][j])) {
+					ssi_wrn("copy of '%s' does not produce the same output (state not described by options?), transform samples on calling thread", transformers[j]->getName());
+					cloned = false;
 				}
 			}
+		}
 
-			// create and add sample
-			new_sample = new ssi_sample_t;
-			new_sample->class_id = sample->class_id == SSI_ISAMPLES_GARBAGE_CLASS_ID ? SSI_ISAMPLES_GARBAGE_CLASS_ID : label_map[sample->class_id];
-			new_sample->num = num;
-			new_sample->score = 0.0f;
-			new_sample->streams = result;
-			new_sample->time = sample->time;
-			new_sample->user_id = sample->user_id == SSI_ISAMPLES_GARBAGE_USER_ID ? SSI_ISAMPLES_GARBAGE_USER_ID : user_map[sample->user_id];
-			to.addSample(new_sample);
+		// a copy may have the same output format, but still compute something else
+		if (cloned && n_sets > 1 && samples.size() > 0) {
+			ssi_sample_t *expected = TransformSample(*samples[0], num, transformers, frame_size, delta_size, true, true, label_map, user_map);
+			for (ssi_size_t i = 1; i < n_sets && cloned; i++) {
+				ssi_sample_t *result = TransformSample(*samples[0], num, sets[i], frame_size, delta_size, true, true, label_map, user_map);
+				if (!IsSameSample(*expected, *result)) {
+					ssi_wrn("copies of the transformers do not produce the same output (state not described by options?), transform samples on calling thread");
+					cloned = false;
+				}
+				ssi_sample_destroy(*result);
+				delete result;
+			}
+			ssi_sample_destroy(*expected);
+			delete expected;
+		}
+
+		transform_job_t job;
+		job.n_samples = ssi_cast(ssi_size_t, samples.size());
+		job.from = job.n_samples > 0 ? &samples[0] : 0;
+		job.to = new ssi_sample_t *[job.n_samples];
+		job.num = num;
+		job.frame_size = frame_size;
+		job.delta_size = delta_size;
+		job.label_map = label_map;
+		job.user_map = user_map;
+		job.sets = sets;
+		job.free_sets = new ssi_size_t[n_sets];
+		job.n_free_sets = cloned ? n_sets : 1;
+		for (ssi_size_t i = 0; i < job.n_free_sets; i++) {
+			job.free_sets[i] = i;
+		}
+
+		// transform samples
+		ssi_size_t n_blocks = (job.n_samples + PARALLEL_BLOCK_SIZE - 1) / PARALLEL_BLOCK_SIZE;
+		if (job.n_free_sets > 1) {
+			pool->run(n_blocks, TransformTask, &job);
+		} else {
+			for (ssi_size_t i = 0; i < n_blocks; i++) {
+				TransformTask(i, &job);
+			}
+		}
+
+		// add samples in original order
+		for (ssi_size_t i = 0; i < job.n_samples; i++) {
+			to.addSample(job.to[i]);
 		}
 
 		// clean up
-		if (num == 1) {
-			delete[] transformers_h;
+		for (ssi_size_t i = 1; i < n_sets; i++) {
+			for (ssi_size_t j = 0; j < num; j++) {
+				bool shared = false;
+				for (ssi_size_t k = 0; k < j; k++) {
+					shared = shared || sets[i][k] == sets[i][j];
+				}
+				if (!shared) {
+					delete sets[i][j];
+				}
+			}
+			delete[] sets[i];
+		}
+		delete[] sets;
+		delete[] job.free_sets;
+		delete[] job.to;
+
+		if (!shallow) {
+			for (ssi_size_t i = 0; i < samples.size(); i++) {
+				ssi_sample_destroy(*samples[i]);
+				delete samples[i];
+			}
 		}
 
 		delete[] label_map;
 		delete[] user_map;
 	}
 
+	void ModelTools::TransformTask(ssi_size_t index, void *arg) {
+		transform_job_t &job = *ssi_pcast(transform_job_t, arg);
+
+		// at most one task per thread is running, so a set is always available
+		ssi_size_t set = 0;
+		{
+			Lock lock(job.mutex);
+			set = job.free_sets[--job.n_free_sets];
+		}
+
+		ssi_size_t from = index * PARALLEL_BLOCK_SIZE;
+		ssi_size_t to = min(from + PARALLEL_BLOCK_SIZE, job.n_samples);
+		for (ssi_size_t i = from; i < to; i++) {
+			job.to[i] = TransformSample(*job.from[i], job.num, job.sets[set], job.frame_size, job.delta_size, true, true, job.label_map, job.user_map);
+		}
+
+		{
+			Lock lock(job.mutex);
+			job.free_sets[job.n_free_sets++] = set;
+		}
+	}
+
 	void ModelTools::TransformSampleListWithExtraStream(ISamples &from, ISamples **from_extra,
 		SampleList &to,
 		ssi_size_t num, ssi_size_t num_extra,
@@ -0,0 +1,224 @@
+// FilterFusion.cpp
+// created: 2026/10/19
+// Copyright (C) University of Augsburg, Lab for Human Centered Multimedia
+//
+// *************************************************************************************************
+//
+// This file is part of Social Signal Interpretation (SSI) developed at the
+// Lab for Human Centered Multimedia of the University of Augsburg
+//
+// This library is free software; you can redistribute itand/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 3 of the License, or any laterversion.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FORA PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along withthis library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+//
+//*************************************************************************************************
+
+#include "signal/FilterFusion.h"
+
+#ifdef USE_SSI_LEAK_DETECTOR
+	#include "SSI_LeakWatcher.h"
+	#ifdef _DEBUG
+		#define new DEBUG_NEW
+		#undef THIS_FILE
+		static char THIS_FILE[] = __FILE__;
+	#endif
+#endif
+
+namespace ssi {
+
+FilterFusion::FilterFusion ()
+	: _n_filters (0),
+	_filters (0),
+	_fused (0),
+	_streams (0),
+	_block_num (0) {
+}
+
+FilterFusion::~FilterFusion () {
+	release ();
+}
+
+void FilterFusion::release () {
+
+	if (_streams) {
+		for (ssi_size_t i = 0; i + 1 < _n_filters; i++) {
+			ssi_stream_destroy (_streams[i]);
+		}
+	}
+	delete[] _streams; _streams = 0;
+	delete[] _filters; _filters = 0;
+	delete[] _fused; _fused = 0;
+	_n_filters = 0;
+	_block_num = 0;
+}
+
+void FilterFusion::enter (ssi_size_t n_filters,
+	IFilter **filters,
+	ssi_stream_t &stream_in,
+	ssi_stream_t &stream_out,
+	bool fuse,
+	ssi_size_t block_bytes) {
+
+	release ();
+
+	_n_filters = n_filters;
+	if (_n_filters == 0) {
+		return;
+	}
+
+	_filters = new IFilter *[_n_filters];
+	_fused = new bool[_n_filters];
+	for (ssi_size_t i = 0; i < _n_filters; i++) {
+		_filters[i] = filters[i];
+		_fused[i] = fuse && _filters[i]->isSampleWise ();
+	}
+
+	// a single filter gains nothing from blocks
+	for (ssi_size_t i = 0; i < _n_filters; i++) {
+		if (_fused[i]) {
+			bool prev = i > 0 && _filters[i - 1]->isSampleWise ();
+			bool next = i + 1 < _n_filters && _filters[i + 1]->isSampleWise ();
+			_fused[i] = prev || next;
+		}
+	}
+
+	_streams = _n_filters > 1 ? new ssi_stream_t[_n_filters - 1] : 0;
+
+	ssi_size_t sample_bytes = stream_in.dim * stream_in.byte;
+	for (ssi_size_t i = 0; i < _n_filters; i++) {
+		ssi_stream_t &in = i == 0 ? stream_in : _streams[i - 1];
+		if (i + 1 < _n_filters) {
+			ssi_stream_init (_streams[i], 0, _filters[i]->getSampleDimensionOut (in.dim), _filters[i]->getSampleBytesOut (in.byte), _filters[i]->getSampleTypeOut (in.type), in.sr);
+			sample_bytes += _streams[i].dim * _streams[i].byte;
+			_filters[i]->transform_enter (in, _streams[i]);
+		} else {
+			_filters[i]->transform_enter (in, stream_out);
+		}
+	}
+	sample_bytes += stream_out.dim * stream_out.byte;
+
+	_block_num = sample_bytes > 0 ? block_bytes / sample_bytes : 0;
+	if (_block_num < 16) {
+		_block_num = 16;
+	}
+
+	for (ssi_size_t i = 0; i + 1 < _n_filters; i++) {
+		if (_fused[i] && _fused[i + 1]) {
+			ssi_stream_adjust (_streams[i], _block_num);
+		}
+	}
+}
+
+ssi_size_t FilterFusion::getFusedNum () {
+
+	ssi_size_t n = 0;
+	for (ssi_size_t i = 0; i < _n_filters; i++) {
+		if (_fused[i]) {
+			n++;
+		}
+	}
+
+	return n;
+}
+
+void FilterFusion::View (ssi_stream_t &view, ssi_stream_t &stream, ssi_size_t offset, ssi_size_t num) {
+
+	view = stream;
+	view.ptr = stream.ptr + offset * stream.dim * stream.byte;
+	view.num_real = view.num = num;
+	view.tot_real = view.tot = num * stream.dim * stream.byte;
+	view.time = stream.time + (stream.sr > 0 ? offset / stream.sr : 0);
+}
+
+void FilterFusion::transform (ITransformer::info info,
+	ssi_stream_t &stream_in,
+	ssi_stream_t &stream_out) {
+
+	ssi_size_t num = stream_in.num;
+
+	ssi_size_t i = 0;
+	while (i < _n_filters) {
+
+		if (!_fused[i]) {
+			ssi_stream_t &in = i == 0 ? stream_in : _streams[i - 1];
+			ssi_stream_t &out = i + 1 < _n_filters ? _streams[i] : stream_out;
+			if (i + 1 < _n_filters) {
+				ssi_stream_adjust (out, num);
+			}
+			_filters[i]->transform (info, in, out);
+			i++;
+			continue;
+		}
+
+		// run of fused filters [i, end)
+		ssi_size_t end = i;
+		while (end < _n_filters && _fused[end]) {
+			end++;
+		}
+
+		ssi_stream_t &run_in = i == 0 ? stream_in : _streams[i - 1];
+		ssi_stream_t &run_out = end < _n_filters ? _streams[end - 1] : stream_out;
+		if (end < _n_filters) {
+			ssi_stream_adjust (run_out, num);
+		}
+
+		for (ssi_size_t offset = 0; offset < num; offset += _block_num) {
+
+			ssi_size_t n = num - offset < _block_num ? num - offset : _block_num;
+
+			// blocks keep the split into frame and delta samples
+			ITransformer::info block_info;
+			block_info.time = info.time + (stream_in.sr > 0 ? offset / stream_in.sr : 0);
+			block_info.frame_num = offset < info.frame_num ? (info.frame_num - offset < n ? info.frame_num - offset : n) : 0;
+			block_info.delta_num = n - block_info.frame_num;
+
+			for (ssi_size_t k = i; k < end; k++) {
+
+				ssi_stream_t *in = 0;
+				if (k == i) {
+					View (_view_in, run_in, offset, n);
+					in = &_view_in;
+				} else {
+					in = &_streams[k - 1];
+				}
+
+				ssi_stream_t *out = 0;
+				if (k + 1 == end) {
+					View (_view_out, run_out, offset, n);
+					out = &_view_out;
+				} else {
+					out = &_streams[k];
+					ssi_stream_adjust (*out, n);
+				}
+
+				_filters[k]->transform (block_info, *in, *out);
+			}
+		}
+
+		i = end;
+	}
+}
+
+void FilterFusion::flush (ssi_stream_t &stream_in,
+	ssi_stream_t &stream_out) {
+
+	for (ssi_size_t i = 0; i < _n_filters; i++) {
+		ssi_stream_t &in = i == 0 ? stream_in : _streams[i - 1];
+		ssi_stream_t &out = i + 1 < _n_filters ? _streams[i] : stream_out;
+		_filters[i]->transform_flush (in, out);
+	}
+
+	release ();
+}
+
+}
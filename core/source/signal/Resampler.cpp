@@ -0,0 +1,264 @@
+// Resampler.cpp
+// created: 2026/10/19
+// Copyright (C) University of Augsburg, Lab for Human Centered Multimedia
+//
+// *************************************************************************************************
+//
+// This file is part of Social Signal Interpretation (SSI) developed at the
+// Lab for Human Centered Multimedia of the University of Augsburg
+//
+// This library is free software; you can redistribute itand/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 3 of the License, or any laterversion.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FORA PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along withthis library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+//
+//*************************************************************************************************
+
+#include "signal/Resampler.h"
+
+#ifdef USE_SSI_LEAK_DETECTOR
+	#include "SSI_LeakWatcher.h"
+	#ifdef _DEBUG
+		#define new DEBUG_NEW
+		#undef THIS_FILE
+		static char THIS_FILE[] = __FILE__;
+	#endif
+#endif
+
+namespace ssi {
+
+Resampler::Resampler ()
+	: _dim (0),
+	_up (1),
+	_down (1),
+	_taps (0),
+	_delay (0),
+	_coefs (0),
+	_buffer (0),
+	_capacity (0),
+	_num (0),
+	_base (0),
+	_out_pos (0) {
+}
+
+Resampler::~Resampler () {
+	release ();
+}
+
+void Resampler::Ratio (ssi_time_t rate_in, ssi_time_t rate_out, ssi_size_t &up, ssi_size_t &down, ssi_size_t max_factor) {
+
+	up = 1;
+	down = 1;
+
+	if (rate_in <= 0 || rate_out <= 0) {
+		return;
+	}
+
+	// continued fraction expansion of rate_out / rate_in, stop before a term exceeds max_factor
+	double x = rate_out / rate_in;
+	uint64_t p0 = 0, q0 = 1, p1 = 1, q1 = 0;
+	for (int i = 0; i < 32; i++) {
+		uint64_t a = ssi_cast (uint64_t, floor (x));
+		uint64_t p2 = a * p1 + p0;
+		uint64_t q2 = a * q1 + q0;
+		if (p2 > max_factor || q2 > max_factor) {
+			break;
+		}
+		p0 = p1; q0 = q1;
+		p1 = p2; q1 = q2;
+		double frac = x - ssi_cast (double, a);
+		if (frac < 1e-9) {
+			break;
+		}
+		x = 1.0 / frac;
+	}
+
+	if (p1 > 0 && q1 > 0) {
+		up = ssi_cast (ssi_size_t, p1);
+		down = ssi_cast (ssi_size_t, q1);
+	}
+}
+
+void Resampler::init (ssi_size_t dim, ssi_size_t up, ssi_size_t down, ssi_size_t taps, bool compensate) {
+
+	release ();
+
+	_dim = dim;
+	_up = up > 0 ? up : 1;
+	_down = down > 0 ? down : 1;
+	_taps = taps > 0 ? taps : 1;
+	_delay = compensate ? (_taps * _up - 1) / 2 : 0;
+
+	design ();
+	reset (0);
+}
+
+void Resampler::release () {
+
+	delete[] _coefs; _coefs = 0;
+	delete[] _buffer; _buffer = 0;
+	_capacity = 0;
+	_num = 0;
+	_base = 0;
+	_out_pos = 0;
+}
+
+void Resampler::design () {
+
+	// windowed sinc lowpass at the lower of both nyquist frequencies,
+	// computed at the upsampled rate and split into _up phases
+	ssi_size_t n = _taps * _up;
+	double cutoff = 0.5 / (_up > _down ? _up : _down);
+	double center = (n - 1) / 2.0;
+
+	double *h = new double[n];
+	double sum = 0;
+	for (ssi_size_t k = 0; k < n; k++) {
+		double t = k - center;
+		double sinc = t == 0 ? 2.0 * cutoff : sin (2.0 * PI * cutoff * t) / (PI * t);
+		double window = n > 1 ? 0.42 - 0.5 * cos (2.0 * PI * k / (n - 1)) + 0.08 * cos (4.0 * PI * k / (n - 1)) : 1.0;
+		h[k] = sinc * window;
+		sum += h[k];
+	}
+
+	// unit gain after zero stuffing
+	double gain = sum != 0 ? _up / sum : 1.0;
+
+	_coefs = new ssi_real_t[_up * _taps];
+	for (ssi_size_t p = 0; p < _up; p++) {
+		ssi_real_t *coefs = _coefs + p * _taps;
+		for (ssi_size_t k = 0; k < _taps; k++) {
+			coefs[_taps - 1 - k] = ssi_cast (ssi_real_t, h[p + k * _up] * gain);
+		}
+	}
+
+	delete[] h;
+}
+
+void Resampler::reserve (ssi_size_t num) {
+
+	if (num <= _capacity) {
+		return;
+	}
+
+	ssi_size_t capacity = _capacity * 2 > num ? _capacity * 2 : num;
+	ssi_real_t *buffer = new ssi_real_t[_dim * capacity];
+	for (ssi_size_t d = 0; d < _dim; d++) {
+		memcpy (buffer + d * capacity, _buffer + d * _capacity, _num * sizeof (ssi_real_t));
+	}
+
+	delete[] _buffer;
+	_buffer = buffer;
+	_capacity = capacity;
+}
+
+void Resampler::reset (ssi_lsize_t out_pos) {
+
+	_out_pos = out_pos;
+
+	// oldest input sample needed by the next output
+	_base = ssi_cast (int64_t, (_out_pos * _down + _delay) / _up) - ssi_cast (int64_t, _taps - 1);
+	_num = 0;
+
+	// everything before the start of the signal is zero
+	if (_base < 0) {
+		ssi_size_t zeros = ssi_cast (ssi_size_t, -_base);
+		reserve (zeros);
+		for (ssi_size_t d = 0; d < _dim; d++) {
+			memset (_buffer + d * _capacity, 0, zeros * sizeof (ssi_real_t));
+		}
+		_num = zeros;
+	}
+}
+
+ssi_lsize_t Resampler::getInputPos () {
+	return ssi_cast (ssi_lsize_t, _base + _num);
+}
+
+ssi_lsize_t Resampler::getInputEnd (ssi_lsize_t out_end) {
+
+	if (out_end == 0) {
+		return 0;
+	}
+
+	return ((out_end - 1) * _down + _delay) / _up + 1;
+}
+
+void Resampler::push (ssi_size_t num, const ssi_real_t *ptr) {
+
+	reserve (_num + num);
+
+	for (ssi_size_t d = 0; d < _dim; d++) {
+		ssi_real_t *dst = _buffer + d * _capacity + _num;
+		const ssi_real_t *src = ptr + d;
+		for (ssi_size_t i = 0; i < num; i++) {
+			dst[i] = *src;
+			src += _dim;
+		}
+	}
+	_num += num;
+}
+
+ssi_size_t Resampler::pull (ssi_size_t num, ssi_real_t *ptr) {
+
+	ssi_size_t n = 0;
+	int64_t end = _base + _num;
+
+	for (; n < num; n++) {
+
+		ssi_lsize_t u = _out_pos * _down + _delay;
+		int64_t last = ssi_cast (int64_t, u / _up);
+		if (last >= end) {
+			break;
+		}
+
+		const ssi_real_t *coefs = _coefs + (u % _up) * _taps;
+		ssi_size_t offset = ssi_cast (ssi_size_t, last - ssi_cast (int64_t, _taps - 1) - _base);
+
+		// four independent sums over contiguous rows, which compilers map to simd lanes
+		for (ssi_size_t d = 0; d < _dim; d++) {
+			const ssi_real_t *src = _buffer + d * _capacity + offset;
+			ssi_real_t sum0 = 0, sum1 = 0, sum2 = 0, sum3 = 0;
+			ssi_size_t k = 0;
+			for (; k + 4 <= _taps; k += 4) {
+				sum0 += coefs[k] * src[k];
+				sum1 += coefs[k + 1] * src[k + 1];
+				sum2 += coefs[k + 2] * src[k + 2];
+				sum3 += coefs[k + 3] * src[k + 3];
+			}
+			for (; k < _taps; k++) {
+				sum0 += coefs[k] * src[k];
+			}
+			*ptr++ = (sum0 + sum1) + (sum2 + sum3);
+		}
+
+		_out_pos++;
+	}
+
+	// drop samples that are not needed anymore
+	int64_t first = ssi_cast (int64_t, (_out_pos * _down + _delay) / _up) - ssi_cast (int64_t, _taps - 1);
+	if (first > _base) {
+		ssi_size_t drop = first - _base < _num ? ssi_cast (ssi_size_t, first - _base) : _num;
+		if (drop > 0) {
+			for (ssi_size_t d = 0; d < _dim; d++) {
+				ssi_real_t *row = _buffer + d * _capacity;
+				memmove (row, row + drop, (_num - drop) * sizeof (ssi_real_t));
+			}
+			_num -= drop;
+			_base += drop;
+		}
+	}
+
+	return n;
+}
+
+}
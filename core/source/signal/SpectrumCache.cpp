@@ -0,0 +1,232 @@
+// SpectrumCache.cpp
+// created: 2026/10/19
+// Copyright (C) University of Augsburg, Lab for Human Centered Multimedia
+//
+// *************************************************************************************************
+//
+// This file is part of Social Signal Interpretation (SSI) developed at the
+// Lab for Human Centered Multimedia of the University of Augsburg
+//
+// This library is free software; you can redistribute itand/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 3 of the License, or any laterversion.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FORA PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along withthis library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+//
+//*************************************************************************************************
+
+#include "signal/SpectrumCache.h"
+#include "thread/Lock.h"
+
+#ifdef USE_SSI_LEAK_DETECTOR
+	#include "SSI_LeakWatcher.h"
+	#ifdef _DEBUG
+		#define new DEBUG_NEW
+		#undef THIS_FILE
+		static char THIS_FILE[] = __FILE__;
+	#endif
+#endif
+
+namespace ssi {
+
+std::atomic<SpectrumCache *> SpectrumCache::_shared (0);
+Mutex SpectrumCache::_shared_mutex;
+
+SpectrumCache::SpectrumCache ()
+	: _next (0) {
+
+	for (ssi_size_t i = 0; i < MAX_KEYS; i++) {
+		_users[i].store (0);
+	}
+
+	for (ssi_size_t i = 0; i < SLOTS; i++) {
+		slot_t &slot = _slots[i];
+		slot.key = INVALID_KEY;
+		slot.hash = 0;
+		slot.n_in = 0;
+		slot.n_out = 0;
+		slot.capacity_in = 0;
+		slot.capacity_out = 0;
+		slot.in = 0;
+		slot.out = 0;
+	}
+}
+
+SpectrumCache::~SpectrumCache () {
+
+	for (ssi_size_t i = 0; i < SLOTS; i++) {
+		delete[] _slots[i].in;
+		delete[] _slots[i].out;
+	}
+}
+
+SpectrumCache *SpectrumCache::GetShared () {
+
+	// components ask for every frame, so lock only on creation
+	SpectrumCache *cache = _shared.load (std::memory_order_acquire);
+	if (cache) {
+		return cache;
+	}
+
+	Lock lock (_shared_mutex);
+
+	cache = _shared.load (std::memory_order_relaxed);
+	if (!cache) {
+		cache = new SpectrumCache ();
+		_shared.store (cache, std::memory_order_release);
+	}
+
+	return cache;
+}
+
+void SpectrumCache::ReleaseShared () {
+
+	Lock lock (_shared_mutex);
+
+	delete _shared.exchange (0);
+}
+
+ssi_size_t SpectrumCache::getKey (const ssi_char_t *config) {
+
+	return _keys.add (config);
+}
+
+ssi_size_t SpectrumCache::attach (const ssi_char_t *config) {
+
+	ssi_size_t key = getKey (config);
+	if (key < MAX_KEYS) {
+		_users[key].fetch_add (1);
+	}
+
+	return key;
+}
+
+void SpectrumCache::detach (ssi_size_t key) {
+
+	if (key < MAX_KEYS) {
+		_users[key].fetch_sub (1);
+	}
+}
+
+bool SpectrumCache::isShared (ssi_size_t key) {
+
+	if (key == INVALID_KEY) {
+		return false;
+	}
+
+	return key >= MAX_KEYS || _users[key].load (std::memory_order_relaxed) > 1;
+}
+
+ssi_size_t SpectrumCache::Hash (ssi_size_t n, const ssi_real_t *values) {
+
+	// multiply and shift over 64-bit words, hits are confirmed with memcmp anyway
+	const ssi_byte_t *ptr = ssi_pcast (const ssi_byte_t, values);
+	size_t bytes = n * sizeof (ssi_real_t);
+	uint64_t hash = bytes;
+	uint64_t word = 0;
+	for (; bytes >= sizeof (uint64_t); bytes -= sizeof (uint64_t), ptr += sizeof (uint64_t)) {
+		memcpy (&word, ptr, sizeof (uint64_t));
+		hash = (hash ^ word) * 0x9e3779b97f4a7c15ull;
+		hash ^= hash >> 32;
+	}
+	if (bytes > 0) {
+		word = 0;
+		memcpy (&word, ptr, bytes);
+		hash = (hash ^ word) * 0x9e3779b97f4a7c15ull;
+		hash ^= hash >> 32;
+	}
+
+	return ssi_cast (ssi_size_t, hash);
+}
+
+SpectrumCache::slot_t *SpectrumCache::find (ssi_size_t key, ssi_size_t hash, ssi_size_t n_in, const ssi_real_t *in, ssi_size_t n_out) {
+
+	// start with the most recent frame
+	for (ssi_size_t i = 1; i <= SLOTS; i++) {
+		slot_t &slot = _slots[(_next + SLOTS - i) % SLOTS];
+		if (slot.key == key
+			&& slot.hash == hash
+			&& slot.n_in == n_in
+			&& slot.n_out == n_out
+			&& memcmp (slot.in, in, n_in * sizeof (ssi_real_t)) == 0) {
+			return &slot;
+		}
+	}
+
+	return 0;
+}
+
+bool SpectrumCache::get (ssi_size_t key, ssi_size_t n_in, const ssi_real_t *in, ssi_size_t n_out, ssi_real_t *out) {
+
+	if (!isShared (key)) {
+		return false;
+	}
+
+	ssi_size_t hash = Hash (n_in, in);
+
+	Lock lock (_mutex);
+
+	slot_t *slot = find (key, hash, n_in, in, n_out);
+	if (!slot) {
+		return false;
+	}
+	memcpy (out, slot->out, n_out * sizeof (ssi_real_t));
+
+	return true;
+}
+
+void SpectrumCache::put (ssi_size_t key, ssi_size_t n_in, const ssi_real_t *in, ssi_size_t n_out, const ssi_real_t *out) {
+
+	if (!isShared (key)) {
+		return;
+	}
+
+	ssi_size_t hash = Hash (n_in, in);
+
+	Lock lock (_mutex);
+
+	// another component may have stored the frame in the meantime
+	if (find (key, hash, n_in, in, n_out)) {
+		return;
+	}
+
+	slot_t &slot = _slots[_next];
+	_next = (_next + 1) % SLOTS;
+
+	if (slot.capacity_in < n_in) {
+		delete[] slot.in;
+		slot.capacity_in = n_in;
+		slot.in = new ssi_real_t[n_in];
+	}
+	if (slot.capacity_out < n_out) {
+		delete[] slot.out;
+		slot.capacity_out = n_out;
+		slot.out = new ssi_real_t[n_out];
+	}
+
+	slot.key = key;
+	slot.hash = hash;
+	slot.n_in = n_in;
+	slot.n_out = n_out;
+	memcpy (slot.in, in, n_in * sizeof (ssi_real_t));
+	memcpy (slot.out, out, n_out * sizeof (ssi_real_t));
+}
+
+void SpectrumCache::clear () {
+
+	Lock lock (_mutex);
+
+	for (ssi_size_t i = 0; i < SLOTS; i++) {
+		_slots[i].key = INVALID_KEY;
+	}
+}
+
+}
@@ -0,0 +1,535 @@
+// TypeCast.cpp
+// created: 2026/10/19
+// Copyright (C) University of Augsburg, Lab for Human Centered Multimedia
+//
+// *************************************************************************************************
+//
+// This file is part of Social Signal Interpretation (SSI) developed at the
+// Lab for Human Centered Multimedia of the University of Augsburg
+//
+// This library is free software; you can redistribute itand/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 3 of the License, or any laterversion.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FORA PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along withthis library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+//
+//*************************************************************************************************
+
+#include "signal/TypeCast.h"
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+	#define SSI_TYPECAST_X86
+	#include <emmintrin.h>
+	#include <smmintrin.h>
+	#include <immintrin.h>
+	#if defined(_MSC_VER)
+		#include <intrin.h>
+		#define SSI_TYPECAST_TARGET(x)
+	#else
+		#include <cpuid.h>
+		#define SSI_TYPECAST_TARGET(x) __attribute__((target(x)))
+	#endif
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__) || defined(__aarch64__)
+	#define SSI_TYPECAST_NEON
+	#include <arm_neon.h>
+#endif
+
+#ifdef USE_SSI_LEAK_DETECTOR
+	#include "SSI_LeakWatcher.h"
+	#ifdef _DEBUG
+		#define new DEBUG_NEW
+		#undef THIS_FILE
+		static char THIS_FILE[] = __FILE__;
+	#endif
+#endif
+
+namespace ssi {
+
+bool TypeCast::_detected = false;
+ssi_size_t TypeCast::_features = 0;
+
+//*************************************************************************************************
+// scalar kernels
+
+template <typename TIN, typename TOUT>
+static void cast_generic (ssi_size_t n, const void *in, void *out, ssi_real_t scale) {
+
+	const TIN *src = ssi_pcast (const TIN, in);
+	TOUT *dst = ssi_pcast (TOUT, out);
+
+	if (scale == 1.0f) {
+		for (ssi_size_t i = 0; i < n; i++) {
+			dst[i] = ssi_cast (TOUT, src[i]);
+		}
+	} else {
+		for (ssi_size_t i = 0; i < n; i++) {
+			dst[i] = ssi_cast (TOUT, src[i] * scale);
+		}
+	}
+}
+
+template <typename TIN>
+static void cast_generic_bool (ssi_size_t n, const void *in, void *out, ssi_real_t scale) {
+
+	const TIN *src = ssi_pcast (const TIN, in);
+	bool *dst = ssi_pcast (bool, out);
+
+	for (ssi_size_t i = 0; i < n; i++) {
+		dst[i] = src[i] * scale != 0;
+	}
+}
+
+static inline int16_t float_to_short (float value) {
+
+	// also maps nan to the lower limit, like the simd kernels
+	if (!(value > -32768.0f)) {
+		return -32768;
+	}
+	if (value >= 32767.0f) {
+		return 32767;
+	}
+	return ssi_cast (int16_t, value);
+}
+
+static void cast_float_short (ssi_size_t n, const void *in, void *out, ssi_real_t scale) {
+
+	const float *src = ssi_pcast (const float, in);
+	int16_t *dst = ssi_pcast (int16_t, out);
+
+	for (ssi_size_t i = 0; i < n; i++) {
+		dst[i] = float_to_short (src[i] * scale);
+	}
+}
+
+//*************************************************************************************************
+// x86 kernels
+
+#ifdef SSI_TYPECAST_X86
+
+SSI_TYPECAST_TARGET("sse2")
+static void cast_float_short_sse2 (ssi_size_t n, const void *in, void *out, ssi_real_t scale) {
+
+	const float *src = ssi_pcast (const float, in);
+	int16_t *dst = ssi_pcast (int16_t, out);
+
+	__m128 s = _mm_set1_ps (scale);
+	__m128 lo = _mm_set1_ps (-32768.0f);
+	__m128 hi = _mm_set1_ps (32767.0f);
+
+	ssi_size_t i = 0;
+	for (; i + 8 <= n; i += 8) {
+		__m128 a = _mm_min_ps (_mm_max_ps (_mm_mul_ps (_mm_loadu_ps (src + i), s), lo), hi);
+		__m128 b = _mm_min_ps (_mm_max_ps (_mm_mul_ps (_mm_loadu_ps (src + i + 4), s), lo), hi);
+		__m128i packed = _mm_packs_epi32 (_mm_cvttps_epi32 (a), _mm_cvttps_epi32 (b));
+		_mm_storeu_si128 (ssi_pcast (__m128i, dst + i), packed);
+	}
+	for (; i < n; i++) {
+		dst[i] = float_to_short (src[i] * scale);
+	}
+}
+
+SSI_TYPECAST_TARGET("sse2")
+static void cast_float_double_sse2 (ssi_size_t n, const void *in, void *out, ssi_real_t scale) {
+
+	const float *src = ssi_pcast (const float, in);
+	double *dst = ssi_pcast (double, out);
+
+	__m128 s = _mm_set1_ps (scale);
+
+	ssi_size_t i = 0;
+	for (; i + 4 <= n; i += 4) {
+		__m128 v = _mm_mul_ps (_mm_loadu_ps (src + i), s);
+		_mm_storeu_pd (dst + i, _mm_cvtps_pd (v));
+		_mm_storeu_pd (dst + i + 2, _mm_cvtps_pd (_mm_movehl_ps (v, v)));
+	}
+	for (; i < n; i++) {
+		dst[i] = ssi_cast (double, src[i] * scale);
+	}
+}
+
+SSI_TYPECAST_TARGET("sse2")
+static void cast_double_float_sse2 (ssi_size_t n, const void *in, void *out, ssi_real_t scale) {
+
+	const double *src = ssi_pcast (const double, in);
+	float *dst = ssi_pcast (float, out);
+
+	__m128d s = _mm_set1_pd (scale);
+
+	ssi_size_t i = 0;
+	for (; i + 4 <= n; i += 4) {
+		__m128 a = _mm_cvtpd_ps (_mm_mul_pd (_mm_loadu_pd (src + i), s));
+		__m128 b = _mm_cvtpd_ps (_mm_mul_pd (_mm_loadu_pd (src + i + 2), s));
+		_mm_storeu_ps (dst + i, _mm_movelh_ps (a, b));
+	}
+	for (; i < n; i++) {
+		dst[i] = ssi_cast (float, src[i] * scale);
+	}
+}
+
+SSI_TYPECAST_TARGET("sse4.1")
+static void cast_short_float_sse41 (ssi_size_t n, const void *in, void *out, ssi_real_t scale) {
+
+	const int16_t *src = ssi_pcast (const int16_t, in);
+	float *dst = ssi_pcast (float, out);
+
+	__m128 s = _mm_set1_ps (scale);
+
+	ssi_size_t i = 0;
+	for (; i + 8 <= n; i += 8) {
+		__m128i v = _mm_loadu_si128 (ssi_pcast (const __m128i, src + i));
+		__m128i a = _mm_cvtepi16_epi32 (v);
+		__m128i b = _mm_cvtepi16_epi32 (_mm_srli_si128 (v, 8));
+		_mm_storeu_ps (dst + i, _mm_mul_ps (_mm_cvtepi32_ps (a), s));
+		_mm_storeu_ps (dst + i + 4, _mm_mul_ps (_mm_cvtepi32_ps (b), s));
+	}
+	for (; i < n; i++) {
+		dst[i] = src[i] * scale;
+	}
+}
+
+SSI_TYPECAST_TARGET("sse4.1")
+static void cast_uchar_float_sse41 (ssi_size_t n, const void *in, void *out, ssi_real_t scale) {
+
+	const ssi_uchar_t *src = ssi_pcast (const ssi_uchar_t, in);
+	float *dst = ssi_pcast (float, out);
+
+	__m128 s = _mm_set1_ps (scale);
+
+	ssi_size_t i = 0;
+	for (; i + 16 <= n; i += 16) {
+		__m128i v = _mm_loadu_si128 (ssi_pcast (const __m128i, src + i));
+		for (int k = 0; k < 4; k++) {
+			__m128i w = _mm_cvtepu8_epi32 (v);
+			_mm_storeu_ps (dst + i + 4 * k, _mm_mul_ps (_mm_cvtepi32_ps (w), s));
+			v = _mm_srli_si128 (v, 4);
+		}
+	}
+	for (; i < n; i++) {
+		dst[i] = src[i] * scale;
+	}
+}
+
+SSI_TYPECAST_TARGET("avx2")
+static void cast_short_float_avx2 (ssi_size_t n, const void *in, void *out, ssi_real_t scale) {
+
+	const int16_t *src = ssi_pcast (const int16_t, in);
+	float *dst = ssi_pcast (float, out);
+
+	__m256 s = _mm256_set1_ps (scale);
+
+	ssi_size_t i = 0;
+	for (; i + 16 <= n; i += 16) {
+		__m128i a = _mm_loadu_si128 (ssi_pcast (const __m128i, src + i));
+		__m128i b = _mm_loadu_si128 (ssi_pcast (const __m128i, src + i + 8));
+		_mm256_storeu_ps (dst + i, _mm256_mul_ps (_mm256_cvtepi32_ps (_mm256_cvtepi16_epi32 (a)), s));
+		_mm256_storeu_ps (dst + i + 8, _mm256_mul_ps (_mm256_cvtepi32_ps (_mm256_cvtepi16_epi32 (b)), s));
+	}
+	for (; i < n; i++) {
+		dst[i] = src[i] * scale;
+	}
+}
+
+SSI_TYPECAST_TARGET("avx2")
+static void cast_uchar_float_avx2 (ssi_size_t n, const void *in, void *out, ssi_real_t scale) {
+
+	const ssi_uchar_t *src = ssi_pcast (const ssi_uchar_t, in);
+	float *dst = ssi_pcast (float, out);
+
+	__m256 s = _mm256_set1_ps (scale);
+
+	ssi_size_t i = 0;
+	for (; i + 16 <= n; i += 16) {
+		__m128i v = _mm_loadu_si128 (ssi_pcast (const __m128i, src + i));
+		_mm256_storeu_ps (dst + i, _mm256_mul_ps (_mm256_cvtepi32_ps (_mm256_cvtepu8_epi32 (v)), s));
+		_mm256_storeu_ps (dst + i + 8, _mm256_mul_ps (_mm256_cvtepi32_ps (_mm256_cvtepu8_epi32 (_mm_srli_si128 (v, 8))), s));
+	}
+	for (; i < n; i++) {
+		dst[i] = src[i] * scale;
+	}
+}
+
+SSI_TYPECAST_TARGET("avx2")
+static void cast_float_short_avx2 (ssi_size_t n, const void *in, void *out, ssi_real_t scale) {
+
+	const float *src = ssi_pcast (const float, in);
+	int16_t *dst = ssi_pcast (int16_t, out);
+
+	__m256 s = _mm256_set1_ps (scale);
+	__m256 lo = _mm256_set1_ps (-32768.0f);
+	__m256 hi = _mm256_set1_ps (32767.0f);
+
+	ssi_size_t i = 0;
+	for (; i + 16 <= n; i += 16) {
+		__m256 a = _mm256_min_ps (_mm256_max_ps (_mm256_mul_ps (_mm256_loadu_ps (src + i), s), lo), hi);
+		__m256 b = _mm256_min_ps (_mm256_max_ps (_mm256_mul_ps (_mm256_loadu_ps (src + i + 8), s), lo), hi);
+		// packs works per 128 bit lane, the permute restores the order
+		__m256i packed = _mm256_packs_epi32 (_mm256_cvttps_epi32 (a), _mm256_cvttps_epi32 (b));
+		_mm256_storeu_si256 (ssi_pcast (__m256i, dst + i), _mm256_permute4x64_epi64 (packed, 0xD8));
+	}
+	for (; i < n; i++) {
+		dst[i] = float_to_short (src[i] * scale);
+	}
+}
+
+SSI_TYPECAST_TARGET("avx2")
+static void cast_float_double_avx2 (ssi_size_t n, const void *in, void *out, ssi_real_t scale) {
+
+	const float *src = ssi_pcast (const float, in);
+	double *dst = ssi_pcast (double, out);
+
+	__m128 s = _mm_set1_ps (scale);
+
+	ssi_size_t i = 0;
+	for (; i + 8 <= n; i += 8) {
+		_mm256_storeu_pd (dst + i, _mm256_cvtps_pd (_mm_mul_ps (_mm_loadu_ps (src + i), s)));
+		_mm256_storeu_pd (dst + i + 4, _mm256_cvtps_pd (_mm_mul_ps (_mm_loadu_ps (src + i + 4), s)));
+	}
+	for (; i < n; i++) {
+		dst[i] = ssi_cast (double, src[i] * scale);
+	}
+}
+
+SSI_TYPECAST_TARGET("avx2")
+static void cast_double_float_avx2 (ssi_size_t n, const void *in, void *out, ssi_real_t scale) {
+
+	const double *src = ssi_pcast (const double, in);
+	float *dst = ssi_pcast (float, out);
+
+	__m256d s = _mm256_set1_pd (scale);
+
+	ssi_size_t i = 0;
+	for (; i + 8 <= n; i += 8) {
+		_mm_storeu_ps (dst + i, _mm256_cvtpd_ps (_mm256_mul_pd (_mm256_loadu_pd (src + i), s)));
+		_mm_storeu_ps (dst + i + 4, _mm256_cvtpd_ps (_mm256_mul_pd (_mm256_loadu_pd (src + i + 4), s)));
+	}
+	for (; i < n; i++) {
+		dst[i] = ssi_cast (float, src[i] * scale);
+	}
+}
+
+#endif
+
+//*************************************************************************************************
+// neon kernels
+
+#ifdef SSI_TYPECAST_NEON
+
+static void cast_short_float_neon (ssi_size_t n, const void *in, void *out, ssi_real_t scale) {
+
+	const int16_t *src = ssi_pcast (const int16_t, in);
+	float *dst = ssi_pcast (float, out);
+
+	ssi_size_t i = 0;
+	for (; i + 8 <= n; i += 8) {
+		int16x8_t v = vld1q_s16 (src + i);
+		vst1q_f32 (dst + i, vmulq_n_f32 (vcvtq_f32_s32 (vmovl_s16 (vget_low_s16 (v))), scale));
+		vst1q_f32 (dst + i + 4, vmulq_n_f32 (vcvtq_f32_s32 (vmovl_s16 (vget_high_s16 (v))), scale));
+	}
+	for (; i < n; i++) {
+		dst[i] = src[i] * scale;
+	}
+}
+
+static void cast_uchar_float_neon (ssi_size_t n, const void *in, void *out, ssi_real_t scale) {
+
+	const ssi_uchar_t *src = ssi_pcast (const ssi_uchar_t, in);
+	float *dst = ssi_pcast (float, out);
+
+	ssi_size_t i = 0;
+	for (; i + 8 <= n; i += 8) {
+		uint16x8_t v = vmovl_u8 (vld1_u8 (src + i));
+		vst1q_f32 (dst + i, vmulq_n_f32 (vcvtq_f32_u32 (vmovl_u16 (vget_low_u16 (v))), scale));
+		vst1q_f32 (dst + i + 4, vmulq_n_f32 (vcvtq_f32_u32 (vmovl_u16 (vget_high_u16 (v))), scale));
+	}
+	for (; i < n; i++) {
+		dst[i] = src[i] * scale;
+	}
+}
+
+static void cast_float_short_neon (ssi_size_t n, const void *in, void *out, ssi_real_t scale) {
+
+	const float *src = ssi_pcast (const float, in);
+	int16_t *dst = ssi_pcast (int16_t, out);
+
+	float32x4_t lo = vdupq_n_f32 (-32768.0f);
+	float32x4_t hi = vdupq_n_f32 (32767.0f);
+
+	ssi_size_t i = 0;
+	for (; i + 8 <= n; i += 8) {
+		float32x4_t a = vminq_f32 (vmaxq_f32 (vmulq_n_f32 (vld1q_f32 (src + i), scale), lo), hi);
+		float32x4_t b = vminq_f32 (vmaxq_f32 (vmulq_n_f32 (vld1q_f32 (src + i + 4), scale), lo), hi);
+		vst1q_s16 (dst + i, vcombine_s16 (vqmovn_s32 (vcvtq_s32_f32 (a)), vqmovn_s32 (vcvtq_s32_f32 (b))));
+	}
+	for (; i < n; i++) {
+		dst[i] = float_to_short (src[i] * scale);
+	}
+}
+
+#endif
+
+//*************************************************************************************************
+
+ssi_size_t TypeCast::Detect () {
+
+	ssi_size_t features = 0;
+
+#if defined(SSI_TYPECAST_X86)
+
+	unsigned int eax = 0, ebx = 0, ecx = 0, edx = 0;
+	unsigned int ebx7 = 0;
+	bool ymm = false;
+
+#if defined(_MSC_VER)
+	int info[4];
+	__cpuid (info, 0);
+	int max_leaf = info[0];
+	__cpuid (info, 1);
+	ecx = info[2]; edx = info[3];
+	if (max_leaf >= 7) {
+		__cpuidex (info, 7, 0);
+		ebx7 = info[1];
+	}
+	if ((ecx & (1 << 27)) && (ecx & (1 << 28))) {
+		ymm = (_xgetbv (0) & 6) == 6;
+	}
+#else
+	unsigned int max_leaf = __get_cpuid_max (0, 0);
+	__get_cpuid (1, &eax, &ebx, &ecx, &edx);
+	if (max_leaf >= 7) {
+		unsigned int eax7, ecx7, edx7;
+		__cpuid_count (7, 0, eax7, ebx7, ecx7, edx7);
+	}
+	if ((ecx & (1 << 27)) && (ecx & (1 << 28))) {
+		unsigned int xcr0_lo, xcr0_hi;
+		__asm__ ("xgetbv" : "=a" (xcr0_lo), "=d" (xcr0_hi) : "c" (0));
+		ymm = (xcr0_lo & 6) == 6;
+	}
+#endif
+
+	if (edx & (1 << 26)) {
+		features |= SSE2;
+	}
+	if (ecx & (1 << 19)) {
+		features |= SSE41;
+	}
+	// avx2 also needs the os to save the ymm registers
+	if (ymm && (ebx7 & (1 << 5))) {
+		features |= AVX2;
+	}
+
+#elif defined(SSI_TYPECAST_NEON)
+
+	features |= NEON;
+
+#endif
+
+	return features;
+}
+
+ssi_size_t TypeCast::GetCpuFeatures () {
+
+	if (!_detected) {
+		_features = Detect ();
+		_detected = true;
+	}
+
+	return _features;
+}
+
+void TypeCast::SetCpuFeatures (ssi_size_t features) {
+	_features = Detect () & features;
+	_detected = true;
+}
+
+template <typename TIN>
+static ssi_cast_kernel_t resolve_generic (ssi_type_t type_out) {
+
+	switch (type_out) {
+		case SSI_CHAR: return &cast_generic<TIN, ssi_char_t>;
+		case SSI_UCHAR: return &cast_generic<TIN, ssi_uchar_t>;
+		case SSI_SHORT: return &cast_generic<TIN, int16_t>;
+		case SSI_USHORT: return &cast_generic<TIN, uint16_t>;
+		case SSI_INT: return &cast_generic<TIN, int32_t>;
+		case SSI_UINT: return &cast_generic<TIN, uint32_t>;
+		case SSI_LONG: return &cast_generic<TIN, int64_t>;
+		case SSI_ULONG: return &cast_generic<TIN, uint64_t>;
+		case SSI_FLOAT: return &cast_generic<TIN, float>;
+		case SSI_DOUBLE: return &cast_generic<TIN, double>;
+		case SSI_BOOL: return &cast_generic_bool<TIN>;
+		default: return 0;
+	}
+}
+
+ssi_cast_kernel_t TypeCast::Resolve (ssi_type_t type_in, ssi_type_t type_out) {
+
+	ssi_size_t features = GetCpuFeatures ();
+
+	if (type_in == SSI_SHORT && type_out == SSI_FLOAT) {
+#if defined(SSI_TYPECAST_X86)
+		if (features & AVX2) return &cast_short_float_avx2;
+		if (features & SSE41) return &cast_short_float_sse41;
+#elif defined(SSI_TYPECAST_NEON)
+		if (features & NEON) return &cast_short_float_neon;
+#endif
+	} else if (type_in == SSI_UCHAR && type_out == SSI_FLOAT) {
+#if defined(SSI_TYPECAST_X86)
+		if (features & AVX2) return &cast_uchar_float_avx2;
+		if (features & SSE41) return &cast_uchar_float_sse41;
+#elif defined(SSI_TYPECAST_NEON)
+		if (features & NEON) return &cast_uchar_float_neon;
+#endif
+	} else if (type_in == SSI_FLOAT && type_out == SSI_SHORT) {
+#if defined(SSI_TYPECAST_X86)
+		if (features & AVX2) return &cast_float_short_avx2;
+		if (features & SSE2) return &cast_float_short_sse2;
+#elif defined(SSI_TYPECAST_NEON)
+		if (features & NEON) return &cast_float_short_neon;
+#endif
+		return &cast_float_short;
+	} else if (type_in == SSI_FLOAT && type_out == SSI_DOUBLE) {
+#if defined(SSI_TYPECAST_X86)
+		if (features & AVX2) return &cast_float_double_avx2;
+		if (features & SSE2) return &cast_float_double_sse2;
+#endif
+	} else if (type_in == SSI_DOUBLE && type_out == SSI_FLOAT) {
+#if defined(SSI_TYPECAST_X86)
+		if (features & AVX2) return &cast_double_float_avx2;
+		if (features & SSE2) return &cast_double_float_sse2;
+#endif
+	}
+
+	switch (type_in) {
+		case SSI_CHAR: return resolve_generic<ssi_char_t> (type_out);
+		case SSI_UCHAR: return resolve_generic<ssi_uchar_t> (type_out);
+		case SSI_SHORT: return resolve_generic<int16_t> (type_out);
+		case SSI_USHORT: return resolve_generic<uint16_t> (type_out);
+		case SSI_INT: return resolve_generic<int32_t> (type_out);
+		case SSI_UINT: return resolve_generic<uint32_t> (type_out);
+		case SSI_LONG: return resolve_generic<int64_t> (type_out);
+		case SSI_ULONG: return resolve_generic<uint64_t> (type_out);
+		case SSI_FLOAT: return resolve_generic<float> (type_out);
+		case SSI_DOUBLE: return resolve_generic<double> (type_out);
+		case SSI_BOOL: return resolve_generic<bool> (type_out);
+		default: return 0;
+	}
+}
+
+void TypeCast::Cast (ssi_size_t n, const void *in, void *out, ssi_type_t type_in, ssi_type_t type_out, ssi_real_t scale) {
+
+	ssi_cast_kernel_t kernel = Resolve (type_in, type_out);
+	if (!kernel) {
+		ssi_err ("unsupported sample type");
+	}
+
+	kernel (n, in, out, scale);
+}
+
+}
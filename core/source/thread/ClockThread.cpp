@@ -41,34 +41,73 @@ ssi_char_t *ClockThread::ssi_log_name = "tthread___";
 int ClockThread::ssi_log_level = SSI_LOG_LEVEL_DEFAULT;
 
 ClockThread::ClockThread (ssi_size_t timeout)
-	: Thread(false, timeout) {
+	: Thread(false, timeout),
+	_period (1.0),
+	_id (TimerService::INVALID_ID) {
 }
 
 ClockThread::~ClockThread() {
+
+	if (_id != TimerService::INVALID_ID) {
+		TimerService::GetShared ()->remove (_id);
+		_id = TimerService::INVALID_ID;
+	}
+}
+
+bool ClockThread::start () {
+
+	if (_id != TimerService::INVALID_ID) {
+		ssi_wrn ("already started '%s'", Thread::getName ());
+		return false;
+	}
+
+	// may still set the clock
+	enter ();
+
+	// missed ticks are caught up, so a sensor provides the expected number of samples
+	_id = TimerService::GetShared ()->add (Thread::getName (), _period, Tick, this, true);
+
+	return true;
+}
+
+bool ClockThread::stop () {
+
+	if (_id == TimerService::INVALID_ID) {
+		return false;
+	}
+
+	terminate ();
+	TimerService::GetShared ()->remove (_id);
+	_id = TimerService::INVALID_ID;
+	flush ();
+
+	return true;
 }
 
 void ClockThread::setClockS(ssi_time_t seconds) {
 
-	_timer.setClockS(seconds);
+	_period = seconds;
 }
 
 void ClockThread::setClockMs(ssi_size_t milliseconds) {
 
-	_timer.setClockMs(milliseconds);
+	_period = milliseconds / 1000.0;
 }
 
 void ClockThread::setClockHz(ssi_time_t hz) {
 
-	_timer.setClockHz(hz);
+	_period = 1.0 / hz;
+}
+
+void ClockThread::Tick (void *arg) {
+
+	ssi_pcast (ClockThread, arg)->clock ();
 }
 
 void ClockThread::run() {
 
-	if (isFirstCycle()) {
-		_timer.reset();		
-	}
+	// not used, clock () is called by the timer service
 	clock();
-	_timer.wait();
 }
 
 }
@@ -25,6 +25,7 @@
 //*************************************************************************************************
 
 #include "thread/Condition.h"
+#include "thread/Timer.h"
 
 #ifdef USE_SSI_LEAK_DETECTOR
 	#include "SSI_LeakWatcher.h"
@@ -81,6 +82,29 @@ void Condition::wait (Mutex *mutex) {
 
 #else
 
+	waitEvents (mutex, INFINITE);
+
+#endif
+}
+
+// wait for condition until deadline
+bool Condition::wait (Mutex *mutex, int64_t deadline) {
+
+#if hasCXX11threads
+
+	return cond_var.wait_until (*mutex, std::chrono::steady_clock::time_point (std::chrono::microseconds (deadline))) == std::cv_status::no_timeout;
+
+#else
+
+	int64_t now = Timer::Now ();
+	return waitEvents (mutex, now < deadline ? ssi_cast (DWORD, (deadline - now + 999) / 1000) : 0);
+
+#endif
+}
+
+#if !hasCXX11threads
+bool Condition::waitEvents (Mutex *mutex, DWORD timeout) {
+
 // Avoid race conditions.
 	waiters_count_mutex.acquire ();
 	waiters_count++;
@@ -94,7 +118,7 @@ void Condition::wait (Mutex *mutex) {
 	int result = ::WaitForMultipleObjects (2, // Wait on both events
 		(HANDLE *) events, // events
 		FALSE, // Wait for either event to be signaled
-		INFINITE); // Wait "forever"
+		timeout);
 
 
 	waiters_count_mutex.acquire ();
@@ -107,11 +131,12 @@ void Condition::wait (Mutex *mutex) {
 		// We're the last waiter to be notified or to stop waiting, so
 		// reset the manual event.
 		::ResetEvent ((HANDLE) events[Condition::BROADCAST]);
-// hasCXX11threads
 	// Reacquire the <external_mutex>.
 	mutex->acquire ();
-#endif
+
+	return result != WAIT_TIMEOUT;
 }
+#endif
 
 
 
@@ -28,11 +28,11 @@
 
 #if __gnu_linux__
 #include <ctime>
-#include <stdint.h>
+#include <cerrno>
+#endif
+#if hasCXX11threads
 #include <chrono>
 #include <thread>
-#include <iostream>
-#include <fstream>
 #endif
 
 #ifdef USE_SSI_LEAK_DETECTOR
@@ -117,45 +117,48 @@ void Timer::setClockHz(ssi_time_t hz) {
 }
 
 void Timer::reset() {
-#if _WIN32|_WIN64
-	_init = ::timeGetTime();
-#else
-	uint32_t ms=0;
-	timespec ts;
-	clock_gettime (CLOCK_MONOTONIC_RAW, &ts);
-	ms= ts.tv_sec*1000+ (uint32_t)(ts.tv_nsec/1000000);
-	_init =ms;
 
-#endif
+	_init = Now ();
+	_next = _delta;
 }
 
 void Timer::wait () {
-#if _WIN32|_WIN64
-	_now = ::timeGetTime () - _init;
-	ssi_size_t next_ms = ssi_cast (DWORD, 1000.0*_next + 0.5);
-	if (_now < next_ms) {
-		::Sleep (next_ms - _now);
-	}
+
+	// absolute deadlines, so the error does not accumulate
+	SleepUntil (_init + ssi_cast (int64_t, 1000000.0 * _next + 0.5));
 	_next += _delta;
-#else
-	uint64_t ms=0;
-	timespec ts;
-	clock_gettime (CLOCK_MONOTONIC_RAW, &ts);
-	
+}
 
-	
-	ms= ts.tv_sec*1000+ (uint64_t)(ts.tv_nsec/1000000L);
-	_now=ms - _init;
-	ssi_size_t next_ms=1000.0*_next + 0.5;
-	
+int64_t Timer::Now () {
 
-	
-	if (_now < next_ms) {
-		
-		std::this_thread::sleep_for(std::chrono::milliseconds(next_ms - _now));
-		}
-	_next += _delta;
+#if hasCXX11threads
+	return std::chrono::duration_cast<std::chrono::microseconds> (std::chrono::steady_clock::now ().time_since_epoch ()).count ();
+#else
+	static LARGE_INTEGER frequency = { 0 };
+	if (frequency.QuadPart == 0) {
+		::QueryPerformanceFrequency (&frequency);
+	}
+	LARGE_INTEGER counter;
+	::QueryPerformanceCounter (&counter);
+	return ssi_cast (int64_t, (counter.QuadPart / frequency.QuadPart) * 1000000 + ((counter.QuadPart % frequency.QuadPart) * 1000000) / frequency.QuadPart);
+#endif
+}
+
+void Timer::SleepUntil (int64_t deadline) {
 
+#if __gnu_linux__
+	// steady_clock is CLOCK_MONOTONIC
+	timespec ts;
+	ts.tv_sec = ssi_cast (time_t, deadline / 1000000);
+	ts.tv_nsec = ssi_cast (long, (deadline % 1000000) * 1000);
+	while (clock_nanosleep (CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, 0) == EINTR);
+#elif hasCXX11threads
+	std::this_thread::sleep_until (std::chrono::steady_clock::time_point (std::chrono::microseconds (deadline)));
+#else
+	int64_t now = Now ();
+	if (now < deadline) {
+		::Sleep (ssi_cast (DWORD, (deadline - now + 500) / 1000));
+	}
 #endif
 }
 
@@ -0,0 +1,245 @@
+// TimerService.cpp
+// created: 2026/10/19
+// Copyright (C) University of Augsburg, Lab for Human Centered Multimedia
+//
+// *************************************************************************************************
+//
+// This file is part of Social Signal Interpretation (SSI) developed at the
+// Lab for Human Centered Multimedia of the University of Augsburg
+//
+// This library is free software; you can redistribute itand/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 3 of the License, or any laterversion.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FORA PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along withthis library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+//
+//*************************************************************************************************
+
+#include "thread/TimerService.h"
+#include "thread/Timer.h"
+#include "thread/Lock.h"
+
+#ifdef USE_SSI_LEAK_DETECTOR
+	#include "SSI_LeakWatcher.h"
+	#ifdef _DEBUG
+		#define new DEBUG_NEW
+		#undef THIS_FILE
+		static char THIS_FILE[] = __FILE__;
+	#endif
+#endif
+
+namespace ssi {
+
+ssi_char_t *TimerService::ssi_log_name = "timerserv_";
+int TimerService::ssi_log_level = SSI_LOG_LEVEL_DEFAULT;
+
+TimerService *TimerService::_shared = 0;
+Mutex TimerService::_shared_mutex;
+
+TimerService::TimerService (const ssi_char_t *name)
+	: _stop (false),
+	_next_id (0),
+	_running (INVALID_ID) {
+
+	_name = ssi_strcpy (name);
+
+	_worker.setName (_name);
+	_worker.set (this);
+	_worker.start ();
+}
+
+TimerService::~TimerService () {
+
+	{
+		Lock lock (_mutex);
+		_stop = true;
+		_wake.wakeAll ();
+	}
+
+	_worker.stop ();
+
+	for (size_t i = 0; i < _entries.size (); i++) {
+		delete[] _entries[i]->name;
+		delete _entries[i];
+	}
+	_entries.clear ();
+
+	delete[] _name;
+}
+
+TimerService *TimerService::GetShared () {
+
+	Lock lock (_shared_mutex);
+
+	if (!_shared) {
+		_shared = new TimerService ("timerservice");
+	}
+
+	return _shared;
+}
+
+void TimerService::ReleaseShared () {
+
+	Lock lock (_shared_mutex);
+
+	delete _shared;
+	_shared = 0;
+}
+
+ssi_size_t TimerService::add (const ssi_char_t *name, ssi_time_t period, callback_t callback, void *arg, bool catchup) {
+
+	entry_t *entry = new entry_t;
+	entry->name = ssi_strcpy (name);
+	entry->period = ssi_cast (int64_t, period * 1000000.0 + 0.5);
+	if (entry->period < 1) {
+		entry->period = 1;
+	}
+	entry->deadline = Timer::Now ();
+	entry->callback = callback;
+	entry->arg = arg;
+	entry->catchup = catchup;
+	entry->n_calls = 0;
+	entry->n_skipped = 0;
+	entry->delay_sum = 0;
+	entry->delay_max = 0;
+
+	Lock lock (_mutex);
+
+	entry->id = _next_id++;
+	_entries.push_back (entry);
+	_wake.wakeAll ();
+
+	ssi_msg (SSI_LOG_LEVEL_DETAIL, "add '%s' (%.3lfs)", entry->name, period);
+
+	return entry->id;
+}
+
+void TimerService::remove (ssi_size_t id) {
+
+	Lock lock (_mutex);
+
+	while (_running == id) {
+		_done.wait (&_mutex);
+	}
+
+	for (size_t i = 0; i < _entries.size (); i++) {
+		if (_entries[i]->id == id) {
+			entry_t *entry = _entries[i];
+			_entries.erase (_entries.begin () + i);
+			if (ssi_log_level >= SSI_LOG_LEVEL_DETAIL) {
+				print (ssiout, entry);
+			}
+			delete[] entry->name;
+			delete entry;
+			break;
+		}
+	}
+
+	_wake.wakeAll ();
+}
+
+ssi_size_t TimerService::size () {
+
+	Lock lock (_mutex);
+
+	return ssi_cast (ssi_size_t, _entries.size ());
+}
+
+TimerService::entry_t *TimerService::next () {
+
+	entry_t *result = 0;
+	for (size_t i = 0; i < _entries.size (); i++) {
+		if (!result || _entries[i]->deadline < result->deadline) {
+			result = _entries[i];
+		}
+	}
+
+	return result;
+}
+
+void TimerService::work () {
+
+	while (!_stop) {
+
+		entry_t *entry = next ();
+		if (!entry) {
+			_wake.wait (&_mutex);
+			continue;
+		}
+
+		// wait for deadline, or until an entry is added or removed
+		int64_t now = Timer::Now ();
+		if (now < entry->deadline) {
+			_wake.wait (&_mutex, entry->deadline);
+			continue;
+		}
+
+		_running = entry->id;
+		_mutex.release ();
+		entry->callback (entry->arg);
+		_mutex.acquire ();
+		_running = INVALID_ID;
+
+		int64_t delay = now - entry->deadline;
+		entry->n_calls++;
+		entry->delay_sum += delay;
+		if (delay > entry->delay_max) {
+			entry->delay_max = delay;
+		}
+
+		// skip ticks that have already passed
+		entry->deadline += entry->period;
+		now = Timer::Now ();
+		if (!entry->catchup && entry->deadline <= now) {
+			int64_t n = (now - entry->deadline) / entry->period + 1;
+			entry->n_skipped += ssi_cast (ssi_size_t, n);
+			entry->deadline += n * entry->period;
+		}
+
+		_done.wakeAll ();
+	}
+}
+
+void TimerService::print (FILE *file) {
+
+	Lock lock (_mutex);
+
+	ssi_fprint (file, "#   calls\tskipped\tdelay (mean/max in us)\tname\n");
+	for (size_t i = 0; i < _entries.size (); i++) {
+		ssi_fprint (file, "%03u ", ssi_cast (ssi_size_t, i));
+		print (file, _entries[i]);
+	}
+}
+
+void TimerService::print (FILE *file, entry_t *entry) {
+
+	ssi_fprint (file, "%u\t%u\t%.1lf/%.1lf\t%s\n",
+		entry->n_calls,
+		entry->n_skipped,
+		entry->n_calls > 0 ? ssi_cast (double, entry->delay_sum) / entry->n_calls : 0.0,
+		ssi_cast (double, entry->delay_max),
+		entry->name);
+}
+
+TimerService::Worker::Worker ()
+	: Thread (true),
+	_service (0) {
+}
+
+void TimerService::Worker::run () {
+
+	// single execution, the loop ends when the service is destroyed
+	_service->_mutex.acquire ();
+	_service->work ();
+	_service->_mutex.release ();
+}
+
+}
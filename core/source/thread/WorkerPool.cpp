@@ -0,0 +1,214 @@
+// WorkerPool.cpp
+// created: 2026/10/19
+// Copyright (C) University of Augsburg, Lab for Human Centered Multimedia
+//
+// *************************************************************************************************
+//
+// This file is part of Social Signal Interpretation (SSI) developed at the
+// Lab for Human Centered Multimedia of the University of Augsburg
+//
+// This library is free software; you can redistribute itand/or
+// modify it under the terms of the GNU Lesser General Public
+// License as published by the Free Software Foundation; either
+// version 3 of the License, or any laterversion.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FORA PARTICULAR PURPOSE.  See the GNU
+// Lesser General Public License for more details.
+//
+// You should have received a copy of the GNU Lesser General Public
+// License along withthis library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+//
+//*************************************************************************************************
+
+#include "thread/WorkerPool.h"
+#include "thread/Lock.h"
+
+#if hasCXX11threads
+	#include <thread>
+#endif
+
+#ifdef USE_SSI_LEAK_DETECTOR
+	#include "SSI_LeakWatcher.h"
+	#ifdef _DEBUG
+		#define new DEBUG_NEW
+		#undef THIS_FILE
+		static char THIS_FILE[] = __FILE__;
+	#endif
+#endif
+
+namespace ssi {
+
+ssi_char_t *WorkerPool::ssi_log_name = "workerpool";
+int WorkerPool::ssi_log_level = SSI_LOG_LEVEL_DEFAULT;
+
+WorkerPool *WorkerPool::_shared = 0;
+Mutex WorkerPool::_shared_mutex;
+
+WorkerPool::WorkerPool (const ssi_char_t *name,
+	ssi_size_t n_threads)
+	: _n_worker (0),
+	_worker (0),
+	_stop (false),
+	_task (0),
+	_arg (0),
+	_n (0),
+	_next (0),
+	_finished (0) {
+
+	_name = ssi_strcpy (name);
+
+	if (n_threads == 0) {
+		n_threads = GetNumberOfCores ();
+	}
+	_n_worker = n_threads > 1 ? n_threads - 1 : 0;
+
+	if (_n_worker > 0) {
+		_worker = new Worker[_n_worker];
+		ssi_char_t string[SSI_MAX_CHAR];
+		for (ssi_size_t i = 0; i < _n_worker; i++) {
+			ssi_sprint (string, "%s#%02u", _name, i);
+			_worker[i].setName (string);
+			_worker[i].set (this);
+			_worker[i].start ();
+		}
+	}
+
+	ssi_msg (SSI_LOG_LEVEL_DETAIL, "started %u worker '%s'", _n_worker, _name);
+}
+
+WorkerPool::~WorkerPool () {
+
+	{
+		Lock lock (_mutex);
+		_stop = true;
+		_wake.wakeAll ();
+	}
+
+	for (ssi_size_t i = 0; i < _n_worker; i++) {
+		_worker[i].stop ();
+	}
+
+	delete[] _worker;
+	delete[] _name;
+}
+
+ssi_size_t WorkerPool::GetNumberOfCores () {
+
+	ssi_size_t n = 0;
+
+#if hasCXX11threads
+	n = ssi_cast (ssi_size_t, std::thread::hardware_concurrency ());
+#else
+	SYSTEM_INFO info;
+	::GetSystemInfo (&info);
+	n = ssi_cast (ssi_size_t, info.dwNumberOfProcessors);
+#endif
+
+	return n > 0 ? n : 1;
+}
+
+WorkerPool *WorkerPool::GetShared () {
+
+	Lock lock (_shared_mutex);
+
+	if (!_shared) {
+		_shared = new WorkerPool ("shared");
+	}
+
+	return _shared;
+}
+
+void WorkerPool::ReleaseShared () {
+
+	Lock lock (_shared_mutex);
+
+	delete _shared;
+	_shared = 0;
+}
+
+void WorkerPool::run (ssi_size_t n, task_t task, void *arg) {
+
+	if (n == 0) {
+		return;
+	}
+
+	// nested calls and calls while the pool is busy run on the calling thread
+	bool busy = _n_worker == 0 || n == 1;
+	if (!busy) {
+		_mutex.acquire ();
+		busy = _n > 0;
+		if (busy) {
+			_mutex.release ();
+		}
+	}
+	if (busy) {
+		for (ssi_size_t i = 0; i < n; i++) {
+			task (i, arg);
+		}
+		return;
+	}
+
+	_task = task;
+	_arg = arg;
+	_n = n;
+	_next = 0;
+	_finished = 0;
+	_wake.wakeAll ();
+
+	work ();
+
+	while (_finished < _n) {
+		_done.wait (&_mutex);
+	}
+
+	_n = 0;
+	_next = 0;
+	_task = 0;
+	_arg = 0;
+
+	_mutex.release ();
+}
+
+void WorkerPool::work () {
+
+	while (_next < _n) {
+
+		ssi_size_t index = _next++;
+		task_t task = _task;
+		void *arg = _arg;
+
+		_mutex.release ();
+		task (index, arg);
+		_mutex.acquire ();
+
+		if (++_finished == _n) {
+			_done.wakeAll ();
+		}
+	}
+}
+
+WorkerPool::Worker::Worker ()
+	: Thread (true),
+	_pool (0) {
+}
+
+void WorkerPool::Worker::run () {
+
+	// single execution, the loop ends when the pool is destroyed
+	_pool->_mutex.acquire ();
+	for (;;) {
+		while (!_pool->_stop && _pool->_next >= _pool->_n) {
+			_pool->_wake.wait (&_pool->_mutex);
+		}
+		if (_pool->_stop) {
+			break;
+		}
+		_pool->work ();
+	}
+	_pool->_mutex.release ();
+}
+
+}
@@ -26,6 +26,7 @@
 
 #include "ioput/example/Exsemble.h"
 #include "thread/ThreadPool.h"
+#include "thread/TimerService.h"
 using namespace ssi;
 
 #include "TalkingThread.h"
@@ -57,6 +58,7 @@ bool ex_tthread(void *arg);
 bool ex_trigger(void *arg);
 bool ex_queue(void *arg);
 bool ex_pool(void *arg);
+bool ex_service(void *arg);
 
 int main () {
 
@@ -78,6 +80,7 @@ int main () {
 	ex.add(&ex_trigger, 0, "TRIGGER", "Trigger-listener example.");
 	ex.add(&ex_queue, 0, "QUEUE", "How to use a thread-safe queue.");
 	ex.add(&ex_pool, 0, "POOL", "How to execute a pool of parallel jobs.");
+	ex.add(&ex_service, 0, "SERVICE", "How to register periodic callbacks with the timer service.");
 	ex.show();
 
 #ifdef USE_SSI_LEAK_DETECTOR
@@ -304,3 +307,31 @@ bool ex_pool (void *arg) {
 
 	return true;
 }
+
+void service_tick (void *arg) {
+
+	ssi_size_t *counter = ssi_pcast (ssi_size_t, arg);
+	++*counter;
+}
+
+bool ex_service (void *arg) {
+
+	TimerService *service = TimerService::GetShared ();
+
+	ssi_size_t counter[3] = { 0, 0, 0 };
+	ssi_size_t id[3];
+	id[0] = service->add ("1ms", 0.001, service_tick, &counter[0]);
+	id[1] = service->add ("10ms", 0.01, service_tick, &counter[1]);
+	id[2] = service->add ("100ms", 0.1, service_tick, &counter[2]);
+
+	ssi_print ("\n\n\tpress enter to stop callbacks\n\n");
+	getchar ();
+
+	service->print ();
+	for (ssi_size_t i = 0; i < 3; i++) {
+		service->remove (id[i]);
+	}
+	TimerService::ReleaseShared ();
+
+	return true;
+}
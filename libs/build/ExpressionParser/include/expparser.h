@@ -25,6 +25,7 @@
  *     Other:
  *        Scientific notation supported
  *         Error handling supported
+ *         Expressions can be compiled once and evaluated for many values
  *
  * @license
  * Licensed under the Apache License, Version 2.0 (the "License"); you may not
@@ -70,6 +71,7 @@
 #include "error.h"
 #include "functions.h"
 #include "variablelist.h"
+#include "expprogram.h"
 
 class ExpParser
 {
@@ -78,6 +80,12 @@ class ExpParser
         ExpParser();
         char* parse(const char expr[], double &result);
 
+        // returns the slot a variable is bound to or -1 if it is not a slot
+        typedef int (*slotproc)(const char name[], void *param);
+
+        // compiles the given expression, assignments are not supported
+        char* compile(const char expr[], ExpProgram &program, slotproc resolve = 0, void *param = 0);
+
     // enumerations
     private:
 
@@ -104,6 +112,18 @@ class ExpParser
 
         Variablelist user_var;        // list with variables defined by user
 
+        struct NODE                   // node of a compiled expression
+        {
+            int opcode;
+            int id;
+            double value;
+            int lhs;
+            int rhs;
+        };
+        std::vector<NODE> nodes;
+        slotproc resolve;
+        void *resolve_param;
+
     // private functions
     private:
         void getToken();
@@ -120,6 +140,20 @@ class ExpParser
         double parse_level10();
         double parse_number();
 
+        int compile_level2();
+        int compile_level3();
+        int compile_level4();
+        int compile_level5();
+        int compile_level6();
+        int compile_level7();
+        int compile_level8();
+        int compile_level9();
+        int compile_level10();
+        int compile_number();
+        int add_node(const int opcode, const int id, const double value, const int lhs = -1, const int rhs = -1);
+        void emit_node(ExpProgram &program, const int node, const int depth);
+        int get_function_id(const char fn_name[]);
+
         int get_operator_id(const char op_name[]);
         double eval_operator(const int op_id, const double &lhs, const double &rhs);
         double eval_function(const char fn_name[], const double &value);
@@ -0,0 +1,90 @@
+/**
+ * @file expprogram.h
+ *
+ * @brief
+ * Compiled form of an expression, see ExpParser::compile.
+ *
+ * Variables are bound to slots when compiling. Each slot points to an array
+ * of values and the program is evaluated for all entries at once, operating
+ * on blocks of values so that the inner loops can be vectorized.
+ *
+ * @license
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy
+ * of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+
+#ifndef EXPPROGRAM_H
+#define EXPPROGRAM_H
+
+#include <vector>
+
+class ExpProgram
+{
+    friend class ExpParser;
+
+    // public functions
+    public:
+        ExpProgram();
+
+        void clear();
+        int get_n_slots() const {return n_slots;}
+        bool is_constant(double *value) const;
+
+        // evaluates n values, slots[i] points to n values of slot i,
+        // returns an error message or 0
+        char* eval(int n, const double * const slots[], double result[]);
+
+    // enumerations
+    public:
+
+        enum OPCODE {CONSTANT, SLOT, NEGATE, OPERATOR, FUNCTION};
+
+        // same order as in ExpParser
+        enum OPERATOR_ID {AND, OR, BITSHIFTLEFT, BITSHIFTRIGHT,
+                       EQUAL, UNEQUAL, SMALLER, LARGER, SMALLEREQ, LARGEREQ,
+                       PLUS, MINUS,
+                       MULTIPLY, DIVIDE, MODULUS, XOR,
+                       POW,
+                       FACTORIAL};
+
+        enum FUNCTION_ID {ABS, EXP, SIGN, SQRT, LOG, LOG10,
+                       SIN, COS, TAN, ASIN, ACOS, ATAN,
+                       FACT};
+
+        static double eval_operator(const int op_id, const double lhs, const double rhs);
+        static double eval_function(const int fn_id, const double value);
+
+    // data
+    private:
+        static const int BLOCK_SIZE = 256;
+
+        struct INSTRUCTION
+        {
+            int opcode;
+            int id;
+            double value;
+        };
+
+        std::vector<INSTRUCTION> code;
+        int n_slots;
+        int depth_max;
+
+        std::vector<double> stack;
+        char err_str[255];
+
+    // private functions
+    private:
+        void emit(const int opcode, const int id, const double value, const int depth);
+};
+
+#endif
@@ -43,6 +43,9 @@ ExpParser::ExpParser()
 
     token[0] = '\0';
     token_type = NOTHING;
+
+    resolve = 0;
+    resolve_param = 0;
 }
 
 
@@ -109,6 +112,69 @@ char* ExpParser::parse(const char new_expr[], double &result)
 }
 
 
+/**
+ * compiles the given expression into a program.
+ * constant sub expressions are evaluated at compile time, variables
+ * are bound to slots by the resolve function.
+ * returns an error message or 0 on success
+ */
+char* ExpParser::compile(const char new_expr[], ExpProgram &program, slotproc new_resolve, void *param)
+{
+    program.clear();
+    nodes.clear();
+    resolve = new_resolve;
+    resolve_param = param;
+
+    try
+    {
+        if ((int)strlen(new_expr) > EXPR_LEN_MAX)
+        {
+            throw Error(row(), col(), 200);
+        }
+
+        strncpy(expr, new_expr, EXPR_LEN_MAX - 1);
+        e = expr;
+
+        getToken();
+        if (token_type == DELIMETER && *token == '\0')
+        {
+            throw Error(row(), col(), 4);
+        }
+
+        int root = compile_level2();
+
+        if (token_type != DELIMETER || *token != '\0')
+        {
+            if (token_type == DELIMETER)
+            {
+                throw Error(row(), col(), 101, token);
+            }
+            else
+            {
+                throw Error(row(), col(), 5, token);
+            }
+        }
+
+        emit_node(program, root, 0);
+    }
+    catch (Error err)
+    {
+        program.clear();
+        if (err.get_row() == -1)
+        {
+            _snprintf(ans_str, sizeof(ans_str), "Error: %s (col %i)", err.get_msg(), err.get_col());
+        }
+        else
+        {
+            _snprintf(ans_str, sizeof(ans_str), "Error: %s (ln %i, col %i)", err.get_msg(), err.get_row(), err.get_col());
+        }
+        return ans_str;
+    }
+
+    return 0;
+}
+
+
 /*
  * checks if the given char c is a minus
  */
@@ -596,6 +662,290 @@ double ans = 0;
 }
 
 
+/*
+ * adds a node to the compiled expression, if all operands are constant
+ * the node is evaluated right away
+ */
+int ExpParser::add_node(const int opcode, const int id, const double value, const int lhs, const int rhs)
+{
+    NODE node = {opcode, id, value, lhs, rhs};
+
+    switch (opcode)
+    {
+        case ExpProgram::NEGATE:
+            if (nodes[lhs].opcode == ExpProgram::CONSTANT)
+            {
+                node.opcode = ExpProgram::CONSTANT;
+                node.value = -nodes[lhs].value;
+            }
+            break;
+        case ExpProgram::FUNCTION:
+            if (nodes[lhs].opcode == ExpProgram::CONSTANT)
+            {
+                node.opcode = ExpProgram::CONSTANT;
+                node.value = ExpProgram::eval_function(id, nodes[lhs].value);
+            }
+            break;
+        case ExpProgram::OPERATOR:
+            if (nodes[lhs].opcode == ExpProgram::CONSTANT && nodes[rhs].opcode == ExpProgram::CONSTANT)
+            {
+                node.opcode = ExpProgram::CONSTANT;
+                node.value = ExpProgram::eval_operator(id, nodes[lhs].value, nodes[rhs].value);
+            }
+            break;
+    }
+
+    if (node.opcode == ExpProgram::CONSTANT)
+    {
+        node.lhs = node.rhs = -1;
+    }
+
+    nodes.push_back(node);
+    return (int)nodes.size() - 1;
+}
+
+/*
+ * writes the instructions of a node in postfix order,
+ * depth is the size of the stack before the node is evaluated
+ */
+void ExpParser::emit_node(ExpProgram &program, const int index, const int depth)
+{
+    const NODE &node = nodes[index];
+
+    switch (node.opcode)
+    {
+        case ExpProgram::NEGATE:
+        case ExpProgram::FUNCTION:
+            emit_node(program, node.lhs, depth);
+            break;
+        case ExpProgram::OPERATOR:
+            emit_node(program, node.lhs, depth);
+            emit_node(program, node.rhs, depth + 1);
+            break;
+    }
+
+    program.emit(node.opcode, node.id, node.value, depth + 1);
+}
+
+int ExpParser::compile_level2()
+{
+    int op_id;
+    int node = compile_level3();
+
+    op_id = get_operator_id(token);
+    while (op_id == AND || op_id == OR || op_id == BITSHIFTLEFT || op_id == BITSHIFTRIGHT)
+    {
+        getToken();
+        int rhs = compile_level3();
+        node = add_node(ExpProgram::OPERATOR, op_id, 0, node, rhs);
+        op_id = get_operator_id(token);
+    }
+
+    return node;
+}
+
+int ExpParser::compile_level3()
+{
+    int op_id;
+    int node = compile_level4();
+
+    op_id = get_operator_id(token);
+    while (op_id == EQUAL || op_id == UNEQUAL || op_id == SMALLER || op_id == LARGER || op_id == SMALLEREQ || op_id == LARGEREQ)
+    {
+        getToken();
+        int rhs = compile_level4();
+        node = add_node(ExpProgram::OPERATOR, op_id, 0, node, rhs);
+        op_id = get_operator_id(token);
+    }
+
+    return node;
+}
+
+int ExpParser::compile_level4()
+{
+    int op_id;
+    int node = compile_level5();
+
+    op_id = get_operator_id(token);
+    while (op_id == PLUS || op_id == MINUS)
+    {
+        getToken();
+        int rhs = compile_level5();
+        node = add_node(ExpProgram::OPERATOR, op_id, 0, node, rhs);
+        op_id = get_operator_id(token);
+    }
+
+    return node;
+}
+
+int ExpParser::compile_level5()
+{
+    int op_id;
+    int node = compile_level6();
+
+    op_id = get_operator_id(token);
+    while (op_id == MULTIPLY || op_id == DIVIDE || op_id == MODULUS || op_id == XOR)
+    {
+        getToken();
+        int rhs = compile_level6();
+        node = add_node(ExpProgram::OPERATOR, op_id, 0, node, rhs);
+        op_id = get_operator_id(token);
+    }
+
+    return node;
+}
+
+int ExpParser::compile_level6()
+{
+    int op_id;
+    int node = compile_level7();
+
+    op_id = get_operator_id(token);
+    while (op_id == POW)
+    {
+        getToken();
+        int rhs = compile_level7();
+        node = add_node(ExpProgram::OPERATOR, op_id, 0, node, rhs);
+        op_id = get_operator_id(token);
+    }
+
+    return node;
+}
+
+int ExpParser::compile_level7()
+{
+    int op_id;
+    int node = compile_level8();
+
+    op_id = get_operator_id(token);
+    while (op_id == FACTORIAL)
+    {
+        getToken();
+        node = add_node(ExpProgram::FUNCTION, ExpProgram::FACT, 0, node);
+        op_id = get_operator_id(token);
+    }
+
+    return node;
+}
+
+int ExpParser::compile_level8()
+{
+    int op_id = get_operator_id(token);
+    if (op_id == MINUS)
+    {
+        getToken();
+        return add_node(ExpProgram::NEGATE, 0, 0, compile_level9());
+    }
+
+    return compile_level9();
+}
+
+int ExpParser::compile_level9()
+{
+    if (token_type == FUNCTION)
+    {
+        int fn_id = get_function_id(token);
+        if (fn_id == -1)
+        {
+            throw Error(row(), col(), 102, token);
+        }
+        getToken();
+        return add_node(ExpProgram::FUNCTION, fn_id, 0, compile_level10());
+    }
+
+    return compile_level10();
+}
+
+int ExpParser::compile_level10()
+{
+    if (token_type == DELIMETER)
+    {
+        if (token[0] == '(' && token[1] == '\0')
+        {
+            getToken();
+            int node = compile_level2();
+            if (token_type != DELIMETER || token[0] != ')' || token[1] || '\0')
+            {
+                throw Error(row(), col(), 3);
+            }
+            getToken();
+            return node;
+        }
+    }
+
+    return compile_number();
+}
+
+int ExpParser::compile_number()
+{
+    int node = -1;
+
+    switch (token_type)
+    {
+        case NUMBER:
+            node = add_node(ExpProgram::CONSTANT, 0, strtod(token, NULL));
+            getToken();
+            break;
+
+        case VARIABLE:
+        {
+            int slot = resolve ? resolve(token, resolve_param) : -1;
+            if (slot >= 0)
+            {
+                node = add_node(ExpProgram::SLOT, slot, 0);
+            }
+            else
+            {
+                node = add_node(ExpProgram::CONSTANT, 0, eval_variable(token));
+            }
+            getToken();
+            break;
+        }
+
+        default:
+            if (token[0] == '\0')
+            {
+                throw Error(row(), col(), 6);
+            }
+            else
+            {
+                throw Error(row(), col(), 7);
+            }
+            break;
+    }
+
+    return node;
+}
+
+/*
+ * returns the id of the given function
+ * returns -1 if the function is not recognized
+ */
+int ExpParser::get_function_id(const char fn_name[])
+{
+    char fnU[NAME_LEN_MAX+1];
+    toupper(fnU, fn_name);
+
+    if (!strcmp(fnU, "ABS")) {return ExpProgram::ABS;}
+    if (!strcmp(fnU, "EXP")) {return ExpProgram::EXP;}
+    if (!strcmp(fnU, "SIGN")) {return ExpProgram::SIGN;}
+    if (!strcmp(fnU, "SQRT")) {return ExpProgram::SQRT;}
+    if (!strcmp(fnU, "LOG")) {return ExpProgram::LOG;}
+    if (!strcmp(fnU, "LOG10")) {return ExpProgram::LOG10;}
+
+    if (!strcmp(fnU, "SIN")) {return ExpProgram::SIN;}
+    if (!strcmp(fnU, "COS")) {return ExpProgram::COS;}
+    if (!strcmp(fnU, "TAN")) {return ExpProgram::TAN;}
+    if (!strcmp(fnU, "ASIN")) {return ExpProgram::ASIN;}
+    if (!strcmp(fnU, "ACOS")) {return ExpProgram::ACOS;}
+    if (!strcmp(fnU, "ATAN")) {return ExpProgram::ATAN;}
+
+    if (!strcmp(fnU, "FACTORIAL")) {return ExpProgram::FACT;}
+
+    return -1;
+}
+
+
 /*
  * returns the id of the given operator
  * treturns -1 if the operator is not recognized
@@ -0,0 +1,230 @@
+/**
+ * @file expprogram.cpp
+ *
+ * @brief
+ * Compiled form of an expression. See the header file for more detailed explanation
+ *
+ * @license
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy
+ * of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied. See the
+ * License for the specific language governing permissions and limitations under
+ * the License.
+ */
+
+#include <cmath>
+#include <cstdio>
+
+#include "expprogram.h"
+#include "error.h"
+#include "functions.h"
+
+#if __gnu_linux__ || (defined(ANDROID)) || __APPLE__
+    #define _snprintf snprintf
+#endif
+
+ExpProgram::ExpProgram()
+{
+    n_slots = 0;
+    depth_max = 0;
+    err_str[0] = '\0';
+}
+
+void ExpProgram::clear()
+{
+    code.clear();
+    n_slots = 0;
+    depth_max = 0;
+}
+
+/*
+ * appends an instruction, depth is the stack size after it was executed
+ */
+void ExpProgram::emit(const int opcode, const int id, const double value, const int depth)
+{
+    INSTRUCTION ins;
+    ins.opcode = opcode;
+    ins.id = id;
+    ins.value = value;
+    code.push_back(ins);
+
+    if (opcode == SLOT && id + 1 > n_slots)
+    {
+        n_slots = id + 1;
+    }
+    if (depth > depth_max)
+    {
+        depth_max = depth;
+    }
+}
+
+/*
+ * returns true if the expression does not depend on any slot
+ */
+bool ExpProgram::is_constant(double *value) const
+{
+    if (code.size() == 1 && code[0].opcode == CONSTANT)
+    {
+        if (value)
+        {
+            *value = code[0].value;
+        }
+        return true;
+    }
+    return false;
+}
+
+double ExpProgram::eval_operator(const int op_id, const double lhs, const double rhs)
+{
+    switch (op_id)
+    {
+        case AND:           return static_cast<int>(lhs) & static_cast<int>(rhs);
+        case OR:            return static_cast<int>(lhs) | static_cast<int>(rhs);
+        case BITSHIFTLEFT:  return static_cast<int>(lhs) << static_cast<int>(rhs);
+        case BITSHIFTRIGHT: return static_cast<int>(lhs) >> static_cast<int>(rhs);
+
+        case EQUAL:     return lhs == rhs;
+        case UNEQUAL:   return lhs != rhs;
+        case SMALLER:   return lhs < rhs;
+        case LARGER:    return lhs > rhs;
+        case SMALLEREQ: return lhs <= rhs;
+        case LARGEREQ:  return lhs >= rhs;
+
+        case PLUS:      return lhs + rhs;
+        case MINUS:     return lhs - rhs;
+
+        case MULTIPLY:  return lhs * rhs;
+        case DIVIDE:    return lhs / rhs;
+        case MODULUS:   return static_cast<int>(lhs) % static_cast<int>(rhs);
+        case XOR:       return static_cast<int>(lhs) ^ static_cast<int>(rhs);
+
+        case POW:       return pow(lhs, rhs);
+
+        case FACTORIAL: return factorial(lhs);
+    }
+
+    throw Error(-1, -1, 104, op_id);
+    return 0;
+}
+
+double ExpProgram::eval_function(const int fn_id, const double value)
+{
+    switch (fn_id)
+    {
+        case ABS:   return fabs(value);
+        case EXP:   return exp(value);
+        case SIGN:  return sign(value);
+        case SQRT:  return sqrt(value);
+        case LOG:   return log(value);
+        case LOG10: return log10(value);
+
+        case SIN:   return sin(value);
+        case COS:   return cos(value);
+        case TAN:   return tan(value);
+        case ASIN:  return asin(value);
+        case ACOS:  return acos(value);
+        case ATAN:  return atan(value);
+
+        case FACT:  return factorial(value);
+    }
+
+    throw Error(-1, -1, 102, "?");
+    return 0;
+}
+
+/*
+ * evaluates the program for n values.
+ * each instruction is applied to a whole block before the next one is
+ * executed, the common operators are written as plain loops
+ */
+char* ExpProgram::eval(int n, const double * const slots[], double result[])
+{
+    if (code.empty())
+    {
+        _snprintf(err_str, sizeof(err_str), "Error: program is empty");
+        return err_str;
+    }
+
+    stack.resize(depth_max * BLOCK_SIZE);
+
+    try
+    {
+        for (int offset = 0; offset < n; offset += BLOCK_SIZE)
+        {
+            const int b = n - offset < BLOCK_SIZE ? n - offset : BLOCK_SIZE;
+            double *top = &stack[0] - BLOCK_SIZE;
+
+            for (size_t k = 0; k < code.size(); k++)
+            {
+                const INSTRUCTION &ins = code[k];
+
+                switch (ins.opcode)
+                {
+                    case CONSTANT:
+                    {
+                        top += BLOCK_SIZE;
+                        const double value = ins.value;
+                        for (int i = 0; i < b; i++) top[i] = value;
+                        break;
+                    }
+                    case SLOT:
+                    {
+                        top += BLOCK_SIZE;
+                        const double *src = slots[ins.id] + offset;
+                        for (int i = 0; i < b; i++) top[i] = src[i];
+                        break;
+                    }
+                    case NEGATE:
+                    {
+                        for (int i = 0; i < b; i++) top[i] = -top[i];
+                        break;
+                    }
+                    case FUNCTION:
+                    {
+                        switch (ins.id)
+                        {
+                            case ABS:  for (int i = 0; i < b; i++) top[i] = fabs(top[i]); break;
+                            case SQRT: for (int i = 0; i < b; i++) top[i] = sqrt(top[i]); break;
+                            case EXP:  for (int i = 0; i < b; i++) top[i] = exp(top[i]); break;
+                            case LOG:  for (int i = 0; i < b; i++) top[i] = log(top[i]); break;
+                            default:   for (int i = 0; i < b; i++) top[i] = eval_function(ins.id, top[i]); break;
+                        }
+                        break;
+                    }
+                    case OPERATOR:
+                    {
+                        const double *rhs = top;
+                        top -= BLOCK_SIZE;
+                        switch (ins.id)
+                        {
+                            case PLUS:     for (int i = 0; i < b; i++) top[i] += rhs[i]; break;
+                            case MINUS:    for (int i = 0; i < b; i++) top[i] -= rhs[i]; break;
+                            case MULTIPLY: for (int i = 0; i < b; i++) top[i] *= rhs[i]; break;
+                            case DIVIDE:   for (int i = 0; i < b; i++) top[i] /= rhs[i]; break;
+                            default:       for (int i = 0; i < b; i++) top[i] = eval_operator(ins.id, top[i], rhs[i]); break;
+                        }
+                        break;
+                    }
+                }
+            }
+
+            for (int i = 0; i < b; i++)
+            {
+                result[offset + i] = top[i];
+            }
+        }
+    }
+    catch (Error err)
+    {
+        _snprintf(err_str, sizeof(err_str), "Error: %s", err.get_msg());
+        return err_str;
+    }
+
+    return 0;
+}
@@ -45,7 +45,7 @@ public:
 	bool setSelection (ssi_size_t n_samples, 
 		const ssi_size_t *sset);
 
-	void reset () { _samples.reset (); _nset = 0; };//
+	void reset () { _nset = 0; };// samples are read through get (), so the iterator of the source is left alone
 	ssi_sample_t *get (ssi_size_t index);//
 	ssi_sample_t *next ();//
 
@@ -134,6 +134,11 @@ public:
 		ssi_stream_t **streams,
 		ssi_size_t class_num,
 		ssi_real_t *class_probs);
+	bool forward_batch (ssi_size_t n_samples,
+		ssi_size_t n_features,
+		ssi_real_t *features,
+		ssi_size_t class_num,
+		ssi_real_t *class_probs);
 	bool cluster (ISamples &samples);
 
 	void release ();
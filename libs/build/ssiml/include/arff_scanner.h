@@ -131,6 +131,16 @@ private:
     char m_prev_char;
     /** file pointer */
     FILE* m_fp;
+    /** size of the read-ahead buffer */
+    static const size_t BUFFER_SIZE = 1 << 16;
+    /** read-ahead buffer */
+    char* m_buffer;
+    /** position of the next character in the buffer */
+    size_t m_buffer_pos;
+    /** number of valid characters in the buffer */
+    size_t m_buffer_len;
+    /** whether reading past the end of the file was attempted */
+    bool m_eof;
 };
 
 }
@@ -92,6 +92,17 @@ void str2num(const std::string& str, T& num) {
     return;
 }
 
+/**
+ * @brief Faster versions for the types used by the parser, which do not
+ * construct a stream for each value
+ */
+template <>
+void str2num<float>(const std::string& str, float& num);
+template <>
+void str2num<double>(const std::string& str, double& num);
+template <>
+void str2num<int64>(const std::string& str, int64& num);
+
 
 /**
  * @brief Convert the input character to lower case
@@ -1103,6 +1103,101 @@ bool Trainer::forward_probs (ssi_size_t n_streams,
 	return result;
 }
 
+bool Trainer::forward_batch (ssi_size_t n_samples,
+	ssi_size_t n_features,
+	ssi_real_t *features,
+	ssi_size_t n_probs,
+	ssi_real_t *probs) {
+
+	if (!_is_trained) {
+		ssi_wrn ("not trained");
+		return false;
+	}
+
+	if (_fusion) {
+		ssi_wrn ("batch mode not supported for fusion");
+		return false;
+	}
+
+	if (n_samples == 0) {
+		return true;
+	}
+
+	ssi_stream_t &ref = _stream_refs[_stream_index];
+	if (!_preproc_mode && (ref.dim != n_features || ref.type != SSI_REAL)) {
+		ssi_wrn ("stream #%u not compatible", _stream_index);
+		return false;
+	}
+
+	// each row is wrapped into a single-sample stream which points into the matrix
+	ssi_stream_t row = ref;
+	row.num = row.num_real = 1;
+	row.dim = n_features;
+	row.byte = sizeof (ssi_real_t);
+	row.tot = row.tot_real = n_features * sizeof (ssi_real_t);
+	row.type = SSI_REAL;
+
+	if ((!_preproc_mode && _has_transformer && _transformer[_stream_index])
+		|| (_has_activity && _activity[_stream_index])) {
+
+		// transformers operate on sample streams, so fall back to single sample mode
+		if (_n_streams != 1) {
+			ssi_wrn ("batch mode not supported for multiple streams with transformer");
+			return false;
+		}
+
+		bool result = true;
+		for (ssi_size_t i = 0; i < n_samples && result; i++) {
+			row.ptr = ssi_pcast (ssi_byte_t, features + i * n_features);
+			result = forward_probs (row, n_probs, probs + i * n_probs);
+		}
+
+		return result;
+	}
+
+	ssi_size_t dim = n_features;
+	ssi_real_t *matrix = features;
+	ssi_real_t *matrix_s = 0;
+	ssi_real_t *matrix_n = 0;
+
+	if (_has_selection && _stream_select[_stream_index]) {
+		ssi_size_t n_select = _n_stream_select[_stream_index];
+		ssi_size_t *select = _stream_select[_stream_index];
+		matrix_s = new ssi_real_t[n_samples * n_select];
+		ssi_real_t *src = matrix;
+		ssi_real_t *dst = matrix_s;
+		for (ssi_size_t i = 0; i < n_samples; i++) {
+			for (ssi_size_t j = 0; j < n_select; j++) {
+				*dst++ = src[select[j]];
+			}
+			src += dim;
+		}
+		matrix = matrix_s;
+		dim = n_select;
+	}
+
+	if (_has_normalization && _normalization[_stream_index] && _normalization[_stream_index]->method != ISNorm::METHOD::NONE) {
+		if (!matrix_s) {
+			matrix_n = new ssi_real_t[n_samples * dim];
+			memcpy (matrix_n, matrix, n_samples * dim * sizeof (ssi_real_t));
+			matrix = matrix_n;
+		}
+		row.dim = dim;
+		row.tot = row.tot_real = dim * sizeof (ssi_real_t);
+		for (ssi_size_t i = 0; i < n_samples; i++) {
+			row.ptr = ssi_pcast (ssi_byte_t, matrix + i * dim);
+			ISNorm::Norm (row, *_normalization[_stream_index]);
+		}
+	}
+
+	bool result = _models[0]->forward_batch (n_samples, dim, matrix, n_probs, probs);
+
+	delete[] matrix_s;
+	delete[] matrix_n;
+
+	return result;
+}
+
 bool Trainer::Load (Trainer &trainer,
 	const ssi_char_t *filepath) {
 
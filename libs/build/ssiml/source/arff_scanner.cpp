@@ -40,11 +40,16 @@ ArffScanner::ArffScanner(const std::string& _file): m_file(_file),
                                             m_col((int64)0),
                                             m_char(NEWLINE),
                                             m_prev_char((char)0),
-                                            m_fp(NULL) {
+                                            m_fp(NULL),
+                                            m_buffer(NULL),
+                                            m_buffer_pos(0),
+                                            m_buffer_len(0),
+                                            m_eof(false) {
     m_fp = fopen(m_file.c_str(), "r");
     if(m_fp == NULL) {
         THROW("ArffScanner: failed to open the file '%s'!", m_file.c_str());
     }
+    m_buffer = new char[BUFFER_SIZE];
 }
 
 ArffScanner::~ArffScanner() {
@@ -52,6 +57,7 @@ ArffScanner::~ArffScanner() {
         fclose(m_fp);
         m_fp = NULL;
     }
+    delete[] m_buffer;
 }
 
 bool ArffScanner::is_newline(char c) const {
@@ -68,8 +74,16 @@ char ArffScanner::next() {
     }
     ++m_col;
     m_prev_char = m_char;
-    if(fread(&m_char, sizeof(m_char), 1, m_fp) != sizeof(m_char)) {
+    // read ahead in blocks instead of calling fread() per character
+    if(m_buffer_pos == m_buffer_len) {
+        m_buffer_len = fread(m_buffer, 1, BUFFER_SIZE, m_fp);
+        m_buffer_pos = 0;
+    }
+    if(m_buffer_pos < m_buffer_len) {
+        m_char = m_buffer[m_buffer_pos++];
+    } else {
         m_char = (char)-1;  // you would have reached end-of-file?
+        m_eof = true;
     }
     return m_char;
 }
@@ -91,7 +105,7 @@ int64 ArffScanner::column() const {
 }
 
 bool ArffScanner::eof() const {
-    return feof(m_fp) != 0;
+    return m_eof;
 }
 
 std::string ArffScanner::err_msg(const std::string& msg) const {
@@ -31,6 +31,7 @@
 #include <stdexcept>
 
 #include "arff_utils.h"
+#include "ioput/file/AsciiNumber.h"
 
 namespace ssi {
 
@@ -49,6 +50,35 @@ void throw_ex(const char* file, int64 line, const char* fmt, ...) {
 }
 #undef STR_LENGTH
 
+template <typename T>
+static void str2num_ascii(const std::string& str, T& num) {
+    const char* ptr = str.c_str();
+    const char* end = ptr + str.size();
+    while(ptr < end && isspace((unsigned char)*ptr)) {
+        ++ptr;
+    }
+    if(!AsciiNumber::Parse(ptr, end, num)) {
+        THROW("(str2num) Input '%s' is not a number!", str.c_str());
+    }
+}
+
+template <>
+void str2num<float>(const std::string& str, float& num) {
+    str2num_ascii<float>(str, num);
+}
+
+template <>
+void str2num<double>(const std::string& str, double& num) {
+    str2num_ascii<double>(str, num);
+}
+
+template <>
+void str2num<int64>(const std::string& str, int64& num) {
+    int64_t value;
+    str2num_ascii<int64_t>(str, value);
+    num = value;
+}
+
 char to_lower(char c) {
     if((c >= 'A') && (c <= 'Z')) {
         return ((c - 'A') + 'a');
@@ -31,6 +31,7 @@
 
 #include "base/IFilter.h"
 #include "ioput/option/OptionList.h"
+#include "signal/TypeCast.h"
 
 namespace ssi {
 
@@ -56,6 +57,8 @@ public:
 	const ssi_char_t *getName () { return GetCreateName (); };
 	const ssi_char_t *getInfo () { return "Converts audio signal from shorts to floats or vice versa."; };
 
+	bool isSampleWise () { return true; };
+
 	void transform_enter (ssi_stream_t &stream_in,
 		ssi_stream_t &stream_out,
 		ssi_size_t xtra_stream_in_num = 0,
@@ -108,7 +111,8 @@ protected:
 	AudioConvert::Options _options;
 	ssi_char_t *_file;
 
-	bool _short_to_float;
+	ssi_cast_kernel_t _kernel;
+	ssi_real_t _scale;
 };
 
 }
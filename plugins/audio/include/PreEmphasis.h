@@ -63,6 +63,8 @@ public:
 	const ssi_char_t *getName () { return GetCreateName (); };
 	const ssi_char_t *getInfo () { return "This component performs pre- and de-emphasis of speech signals using a 1st order difference equation: y(t) = x(t) - k*x(t-1)  (de-emphasis: y(t) = x(t) + k*x(t-1))."; };
 
+	bool isSampleWise () { return true; };
+
 	void transform_enter (ssi_stream_t &stream_in,
 		ssi_stream_t &stream_out,
 		ssi_size_t xtra_stream_in_num = 0,
@@ -40,7 +40,8 @@ namespace ssi {
 
 AudioConvert::AudioConvert (const ssi_char_t *file)
 	: _file (0),
-	_short_to_float (false) {
+	_kernel (0),
+	_scale (1.0f) {
 
 	if (file) {
 
@@ -65,7 +66,9 @@ void AudioConvert::transform_enter (ssi_stream_t &stream_in,
 	ssi_size_t xtra_stream_in_num,
 	ssi_stream_t xtra_stream_in[]) {
 
-	_short_to_float = stream_in.type == SSI_SHORT;
+	// float to short saturates instead of wrapping around at full scale
+	_kernel = TypeCast::Resolve (stream_in.type, stream_out.type);
+	_scale = stream_in.type == SSI_SHORT ? 1.0f / 32768.0f : 32768.0f;
 }
 
 void AudioConvert::transform (ITransformer::info info,
@@ -74,26 +77,7 @@ void AudioConvert::transform (ITransformer::info info,
 	ssi_size_t xtra_stream_in_num,
 	ssi_stream_t xtra_stream_in[]) {
 
-	if (_short_to_float) {
-
-        int16_t *srcptr = ssi_pcast (int16_t, stream_in.ptr);
-		ssi_real_t *dstptr = ssi_pcast (ssi_real_t, stream_out.ptr);
-		ssi_size_t N = stream_in.num * stream_in.dim;
-
-		for (ssi_size_t i = 0; i < N; i++) {
-			*dstptr++ = ssi_cast (ssi_real_t, *srcptr++) / 32768.0f;
-		}		
-
-	} else {
-
-		ssi_real_t *srcptr = ssi_pcast (ssi_real_t, stream_in.ptr);
-        int16_t *dstptr = ssi_pcast (int16_t, stream_out.ptr);
-		ssi_size_t N = stream_in.num * stream_in.dim;
-		
-		for (ssi_size_t i = 0; i < N; i++) {
-            *dstptr++ = ssi_cast (int16_t, *srcptr++ * 32768.0f);
-		}		
-	}	
+	_kernel (stream_in.num * stream_in.dim, stream_in.ptr, stream_out.ptr, _scale);
 }
 
 void AudioConvert::transform_flush (ssi_stream_t &stream_in,
@@ -59,6 +59,8 @@ public:
 	const ssi_char_t *getName () { return GetCreateName (); };
 	const ssi_char_t *getInfo () { return "Inverts input stream."; };
 
+	bool isSampleWise () { return true; };
+
 	void transform_enter (ssi_stream_t &stream_in,
 		ssi_stream_t &stream_out,
 		ssi_size_t xtra_stream_in_num = 0,
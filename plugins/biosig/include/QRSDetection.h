@@ -33,6 +33,7 @@
 #include "base/IFilter.h"
 #include "ioput/option/OptionList.h"
 #include "event/EventAddress.h"
+#include "signal/FilterFusion.h"
 
 namespace ssi {
 
@@ -129,13 +130,12 @@ protected:
 	QRSDetection::Options _options;
 	ssi_char_t *_file;
 
-	ITransformer *_bandpass;
-	ssi_stream_t _bandpass_stream;
-	ITransformer *_diff;
-	ssi_stream_t _diff_stream;
-	ITransformer *_pre;
-	ssi_stream_t _pre_stream;
-	ITransformer *_pre_low;
+	// pre-processing runs block wise, only the result is kept for the whole frame
+	IFilter *_bandpass;
+	IFilter *_diff;
+	IFilter *_pre;
+	IFilter *_pre_low;
+	FilterFusion _fusion;
 	ssi_stream_t _pre_low_stream;
 
 	IEventListener *_listener;
@@ -131,21 +131,15 @@ void QRSDetection::transform_enter (ssi_stream_t &stream_in,
 	bandpass->getOptions()->low = 5;
 	bandpass->getOptions()->order = 13;
 	_bandpass = bandpass;
-	ssi_stream_init (_bandpass_stream, 0, _bandpass->getSampleDimensionOut (stream_in.dim), _bandpass->getSampleBytesOut (stream_in.byte), _bandpass->getSampleTypeOut (stream_in.type), stream_in.sr);
-	_bandpass->transform_enter (stream_in, _bandpass_stream);
 
 	//diff
 	Derivative *diff = ssi_pcast(Derivative, Factory::Create (Derivative::GetCreateName (), 0, false));
 	ssi_strcpy (diff->getOptions()->names, "1st");
 	_diff = diff;
-	ssi_stream_init (_diff_stream, 0, _diff->getSampleDimensionOut (_bandpass_stream.dim), _diff->getSampleBytesOut (_bandpass_stream.byte), _diff->getSampleTypeOut (_bandpass_stream.type), _bandpass_stream.sr);
-	_diff->transform_enter (_bandpass_stream, _diff_stream);
 
 	//qrs-pre-process
 	QRSPreProcess *pre = ssi_pcast(QRSPreProcess, Factory::Create (QRSPreProcess::GetCreateName (), 0, false));
 	_pre = pre;
-	ssi_stream_init (_pre_stream, 0, _pre->getSampleDimensionOut (_diff_stream.dim), _pre->getSampleBytesOut (_diff_stream.byte), _pre->getSampleTypeOut (_diff_stream.type), _diff_stream.sr);
-	_pre->transform_enter(_diff_stream, _pre_stream);
 
 	Butfilt *pre_low = ssi_create (Butfilt, 0, false);
 	pre_low->getOptions()->zero = true;
@@ -154,8 +148,18 @@ void QRSDetection::transform_enter (ssi_stream_t &stream_in,
 	pre_low->getOptions ()->order = 3;
 	pre_low->getOptions ()->type = Butfilt::LOW;	
 	_pre_low = pre_low;
-	ssi_stream_init (_pre_low_stream, 0, _pre_low->getSampleDimensionOut (_pre_stream.dim), _pre_low->getSampleBytesOut (_pre_stream.byte), _pre_low->getSampleTypeOut (_pre_stream.type), _pre_stream.sr);
-	_pre_low->transform_enter(_pre_stream, _pre_low_stream);
+
+	IFilter *filters[] = { _bandpass, _diff, _pre, _pre_low };
+	ssi_size_t dim = stream_in.dim;
+	ssi_size_t byte = stream_in.byte;
+	ssi_type_t type = stream_in.type;
+	for (ssi_size_t i = 0; i < 4; i++) {
+		dim = filters[i]->getSampleDimensionOut (dim);
+		byte = filters[i]->getSampleBytesOut (byte);
+		type = filters[i]->getSampleTypeOut (type);
+	}
+	ssi_stream_init (_pre_low_stream, 0, dim, byte, type, stream_in.sr);
+	_fusion.enter (4, filters, stream_in, _pre_low_stream);
 
 	//qrs-detect
 	ssi_size_t sample_dimension = _pre_low_stream.dim;
@@ -183,15 +187,8 @@ void QRSDetection::transform (ITransformer::info info,
 	ssi_size_t n = stream_in.num;
 	ssi_time_t sr = stream_in.sr;
 
-	ssi_stream_adjust (_bandpass_stream, n);
-	ssi_stream_adjust (_diff_stream, n);
-	ssi_stream_adjust (_pre_stream, n);
 	ssi_stream_adjust (_pre_low_stream, n);
-				
-	_bandpass->transform (info, stream_in, _bandpass_stream);
-	_diff->transform (info, _bandpass_stream, _diff_stream);
-	_pre->transform (info, _diff_stream, _pre_stream);
-	_pre_low->transform (info, _pre_stream, _pre_low_stream);
+	_fusion.transform (info, stream_in, _pre_low_stream);
 
 	//qrs-detect
 	ssi_size_t sample_dimension = _pre_low_stream.dim;
@@ -375,20 +372,12 @@ void QRSDetection::transform_flush (ssi_stream_t &stream_in,
 	ssi_size_t xtra_stream_in_num ,
 	ssi_stream_t xtra_stream_in[] ) {
 
-	_pre_low->transform_flush (_pre_stream, _pre_low_stream);
+	_fusion.flush (stream_in, _pre_low_stream);
 	ssi_stream_reset (_pre_low_stream);
-	delete _pre_low; _pre_low = 0;
 
-	_pre->transform_flush (_diff_stream, _pre_stream);
-	ssi_stream_reset (_pre_stream);
+	delete _pre_low; _pre_low = 0;
 	delete _pre; _pre = 0;
-
-	_diff->transform_flush (_bandpass_stream, _diff_stream);
-	ssi_stream_reset (_diff_stream);
 	delete _diff; _diff = 0;
-
-	_bandpass->transform_flush (stream_in, _bandpass_stream);
-	ssi_stream_reset (_bandpass_stream);
 	delete _bandpass; _bandpass = 0;
 
 	delete[] _history_RR;
@@ -29,29 +29,35 @@
 #ifndef SSI_EVENT_EVENTBOARDWORKER_H
 #define SSI_EVENT_EVENTBOARDWORKER_H
 
-#include "thread/Thread.h"
+#include "thread/TimerService.h"
 #include "event/EventList.h"
 
 namespace ssi {
 
 class TheEventBoard;
-class Timer;
 
-class EventBoardWorker : public Thread {
+// processes the events of the board on a TimerService of its own
+class EventBoardWorker {
 
 public:
 
 	EventBoardWorker (TheEventBoard *board);
 	virtual ~EventBoardWorker ();
 	
-	void enter ();
-	void run ();
-	void flush ();
+	bool start ();
+	bool stop ();
 
 protected:
 
+	static ssi_char_t *ssi_log_name;
+	static int ssi_log_level;
+
+	static void Clock (void *arg);
+	void run ();
+
 	TheEventBoard *_board;
-	Timer *_timer;
+	TimerService *_service;
+	ssi_size_t _id;
 };
 
 }
@@ -27,39 +27,55 @@
 #include "EventBoardWorker.h"
 #include "TheEventBoard.h"
 #include "EventQueue.h"
-#include "thread/Timer.h"
 
 namespace ssi {
 
+ssi_char_t *EventBoardWorker::ssi_log_name = "eworker___";
+int EventBoardWorker::ssi_log_level = SSI_LOG_LEVEL_DEFAULT;
+
 EventBoardWorker::EventBoardWorker (TheEventBoard *board) 
 : _board (board),
-	_timer (0) {
-
-	Thread::setName ("EventBoardWorker");
+	_service (0),
+	_id (TimerService::INVALID_ID) {
 }
 
-void EventBoardWorker::enter () {
+bool EventBoardWorker::start () {
+
+	// listeners may take long, so they get their own service and do not delay the sensors on the shared one
+	if (!_service) {
+		_service = new TimerService ("EventBoardWorker");
+		_id = _service->add ("EventBoardWorker", _board->_options.update / 1000.0, Clock, this);
+	}
+
+	return true;
 }
 
-void EventBoardWorker::run () {	
+bool EventBoardWorker::stop () {
 
-	if (!_timer) {
-		_timer = new Timer (_board->_options.update);
+	if (_service) {
+		_service->remove (_id);
+		_id = TimerService::INVALID_ID;
+		delete _service; _service = 0;
 	}
 
-	ssi_size_t n = _board->_queue->fetch (*_board->_events);
-	SSI_DBG (SSI_LOG_LEVEL_DEBUG, "process %u events", n);		
-	_board->process (n);
+	return true;
+}
 
-	_timer->wait ();	
+void EventBoardWorker::Clock (void *arg) {
+
+	ssi_pcast (EventBoardWorker, arg)->run ();
 }
 
-void EventBoardWorker::flush () {
+void EventBoardWorker::run () {	
 
-	delete _timer; _timer = 0;
+	ssi_size_t n = _board->_queue->fetch (*_board->_events);
+	SSI_DBG (SSI_LOG_LEVEL_DEBUG, "process %u events", n);		
+	_board->process (n);
 }
 
 EventBoardWorker::~EventBoardWorker () {
+
+	stop ();
 }
 
 }
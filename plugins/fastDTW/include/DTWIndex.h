@@ -0,0 +1,118 @@
+// DTWIndex.h
+// created: 19/10/2026
+// Copyright (C) University of Augsburg, Lab for Human Centered Multimedia
+//
+// *************************************************************************************************
+//
+// This file is part of Social Signal Interpretation (SSI) developed at the
+// Lab for Human Centered Multimedia of the University of Augsburg
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public
+// License as published by the Free Software Foundation; either
+// version 3 of the License, or any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+//
+//*************************************************************************************************
+
+#pragma once
+
+#ifndef SSI_FASTDTW_DTWINDEX_H
+#define SSI_FASTDTW_DTWINDEX_H
+
+#include "SSI_Cons.h"
+
+#include <vector>
+
+namespace ssi {
+
+	// Stores templates as flat float arrays and matches a query against them
+	// with a Sakoe-Chiba banded DTW. The local cost is the euclidean distance
+	// between two samples, i.e. the same as fastdtw::EuclideanDistance.
+	//
+	// nearest() visits the templates in order of their LB_Kim bound, rejects
+	// candidates with LB_Keogh and abandons the DTW recursion as soon as the
+	// current row plus the remaining LB_Keogh terms exceed the best distance.
+	// Cost rows, envelopes and bounds are kept between calls, so no memory
+	// is allocated once the index has seen the longest query.
+	class DTWIndex {
+
+	public:
+
+		static const ssi_size_t NONE = ~0u;
+
+		DTWIndex();
+		virtual ~DTWIndex();
+
+		void clear();
+
+		// width of the band as fraction of the longer series
+		void setBand(ssi_real_t band);
+		ssi_real_t getBand() { return _band; };
+
+		// copies a template of num x dim samples, returns its index
+		ssi_size_t add(ssi_size_t num, ssi_size_t dim, const float *ptr);
+		ssi_size_t getSize() { return ssi_size_t(_templates.size()); };
+		ssi_size_t getDim() { return _dim; };
+
+		// banded distance between the query and every template
+		void distances(ssi_size_t num, const float *query, float *dists);
+		// index of the closest template or NONE if the index is empty
+		ssi_size_t nearest(ssi_size_t num, const float *query, float &dist);
+
+		// statistics of the last call to nearest()
+		ssi_size_t getPrunedKim() { return _n_pruned_kim; };
+		ssi_size_t getPrunedKeogh() { return _n_pruned_keogh; };
+		ssi_size_t getAbandoned() { return _n_abandoned; };
+		ssi_size_t getComputed() { return _n_computed; };
+
+	protected:
+
+		struct template_t {
+			ssi_size_t offset;
+			ssi_size_t num;
+			ssi_size_t env_num;
+			std::vector<float> lower;
+			std::vector<float> upper;
+		};
+
+		float distance(const float *a, const float *b);
+		ssi_size_t width(ssi_size_t n, ssi_size_t m);
+		void window(ssi_size_t i, ssi_size_t n, ssi_size_t m, ssi_size_t w, ssi_size_t &from, ssi_size_t &to);
+		void envelope(template_t &t, ssi_size_t num);
+
+		float lbKim(const template_t &t, ssi_size_t num, const float *query);
+		float lbKeogh(template_t &t, ssi_size_t num, const float *query, float bound);
+		float dtw(const template_t &t, ssi_size_t num, const float *query, float bound, const float *tail);
+
+		ssi_real_t _band;
+		ssi_size_t _dim;
+
+		std::vector<float> _data;
+		std::vector<template_t> _templates;
+
+		std::vector<float> _row_prev;
+		std::vector<float> _row_curr;
+		std::vector<float> _tail;
+		std::vector<float> _kim;
+		std::vector<ssi_size_t> _order;
+		std::vector<ssi_size_t> _deque_min;
+		std::vector<ssi_size_t> _deque_max;
+
+		ssi_size_t _n_pruned_kim;
+		ssi_size_t _n_pruned_keogh;
+		ssi_size_t _n_abandoned;
+		ssi_size_t _n_computed;
+	};
+
+}
+
+#endif
@@ -39,6 +39,7 @@
 #include "FastDTW.h"
 #include "DTW.h"
 #include "EuclideanDistance.h"
+#include "DTWIndex.h"
 
 namespace ssi {
 
@@ -46,6 +47,11 @@ namespace ssi {
 
 	public:
 
+		enum ALGORITHM {
+			FASTDTW = 0,
+			BANDED
+		};
+
 		class Options : public OptionList {
 
 		public:
@@ -53,12 +59,16 @@ namespace ssi {
 			Options()
 			{
 				addOption("samplefilename", &opt_samplefile, SSI_MAX_CHAR, SSI_CHAR, "Sample filename.");
-				addOption("eventdata", &outputOption, 1, SSI_INT, "0 = avg. distance of all classes; 1 = all distances; 2 = the class with the lowest avg. distance;");
+				addOption("eventdata", &outputOption, 1, SSI_INT, "0 = avg. distance of all classes; 1 = all distances; 2 = the class with the lowest avg. distance; 3 = the class of the nearest sample (pruned search if algorithm=1);");
+				addOption("algorithm", &algorithm, 1, SSI_INT, "0 = FastDTW (default); 1 = DTW restricted to a Sakoe-Chiba band, distances differ from FastDTW;");
+				addOption("band", &band, 1, SSI_REAL, "width of the band as fraction of the longer series (algorithm=1)");
 				SSI_OPTIONLIST_ADD_ADDRESS(address);
 
 				setAddress("distances@fastdtw");
 				setSampleFilename("");
 				outputOption = 0;
+				algorithm = FASTDTW;
+				band = 0.1f;
 			}
 
 			void setAddress(const ssi_char_t *address) {
@@ -75,6 +85,8 @@ namespace ssi {
 			}
 
 			ssi_size_t outputOption;
+			ssi_size_t algorithm;
+			ssi_real_t band;
 			ssi_char_t opt_samplefile[SSI_MAX_CHAR];
 			ssi_char_t address[SSI_MAX_CHAR];
 		};
@@ -104,12 +116,18 @@ namespace ssi {
 			return _eaddress.getAddress();
 		}
 
+		void setLogLevel(ssi_size_t level) override
+		{
+			ssi_log_level = level;
+		}
+
 	protected:
 
 		SSI_FastDTW(const ssi_char_t *file = nullptr);
 		ssi_char_t *_file;
 		Options _options;
 		static char ssi_log_name[];
+		int ssi_log_level;
 
 		//streams loaded from sample file
 		std::vector<fastdtw::TimeSeries<float, 1>*> timeseries_1d;
@@ -121,6 +139,10 @@ namespace ssi {
 		fastdtw::TimeSeries<float, 2> ts_2d;
 		fastdtw::TimeSeries<float, 3> ts_3d;
 
+		//templates and distances for the banded algorithm
+		DTWIndex index;
+		std::vector<float> distances;
+
 
 		std::vector<std::string> *classnames;
 
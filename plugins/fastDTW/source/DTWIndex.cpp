@@ -0,0 +1,354 @@
+// DTWIndex.cpp
+// created: 19/10/2026
+// Copyright (C) University of Augsburg, Lab for Human Centered Multimedia
+//
+// *************************************************************************************************
+//
+// This file is part of Social Signal Interpretation (SSI) developed at the
+// Lab for Human Centered Multimedia of the University of Augsburg
+//
+// This library is free software; you can redistribute it and/or
+// modify it under the terms of the GNU General Public
+// License as published by the Free Software Foundation; either
+// version 3 of the License, or any later version.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public
+// License along with this library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+//
+//*************************************************************************************************
+
+#include "DTWIndex.h"
+
+#include <algorithm>
+#include <limits>
+#include <cmath>
+
+namespace ssi {
+
+	static const float DTWINDEX_INF = std::numeric_limits<float>::infinity();
+
+	DTWIndex::DTWIndex()
+		: _band(0.1f),
+		_dim(0),
+		_n_pruned_kim(0),
+		_n_pruned_keogh(0),
+		_n_abandoned(0),
+		_n_computed(0) {
+	}
+
+	DTWIndex::~DTWIndex() {
+	}
+
+	void DTWIndex::clear() {
+
+		_dim = 0;
+		_data.clear();
+		_templates.clear();
+	}
+
+	void DTWIndex::setBand(ssi_real_t band) {
+
+		_band = band < 0 ? 0 : (band > 1 ? 1 : band);
+
+		// envelopes depend on the band
+		for (size_t i = 0; i < _templates.size(); i++) {
+			_templates[i].env_num = 0;
+		}
+	}
+
+	ssi_size_t DTWIndex::add(ssi_size_t num, ssi_size_t dim, const float *ptr) {
+
+		if (_templates.empty()) {
+			_dim = dim;
+		}
+
+		template_t t;
+		t.offset = ssi_size_t(_data.size());
+		t.num = num;
+		t.env_num = 0;
+		_data.insert(_data.end(), ptr, ptr + num * dim);
+		_templates.push_back(t);
+
+		return ssi_size_t(_templates.size() - 1);
+	}
+
+	float DTWIndex::distance(const float *a, const float *b) {
+
+		float sum = 0;
+		for (ssi_size_t d = 0; d < _dim; d++) {
+			float diff = a[d] - b[d];
+			sum += diff * diff;
+		}
+		return std::sqrt(sum);
+	}
+
+	ssi_size_t DTWIndex::width(ssi_size_t n, ssi_size_t m) {
+
+		ssi_size_t w = ssi_size_t(std::ceil(_band * (n > m ? n : m)));
+
+		// the band has to cover the slope of the diagonal, otherwise there
+		// are rows whose windows do not overlap and no path exists
+		if (n > 1) {
+			ssi_size_t slope = (m - 1 + n - 2) / (n - 1);
+			if (w < slope) {
+				w = slope;
+			}
+		}
+
+		return w < 1 ? 1 : w;
+	}
+
+	void DTWIndex::window(ssi_size_t i, ssi_size_t n, ssi_size_t m, ssi_size_t w, ssi_size_t &from, ssi_size_t &to) {
+
+		if (n == 1) {
+			from = 0;
+			to = m - 1;
+			return;
+		}
+
+		// center of the band follows the diagonal from (0,0) to (n-1,m-1)
+		uint64_t pos = uint64_t(i) * (m - 1);
+		ssi_size_t lo = ssi_size_t(pos / (n - 1));
+		ssi_size_t hi = ssi_size_t((pos + n - 2) / (n - 1));
+
+		from = lo > w ? lo - w : 0;
+		to = hi + w < m ? hi + w : m - 1;
+	}
+
+	void DTWIndex::envelope(template_t &t, ssi_size_t num) {
+
+		if (t.env_num == num) {
+			return;
+		}
+
+		t.lower.resize(num * _dim);
+		t.upper.resize(num * _dim);
+		_deque_min.resize(t.num);
+		_deque_max.resize(t.num);
+
+		ssi_size_t w = width(num, t.num);
+		const float *ptr = &_data[t.offset];
+
+		// the windows move monotonically, so a running min/max per dimension
+		// visits each template sample only once
+		for (ssi_size_t d = 0; d < _dim; d++) {
+
+			ssi_size_t min_head = 0, min_tail = 0;
+			ssi_size_t max_head = 0, max_tail = 0;
+			ssi_size_t next = 0;
+
+			for (ssi_size_t i = 0; i < num; i++) {
+
+				ssi_size_t from, to;
+				window(i, num, t.num, w, from, to);
+
+				for (; next <= to; next++) {
+					float value = ptr[next * _dim + d];
+					while (min_tail > min_head && ptr[_deque_min[min_tail - 1] * _dim + d] >= value) {
+						min_tail--;
+					}
+					_deque_min[min_tail++] = next;
+					while (max_tail > max_head && ptr[_deque_max[max_tail - 1] * _dim + d] <= value) {
+						max_tail--;
+					}
+					_deque_max[max_tail++] = next;
+				}
+				while (_deque_min[min_head] < from) {
+					min_head++;
+				}
+				while (_deque_max[max_head] < from) {
+					max_head++;
+				}
+
+				t.lower[i * _dim + d] = ptr[_deque_min[min_head] * _dim + d];
+				t.upper[i * _dim + d] = ptr[_deque_max[max_head] * _dim + d];
+			}
+		}
+
+		t.env_num = num;
+	}
+
+	float DTWIndex::lbKim(const template_t &t, ssi_size_t num, const float *query) {
+
+		const float *ptr = &_data[t.offset];
+
+		// first and last pair are part of every warping path
+		float lb = distance(query, ptr);
+		if (num > 1 || t.num > 1) {
+			lb += distance(query + (num - 1) * _dim, ptr + (t.num - 1) * _dim);
+		}
+
+		return lb;
+	}
+
+	float DTWIndex::lbKeogh(template_t &t, ssi_size_t num, const float *query, float bound) {
+
+		envelope(t, num);
+
+		// every query sample is matched at least once inside its window, hence
+		// its distance to the window envelope bounds its share of the path cost
+		float lb = 0;
+		for (ssi_size_t i = 0; i < num; i++) {
+
+			const float *q = query + i * _dim;
+			const float *lower = &t.lower[i * _dim];
+			const float *upper = &t.upper[i * _dim];
+
+			float sum = 0;
+			for (ssi_size_t d = 0; d < _dim; d++) {
+				float diff = 0;
+				if (q[d] > upper[d]) {
+					diff = q[d] - upper[d];
+				} else if (q[d] < lower[d]) {
+					diff = lower[d] - q[d];
+				}
+				sum += diff * diff;
+			}
+
+			_tail[i] = std::sqrt(sum);
+			lb += _tail[i];
+			if (lb >= bound) {
+				return lb;
+			}
+		}
+
+		// _tail[i] holds the bound of all rows after i
+		float rest = 0;
+		for (ssi_size_t i = num; i > 0; i--) {
+			float value = _tail[i - 1];
+			_tail[i - 1] = rest;
+			rest += value;
+		}
+
+		return lb;
+	}
+
+	float DTWIndex::dtw(const template_t &t, ssi_size_t num, const float *query, float bound, const float *tail) {
+
+		const float *ptr = &_data[t.offset];
+		ssi_size_t w = width(num, t.num);
+
+		_row_prev.resize(t.num);
+		_row_curr.resize(t.num);
+		float *prev = &_row_prev[0];
+		float *curr = &_row_curr[0];
+
+		ssi_size_t prev_from = 0, prev_to = 0;
+
+		for (ssi_size_t i = 0; i < num; i++) {
+
+			ssi_size_t from, to;
+			window(i, num, t.num, w, from, to);
+
+			const float *q = query + i * _dim;
+			float row_min = DTWINDEX_INF;
+
+			for (ssi_size_t j = from; j <= to; j++) {
+
+				float best;
+				if (i == 0) {
+					best = j == 0 ? 0 : curr[j - 1];
+				} else {
+					best = DTWINDEX_INF;
+					if (j >= prev_from && j <= prev_to) {
+						best = prev[j];
+					}
+					if (j > prev_from && j - 1 <= prev_to && prev[j - 1] < best) {
+						best = prev[j - 1];
+					}
+					if (j > from && curr[j - 1] < best) {
+						best = curr[j - 1];
+					}
+				}
+
+				curr[j] = best + distance(q, ptr + j * _dim);
+				if (curr[j] < row_min) {
+					row_min = curr[j];
+				}
+			}
+
+			if (row_min + (tail ? tail[i] : 0) >= bound) {
+				return DTWINDEX_INF;
+			}
+
+			float *tmp = prev;
+			prev = curr;
+			curr = tmp;
+			prev_from = from;
+			prev_to = to;
+		}
+
+		return prev[t.num - 1];
+	}
+
+	void DTWIndex::distances(ssi_size_t num, const float *query, float *dists) {
+
+		for (size_t k = 0; k < _templates.size(); k++) {
+			dists[k] = num > 0 ? dtw(_templates[k], num, query, DTWINDEX_INF, 0) : DTWINDEX_INF;
+		}
+	}
+
+	ssi_size_t DTWIndex::nearest(ssi_size_t num, const float *query, float &dist) {
+
+		_n_pruned_kim = 0;
+		_n_pruned_keogh = 0;
+		_n_abandoned = 0;
+		_n_computed = 0;
+
+		dist = DTWINDEX_INF;
+		if (num == 0 || _templates.empty()) {
+			return NONE;
+		}
+
+		ssi_size_t n_templates = ssi_size_t(_templates.size());
+
+		_kim.resize(n_templates);
+		_order.resize(n_templates);
+		_tail.resize(num);
+
+		for (ssi_size_t k = 0; k < n_templates; k++) {
+			_kim[k] = lbKim(_templates[k], num, query);
+			_order[k] = k;
+		}
+
+		// promising candidates first, so the bound shrinks early
+		const float *kim = &_kim[0];
+		std::sort(_order.begin(), _order.end(), [kim](ssi_size_t a, ssi_size_t b) { return kim[a] < kim[b]; });
+
+		ssi_size_t best = NONE;
+
+		for (ssi_size_t k = 0; k < n_templates; k++) {
+
+			ssi_size_t index = _order[k];
+			template_t &t = _templates[index];
+
+			if (_kim[index] >= dist) {
+				_n_pruned_kim = n_templates - k;
+				break;
+			}
+
+			if (lbKeogh(t, num, query, dist) >= dist) {
+				_n_pruned_keogh++;
+				continue;
+			}
+
+			float d = dtw(t, num, query, dist, &_tail[0]);
+			if (d < dist) {
+				dist = d;
+				best = index;
+				_n_computed++;
+			} else {
+				_n_abandoned++;
+			}
+		}
+
+		return best;
+	}
+
+}
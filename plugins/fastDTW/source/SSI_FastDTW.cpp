@@ -34,7 +34,7 @@ namespace ssi {
 	char SSI_FastDTW::ssi_log_name[] = "fastdtw___";
 
 	SSI_FastDTW::SSI_FastDTW(const ssi_char_t *file)
-		: _file(0), _elistener(0), inputdim(0){
+		: _file(0), _elistener(0), inputdim(0), ssi_log_level(SSI_LOG_LEVEL_DEFAULT) {
 
 		if (file) {
 			if (!OptionList::LoadXML(file, _options)) {
@@ -81,6 +81,9 @@ namespace ssi {
 
 		sampleList.printInfo();
 
+		index.clear();
+		index.setBand(_options.band);
+
 		//get streams of classes from file sample file and store in memory
 
 		for (int i = 0; i < sampleList.getSize(); i++) {
@@ -97,6 +100,12 @@ namespace ssi {
 				ssi_stream_t **stream = sample->streams;
 
                 inputdim = stream[j]->dim;
+
+				if (_options.algorithm == BANDED) {
+					index.add(stream[j]->num, stream[j]->dim, reinterpret_cast<float*>(stream[j]->ptr));
+					continue;
+				}
+
 				if (stream[j]->dim < 1 || stream[j]->dim > 3)
 				{
 					ssi_err("Sample list: Unsupported count of dimensions!");
@@ -150,12 +159,35 @@ namespace ssi {
         if (inputdim != stream_in[0].dim)
             ssi_err("Dimension of sample list differs from input stream!");
 
-		if  (stream_in_num == 1 && stream_in[0].dim > 0 && stream_in[0].dim < 4) {
+		if  (stream_in_num == 1 && stream_in[0].dim > 0 && (_options.algorithm == BANDED || stream_in[0].dim < 4)) {
 
 			//store distances between each stored data stream and the current data
 			std::multimap<std::string, float> dist_mm;
 
-			if (inputdim == 1) {
+			//nearest sample, only set by the pruned search
+			std::string nearest_class = "";
+			float nearest_dist = -1;
+
+			distances.resize(classnames->size());
+
+			if (_options.algorithm == BANDED) {
+
+				float* f1 = reinterpret_cast<float*>(stream_in[0].ptr);
+
+				if (_options.outputOption == 3) {
+					ssi_size_t nearest = index.nearest(stream_in[0].num, f1, nearest_dist);
+					if (nearest != DTWIndex::NONE) {
+						nearest_class = classnames->at(nearest);
+					}
+					ssi_msg(SSI_LOG_LEVEL_DEBUG, "pruned %u (kim) + %u (keogh), abandoned %u, computed %u", index.getPrunedKim(), index.getPrunedKeogh(), index.getAbandoned(), index.getComputed());
+				} else {
+					index.distances(stream_in[0].num, f1, &distances[0]);
+					for (int i = 0; i < classnames->size(); i++) {
+						dist_mm.insert(std::pair<std::string, float>(classnames->at(i), distances[i]));
+					}
+				}
+			}
+			else if (inputdim == 1) {
 				//clear old data
 				ts_1d.clear();
 
@@ -172,7 +204,11 @@ namespace ssi {
 				for (int i = 0; i < classnames->size(); i++) {
 					fastdtw::TimeWarpInfo<float> info = fastdtw::FAST::getWarpInfoBetween(ts_1d, *timeseries_1d.at(i), fastdtw::EuclideanDistance());
 
-					dist_mm.insert(std::pair<std::string, float>(classnames->at(i), info.getDistance()));
+					distances[i] = info.getDistance();
+				}
+
+				for (int i = 0; i < classnames->size(); i++) {
+					dist_mm.insert(std::pair<std::string, float>(classnames->at(i), distances[i]));
 				}
 			}
 			else if (inputdim == 2) {
@@ -193,7 +229,11 @@ namespace ssi {
 				for (int i = 0; i < classnames->size(); i++) {
 					fastdtw::TimeWarpInfo<float> info = fastdtw::FAST::getWarpInfoBetween(ts_2d, *timeseries_2d.at(i), fastdtw::EuclideanDistance());
 
-					dist_mm.insert(std::pair<std::string, float>(classnames->at(i), info.getDistance()));
+					distances[i] = info.getDistance();
+				}
+
+				for (int i = 0; i < classnames->size(); i++) {
+					dist_mm.insert(std::pair<std::string, float>(classnames->at(i), distances[i]));
 				}
 			}
 			else if (inputdim == 3)
@@ -215,7 +255,11 @@ namespace ssi {
 				for (int i = 0; i < classnames->size(); i++) {
 					fastdtw::TimeWarpInfo<float> info = fastdtw::FAST::getWarpInfoBetween(ts_3d, *timeseries_3d.at(i), fastdtw::EuclideanDistance());
 
-					dist_mm.insert(std::pair<std::string, float>(classnames->at(i), info.getDistance()));
+					distances[i] = info.getDistance();
+				}
+
+				for (int i = 0; i < classnames->size(); i++) {
+					dist_mm.insert(std::pair<std::string, float>(classnames->at(i), distances[i]));
 				}
 			}
 
@@ -316,6 +360,26 @@ namespace ssi {
 						e[0].id = Factory::GetStringId(classname.c_str());
 						e[0].value = ssi_cast(ssi_real_t, min_dist);
 
+					} break;
+
+					case 3: {
+
+						if (nearest_dist < 0) {
+							std::multimap<std::string, float>::iterator it;
+							for (it = dist_mm.begin(); it != dist_mm.end(); ++it) {
+								if (nearest_dist < 0 || nearest_dist > (*it).second) {
+									nearest_class = (*it).first;
+									nearest_dist = (*it).second;
+								}
+							}
+						}
+
+						ssi_event_adjust(_event, 1 * sizeof(ssi_event_map_t));
+						ssi_event_map_t *e = ssi_pcast(ssi_event_map_t, _event.ptr);
+
+						e[0].id = Factory::GetStringId(nearest_class.c_str());
+						e[0].value = ssi_cast(ssi_real_t, nearest_dist);
+
 					} break;
 					default:
 						ssi_err("Unknown option for eventdata!")
@@ -366,6 +430,8 @@ namespace ssi {
 			timeseries_3d.clear();
 		}
 
+		index.clear();
+
 		delete classnames;
 	}
 
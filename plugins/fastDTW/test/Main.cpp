@@ -49,6 +49,8 @@ bool ex_record_mouse(void *arg);
 bool ex_stream_audio(void *arg);
 bool ex_record_audio(void *arg);
 
+bool ex_benchmark(void *arg);
+
 int main () {
 
 #ifdef USE_SSI_LEAK_DETECTOR
@@ -59,6 +61,7 @@ int main () {
 	
 	Exsemble ex;
 	ex.add(ex_stream_mouse, 0, "Recognize: Mouse 2D", "Demonstrates the use of fastDTW with 2D data.");
+	ex.add(ex_benchmark, 0, "Benchmark", "Compares FastDTW against the pruned banded DTW on random gestures.");
 #if _WIN32
     ex.add(ex_record_mouse, 0, "Record: Mouse 2D",	  "Record data for fastDTW with 2D data.");
 
@@ -438,3 +441,80 @@ bool ex_stream_audio(void *arg) {
 	return true;
 }
 #endif
+
+bool ex_benchmark(void *arg) {
+
+	const ssi_size_t n_templates = 500;
+	const ssi_size_t n_queries = 20;
+	const ssi_size_t max_len = 150;
+	const ssi_size_t dim = 2;
+
+	ssi_random_seed();
+
+	// random walks stand in for recorded mouse gestures
+	std::vector<std::vector<float>> templates(n_templates);
+	std::vector<std::vector<float>> queries(n_queries);
+	for (ssi_size_t i = 0; i < n_templates + n_queries; i++) {
+		std::vector<float> &walk = i < n_templates ? templates[i] : queries[i - n_templates];
+		ssi_size_t num = 10 + ssi_random(max_len - 10);
+		walk.resize(num * dim);
+		for (ssi_size_t j = 0; j < num * dim; j++) {
+			walk[j] = (j < dim ? 0 : walk[j - dim]) + ssi_cast(float, ssi_random(-0.5, 0.5));
+		}
+	}
+
+	std::vector<fastdtw::TimeSeries<float, dim>*> series(n_templates);
+	DTWIndex index;
+	for (ssi_size_t i = 0; i < n_templates; i++) {
+		ssi_size_t num = ssi_size_t(templates[i].size() / dim);
+		series[i] = new fastdtw::TimeSeries<float, dim>();
+		for (ssi_size_t j = 0; j < num; j++) {
+			series[i]->addLast(j, fastdtw::TimeSeriesPoint<float, dim>(&templates[i][j * dim]));
+		}
+		index.add(num, dim, &templates[i][0]);
+	}
+
+	ssi_size_t agree = 0, pruned = 0, abandoned = 0;
+
+	ssi_size_t time_fast = ssi_time_ms();
+	std::vector<ssi_size_t> nearest_fast(n_queries);
+	for (ssi_size_t q = 0; q < n_queries; q++) {
+		ssi_size_t num = ssi_size_t(queries[q].size() / dim);
+		fastdtw::TimeSeries<float, dim> query;
+		for (ssi_size_t j = 0; j < num; j++) {
+			query.addLast(j, fastdtw::TimeSeriesPoint<float, dim>(&queries[q][j * dim]));
+		}
+		float best = -1;
+		for (ssi_size_t i = 0; i < n_templates; i++) {
+			float dist = fastdtw::FAST::getWarpInfoBetween(query, *series[i], fastdtw::EuclideanDistance()).getDistance();
+			if (best < 0 || dist < best) {
+				best = dist;
+				nearest_fast[q] = i;
+			}
+		}
+	}
+	time_fast = ssi_time_ms() - time_fast;
+
+	ssi_size_t time_banded = ssi_time_ms();
+	for (ssi_size_t q = 0; q < n_queries; q++) {
+		float dist;
+		ssi_size_t nearest = index.nearest(ssi_size_t(queries[q].size() / dim), &queries[q][0], dist);
+		pruned += index.getPrunedKim() + index.getPrunedKeogh();
+		abandoned += index.getAbandoned();
+		if (nearest == nearest_fast[q]) {
+			agree++;
+		}
+	}
+	time_banded = ssi_time_ms() - time_banded;
+
+	ssi_print("\n%u queries against %u templates\n\n", n_queries, n_templates);
+	ssi_print("FastDTW\t\t%u ms\n", time_fast);
+	ssi_print("banded DTW\t%u ms (pruned %u, abandoned %u of %u)\n", time_banded, pruned, abandoned, n_queries * n_templates);
+	ssi_print("same nearest template in %u of %u queries\n\n", agree, n_queries);
+
+	for (ssi_size_t i = 0; i < n_templates; i++) {
+		delete series[i];
+	}
+
+	return true;
+}
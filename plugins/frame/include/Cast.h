@@ -37,6 +37,7 @@ Provides second-order infinite impulse response (IIR) filtering.
 
 #include "base/IFilter.h"
 #include "ioput/option/OptionList.h"
+#include "signal/TypeCast.h"
 
 namespace ssi {
 
@@ -76,6 +77,12 @@ public:
 		return _options.cast;
 	}
 
+	bool isSampleWise () { return true; };
+
+	void transform_enter (ssi_stream_t &stream_in,
+		ssi_stream_t &stream_out,
+		ssi_size_t xtra_stream_in_num = 0,
+		ssi_stream_t xtra_stream_in[] = 0);
 	void transform (ITransformer::info,
 		ssi_stream_t &stream_in,
 		ssi_stream_t &stream_out,
@@ -87,6 +94,8 @@ protected:
 	Cast (const ssi_char_t *file = 0);
 	Cast::Options _options;
 	ssi_char_t *_file;
+
+	ssi_cast_kernel_t _kernel;
 };
 
 }
@@ -35,6 +35,8 @@
 #include "ioput/option/OptionList.h"
 #include "ioput/xml/tinyxml.h"
 #include "base/IXMLPipeline.h"
+#include "signal/FilterFusion.h"
+#include "thread/WorkerPool.h"
 
 namespace ssi {
 
@@ -49,6 +51,15 @@ namespace ssi {
  *
  * Either the filter or the feature set may be empty.
  *
+ * Consecutive sample wise filters are fused, i.e. they process
+ * the frame in small blocks without full intermediate streams
+ * (see FilterFusion).
+ *
+ * If option 'parallel' is set, features are evaluated concurrently
+ * on the shared WorkerPool. Each feature writes to its own slice
+ * of the output sample, but all of them read the same input stream,
+ * i.e. features must not modify their input.
+ *
  * @author Johannes Wagner
  * @date  Feb 2009
  */
@@ -67,11 +78,14 @@ public:
 
 	public:
 
-		Options () {
+		Options ()
+			: fuse (true), parallel (false) {
 
 			path[0] = '\0';
 			addOption("file", path, SSI_MAX_CHAR, SSI_CHAR, "deprecated, see path");
 			addOption("path", path, SSI_MAX_CHAR, SSI_CHAR, "path to file with chain definition");
+			addOption("fuse", &fuse, 1, SSI_BOOL, "run consecutive sample wise filters block by block");
+			addOption("parallel", &parallel, 1, SSI_BOOL, "evaluate features concurrently on the shared worker pool (features must not modify their input)");
 		};
 
 		void set (const ssi_char_t *f) {
@@ -79,6 +93,8 @@ public:
 		};
 
 		ssi_char_t path[SSI_MAX_CHAR];
+		bool fuse;
+		bool parallel;
 	};
 
 public:
@@ -172,11 +188,18 @@ protected:
 	ssi_size_t _n_features;
 	IFeature **_features;
 
-	ssi_stream_t **_stream_tmp;
-	ssi_size_t _stream_tmp_num;
+	FilterFusion _fusion;
+	ssi_stream_t _stream_filter;
 	ssi_size_t *_feature_dim_out;
 	ssi_size_t _feature_dim_out_tot;
 
+	static void FeatureTask (ssi_size_t index, void *arg);
+	WorkerPool *_pool;
+	ssi_size_t *_feature_offset;
+	ITransformer::info _job_info;
+	ssi_stream_t *_job_in;
+	ssi_stream_t *_job_out;
+
 	ssi_size_t _meta_size;
 	ssi_byte_t *_meta_data;
 
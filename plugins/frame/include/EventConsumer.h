@@ -52,12 +52,16 @@ public:
 	public:
 
 		Options () 
-			: async (false) {
+			: async (false), queue (32), coalesce (true) {
 
 			addOption ("async", &async, 1, SSI_BOOL, "process consumer asynchronously (update call is not blocked)");			
+			addOption ("queue", &queue, 1, SSI_SIZE, "maximum number of pending events if processed asynchronously (if full oldest event is dropped)");
+			addOption ("coalesce", &coalesce, 1, SSI_BOOL, "merge overlapping events into a single update");
 		};
 
 		bool async;
+		ssi_size_t queue;
+		bool coalesce;
 	};
 
 public: 	
@@ -80,6 +84,13 @@ public:
 		ssi_log_level = level;
 	}
 
+	// statistics since last listen_enter ()
+	ssi_size_t getProcessedCount () { return _n_processed; };
+	ssi_size_t getDroppedCount () { return _n_dropped; };
+	ssi_size_t getCoalescedCount () { return _n_coalesced; };
+	ssi_size_t getMaxLatencyMs () { return _latency_max; };
+	ssi_time_t getMeanLatencyMs () { return _n_processed > 0 ? ssi_cast (ssi_time_t, _latency_sum) / _n_processed : 0; };
+
 protected:
 
 	EventConsumer (const ssi_char_t *file = 0);
@@ -105,6 +116,24 @@ protected:
 	Event _update_event;
 	IConsumer::info _update_info;
 
+	struct trigger_t {
+		IConsumer::info info;
+		ssi_size_t time_ms;
+	};
+	static bool Overlap (const IConsumer::info &a, const IConsumer::info &b);
+	static void Merge (IConsumer::info &to, const IConsumer::info &from);
+	void enqueue (const IConsumer::info &info, ssi_size_t time_ms);
+	trigger_t *_queue;
+	ssi_size_t _queue_size;
+	ssi_size_t _queue_first;
+	ssi_size_t _queue_count;
+
+	ssi_size_t _n_processed;
+	ssi_size_t _n_dropped;
+	ssi_size_t _n_coalesced;
+	ssi_size_t _latency_max;
+	ssi_size_t _latency_sum;
+
 	TheFramework *_frame;
 
 	static ssi_char_t *ssi_log_name;
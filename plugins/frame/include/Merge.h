@@ -43,14 +43,16 @@ public:
 	public:
 
 		Options ()
-			: warning (true), dims (0) {
+			: warning (true), dims (0), resample (false) {
 
 			addOption ("warning", &warning, 1, SSI_BOOL, "suppress warning if streams do not fit in #samples");	
 			addOption ("dims", &dims, 1, SSI_SIZE, "#dimensions that will be added to the main stream");
+			addOption ("resample", &resample, 1, SSI_BOOL, "resample additional streams to the sample rate of the main stream");
 		};
 
 		bool warning;
 		ssi_size_t dims;
+		bool resample;
 	};
 
 public:
@@ -90,6 +92,10 @@ public:
 		return SSI_REAL;
 	}
 
+	bool alignXtraStreams () {
+		return _options.resample;
+	}
+
 protected:
 
 	Merge (const ssi_char_t *file = 0);
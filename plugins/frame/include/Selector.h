@@ -89,6 +89,8 @@ public:
 	const ssi_char_t *getName () { return GetCreateName (); };
 	const ssi_char_t *getInfo () { return "Selects certain dimensions of the input stream in abitrary order."; };
 
+	bool isSampleWise () { return true; };
+
 	 void transform_enter (ssi_stream_t &stream_in,
 		ssi_stream_t &stream_out,
 		ssi_size_t xtra_stream_in_num = 0,
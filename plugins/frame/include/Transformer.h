@@ -32,6 +32,7 @@
 #include "FrameLibCons.h"
 #include "base/ITransformer.h"
 #include "base/ITransformable.h"
+#include "signal/Resampler.h"
 
 namespace ssi {
 
@@ -96,6 +97,7 @@ protected:
 
 	bool check_trigger_stream(ssi_stream_t &s);
 	int transform ();
+	int align_xtra ();
 
 	ITransformer *_transformer;
 	ssi_stream_t _stream_in, _stream_out;
@@ -110,6 +112,12 @@ protected:
 	int *_xtra_stream_ids;
 	ssi_stream_t *_xtra_streams;
 
+	// xtra streams resampled to the main rate, see ITransformer::alignXtraStreams()
+	Resampler **_xtra_resamplers;
+	ssi_stream_t *_xtra_raw;
+	ssi_lsize_t _xtra_aligned_pos;
+	bool _xtra_aligned;
+
 	TheFramework *_frame;
 };
 
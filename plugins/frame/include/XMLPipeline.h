@@ -113,6 +113,20 @@ protected:
 	typedef std::pair<String, ITransformable *> transformable_pair_t;
 	transformable_map_t _transformable_map;
 
+	// identical transformers share their output, maps signature to output pin
+	String getSignature (TiXmlElement *element,
+		ITransformable *input,
+		ssi_size_t xinput_size,
+		ITransformable **xinput,
+		ITransformable *trigger,
+		const ssi_char_t *frame_size,
+		const ssi_char_t *delta_size,
+		bool async,
+		const ssi_char_t *buffer_size);
+	typedef std::map<String, String> signature_map_t;
+	typedef std::pair<String, String> signature_pair_t;
+	signature_map_t _signature_map;
+
 	typedef std::map<String, IConsumer *> consumer_map_t;
 	typedef std::pair<String, IConsumer *> consumer_pair_t;
 	consumer_map_t _consumer_map;
@@ -35,7 +35,8 @@ Provides second-order infinite impulse response (IIR) filtering.
 namespace ssi {
 
 Cast::Cast (const ssi_char_t *file) 
-	: _file (0) {
+	: _file (0),
+	_kernel (0) {
 
 	if (file) {
 		if (!OptionList::LoadXML (file, _options)) {
@@ -53,6 +54,16 @@ Cast::~Cast () {
 	}
 }
 
+void Cast::transform_enter (ssi_stream_t &stream_in,
+	ssi_stream_t &stream_out,
+	ssi_size_t xtra_stream_in_num,
+	ssi_stream_t xtra_stream_in[]) {
+
+	_kernel = TypeCast::Resolve (stream_in.type, stream_out.type);
+	if (!_kernel) {
+		ssi_err ("cast from type '%s' to '%s' not supported", SSI_TYPE_NAMES[stream_in.type], SSI_TYPE_NAMES[stream_out.type]);
+	}
+}
 
 void Cast::transform (ITransformer::info,
 	ssi_stream_t &stream_in,
@@ -63,7 +74,7 @@ void Cast::transform (ITransformer::info,
 	ssi_size_t sample_dimension = stream_in.dim;
 	ssi_size_t sample_number = stream_in.num;
 
-	ssi_cast2type (sample_dimension * sample_number, stream_in.ptr, stream_out.ptr, stream_in.type, stream_out.type);
+	_kernel (sample_dimension * sample_number, stream_in.ptr, stream_out.ptr, 1.0f);
 }
 
 }
@@ -40,7 +40,8 @@ Chain::Chain (const ssi_char_t *file)
 	_n_features (0),		
 	_features (0),
 	_feature_dim_out (0),
-	_stream_tmp (0),
+	_pool (0),
+	_feature_offset (0),
 	_file (0),
 	_parsed (false),
 	_load_from_file(true),
@@ -80,30 +81,56 @@ void Chain::transform_enter (ssi_stream_t &stream_in,
 	
 	parse();
 
-	// create temporary streams, init them and call transform_enter for each filter/feature
-	_stream_tmp_num = 1 + _n_filters + (_n_features > 0 ? 1 : 0);
-	_stream_tmp = new ssi_stream_t *[_stream_tmp_num];		
-	_stream_tmp[0] = &stream_in; // first is always the input stream
-	for (ssi_size_t i = 1; i < _stream_tmp_num - 1; i++) { // create temporary streams
-		_stream_tmp[i] = new ssi_stream_t;
-	}
-	_stream_tmp[_stream_tmp_num-1] = &stream_out; // last is always the output stream
-	for (ssi_size_t i = 0; i < _n_filters; i++) {
-		if (i+1 < _stream_tmp_num-1) {
-			ssi_stream_init (*_stream_tmp[i+1], 0, _filters[i]->getSampleDimensionOut (_stream_tmp[i]->dim), _filters[i]->getSampleBytesOut (_stream_tmp[i]->byte), _stream_tmp[i]->type, _stream_tmp[i]->sr);											
+	// filters write to a temporary stream if features follow, otherwise to the output stream
+	ssi_stream_t *features_in = &stream_in;
+	if (_n_filters > 0) {
+		ssi_stream_t *filters_out = &stream_out;
+		if (_n_features > 0) {
+			ssi_size_t dim = stream_in.dim;
+			ssi_size_t byte = stream_in.byte;
+			ssi_type_t type = stream_in.type;
+			for (ssi_size_t i = 0; i < _n_filters; i++) {
+				dim = _filters[i]->getSampleDimensionOut (dim);
+				byte = _filters[i]->getSampleBytesOut (byte);
+				type = _filters[i]->getSampleTypeOut (type);
+			}
+			ssi_stream_init (_stream_filter, 0, dim, byte, type, stream_in.sr);
+			filters_out = &_stream_filter;
+			features_in = &_stream_filter;
 		}
-		_filters[i]->transform_enter (*_stream_tmp[i], *_stream_tmp[i+1]);
+		_fusion.enter (_n_filters, _filters, stream_in, *filters_out, _options.fuse);
+		ssi_msg (SSI_LOG_LEVEL_DETAIL, "fused %u of %u filter (%u samples per block)", _fusion.getFusedNum (), _n_filters, _fusion.getBlockNum ());
 	}
+
 	if (_n_features > 0) {
 		_feature_dim_out = new ssi_size_t[_n_features];
-		_feature_dim_out_tot = _stream_tmp[_stream_tmp_num-1]->dim;
+		_feature_offset = new ssi_size_t[_n_features];
+		_feature_dim_out_tot = stream_out.dim;
+		ssi_size_t offset = 0;
 		for (ssi_size_t i = 0; i < _n_features; i++) {			
-			_feature_dim_out[i] = _features[i]->getSampleDimensionOut (_stream_tmp[_stream_tmp_num-2]->dim);
-			_stream_tmp[_stream_tmp_num-1]->dim = _feature_dim_out[i];
-			_features[i]->transform_enter (*_stream_tmp[_stream_tmp_num-2], *_stream_tmp[_stream_tmp_num-1]);
+			_feature_dim_out[i] = _features[i]->getSampleDimensionOut (features_in->dim);
+			_feature_offset[i] = offset;
+			offset += stream_out.byte * _feature_dim_out[i];
+			stream_out.dim = _feature_dim_out[i];
+			_features[i]->transform_enter (*features_in, stream_out);
 		}
-		_stream_tmp[_stream_tmp_num-1]->dim = _feature_dim_out_tot;
+		stream_out.dim = _feature_dim_out_tot;
 	}
+
+	_pool = _options.parallel && _n_features > 1 ? WorkerPool::GetShared () : 0;
+	if (_pool) {
+		ssi_msg (SSI_LOG_LEVEL_DETAIL, "evaluate %u features on %u threads", _n_features, _pool->size ());
+	}
+}
+
+void Chain::FeatureTask (ssi_size_t index, void *arg) {
+
+	Chain *me = ssi_pcast (Chain, arg);
+
+	ssi_stream_t stream_out = *me->_job_out;
+	stream_out.dim = me->_feature_dim_out[index];
+	stream_out.ptr += me->_feature_offset[index];
+	me->_features[index]->transform (me->_job_info, *me->_job_in, stream_out);
 }
 	
 void Chain::transform (ITransformer::info info,
@@ -118,27 +145,31 @@ void Chain::transform (ITransformer::info info,
 	}
 	else
 	{
-		// adjust arrays
-		_stream_tmp[0] = &stream_in; // first is always the input stream
-		ssi_size_t sample_number = stream_in.num;
-		for (ssi_size_t i = 1; i < _stream_tmp_num - 1; i++) {
-			ssi_stream_adjust(*_stream_tmp[i], sample_number);
-		}
-		_stream_tmp[_stream_tmp_num - 1] = &stream_out; // last is always the output stream
-
 		// transform data
-		for (ssi_size_t i = 0; i < _n_filters; i++) {
-			_filters[i]->transform(info, *_stream_tmp[i], *_stream_tmp[i + 1]);
+		ssi_stream_t *features_in = &stream_in;
+		if (_n_filters > 0) {
+			if (_n_features > 0) {
+				ssi_stream_adjust (_stream_filter, stream_in.num);
+				_fusion.transform (info, stream_in, _stream_filter);
+				features_in = &_stream_filter;
+			} else {
+				_fusion.transform (info, stream_in, stream_out);
+			}
 		}
-		if (_n_features > 0) {
-			ssi_byte_t *ptr_tmp = _stream_tmp[_stream_tmp_num - 1]->ptr;
+		if (_pool) {
+			_job_info = info;
+			_job_in = features_in;
+			_job_out = &stream_out;
+			_pool->run (_n_features, FeatureTask, this);
+		} else if (_n_features > 0) {
+			ssi_byte_t *ptr_tmp = stream_out.ptr;
 			for (ssi_size_t i = 0; i < _n_features; i++) {
-				_stream_tmp[_stream_tmp_num - 1]->dim = _feature_dim_out[i];
-				_features[i]->transform(info, *_stream_tmp[_stream_tmp_num - 2], *_stream_tmp[_stream_tmp_num - 1]);
-				_stream_tmp[_stream_tmp_num - 1]->ptr += _stream_tmp[_stream_tmp_num - 1]->byte * _feature_dim_out[i];
+				stream_out.dim = _feature_dim_out[i];
+				_features[i]->transform(info, *features_in, stream_out);
+				stream_out.ptr += stream_out.byte * _feature_dim_out[i];
 			}
-			_stream_tmp[_stream_tmp_num - 1]->ptr = ptr_tmp;
-			_stream_tmp[_stream_tmp_num - 1]->dim = _feature_dim_out_tot;
+			stream_out.ptr = ptr_tmp;
+			stream_out.dim = _feature_dim_out_tot;
 		}
 	}
 }
@@ -148,26 +179,30 @@ void Chain::transform_flush (ssi_stream_t &stream_in,
 	ssi_size_t xtra_stream_in_num,
 	ssi_stream_t xtra_stream_in[]) {
 
-	// destroy arrays and flush transformer
-	_stream_tmp[0] = &stream_in; // first is always the input stream
-	_stream_tmp[_stream_tmp_num-1] = &stream_out; // last is always the output stream
-	for (ssi_size_t i = 0; i < _n_filters; i++) {
-		_filters[i]->transform_flush (*_stream_tmp[i], *_stream_tmp[i+1]);
+	// flush transformer and destroy arrays
+	ssi_stream_t *features_in = &stream_in;
+	if (_n_filters > 0) {
+		if (_n_features > 0) {
+			_fusion.flush (stream_in, _stream_filter);
+			features_in = &_stream_filter;
+		} else {
+			_fusion.flush (stream_in, stream_out);
+		}
 	}
 	if (_n_features > 0) {
 		for (ssi_size_t i = 0; i < _n_features; i++) {
-			_stream_tmp[_stream_tmp_num-1]->dim = _feature_dim_out[i];				
-			_features[i]->transform_flush (*_stream_tmp[_stream_tmp_num-2], *_stream_tmp[_stream_tmp_num-1]);	
+			stream_out.dim = _feature_dim_out[i];				
+			_features[i]->transform_flush (*features_in, stream_out);	
 		}
-		_stream_tmp[_stream_tmp_num-1]->dim = _feature_dim_out_tot;	
+		stream_out.dim = _feature_dim_out_tot;	
 	}
-	for (ssi_size_t i = 1; i < _stream_tmp_num - 1; i++) {
-		ssi_stream_destroy (*_stream_tmp[i]);
-		delete _stream_tmp[i];
+	if (_n_filters > 0 && _n_features > 0) {
+		ssi_stream_destroy (_stream_filter);
 	}
 
-	delete[] _stream_tmp; _stream_tmp = 0;
 	delete[] _feature_dim_out; _feature_dim_out = 0;
+	delete[] _feature_offset; _feature_offset = 0;
+	_pool = 0;
 
 	if (_load_from_file) {
 		release();
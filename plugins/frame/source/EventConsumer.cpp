@@ -47,7 +47,16 @@ EventConsumer::EventConsumer (const ssi_char_t *file)
 	ssi_log_level (SSI_LOG_LEVEL_DEFAULT),
 	_terminate (false),
 	_consumer_count (0),
-	_async (false) {
+	_async (false),
+	_queue (0),
+	_queue_size (0),
+	_queue_first (0),
+	_queue_count (0),
+	_n_processed (0),
+	_n_dropped (0),
+	_n_coalesced (0),
+	_latency_max (0),
+	_latency_sum (0) {
 
 	if (file) {
 		if (!OptionList::LoadXML (file, _options)) {
@@ -132,7 +141,22 @@ void EventConsumer::listen_enter () {
 
 	_terminate = false;
 
+	_n_processed = 0;
+	_n_dropped = 0;
+	_n_coalesced = 0;
+	_latency_max = 0;
+	_latency_sum = 0;
+
 	if (_async) {
+		_queue_size = _options.queue > 0 ? _options.queue : 1;
+		_queue = new trigger_t[_queue_size];
+		for (ssi_size_t i = 0; i < _queue_size; i++) {
+			_queue[i].info.event = new ssi_event_t;
+			ssi_event_init (*_queue[i].info.event);
+		}
+		_queue_first = 0;
+		_queue_count = 0;
+
 		this->setName (getName());
 		start ();
 	}
@@ -144,36 +168,99 @@ bool EventConsumer::update (IEvents &events, ssi_size_t n_new_events, ssi_size_t
 		return true;
 	}
 
-	if (n_new_events > 1) {
-		ssi_wrn ("skip %u events", n_new_events - 1);
-	}
-
-	ssi_event_t *e = events.next (); 
-	IConsumer::info info;
-	info.time = e->time / 1000.0;
-	info.dur = e->dur / 1000.0;
-	info.status = e->state == SSI_ESTATE_COMPLETED ? IConsumer::COMPLETED : IConsumer::CONTINUED;	
-	info.event = e;
+	IConsumer::info pending;
+	bool has_pending = false;
 
 	if (_async) {
+		_update_mutex.acquire ();
+	}
 
-		{
-			Lock lock (_update_mutex);
-			_update_info.time = info.time;
-			_update_info.dur = info.dur;
-			_update_info.status = info.status;	
-			ssi_event_destroy(*_update_info.event);
-			ssi_event_clone(*info.event, *_update_info.event);
+	for (ssi_size_t i = 0; i < n_new_events; i++) {
+
+		ssi_event_t *e = events.next (); 
+		IConsumer::info info;
+		info.time = e->time / 1000.0;
+		info.dur = e->dur / 1000.0;
+		info.status = e->state == SSI_ESTATE_COMPLETED ? IConsumer::COMPLETED : IConsumer::CONTINUED;	
+		info.event = e;
+
+		if (_async) {
+			enqueue (info, time_ms);
+		} else {
+			// overlapping events are handled with a single update
+			if (has_pending && _options.coalesce && Overlap (pending, info)) {
+				Merge (pending, info);
+				_n_coalesced++;
+			} else {
+				if (has_pending) {
+					consume (pending);
+					_n_processed++;
+				}
+				pending = info;
+				has_pending = true;
+			}
 		}
+	}
 
+	if (_async) {
+		_update_mutex.release ();
 		_update_event.release ();
+	} else if (has_pending) {
+		consume (pending);
+		_n_processed++;
+	}
 
-	} else {
+	return true;
+}
 
-		consume (info);		
-	}	
+bool EventConsumer::Overlap (const IConsumer::info &a, const IConsumer::info &b) {
 
-	return true;
+	return b.time <= a.time + a.dur && a.time <= b.time + b.dur;
+}
+
+void EventConsumer::Merge (IConsumer::info &to, const IConsumer::info &from) {
+
+	// window covers both events, the later event is kept
+	ssi_time_t from_time = from.time < to.time ? from.time : to.time;
+	ssi_time_t to_time = from.time + from.dur > to.time + to.dur ? from.time + from.dur : to.time + to.dur;
+	to.time = from_time;
+	to.dur = to_time - from_time;
+	to.status = from.status;
+	to.event = from.event;
+}
+
+void EventConsumer::enqueue (const IConsumer::info &info, ssi_size_t time_ms) {
+
+	// called with _update_mutex locked
+
+	if (_options.coalesce && _queue_count > 0) {
+		trigger_t &last = _queue[(_queue_first + _queue_count - 1) % _queue_size];
+		if (Overlap (last.info, info)) {
+			ssi_event_t *event = last.info.event;
+			Merge (last.info, info);
+			last.info.event = event;
+			ssi_event_destroy (*event);
+			ssi_event_clone (*info.event, *event);
+			_n_coalesced++;
+			return;
+		}
+	}
+
+	if (_queue_count == _queue_size) {
+		ssi_msg (SSI_LOG_LEVEL_DETAIL, "queue full, drop event (%.2lf@%.2lf)", _queue[_queue_first].info.dur, _queue[_queue_first].info.time);
+		_queue_first = (_queue_first + 1) % _queue_size;
+		_queue_count--;
+		_n_dropped++;
+	}
+
+	trigger_t &trigger = _queue[(_queue_first + _queue_count) % _queue_size];
+	trigger.info.time = info.time;
+	trigger.info.dur = info.dur;
+	trigger.info.status = info.status;
+	ssi_event_destroy (*trigger.info.event);
+	ssi_event_clone (*info.event, *trigger.info.event);
+	trigger.time_ms = time_ms;
+	_queue_count++;
 }
 
 void EventConsumer::consume (IConsumer::info info) {
@@ -223,11 +310,22 @@ void EventConsumer::listen_flush () {
 
 	if (_async) {
 		stop ();
+
+		_n_dropped += _queue_count;
+		for (ssi_size_t i = 0; i < _queue_size; i++) {
+			ssi_event_destroy (*_queue[i].info.event);
+			delete _queue[i].info.event;
+		}
+		delete[] _queue; _queue = 0;
+		_queue_size = 0;
+		_queue_count = 0;
 	}
 
 	for (ssi_size_t i = 0; i < _consumer_count; i++) {
 		_consumer[i]->flush ();
 	}
+
+	ssi_msg (SSI_LOG_LEVEL_BASIC, "processed %u, coalesced %u, dropped %u events (latency mean=%.1lfms max=%ums)", _n_processed, _n_coalesced, _n_dropped, getMeanLatencyMs (), _latency_max);
 }
 
 void EventConsumer::terminate () {
@@ -242,26 +340,37 @@ void EventConsumer::run () {
 
 	_update_event.wait ();
 
-	if (_terminate) {
-		return;
-	}
-
-	IConsumer::info info;
-	info.event = new ssi_event_t;
-    {
-		Lock lock (_update_mutex);
-
-		info.dur = _update_info.dur;
-		info.time = _update_info.time;
-		info.status = _update_info.status;
-        ssi_event_clone(*_update_info.event, *info.event);
-	}
+	// process all pending events
+	while (!_terminate) {
 
-	consume (info);
+		{
+			Lock lock (_update_mutex);
 
-	ssi_event_destroy(*info.event);
-    delete info.event;
+			if (_queue_count == 0) {
+				break;
+			}
+
+			trigger_t &trigger = _queue[_queue_first];
+			_update_info.dur = trigger.info.dur;
+			_update_info.time = trigger.info.time;
+			_update_info.status = trigger.info.status;
+			ssi_event_destroy (*_update_info.event);
+			ssi_event_clone (*trigger.info.event, *_update_info.event);
+
+			ssi_size_t now = _frame->GetElapsedTimeMs ();
+			ssi_size_t latency = now > trigger.time_ms ? now - trigger.time_ms : 0;
+			_latency_sum += latency;
+			if (latency > _latency_max) {
+				_latency_max = latency;
+			}
+
+			_queue_first = (_queue_first + 1) % _queue_size;
+			_queue_count--;
+		}
 
+		consume (_update_info);
+		_n_processed++;
+	}
 }
 
 }
@@ -54,6 +54,10 @@ Transformer::Transformer (int buffer_id_in,
 	_xtra_stream_num (0),
 	_xtra_stream_ids (0),
 	_xtra_streams (0),
+	_xtra_resamplers (0),
+	_xtra_raw (0),
+	_xtra_aligned_pos (0),
+	_xtra_aligned (false),
 	_frame (0) {
 
 	init(frame_size, delta_size, buffer_size);
@@ -73,6 +77,10 @@ Transformer::Transformer (int buffer_id_in,
 	_xtra_stream_num (xtra_buffer_num),
 	_xtra_stream_ids (0),
 	_xtra_streams (0),
+	_xtra_resamplers (0),
+	_xtra_raw (0),
+	_xtra_aligned_pos (0),
+	_xtra_aligned (false),
 	_frame (0) {
 
 	_xtra_stream_ids = new int[_xtra_stream_num];
@@ -167,6 +175,29 @@ void Transformer::init (ssi_size_t frame_size,
 			// init streams
 			ssi_stream_init (_xtra_streams[i], 0, dim, byte, type, sr);
 		}
+
+		// resample xtra streams that do not run at the main rate
+		if (_transformer->alignXtraStreams ()) {
+			_xtra_resamplers = new Resampler *[_xtra_stream_num];
+			_xtra_raw = new ssi_stream_t[_xtra_stream_num];
+			for (ssi_size_t i = 0; i < _xtra_stream_num; i++) {
+				_xtra_resamplers[i] = 0;
+				_xtra_raw[i] = _xtra_streams[i];
+				if (_xtra_streams[i].sr == sample_rate_in) {
+					continue;
+				}
+				if (_xtra_streams[i].type != SSI_REAL) {
+					ssi_wrn ("cannot resample xtra stream#%u of type %s", i, SSI_TYPE_NAMES[_xtra_streams[i].type]);
+					continue;
+				}
+				ssi_size_t up, down;
+				Resampler::Ratio (_xtra_streams[i].sr, sample_rate_in, up, down);
+				_xtra_resamplers[i] = new Resampler ();
+				_xtra_resamplers[i]->init (_xtra_streams[i].dim, up, down, 16, true);
+				ssi_stream_init (_xtra_streams[i], 0, _xtra_raw[i].dim, _xtra_raw[i].byte, _xtra_raw[i].type, sample_rate_in);
+				ssi_msg (SSI_LOG_LEVEL_DETAIL, "resample xtra stream#%u %.2lf -> %.2lf hz (%u/%u)", i, _xtra_raw[i].sr, sample_rate_in, up, down);
+			}
+		}
 	}
 
 	// initialize trigger stream
@@ -198,6 +229,16 @@ Transformer::~Transformer () {
 			ssi_stream_destroy (_xtra_streams[i]);
 		}		
 	}
+	if (_xtra_resamplers) {
+		for (ssi_size_t i = 0; i < _xtra_stream_num; i++) {
+			if (_xtra_resamplers[i]) {
+				ssi_stream_destroy (_xtra_raw[i]);
+				delete _xtra_resamplers[i];
+			}
+		}
+	}
+	delete[] _xtra_resamplers;
+	delete[] _xtra_raw;
 	delete[] _xtra_streams;
 	delete[] _xtra_stream_ids;
 }
@@ -215,6 +256,15 @@ void Transformer::enter () {
 	ssi_stream_adjust (_stream_in, _sample_number_in);
 	ssi_stream_adjust (_stream_out, _sample_number_out);
 
+	if (_xtra_resamplers) {
+		for (ssi_size_t i = 0; i < _xtra_stream_num; i++) {
+			if (_xtra_resamplers[i]) {
+				ssi_stream_adjust (_xtra_streams[i], _sample_number_in);
+			}
+		}
+		_xtra_aligned = false;
+	}
+
 	ssi_time_t buffer_size;
 	_frame->GetCapacity(_buffer_id_out, buffer_size);
 
@@ -325,6 +375,9 @@ int Transformer::transform () {
 
 	// get data from additional buffers
 	for (ssi_size_t i = 0; i < _xtra_stream_num; i++) {
+		if (_xtra_resamplers && _xtra_resamplers[i]) {
+			continue;
+		}
 		ssi_time_t time = ssi_cast (ssi_time_t, _read_pos) / ssi_cast (ssi_time_t, _stream_in.sr);
 		ssi_time_t duration = _frame_size + _delta_size;
 		status = _frame->GetData (_xtra_stream_ids[i], _xtra_streams[i], time, duration);		
@@ -333,6 +386,14 @@ int Transformer::transform () {
 		}
 	}
 
+	// get data from additional buffers that are resampled
+	if (_xtra_resamplers) {
+		status = align_xtra ();
+		if (status != TimeBuffer::SUCCESS) {
+			return status;
+		}
+	}
+
 	// transform data
 	ITransformer::info tinfo;
 	tinfo.delta_num = _sample_number_delta;
@@ -348,6 +409,67 @@ int Transformer::transform () {
 	return TimeBuffer::SUCCESS;
 }
 
+int Transformer::align_xtra () {
+
+	int status;
+
+	// continue the filters if this frame follows the last one, otherwise start over at the current position
+	bool restart = !_xtra_aligned || _xtra_aligned_pos + _sample_number_frame != _read_pos;
+	ssi_lsize_t out_end = _read_pos + _sample_number_in;
+
+	// first read everything, so a failed read leaves the filter state untouched
+	for (ssi_size_t i = 0; i < _xtra_stream_num; i++) {
+
+		Resampler *resampler = _xtra_resamplers[i];
+		if (!resampler) {
+			continue;
+		}
+
+		if (restart) {
+			resampler->reset (_read_pos);
+		}
+
+		ssi_lsize_t in_from = resampler->getInputPos ();
+		ssi_lsize_t in_to = resampler->getInputEnd (out_end);
+		ssi_size_t num = in_to > in_from ? ssi_cast (ssi_size_t, in_to - in_from) : 0;
+
+		ssi_stream_adjust (_xtra_raw[i], num);
+		if (num > 0) {
+			status = _frame->GetData (_xtra_stream_ids[i], _xtra_raw[i].ptr, num, in_from);
+			if (status != TimeBuffer::SUCCESS) {
+				return status;
+			}
+		}
+	}
+
+	// then run the filters, samples of the last delta are kept
+	ssi_size_t keep = restart ? 0 : _sample_number_delta;
+	for (ssi_size_t i = 0; i < _xtra_stream_num; i++) {
+
+		Resampler *resampler = _xtra_resamplers[i];
+		if (!resampler) {
+			continue;
+		}
+
+		ssi_stream_t &s = _xtra_streams[i];
+		ssi_size_t sample_bytes = s.dim * s.byte;
+		if (keep > 0) {
+			memmove (s.ptr, s.ptr + _sample_number_frame * sample_bytes, keep * sample_bytes);
+		}
+
+		resampler->push (_xtra_raw[i].num, ssi_pcast (ssi_real_t, _xtra_raw[i].ptr));
+		ssi_size_t num = resampler->pull (_sample_number_in - keep, ssi_pcast (ssi_real_t, s.ptr + keep * sample_bytes));
+		if (keep + num < _sample_number_in) {
+			memset (s.ptr + (keep + num) * sample_bytes, 0, (_sample_number_in - keep - num) * sample_bytes);
+		}
+	}
+
+	_xtra_aligned_pos = _read_pos;
+	_xtra_aligned = true;
+
+	return TimeBuffer::SUCCESS;
+}
+
 void Transformer::flush () {
 
 	ssi_msg (SSI_LOG_LEVEL_BASIC, "stop '%s:%s'", _transformer->getName (), Factory::GetObjectId(_transformer));
@@ -589,7 +589,7 @@ IObject *XMLPipeline::parseObject (TiXmlElement *element, bool auto_free) {
 	TiXmlAttribute *attribute = element->FirstAttribute ();
 	while (attribute)
 	{
-		if (strcmp (attribute->Name(), "create") != 0 && strcmp (attribute->Name(), "option") != 0) {
+		if (strcmp (attribute->Name(), "create") != 0 && strcmp (attribute->Name(), "option") != 0 && strcmp (attribute->Name(), "unique") != 0) {
 			if (object->getOptions ()->setOptionValueFromString (attribute->Name (), attribute->Value ())) {
 				SSI_DBG (SSI_LOG_LEVEL_DEBUG, "%s: set option <'%s'='%s'>", element->Value (), attribute->Name(), attribute->Value ());
 			}
@@ -811,11 +811,6 @@ bool XMLPipeline::parseSensor (TiXmlElement *element) {
 
 bool XMLPipeline::parseTransformer (TiXmlElement *element) {
 
-	ITransformer *transformer = ssi_pcast (ITransformer, parseObject (element));
-	if (!transformer) {
-		return false;
-	}
-
 	ssi_size_t xinput_size = 0;
 	ssi_char_t **xinput_pins = 0;
 
@@ -963,16 +958,53 @@ bool XMLPipeline::parseTransformer (TiXmlElement *element) {
 		}
 	}
 
-	if (input_async) {
-		Asynchronous *asynchronous = ssi_pcast (Asynchronous, Factory::Create (Asynchronous::GetCreateName ()));
-		asynchronous->setTransformer (transformer);		
-		ITransformable *output_transformable = output_transformable = _frame->AddTransformer(input_transformable, xinput_size, xinput_transformable, asynchronous, input_frame_size, input_delta_size, output_buffer_size == 0 ? THEFRAMEWORK_DEFAULT_BUFFER_CAP : output_buffer_size, input_trigger);
-		_transformable_map.insert (transformable_pair_t (String (output_pin), output_transformable));
-	} else {
-		ITransformable *output_transformable = output_transformable = _frame->AddTransformer(input_transformable, xinput_size, xinput_transformable, transformer, input_frame_size, input_delta_size, output_buffer_size == 0 ? THEFRAMEWORK_DEFAULT_BUFFER_CAP : output_buffer_size, input_trigger);
-		_transformable_map.insert (transformable_pair_t (String (output_pin), output_transformable));
+	// transformers with an explicit id, that receive events, or are marked as unique, always get their own instance
+	bool unique = false;
+	const ssi_char_t *unique_s = element->Attribute ("unique");
+	if (unique_s && compare ("true", unique_s)) {
+		unique = true;
+	}
+	const ssi_char_t *create = element->Attribute ("create");
+	if (!create || strchr (create, ':') || element->FirstChildElement ("listen")) {
+		unique = true;
+	}
+
+	// reuse output of an identical transformer, before a second instance is created
+	ITransformable *output_transformable = 0;
+	String signature;
+	if (!unique) {
+		signature = getSignature (element, input_transformable, xinput_size, xinput_transformable, input_trigger, input_frame_size, input_delta_size, input_async, output_buffer_size);
+		signature_map_t::iterator it = _signature_map.find (signature);
+		if (it != _signature_map.end ()) {
+			output_transformable = getTransformable (it->second.str ());
+			if (output_transformable) {
+				ssi_msg (SSI_LOG_LEVEL_BASIC, "merge transformer '%s' with output '%s' into identical transformer with output '%s'", create, output_pin, it->second.str ());
+			}
+		}
 	}
 
+	if (!output_transformable) {
+
+		ITransformer *transformer = ssi_pcast (ITransformer, parseObject (element));
+		if (!transformer) {
+			return false;
+		}
+
+		if (input_async) {
+			Asynchronous *asynchronous = ssi_pcast (Asynchronous, Factory::Create (Asynchronous::GetCreateName ()));
+			asynchronous->setTransformer (transformer);		
+			output_transformable = _frame->AddTransformer(input_transformable, xinput_size, xinput_transformable, asynchronous, input_frame_size, input_delta_size, output_buffer_size == 0 ? THEFRAMEWORK_DEFAULT_BUFFER_CAP : output_buffer_size, input_trigger);
+		} else {
+			output_transformable = _frame->AddTransformer(input_transformable, xinput_size, xinput_transformable, transformer, input_frame_size, input_delta_size, output_buffer_size == 0 ? THEFRAMEWORK_DEFAULT_BUFFER_CAP : output_buffer_size, input_trigger);
+		}
+
+		// a transformer that sends events has to be kept apart from identical ones
+		if (!unique && !transformer->getEventAddress ()) {
+			_signature_map.insert (signature_pair_t (signature, String (output_pin)));
+		}
+	}
+	_transformable_map.insert (transformable_pair_t (String (output_pin), output_transformable));
+
 	delete[] input_pin;
 	for (ssi_size_t i = 0; i < xinput_size; i++) {
 		delete[] xinput_pins[i];
@@ -983,6 +1015,67 @@ bool XMLPipeline::parseTransformer (TiXmlElement *element) {
 	return true;
 }
 
+String XMLPipeline::getSignature (TiXmlElement *element,
+	ITransformable *input,
+	ssi_size_t xinput_size,
+	ITransformable **xinput,
+	ITransformable *trigger,
+	const ssi_char_t *frame_size,
+	const ssi_char_t *delta_size,
+	bool async,
+	const ssi_char_t *buffer_size) {
+
+	// component name, option file and options as they are set in the pipeline,
+	// attributes are sorted so that their order does not matter
+	std::map<String, String> attributes;
+	TiXmlAttribute *attribute = element->FirstAttribute ();
+	while (attribute) {
+		if (strcmp (attribute->Name (), "unique") != 0) {
+			attributes[String (attribute->Name ())] = String (attribute->Value ());
+		}
+		attribute = attribute->Next ();
+	}
+
+	String signature;
+	for (std::map<String, String>::iterator it = attributes.begin (); it != attributes.end (); it++) {
+		signature += it->first.str ();
+		signature += "=";
+		signature += it->second.str ();
+		signature += " ";
+	}
+
+	// buffers are identified by id, sizes are converted to samples
+	ssi_char_t string[SSI_MAX_CHAR];
+	ssi_sprint (string, " | input=%d", input->getBufferId ());
+	signature += string;
+	for (ssi_size_t i = 0; i < xinput_size; i++) {
+		ssi_sprint (string, ";%d", xinput[i]->getBufferId ());
+		signature += string;
+	}
+	ssi_sprint (string, " | trigger=%d", trigger ? trigger->getBufferId () : -1);
+	signature += string;
+
+	ssi_size_t samples = 0;
+	if (ssi_parse_samples (frame_size, samples, input->getSampleRate ())) {
+		ssi_sprint (string, " | frame=%u", samples);
+	} else {
+		ssi_sprint (string, " | frame=%s", frame_size);
+	}
+	signature += string;
+	samples = 0;
+	if (delta_size && ssi_parse_samples (delta_size, samples, input->getSampleRate ())) {
+		ssi_sprint (string, " | delta=%u", samples);
+	} else {
+		ssi_sprint (string, " | delta=%s", delta_size ? delta_size : "0");
+	}
+	signature += string;
+
+	ssi_sprint (string, " | async=%s | size=%s", async ? "true" : "false", buffer_size ? buffer_size : THEFRAMEWORK_DEFAULT_BUFFER_CAP);
+	signature += string;
+
+	return signature;
+}
+
 bool XMLPipeline::parseConsumer (TiXmlElement *element) {
 
 	IConsumer *consumer = ssi_pcast (IConsumer, parseObject (element));
@@ -1256,6 +1349,7 @@ IConsumer *XMLPipeline::getConsumer (const ssi_char_t *name) {
 void XMLPipeline::clear () {
 
 	_transformable_map.clear ();
+	_signature_map.clear ();
 	_start_eboard = false;
 	for (ssi_size_t i = 0; i < _n_global_confpaths; i++) {
 		delete[] _global_confpaths[i];
@@ -34,6 +34,7 @@ using namespace ssi;
 #include "RampFilt.h"
 #include "MeanFeat.h"
 #include "Delay.h"
+#include "signal/TypeCast.h"
 
 #ifdef USE_SSI_LEAK_DETECTOR
 	#include "SSI_LeakWatcher.h"
@@ -57,6 +58,8 @@ bool ex_highsr(void *arg);
 bool ex_timeserver(void *arg);
 bool ex_xml(void *arg);
 bool ex_export(void *arg);
+bool ex_merge(void *arg);
+bool ex_typecast(void *arg);
 
 #define PI 3.14159
 #define CONSOLE_WIDTH 650
@@ -99,6 +102,8 @@ int main () {
 	ex.add(&ex_timeserver, 0, "TIMESERVER", "How to use pipeline as a timeserver.");
 	ex.add(&ex_xml, 0, "XML", "How to run a xml pipeline from code.");
 	ex.add(&ex_export, 0, "EXPORT", "How to export dlls used by a pipeline to a directory.");
+	ex.add(&ex_merge, 0, "MERGE", "Identical transformers in a pipeline share a single instance.");
+	ex.add(&ex_typecast, 0, "TYPECAST", "Compare vectorized and scalar type conversion.");
 	ex.show();
 
 	Factory::Clear ();
@@ -792,3 +797,100 @@ bool ex_export(void *arg) {
 
 	return true;
 }
+
+bool ex_merge(void *arg) {
+
+	XMLPipeline *xmlpipe = ssi_create(XMLPipeline, 0, false);
+	if (!xmlpipe->parse("merge")) {
+		ssi_wrn("could not parse pipeline");
+		delete xmlpipe;
+		return false;
+	}
+
+	// 'merged-a' and 'merged-b' share an instance, 'own' has an explicit id
+	ssi_char_t **ids = 0;
+	ssi_size_t n_ids = Factory::GetObjectIds(&ids);
+	ssi_size_t n_selectors = 0;
+	for (ssi_size_t i = 0; i < n_ids; i++) {
+		IObject *object = Factory::GetObjectFromId(ids[i]);
+		if (object && ssi_strcmp(object->getName(), Selector::GetCreateName())) {
+			n_selectors++;
+		}
+		delete[] ids[i];
+	}
+	delete[] ids;
+
+	ssi_print("\n\tselectors: %u (expected 2) %s\n\n", n_selectors, n_selectors == 2 ? "ok" : "failed");
+
+	ITheFramework *frame = Factory::GetFramework();
+
+	frame->Start();
+	frame->Wait();
+	frame->Stop();
+	frame->Clear();
+
+	delete xmlpipe;
+
+	return n_selectors == 2;
+}
+
+bool ex_typecast(void *arg) {
+
+	ssi_size_t n = 48000 * 60;
+	ssi_size_t repeat = 20;
+
+	ssi_real_t *floats = new ssi_real_t[n];
+	int16_t *shorts = new int16_t[n];
+	int16_t *shorts_check = new int16_t[n];
+	ssi_real_t *floats_check = new ssi_real_t[n];
+	ssi_real_t *floats_out = new ssi_real_t[n];
+
+	for (ssi_size_t i = 0; i < n; i++) {
+		floats[i] = ssi_cast (ssi_real_t, 1.2 * sin (i * 0.01));
+	}
+
+	ssi_size_t features = TypeCast::GetCpuFeatures ();
+	ssi_print ("cpu features: %s%s%s%s\n\n", features & TypeCast::SSE2 ? "SSE2 " : "", features & TypeCast::SSE41 ? "SSE4.1 " : "", features & TypeCast::AVX2 ? "AVX2 " : "", features & TypeCast::NEON ? "NEON " : "");
+
+	ssi_size_t masks[] = { 0, features };
+	const ssi_char_t *names[] = { "scalar", "simd" };
+
+	for (ssi_size_t m = 0; m < 2; m++) {
+
+		TypeCast::SetCpuFeatures (masks[m]);
+		ssi_cast_kernel_t to_short = TypeCast::Resolve (SSI_FLOAT, SSI_SHORT);
+		ssi_cast_kernel_t to_float = TypeCast::Resolve (SSI_SHORT, SSI_FLOAT);
+
+		int16_t *s = m == 0 ? shorts_check : shorts;
+		ssi_real_t *f = m == 0 ? floats_check : floats_out;
+
+		ssi_size_t start = ssi_time_ms ();
+		for (ssi_size_t r = 0; r < repeat; r++) {
+			to_short (n, floats, s, 32768.0f);
+			to_float (n, s, f, 1.0f / 32768.0f);
+		}
+		ssi_print ("%s: %u ms\n", names[m], ssi_time_ms () - start);
+	}
+
+	// clipped samples have to saturate in both variants
+	ssi_size_t diff = 0;
+	for (ssi_size_t i = 0; i < n; i++) {
+		if (shorts[i] != shorts_check[i]) {
+			diff++;
+		}
+		if (floats_out[i] != floats_check[i]) {
+			diff++;
+		}
+	}
+	ssi_print ("\n%u of %u samples differ\n", diff, 2 * n);
+
+	TypeCast::SetCpuFeatures (features);
+
+	delete[] floats;
+	delete[] shorts;
+	delete[] shorts_check;
+	delete[] floats_check;
+	delete[] floats_out;
+
+	return true;
+}
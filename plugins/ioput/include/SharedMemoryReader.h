@@ -0,0 +1,161 @@
+// SharedMemoryReader.h
+// created: 2026/10/19
+// Copyright (C) University of Augsburg, Lab for Human Centered Multimedia
+//
+// *************************************************************************************************
+//
+// This file is part of Social Signal Interpretation (SSI) developed at the 
+// Lab for Human Centered Multimedia of the University of Augsburg
+//
+// This library is free software; you can redistribute itand/or
+// modify it under the terms of the GNU General Public
+// License as published by the Free Software Foundation; either
+// version 3 of the License, or any laterversion.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FORA PARTICULAR PURPOSE.  See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public
+// License along withthis library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+//
+//*************************************************************************************************
+
+#pragma once
+
+#ifndef SSI_IOPUT_SHAREDMEMORYREADER_H
+#define SSI_IOPUT_SHAREDMEMORYREADER_H
+
+#include "base/ISensor.h"
+#include "thread/Thread.h"
+#include "ioput/option/OptionList.h"
+#include "SharedMemoryRing.h"
+
+#define SSI_SHAREDMEMORYREADER_PROVIDER_NAME "shm"
+
+namespace ssi {
+
+//! \brief Provides a stream published by a SharedMemoryWriter in another process.
+//
+// Samples are copied from the shared ring to a staging buffer before they are
+// passed to the provider, samples the writer has overwritten in the meantime or
+// the reader has missed are replaced by zeros. When the reader attaches, the
+// stream is padded or skipped according to the start time of the writer, so that
+// both streams share the same time base.
+//
+class SharedMemoryReader : public ISensor, public Thread {
+
+	class SharedMemoryChannel : public IChannel {
+
+		friend class SharedMemoryReader;
+
+		public:
+
+			SharedMemoryChannel () {
+				ssi_stream_init (stream, 0, 0, 0, SSI_UNDEF, 0);
+			}
+			~SharedMemoryChannel () {
+				ssi_stream_destroy (stream);
+			}
+
+			const ssi_char_t *getName () { return SSI_SHAREDMEMORYREADER_PROVIDER_NAME; };
+			const ssi_char_t *getInfo () { return "Properties are determined from the options."; };
+			ssi_stream_t getStream () { return stream; };
+
+		protected:
+
+			ssi_stream_t stream;
+	};
+
+public:
+
+	class Options : public OptionList {
+
+	public:
+
+		Options ()
+			: ssr (0), sdim (0), sbyte (0), stype (SSI_UNDEF), timeout (100) {
+
+			setName ("ssi");
+
+			addOption ("name", name, SSI_MAX_CHAR, SSI_CHAR, "name of shared memory segment");
+			addOption ("ssr", &ssr, 1, SSI_DOUBLE, "sample rate in Hz");
+			addOption ("sdim", &sdim, 1, SSI_UINT, "sample dimension");
+			addOption ("sbyte", &sbyte, 1, SSI_UINT, "sample bytes");
+			addOption ("stype", &stype, 1, SSI_UCHAR, "sample type (0=UNDEF, 1=CHAR, 2=UCHAR, 3=SHORT 4=USHORT, 5=INT, 6=UINT, 7=LONG, 8=ULONG, 9=FLOAT, 10=DOUBLE, 11=LDOUBLE, 12=STRUCT, 13=IMAGE, 14=BOOL)");
+			addOption ("timeout", &timeout, 1, SSI_UINT, "time out in milliseconds");
+		};
+
+		void setName (const ssi_char_t *name) {
+			this->name[0] = '\0';
+			if (name) {
+				ssi_strcpy (this->name, name);
+			}
+		}
+		void setSampleInfo (ssi_time_t sr, ssi_size_t dim, ssi_size_t byte, ssi_type_t type) {
+			ssr = sr; sdim = dim; sbyte = byte; stype = type;
+		}
+
+		ssi_char_t name[SSI_MAX_CHAR];
+		ssi_time_t ssr;
+		ssi_size_t sdim;
+		ssi_size_t sbyte;
+		ssi_type_t stype;
+		ssi_size_t timeout;
+	};
+
+public:
+
+	static const ssi_char_t *GetCreateName () { return "SharedMemoryReader"; };
+	static IObject *Create (const ssi_char_t *file) { return new SharedMemoryReader (file); };
+	~SharedMemoryReader ();
+	
+	SharedMemoryReader::Options *getOptions () { return &_options; };
+	const ssi_char_t *getName () { return GetCreateName (); };
+	const ssi_char_t *getInfo () { return "Receives a stream from a SharedMemoryWriter in another process."; };
+
+	ssi_size_t getChannelSize () { return 1; };
+	IChannel *getChannel (ssi_size_t index) { return &_channel; };
+	bool setProvider (const ssi_char_t *name, IProvider *provider);
+	bool connect ();
+	bool start () { return Thread::start (); };
+	bool stop () { return Thread::stop (); };
+	void run ();
+	void terminate ();
+	bool disconnect ();
+
+	static void SetLogLevel (int level) {
+		ssi_log_level = level;
+	}
+	
+protected:
+
+	SharedMemoryReader (const ssi_char_t *file = 0);
+	SharedMemoryReader::Options _options;
+	ssi_char_t *_file;
+
+	static ssi_char_t *ssi_log_name;
+	static int ssi_log_level;
+
+	bool attach ();
+	bool align ();
+	void read (uint64_t written);
+	void provideZeros (uint64_t num);
+
+	SharedMemoryChannel _channel;
+	IProvider *_provider;
+	SharedMemoryRing _ring;
+	uint64_t _position;
+	ssi_byte_t *_zeros;
+	ssi_byte_t *_buffer;
+	ssi_size_t _n_zeros;
+	uint64_t _provided;
+	bool _aligned;
+	ssi_size_t _bytes_per_sample;
+};
+
+}
+
+#endif
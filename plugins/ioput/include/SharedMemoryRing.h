@@ -0,0 +1,131 @@
+// SharedMemoryRing.h
+// created: 2026/10/19
+// Copyright (C) University of Augsburg, Lab for Human Centered Multimedia
+//
+// *************************************************************************************************
+//
+// This file is part of Social Signal Interpretation (SSI) developed at the 
+// Lab for Human Centered Multimedia of the University of Augsburg
+//
+// This library is free software; you can redistribute itand/or
+// modify it under the terms of the GNU General Public
+// License as published by the Free Software Foundation; either
+// version 3 of the License, or any laterversion.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FORA PARTICULAR PURPOSE.  See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public
+// License along withthis library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+//
+//*************************************************************************************************
+
+#pragma once
+
+#ifndef SSI_IOPUT_SHAREDMEMORYRING_H
+#define SSI_IOPUT_SHAREDMEMORYRING_H
+
+#include "SSI_Cons.h"
+
+#include <atomic>
+
+namespace ssi {
+
+//! \brief Ring of stream samples in a named shared memory segment.
+//
+// A single writer appends samples, any number of readers in other processes
+// follow. Samples are counted from the first sample ever written, a reader
+// keeps its own position and can tell from the counter whether samples were
+// overwritten before it got to them. Readers are woken through a futex on
+// Linux and an event per reader on Windows, otherwise they poll.
+//
+class SharedMemoryRing {
+
+public:
+
+	// header at the start of the segment
+	struct Header {
+
+		static const uint32_t MAGIC = 0x52495353; // 'SSIR'
+		static const uint32_t VERSION = 2;
+		static const uint32_t MAX_READERS = 32;
+
+		uint32_t magic;
+		uint32_t version;
+		uint32_t dim;
+		uint32_t byte;
+		uint32_t type; // ssi_type_t
+		uint32_t capacity; // samples
+		uint32_t start; // framework start of the writer in ms, see ITheFramework::GetStartTimeMs()
+		ssi_time_t sr;
+		ssi_time_t time; // stream time of the first sample
+
+		std::atomic<uint64_t> written; // total number of samples
+		std::atomic<uint64_t> writing; // written plus samples that are being copied
+		std::atomic<uint32_t> alive; // 0 after the writer has closed the ring
+		std::atomic<uint32_t> seq; // incremented after each write
+		std::atomic<uint32_t> waiting; // number of waiting readers
+		std::atomic<uint32_t> readers; // bit i is set while reader i has an event (windows)
+	};
+
+	SharedMemoryRing ();
+	virtual ~SharedMemoryRing ();
+
+	// writer: creates (or replaces) the segment
+	bool create (const ssi_char_t *name,
+		ssi_time_t sr,
+		ssi_size_t dim,
+		ssi_size_t byte,
+		ssi_type_t type,
+		ssi_size_t capacity);
+	// reader: opens an existing segment
+	bool open (const ssi_char_t *name);
+	void close ();
+
+	bool isOpen () { return _header != 0; };
+	bool isAlive () { return _header && _header->alive.load (std::memory_order_acquire) != 0; };
+	Header *getHeader () { return _header; };
+	ssi_byte_t *getData () { return _data; };
+
+	// writer: appends samples, only the last 'capacity' samples are kept
+	void write (ssi_size_t num, const ssi_byte_t *ptr, ssi_time_t time);
+
+	// reader: number of samples written so far
+	uint64_t getWritten () { return _header->written.load (std::memory_order_acquire); };
+	// reader: copies num samples starting at position, returns how many of the first
+	// samples the writer may have overwritten in the meantime
+	ssi_size_t read (uint64_t position, ssi_size_t num, ssi_byte_t *ptr);
+	// reader: waits until more than 'position' samples are written or timeout (ms) elapses
+	uint64_t wait (uint64_t position, ssi_size_t timeout);
+
+protected:
+
+	static ssi_char_t *ssi_log_name;
+	static int ssi_log_level;
+
+	static ssi_size_t DataOffset ();
+	bool map (const ssi_char_t *name, ssi_size_t size, bool create);
+	void notify ();
+
+	bool _owner;
+	ssi_char_t *_name;
+	ssi_size_t _size;
+	Header *_header;
+	ssi_byte_t *_data;
+	ssi_size_t _bytes_per_sample;
+
+#if _WIN32|_WIN64
+	bool registerReader ();
+	void *_mapping;
+	void *_event; // reader
+	int _reader;
+	void *_events[Header::MAX_READERS]; // writer
+#endif
+};
+
+}
+
+#endif
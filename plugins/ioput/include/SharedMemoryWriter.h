@@ -0,0 +1,101 @@
+// SharedMemoryWriter.h
+// created: 2026/10/19
+// Copyright (C) University of Augsburg, Lab for Human Centered Multimedia
+//
+// *************************************************************************************************
+//
+// This file is part of Social Signal Interpretation (SSI) developed at the 
+// Lab for Human Centered Multimedia of the University of Augsburg
+//
+// This library is free software; you can redistribute itand/or
+// modify it under the terms of the GNU General Public
+// License as published by the Free Software Foundation; either
+// version 3 of the License, or any laterversion.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FORA PARTICULAR PURPOSE.  See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public
+// License along withthis library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+//
+//*************************************************************************************************
+
+#pragma once
+
+#ifndef SSI_IOPUT_SHAREDMEMORYWRITER_H
+#define SSI_IOPUT_SHAREDMEMORYWRITER_H
+
+#include "base/IConsumer.h"
+#include "ioput/option/OptionList.h"
+#include "SharedMemoryRing.h"
+
+namespace ssi {
+
+class SharedMemoryWriter : public IConsumer {
+
+public:
+
+	class Options : public OptionList {
+
+	public:
+
+		Options ()
+			: size (10.0) {
+
+			setName ("ssi");
+
+			addOption ("name", name, SSI_MAX_CHAR, SSI_CHAR, "name of shared memory segment");
+			addOption ("size", &size, 1, SSI_DOUBLE, "size of ring in seconds");
+		};
+
+		void setName (const ssi_char_t *name) {
+			this->name[0] = '\0';
+			if (name) {
+				ssi_strcpy (this->name, name);
+			}
+		}
+
+		ssi_char_t name[SSI_MAX_CHAR];
+		ssi_time_t size;
+	};
+
+public:
+
+	static const ssi_char_t *GetCreateName () { return "SharedMemoryWriter"; };
+	static IObject *Create (const ssi_char_t *file) { return new SharedMemoryWriter (file); };
+	~SharedMemoryWriter ();
+	
+	SharedMemoryWriter::Options *getOptions () { return &_options; };
+	const ssi_char_t *getName () { return GetCreateName (); };
+	const ssi_char_t *getInfo () { return "Publishes a stream to other processes through a ring in shared memory (see SharedMemoryReader)."; };
+
+	void consume_enter (ssi_size_t stream_in_num,
+		ssi_stream_t stream_in[]);
+	void consume (IConsumer::info consume_info,
+		ssi_size_t stream_in_num,
+		ssi_stream_t stream_in[]);
+	void consume_flush (ssi_size_t stream_in_num,
+		ssi_stream_t stream_in[]);
+
+	static void SetLogLevel (int level) {
+		ssi_log_level = level;
+	}
+	
+protected:
+
+	SharedMemoryWriter (const ssi_char_t *file = 0);
+	SharedMemoryWriter::Options _options;
+	ssi_char_t *_file;
+
+	SharedMemoryRing _ring;
+
+	static ssi_char_t *ssi_log_name;
+	static int ssi_log_level;
+};
+
+}
+
+#endif
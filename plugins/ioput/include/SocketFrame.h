@@ -0,0 +1,55 @@
+// SocketFrame.h
+// created: 2026/10/19
+// Copyright (C) University of Augsburg, Lab for Human Centered Multimedia
+//
+// *************************************************************************************************
+//
+// This file is part of Social Signal Interpretation (SSI) developed at the 
+// Lab for Human Centered Multimedia of the University of Augsburg
+//
+// This library is free software; you can redistribute itand/or
+// modify it under the terms of the GNU General Public
+// License as published by the Free Software Foundation; either
+// version 3 of the License, or any laterversion.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FORA PARTICULAR PURPOSE.  See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public
+// License along withthis library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+//
+//*************************************************************************************************
+
+
+#pragma once
+
+#ifndef SSI_SOCKET_SOCKETFRAME_H
+#define SSI_SOCKET_SOCKETFRAME_H
+
+#include "SSI_Cons.h"
+
+namespace ssi {
+
+// header preceding each stream frame if streaming in FRAMED format,
+// frames are sent one after another and several may share a packet
+#pragma pack(push, 1)
+struct SocketFrameHeader {
+
+	static const uint32_t MAGIC = 0x46495353; // 'SSIF'
+
+	uint32_t magic;
+	uint16_t id;   // stream index
+	uint16_t type; // ssi_type_t
+	uint32_t num;
+	uint32_t dim;
+	uint32_t byte;
+	ssi_time_t time;
+};
+#pragma pack(pop)
+
+}
+
+#endif
@@ -35,6 +35,7 @@
 #include "ioput/socket/SocketImage.h"
 #include "ioput/option/OptionList.h"
 #include "ioput/file/FileMem.h"
+#include "SocketFrame.h"
 
 #define SSI_SOCKETREADER_PROVIDER_NAME "socket"
 
@@ -75,14 +76,15 @@ public:
 				BINARY,
 				ASCII,
 				OSC,
-				IMAGE
+				IMAGE,
+				FRAMED
 			};
 		};
 
 	public:
 
 		Options ()
-			: port (-1), type (Socket::UDP), ssr (0), sdim (0), sbyte (0), stype (SSI_UNDEF), swidth (640), sheight (480), sdepth (8), schannels (3), size (Socket::MAX_MTU_SIZE), timeout (1000), osc (false), format (FORMAT::BINARY) {
+			: port (-1), type (Socket::UDP), ssr (0), sdim (0), sbyte (0), stype (SSI_UNDEF), swidth (640), sheight (480), sdepth (8), schannels (3), size (Socket::MAX_MTU_SIZE), timeout (1000), osc (false), format (FORMAT::BINARY), sid (0) {
 
 			delim[0] = ',';
 			delim[1] = '\0';
@@ -93,7 +95,8 @@ public:
 			addOption ("size", &size, 1, SSI_UINT, "size of buffer");
 			addOption ("type", &type, 1, SSI_UCHAR, "protocol type (0=UDP, 1=TCP)");
 			addOption ("osc", &osc, 1, SSI_BOOL, "use osc format (deprecated, use format instead)");
-			addOption ("format", &format, 1, SSI_INT, "streaming format: 0=BINARY, 1=ASCII, 2=OSC, 3=IMAGE");
+			addOption ("format", &format, 1, SSI_INT, "streaming format: 0=BINARY, 1=ASCII, 2=OSC, 3=IMAGE, 4=FRAMED");
+			addOption ("sid", &sid, 1, SSI_SIZE, "index of stream to read (if format is set to FRAMED)");
 			addOption ("delim", &delim, SSI_MAX_CHAR, SSI_CHAR, "delim chars if streaming in ascii format");
 			addOption ("ssr", &ssr, 1, SSI_DOUBLE, "sample rate in Hz");
 			addOption ("sdim", &sdim, 1, SSI_UINT, "sample dimension (if format is set to BINARY, ASCII or OSC)");
@@ -136,6 +139,7 @@ public:
 		int swidth, sheight, sdepth, schannels;
 		ssi_size_t timeout;		
 		bool osc;
+		ssi_size_t sid;
 	};
 
 
@@ -195,6 +199,9 @@ protected:
 	ssi_size_t _n_buffer;
 	ssi_byte_t *_buffer, *_buffer2;
 	FileMem *_memory;
+	ssi_size_t _n_fill;
+
+	void readFrames ();
 
 	void message (const char *from,
 		const ssi_char_t *sender_id,
@@ -34,6 +34,7 @@
 #include "ioput/socket/SocketOsc.h"
 #include "ioput/socket/SocketImage.h"
 #include "ioput/option/OptionList.h"
+#include "SocketFrame.h"
 #include "base/ITheFramework.h"
 
 namespace ssi {
@@ -51,14 +52,15 @@ public:
 				BINARY,
 				ASCII,
 				OSC,
-				IMAGE
+				IMAGE,
+				FRAMED
 			};
 		};
 
 	public:
 
 		Options ()
-			: port (1234), type (Socket::UDP), osc (false), reltime (false), format (FORMAT::BINARY), compression (SocketImage::COMPRESSION::JPG), packet_delay (3) {
+			: port (1234), type (Socket::UDP), osc (false), reltime (false), format (FORMAT::BINARY), compression (SocketImage::COMPRESSION::JPG), packet_delay (3), batch (1), batch_bytes (0), batch_delay (0) {
 
 			host[0] = '\0';
 			delim[0] = ',';
@@ -69,12 +71,15 @@ public:
 			addOption ("port", &port, 1, SSI_INT, "port number (-1 for any)");		
 			addOption ("type", &type, 1, SSI_UCHAR, "protocol type (0=UDP, 1=TCP)");	
 			addOption ("osc", &osc, 1, SSI_BOOL, "use osc format (deprecated, use format instead)");
-			addOption ("format", &format, 1, SSI_INT, "streaming format: 0=BINARY, 1=ASCII, 2=OSC, 3=IMAGE");
+			addOption ("format", &format, 1, SSI_INT, "streaming format: 0=BINARY, 1=ASCII, 2=OSC, 3=IMAGE, 4=FRAMED (all streams with header)");
 			addOption ("delim", &delim, SSI_MAX_CHAR, SSI_CHAR, "delim chars if streaming in ascii format");
 			addOption ("id", id, SSI_MAX_CHAR, SSI_CHAR, "id if streaming in osc format");
 			addOption ("compression", &compression, 1, SSI_INT, "compression if streaming images (0=NONE,1=JPG)");
 			addOption ("packet_delay", &packet_delay, 1, SSI_SIZE, "delay between sending packets in milliseconds to give receiver some time to pick them up (IMAGE only)");
 			addOption ("reltime", &reltime, 1, SSI_BOOL, "send relative time stamps (OSC only)");
+			addOption ("batch", &batch, 1, SSI_SIZE, "number of frames collected before sending (FRAMED only)");
+			addOption ("batch_bytes", &batch_bytes, 1, SSI_SIZE, "send collected frames once they exceed this number of bytes, 0 for no limit (FRAMED only, UDP never exceeds maximum packet size)");
+			addOption ("batch_delay", &batch_delay, 1, SSI_SIZE, "send collected frames if the oldest is older than this number of milliseconds, 0 for no limit (FRAMED only)");
 		};
 
 		void setHost (const ssi_char_t *host) {
@@ -100,6 +105,9 @@ public:
 		char delim[SSI_MAX_CHAR];
 		SocketImage::COMPRESSION::VALUE compression;
 		ssi_size_t packet_delay;
+		ssi_size_t batch;
+		ssi_size_t batch_bytes;
+		ssi_size_t batch_delay;
 	};
 
 public:
@@ -149,6 +157,18 @@ protected:
 	ssi_video_params_t _video_format;
 	SocketImage *_socket_img;
 
+	void prepareFrames (ssi_size_t stream_in_num, ssi_stream_t stream_in[]);
+	void batchFrames (ssi_size_t stream_in_num, ssi_stream_t stream_in[]);
+	int sendBatch ();
+	SocketFrameHeader *_headers;
+	const void **_parts;
+	ssi_size_t *_part_sizes;
+	ssi_byte_t *_batch;
+	ssi_size_t _batch_size;
+	ssi_size_t _batch_bytes;
+	ssi_size_t _batch_count;
+	ssi_size_t _batch_time;
+
 	ITheFramework *_frame;
 
 	static ssi_char_t *ssi_log_name;
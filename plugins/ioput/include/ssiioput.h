@@ -38,5 +38,7 @@
 #include "ioput/include/SocketEventReader.h"
 #include "ioput/include/FileSampleWriter.h"
 #include "ioput/include/FakeSignal.h"
+#include "ioput/include/SharedMemoryWriter.h"
+#include "ioput/include/SharedMemoryReader.h"
 
 #endif
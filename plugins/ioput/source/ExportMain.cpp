@@ -57,6 +57,8 @@ DLLEXP bool Register (ssi::Factory *factory, FILE *logfile, ssi::IMessage *messa
 	result = ssi::Factory::Register (ssi::SocketEventReader::GetCreateName (),ssi::SocketEventReader::Create) && result;	
 	result = ssi::Factory::Register (ssi::FileSampleWriter::GetCreateName(), ssi::FileSampleWriter::Create) && result;
 	result = ssi::Factory::Register (ssi::FakeSignal::GetCreateName(), ssi::FakeSignal::Create) && result;
+	result = ssi::Factory::Register (ssi::SharedMemoryWriter::GetCreateName(), ssi::SharedMemoryWriter::Create) && result;
+	result = ssi::Factory::Register (ssi::SharedMemoryReader::GetCreateName(), ssi::SharedMemoryReader::Create) && result;
 	
 	return result;
 }
@@ -0,0 +1,258 @@
+// SharedMemoryReader.cpp
+// created: 2026/10/19
+// Copyright (C) University of Augsburg, Lab for Human Centered Multimedia
+//
+// *************************************************************************************************
+//
+// This file is part of Social Signal Interpretation (SSI) developed at the 
+// Lab for Human Centered Multimedia of the University of Augsburg
+//
+// This library is free software; you can redistribute itand/or
+// modify it under the terms of the GNU General Public
+// License as published by the Free Software Foundation; either
+// version 3 of the License, or any laterversion.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FORA PARTICULAR PURPOSE.  See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public
+// License along withthis library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+//
+//*************************************************************************************************
+
+#include "SharedMemoryReader.h"
+#include "base/Factory.h"
+
+#ifdef USE_SSI_LEAK_DETECTOR
+	#include "SSI_LeakWatcher.h"
+	#ifdef _DEBUG
+		#define new DEBUG_NEW
+		#undef THIS_FILE
+		static char THIS_FILE[] = __FILE__;
+	#endif
+#endif
+
+namespace ssi {
+
+int SharedMemoryReader::ssi_log_level = SSI_LOG_LEVEL_DEFAULT;
+ssi_char_t *SharedMemoryReader::ssi_log_name = "shmread___";
+
+SharedMemoryReader::SharedMemoryReader (const ssi_char_t *file)
+	: _file (0),
+	_provider (0),
+	_position (0),
+	_zeros (0),
+	_buffer (0),
+	_n_zeros (0),
+	_provided (0),
+	_aligned (false),
+	_bytes_per_sample (0) {
+
+	if (file) {
+		if (!OptionList::LoadXML (file, _options)) {
+			OptionList::SaveXML (file, _options);
+		}
+		_file = ssi_strcpy (file);
+	}
+}
+
+SharedMemoryReader::~SharedMemoryReader () {
+
+	if (_file) {
+		OptionList::SaveXML (_file, _options);
+		delete[] _file;
+	}
+}
+
+bool SharedMemoryReader::setProvider (const ssi_char_t *name, IProvider *provider) {
+
+	if (strcmp (name, SSI_SHAREDMEMORYREADER_PROVIDER_NAME) != 0) {
+		ssi_wrn ("unkown provider name '%s'", name);
+		return false;
+	}
+
+	if (_provider) {
+		ssi_wrn ("provider already set");
+		return false;
+	}
+
+	if (_options.sdim == 0) {
+		ssi_err ("option 'sdim' not set");
+	}
+	if (_options.sbyte == 0) {
+		ssi_err ("option 'sbyte' not set");
+	}
+	if (_options.stype == SSI_UNDEF) {
+		ssi_err ("options 'stype' not set");
+	}
+	if (_options.ssr == 0) {
+		ssi_err ("options 'ssr' not set");
+	}
+
+	_provider = provider;
+	_bytes_per_sample = _options.sbyte * _options.sdim;
+	ssi_stream_init (_channel.stream, 0, _options.sdim, _options.sbyte, _options.stype, _options.ssr);
+	_provider->init (&_channel);
+
+	return true;
+}
+
+bool SharedMemoryReader::connect () {
+
+	if (!_provider) {
+		ssi_wrn ("provider not set");
+		return false;
+	}
+
+	// zeros replace samples we have missed
+	_n_zeros = ssi_cast (ssi_size_t, _options.ssr * 0.1 + 0.5);
+	if (_n_zeros == 0) {
+		_n_zeros = 1;
+	}
+	_zeros = new ssi_byte_t[_n_zeros * _bytes_per_sample];
+	memset (_zeros, 0, _n_zeros * _bytes_per_sample);
+	_buffer = new ssi_byte_t[_n_zeros * _bytes_per_sample];
+	_position = 0;
+	_provided = 0;
+
+	// the writer may start later
+	attach ();
+
+	ssi_char_t *thread_name = ssi_strcat ("ssi_sensor_SharedMemoryReader@", _options.name);
+	Thread::setName (thread_name);
+	delete[] thread_name;
+
+	return true;
+}
+
+bool SharedMemoryReader::attach () {
+
+	if (!_ring.open (_options.name)) {
+		return false;
+	}
+
+	SharedMemoryRing::Header *header = _ring.getHeader ();
+	if (header->sr != _options.ssr || header->dim != _options.sdim || header->byte != _options.sbyte || header->type != _options.stype) {
+		ssi_wrn ("stream not compatible");
+		_ring.close ();
+		return false;
+	}
+
+	// a new writer starts again with the first sample
+	_position = 0;
+	_aligned = false;
+
+	ssi_msg (SSI_LOG_LEVEL_BASIC, "attached to '%s'", _options.name);
+
+	return true;
+}
+
+bool SharedMemoryReader::align () {
+
+	// start times are measured with the system clock, so they can be compared across processes
+	ssi_size_t start = Factory::GetFramework ()->GetStartTimeMs ();
+	if (start == 0) {
+		return false;
+	}
+
+	// first sample of the writer in our stream
+	SharedMemoryRing::Header *header = _ring.getHeader ();
+	uint64_t shift = _provided;
+	if (header->start != 0) {
+		ssi_time_t offset = ssi_cast (int32_t, header->start - start) / 1000.0 + header->time;
+		shift = offset > 0 ? ssi_cast (uint64_t, offset * _options.ssr + 0.5) : 0;
+		ssi_msg (SSI_LOG_LEVEL_BASIC, "first sample of '%s' at %.2lfs", _options.name, offset);
+	}
+
+	if (shift >= _provided) {
+		provideZeros (shift - _provided);
+		_position = 0;
+	} else {
+		_position = _provided - shift;
+	}
+	_aligned = true;
+
+	return true;
+}
+
+void SharedMemoryReader::run () {
+
+	if (!_ring.isOpen ()) {
+		if (!attach ()) {
+			::Sleep (_options.timeout);
+			return;
+		}
+	}
+
+	// wait until writer has published its first sample and our framework is running
+	if (!_aligned) {
+		if (_ring.getWritten () == 0 || !align ()) {
+			::Sleep (_options.timeout);
+			return;
+		}
+	}
+
+	uint64_t written = _ring.wait (_position, _options.timeout);
+	if (written > _position) {
+		read (written);
+	} else if (!_ring.isAlive ()) {
+		ssi_msg (SSI_LOG_LEVEL_BASIC, "writer has closed '%s'", _options.name);
+		_ring.close ();
+	}
+}
+
+void SharedMemoryReader::provideZeros (uint64_t num) {
+
+	while (num > 0) {
+		ssi_size_t n = num > _n_zeros ? _n_zeros : ssi_cast (ssi_size_t, num);
+		_provider->provide (_zeros, n);
+		num -= n;
+		_provided += n;
+	}
+}
+
+void SharedMemoryReader::read (uint64_t written) {
+
+	ssi_size_t capacity = _ring.getHeader ()->capacity;
+
+	uint64_t oldest = written > capacity ? written - capacity : 0;
+	if (_position < oldest) {
+		ssi_wrn ("missed %llu samples", ssi_cast (unsigned long long, oldest - _position));
+		provideZeros (oldest - _position);
+		_position = oldest;
+	}
+
+	SSI_DBG (SSI_LOG_LEVEL_DEBUG, "received %llu samples", ssi_cast (unsigned long long, written - _position));
+
+	// the writer may overtake us while we copy, samples it has overwritten are set to zero
+	while (_position < written) {
+		ssi_size_t num = written - _position > _n_zeros ? _n_zeros : ssi_cast (ssi_size_t, written - _position);
+		ssi_size_t lapped = _ring.read (_position, num, _buffer);
+		if (lapped > 0) {
+			ssi_wrn ("writer has overtaken reader, %u samples lost, increase size of ring", lapped);
+			memset (_buffer, 0, lapped * _bytes_per_sample);
+		}
+		_provider->provide (_buffer, num);
+		_position += num;
+		_provided += num;
+	}
+}
+
+void SharedMemoryReader::terminate () {
+
+	_ring.close ();
+}
+
+bool SharedMemoryReader::disconnect () {
+
+	_ring.close ();
+	delete[] _zeros; _zeros = 0;
+	delete[] _buffer; _buffer = 0;
+
+	return true;
+}
+
+}
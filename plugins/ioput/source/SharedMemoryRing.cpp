@@ -0,0 +1,429 @@
+// SharedMemoryRing.cpp
+// created: 2026/10/19
+// Copyright (C) University of Augsburg, Lab for Human Centered Multimedia
+//
+// *************************************************************************************************
+//
+// This file is part of Social Signal Interpretation (SSI) developed at the 
+// Lab for Human Centered Multimedia of the University of Augsburg
+//
+// This library is free software; you can redistribute itand/or
+// modify it under the terms of the GNU General Public
+// License as published by the Free Software Foundation; either
+// version 3 of the License, or any laterversion.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FORA PARTICULAR PURPOSE.  See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public
+// License along withthis library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+//
+//*************************************************************************************************
+
+#include "SharedMemoryRing.h"
+
+#if __gnu_linux__ || __APPLE__
+	#include <sys/mman.h>
+	#include <sys/stat.h>
+	#include <fcntl.h>
+	#include <unistd.h>
+	#include <time.h>
+#endif
+#if __gnu_linux__
+	#include <linux/futex.h>
+	#include <sys/syscall.h>
+	#include <climits>
+#endif
+
+#ifdef USE_SSI_LEAK_DETECTOR
+	#include "SSI_LeakWatcher.h"
+	#ifdef _DEBUG
+		#define new DEBUG_NEW
+		#undef THIS_FILE
+		static char THIS_FILE[] = __FILE__;
+	#endif
+#endif
+
+namespace ssi {
+
+ssi_char_t *SharedMemoryRing::ssi_log_name = "shmring___";
+int SharedMemoryRing::ssi_log_level = SSI_LOG_LEVEL_DEFAULT;
+
+SharedMemoryRing::SharedMemoryRing ()
+	: _owner (false),
+	_name (0),
+	_size (0),
+	_header (0),
+	_data (0),
+	_bytes_per_sample (0) {
+
+#if _WIN32|_WIN64
+	_mapping = 0;
+	_event = 0;
+	_reader = -1;
+	for (uint32_t i = 0; i < Header::MAX_READERS; i++) {
+		_events[i] = 0;
+	}
+#endif
+}
+
+SharedMemoryRing::~SharedMemoryRing () {
+
+	close ();
+}
+
+ssi_size_t SharedMemoryRing::DataOffset () {
+
+	// keep samples on their own cache line
+	return ssi_cast (ssi_size_t, (sizeof (Header) + 63) & ~ssi_cast (size_t, 63));
+}
+
+bool SharedMemoryRing::map (const ssi_char_t *name, ssi_size_t size, bool create) {
+
+#if _WIN32|_WIN64
+
+	ssi_char_t string[SSI_MAX_CHAR];
+
+	ssi_sprint (string, "Local\\ssi_%s", name);
+	if (create) {
+		_mapping = ::CreateFileMappingA (INVALID_HANDLE_VALUE, NULL, PAGE_READWRITE, 0, size, string);
+	} else {
+		_mapping = ::OpenFileMappingA (FILE_MAP_ALL_ACCESS, FALSE, string);
+	}
+	if (!_mapping) {
+		return false;
+	}
+	void *ptr = ::MapViewOfFile (_mapping, FILE_MAP_ALL_ACCESS, 0, 0, create ? size : 0);
+	if (!ptr) {
+		::CloseHandle (_mapping);
+		_mapping = 0;
+		return false;
+	}
+	if (!create) {
+		MEMORY_BASIC_INFORMATION info;
+		::VirtualQuery (ptr, &info, sizeof (info));
+		size = ssi_cast (ssi_size_t, info.RegionSize);
+	}
+
+	_header = ssi_pcast (Header, ptr);
+
+#elif __gnu_linux__ || __APPLE__
+
+	ssi_char_t string[SSI_MAX_CHAR];
+
+	ssi_sprint (string, "/ssi_%s", name);
+	int fd = 0;
+	if (create) {
+		::shm_unlink (string);
+		fd = ::shm_open (string, O_CREAT | O_EXCL | O_RDWR, 0600);
+		if (fd >= 0 && ::ftruncate (fd, size) != 0) {
+			::close (fd);
+			::shm_unlink (string);
+			fd = -1;
+		}
+	} else {
+		fd = ::shm_open (string, O_RDWR, 0600);
+	}
+	if (fd < 0) {
+		return false;
+	}
+	if (!create) {
+		struct stat info;
+		if (::fstat (fd, &info) != 0 || info.st_size < ssi_cast (off_t, size)) {
+			::close (fd);
+			return false;
+		}
+		size = ssi_cast (ssi_size_t, info.st_size);
+	}
+	void *ptr = ::mmap (0, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+	::close (fd);
+	if (ptr == MAP_FAILED) {
+		return false;
+	}
+
+	_header = ssi_pcast (Header, ptr);
+
+#else
+
+	return false;
+
+#endif
+
+	_size = size;
+	_name = ssi_strcpy (name);
+	_owner = create;
+
+	return true;
+}
+
+bool SharedMemoryRing::create (const ssi_char_t *name,
+	ssi_time_t sr,
+	ssi_size_t dim,
+	ssi_size_t byte,
+	ssi_type_t type,
+	ssi_size_t capacity) {
+
+	close ();
+
+	_bytes_per_sample = dim * byte;
+	if (!map (name, DataOffset () + capacity * _bytes_per_sample, true)) {
+		ssi_wrn ("could not create shared memory '%s'", name);
+		return false;
+	}
+
+	_header->written.store (0, std::memory_order_relaxed);
+	_header->writing.store (0, std::memory_order_relaxed);
+	_header->readers.store (0, std::memory_order_relaxed);
+	_header->alive.store (1, std::memory_order_relaxed);
+	_header->seq.store (0, std::memory_order_relaxed);
+	_header->waiting.store (0, std::memory_order_relaxed);
+	_header->dim = dim;
+	_header->byte = byte;
+	_header->type = type;
+	_header->sr = sr;
+	_header->time = 0;
+	_header->capacity = capacity;
+	_header->start = 0;
+	_header->version = Header::VERSION;
+	_data = ssi_pcast (ssi_byte_t, _header) + DataOffset ();
+
+	// readers check the magic number last
+	std::atomic_thread_fence (std::memory_order_release);
+	_header->magic = Header::MAGIC;
+
+	ssi_msg (SSI_LOG_LEVEL_BASIC, "created '%s' (%u samples)", name, capacity);
+
+	return true;
+}
+
+bool SharedMemoryRing::open (const ssi_char_t *name) {
+
+	close ();
+
+	if (!map (name, DataOffset (), false)) {
+		return false;
+	}
+
+	// writer has not finished initialization
+	uint32_t magic = _header->magic;
+	std::atomic_thread_fence (std::memory_order_acquire);
+	if (magic == 0) {
+		close ();
+		return false;
+	}
+
+	if (magic != Header::MAGIC || _header->version != Header::VERSION
+		|| _size < DataOffset () + _header->capacity * _header->dim * _header->byte) {
+		ssi_wrn ("invalid shared memory '%s'", name);
+		close ();
+		return false;
+	}
+
+	_bytes_per_sample = _header->dim * _header->byte;
+	_data = ssi_pcast (ssi_byte_t, _header) + DataOffset ();
+
+#if _WIN32|_WIN64
+	if (!registerReader ()) {
+		ssi_wrn ("too many readers on '%s', polling", name);
+	}
+#endif
+
+	ssi_msg (SSI_LOG_LEVEL_BASIC, "opened '%s' (%u samples)", name, _header->capacity);
+
+	return true;
+}
+
+void SharedMemoryRing::close () {
+
+	if (!_header) {
+		return;
+	}
+
+	if (_owner) {
+		_header->alive.store (0, std::memory_order_release);
+		notify ();
+	}
+
+#if _WIN32|_WIN64
+
+	if (_reader >= 0) {
+		_header->readers.fetch_and (~(1u << _reader));
+		_reader = -1;
+	}
+	if (_event) {
+		::CloseHandle (_event);
+		_event = 0;
+	}
+	for (uint32_t i = 0; i < Header::MAX_READERS; i++) {
+		if (_events[i]) {
+			::CloseHandle (_events[i]);
+			_events[i] = 0;
+		}
+	}
+	::UnmapViewOfFile (_header);
+	::CloseHandle (_mapping);
+	_mapping = 0;
+
+#elif __gnu_linux__ || __APPLE__
+
+	::munmap (_header, _size);
+	if (_owner) {
+		ssi_char_t string[SSI_MAX_CHAR];
+		ssi_sprint (string, "/ssi_%s", _name);
+		::shm_unlink (string);
+	}
+
+#endif
+
+	delete[] _name; _name = 0;
+	_header = 0;
+	_data = 0;
+	_size = 0;
+	_owner = false;
+}
+
+void SharedMemoryRing::write (ssi_size_t num, const ssi_byte_t *ptr, ssi_time_t time) {
+
+	if (!_header || num == 0) {
+		return;
+	}
+
+	uint64_t written = _header->written.load (std::memory_order_relaxed);
+	if (written == 0) {
+		_header->time = time;
+	}
+
+	ssi_size_t capacity = _header->capacity;
+	if (num > capacity) {
+		ptr += (num - capacity) * _bytes_per_sample;
+		written += num - capacity;
+		num = capacity;
+	}
+
+	// readers check this after copying, so they notice samples we overwrite
+	_header->writing.store (written + num, std::memory_order_relaxed);
+	std::atomic_thread_fence (std::memory_order_release);
+
+	ssi_size_t offset = ssi_cast (ssi_size_t, written % capacity);
+	ssi_size_t first = capacity - offset < num ? capacity - offset : num;
+	memcpy (_data + offset * _bytes_per_sample, ptr, first * _bytes_per_sample);
+	if (first < num) {
+		memcpy (_data, ptr + first * _bytes_per_sample, (num - first) * _bytes_per_sample);
+	}
+
+	_header->written.store (written + num, std::memory_order_release);
+	notify ();
+}
+
+ssi_size_t SharedMemoryRing::read (uint64_t position, ssi_size_t num, ssi_byte_t *ptr) {
+
+	ssi_size_t capacity = _header->capacity;
+	ssi_size_t offset = ssi_cast (ssi_size_t, position % capacity);
+	ssi_size_t first = capacity - offset < num ? capacity - offset : num;
+	memcpy (ptr, _data + offset * _bytes_per_sample, first * _bytes_per_sample);
+	if (first < num) {
+		memcpy (ptr + first * _bytes_per_sample, _data, (num - first) * _bytes_per_sample);
+	}
+
+	// a sample is lost as soon as the writer starts to copy the sample capacity positions ahead
+	std::atomic_thread_fence (std::memory_order_acquire);
+	uint64_t writing = _header->writing.load (std::memory_order_relaxed);
+	uint64_t oldest = writing > capacity ? writing - capacity : 0;
+	if (oldest <= position) {
+		return 0;
+	}
+
+	return oldest - position < num ? ssi_cast (ssi_size_t, oldest - position) : num;
+}
+
+#if _WIN32|_WIN64
+bool SharedMemoryRing::registerReader () {
+
+	// an auto-reset event per reader, so every reader is woken
+	uint32_t readers = _header->readers.load ();
+	for (;;) {
+		uint32_t i = 0;
+		while (i < Header::MAX_READERS && (readers & (1u << i))) {
+			i++;
+		}
+		if (i == Header::MAX_READERS) {
+			return false;
+		}
+		// on failure readers is reloaded and we look for a free slot again
+		if (_header->readers.compare_exchange_weak (readers, readers | (1u << i))) {
+			ssi_char_t string[SSI_MAX_CHAR];
+			ssi_sprint (string, "Local\\ssi_%s_event_%u", _name, i);
+			_event = ::CreateEventA (NULL, FALSE, FALSE, string);
+			_reader = ssi_cast (int, i);
+			return _event != 0;
+		}
+	}
+}
+#endif
+
+void SharedMemoryRing::notify () {
+
+	_header->seq.fetch_add (1);
+
+#if _WIN32|_WIN64
+	if (_header->waiting.load () > 0) {
+		uint32_t readers = _header->readers.load ();
+		for (uint32_t i = 0; i < Header::MAX_READERS; i++) {
+			if (readers & (1u << i)) {
+				if (!_events[i]) {
+					ssi_char_t string[SSI_MAX_CHAR];
+					ssi_sprint (string, "Local\\ssi_%s_event_%u", _name, i);
+					_events[i] = ::OpenEventA (EVENT_MODIFY_STATE, FALSE, string);
+				}
+				if (_events[i]) {
+					::SetEvent (_events[i]);
+				}
+			}
+		}
+	}
+#elif __gnu_linux__
+	if (_header->waiting.load () > 0) {
+		::syscall (SYS_futex, &_header->seq, FUTEX_WAKE, INT_MAX, 0, 0, 0);
+	}
+#endif
+}
+
+uint64_t SharedMemoryRing::wait (uint64_t position, ssi_size_t timeout) {
+
+	uint64_t written = _header->written.load (std::memory_order_acquire);
+	if (written > position || !isAlive ()) {
+		return written;
+	}
+
+	// register before checking again, so the writer cannot miss us
+	_header->waiting.fetch_add (1);
+	uint32_t seq = _header->seq.load ();
+	written = _header->written.load (std::memory_order_acquire);
+
+	if (written <= position && isAlive ()) {
+#if _WIN32|_WIN64
+		if (_event) {
+			::WaitForSingleObject (_event, timeout);
+		} else {
+			::Sleep (1);
+		}
+#elif __gnu_linux__
+		// returns at once if seq has changed in the meantime
+		struct timespec ts;
+		ts.tv_sec = timeout / 1000;
+		ts.tv_nsec = (timeout % 1000) * 1000000;
+		::syscall (SYS_futex, &_header->seq, FUTEX_WAIT, seq, &ts, 0, 0);
+#else
+		::Sleep (1);
+#endif
+	}
+
+	_header->waiting.fetch_sub (1);
+
+	return _header->written.load (std::memory_order_acquire);
+}
+
+}
@@ -0,0 +1,117 @@
+// SharedMemoryWriter.cpp
+// created: 2026/10/19
+// Copyright (C) University of Augsburg, Lab for Human Centered Multimedia
+//
+// *************************************************************************************************
+//
+// This file is part of Social Signal Interpretation (SSI) developed at the 
+// Lab for Human Centered Multimedia of the University of Augsburg
+//
+// This library is free software; you can redistribute itand/or
+// modify it under the terms of the GNU General Public
+// License as published by the Free Software Foundation; either
+// version 3 of the License, or any laterversion.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FORA PARTICULAR PURPOSE.  See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public
+// License along withthis library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+//
+//*************************************************************************************************
+
+#include "SharedMemoryWriter.h"
+#include "base/Factory.h"
+
+#ifdef USE_SSI_LEAK_DETECTOR
+	#include "SSI_LeakWatcher.h"
+	#ifdef _DEBUG
+		#define new DEBUG_NEW
+		#undef THIS_FILE
+		static char THIS_FILE[] = __FILE__;
+	#endif
+#endif
+
+namespace ssi {
+
+int SharedMemoryWriter::ssi_log_level = SSI_LOG_LEVEL_DEFAULT;
+ssi_char_t *SharedMemoryWriter::ssi_log_name = "shmwrite__";
+
+SharedMemoryWriter::SharedMemoryWriter (const ssi_char_t *file)
+	: _file (0) {
+
+	if (file) {
+		if (!OptionList::LoadXML (file, _options)) {
+			OptionList::SaveXML (file, _options);
+		}
+		_file = ssi_strcpy (file);
+	}
+}
+
+SharedMemoryWriter::~SharedMemoryWriter () {
+
+	if (_file) {
+		OptionList::SaveXML (_file, _options);
+		delete[] _file;
+	}
+}
+
+void SharedMemoryWriter::consume_enter (ssi_size_t stream_in_num,
+	ssi_stream_t stream_in[]) {
+
+	if (stream_in_num > 1) {
+		ssi_wrn ("only first stream is published");
+	}
+
+	ssi_size_t capacity = ssi_cast (ssi_size_t, _options.size * stream_in[0].sr + 0.5);
+	if (capacity == 0) {
+		capacity = 1;
+	}
+
+	if (_ring.create (_options.name, stream_in[0].sr, stream_in[0].dim, stream_in[0].byte, stream_in[0].type, capacity)) {
+		ssi_msg (SSI_LOG_LEVEL_BASIC, "publish stream as '%s'", _options.name);
+		if (ssi_log_level >= SSI_LOG_LEVEL_DETAIL) {
+			ssi_print ("\
+             rate:\t= %.2lf\n\
+             dim:\t= %u\n\
+             bytes:\t= %u\n\
+             samples:\t= %u\n",
+				stream_in[0].sr,
+				stream_in[0].dim,
+				stream_in[0].byte,
+				capacity
+			);
+		}
+	} else {
+		ssi_wrn ("could not publish stream as '%s', stream is dropped", _options.name);
+	}
+}
+
+void SharedMemoryWriter::consume (IConsumer::info consume_info,
+	ssi_size_t stream_in_num,
+	ssi_stream_t stream_in[]) {
+
+	if (!_ring.isOpen ()) {
+		return;
+	}
+
+	// readers align to our time base
+	if (_ring.getWritten () == 0) {
+		_ring.getHeader ()->start = Factory::GetFramework ()->GetStartTimeMs ();
+	}
+
+	_ring.write (stream_in[0].num, stream_in[0].ptr, stream_in[0].time);
+}
+
+void SharedMemoryWriter::consume_flush (ssi_size_t stream_in_num,
+	ssi_stream_t stream_in[]) {
+
+	_ring.close ();
+
+	ssi_msg (SSI_LOG_LEVEL_BASIC, "stopped");
+}
+
+}
@@ -50,7 +50,8 @@ SocketReader::SocketReader (const ssi_char_t *file)
 	_socket_img (0),
 	_buffer (0),
 	_buffer2 (0),
-	_memory (0) {
+	_memory (0),
+	_n_fill (0) {
 
 	if (file) {
 		if (!OptionList::LoadXML (file, _options)) {
@@ -86,6 +87,7 @@ void SocketReader::setProvider (IProvider *provider) {
 		case Options::FORMAT::BINARY:
 		case Options::FORMAT::ASCII:
 		case Options::FORMAT::OSC:			
+		case Options::FORMAT::FRAMED:
 
 			if (_options.sdim == 0) {
 				ssi_err ("option 'sdim' not set");
@@ -157,6 +159,11 @@ bool SocketReader::connect () {
 			_buffer = new ssi_byte_t[_n_buffer];
 			_socket_img = new SocketImage (*_socket);
 			break;
+		case Options::FORMAT::FRAMED:
+			_n_buffer = _options.size;
+			_buffer = new ssi_byte_t[_n_buffer];
+			_n_fill = 0;
+			break;
 	}
 
 	// set thread name
@@ -200,6 +207,17 @@ void SocketReader::run () {
 					_provider->provide (_buffer, 1);
 				}
 				break;
+			case Options::FORMAT::FRAMED:
+				result = _socket->recv (_buffer + _n_fill, _n_buffer - _n_fill, _options.timeout);
+				if (result > 0) {
+					_n_fill += result;
+					readFrames ();
+					// a datagram always contains complete frames
+					if (_options.type == Socket::UDP) {
+						_n_fill = 0;
+					}
+				}
+				break;
 		}
 	}
 
@@ -220,6 +238,53 @@ void SocketReader::terminate () {
 
 }
 
+void SocketReader::readFrames () {
+
+	// frames are passed to the provider straight from the receive buffer,
+	// an incomplete frame is kept until the rest has arrived
+	ssi_size_t pos = 0;
+	ssi_size_t n_header = sizeof (SocketFrameHeader);
+
+	while (_n_fill - pos >= n_header) {
+
+		SocketFrameHeader header;
+		memcpy (&header, _buffer + pos, n_header);
+
+		if (header.magic != SocketFrameHeader::MAGIC) {
+			ssi_wrn ("invalid frame header, skip received data");
+			pos = _n_fill;
+			break;
+		}
+
+		ssi_size_t n_data = header.num * header.dim * header.byte;
+		if (n_header + n_data > _n_buffer) {
+			ssi_wrn ("frame exceeds buffer size, increase option 'size'");
+			pos = _n_fill;
+			break;
+		}
+		if (_n_fill - pos < n_header + n_data) {
+			break;
+		}
+
+		if (header.id == _options.sid) {
+			if (header.dim != _options.sdim || header.byte != _options.sbyte || header.type != _options.stype) {
+				ssi_wrn ("stream not compatible");
+			} else {
+				_provider->provide (_buffer + pos + n_header, header.num);
+			}
+		}
+
+		pos += n_header + n_data;
+	}
+
+	if (pos > 0) {
+		_n_fill -= pos;
+		if (_n_fill > 0) {
+			memmove (_buffer, _buffer + pos, _n_fill);
+		}
+	}
+}
+
 bool SocketReader::disconnect () {
 
 	return true;
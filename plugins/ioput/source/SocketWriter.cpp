@@ -48,7 +48,15 @@ SocketWriter::SocketWriter (const ssi_char_t *file)
 	_socket_osc (0),
 	_socket_img (0),
 	_frame (0),
-	_memory (0) {
+	_memory (0),
+	_headers (0),
+	_parts (0),
+	_part_sizes (0),
+	_batch (0),
+	_batch_size (0),
+	_batch_bytes (0),
+	_batch_count (0),
+	_batch_time (0) {
 
 	if (file) {
 		if (!OptionList::LoadXML (file, _options)) {
@@ -95,6 +103,20 @@ void SocketWriter::consume_enter (ssi_size_t stream_in_num,
 		case Options::FORMAT::IMAGE:
 			_socket_img = new SocketImage (*_socket, Socket::MAX_MTU_SIZE, _options.packet_delay);
 			break;
+		case Options::FORMAT::FRAMED:
+			_headers = new SocketFrameHeader[stream_in_num];
+			for (ssi_size_t i = 0; i < stream_in_num; i++) {
+				_headers[i].magic = SocketFrameHeader::MAGIC;
+				_headers[i].id = i;
+				_headers[i].type = stream_in[i].type;
+				_headers[i].dim = stream_in[i].dim;
+				_headers[i].byte = stream_in[i].byte;
+			}
+			_parts = new const void *[2 * stream_in_num];
+			_part_sizes = new ssi_size_t[2 * stream_in_num];
+			_batch_bytes = 0;
+			_batch_count = 0;
+			break;
 	}
 
 	ssi_msg (SSI_LOG_LEVEL_BASIC, "started");
@@ -148,15 +170,104 @@ void SocketWriter::consume (IConsumer::info consume_info,
 					result = _socket_img->sendImage (_video_format, stream_in[0].ptr, stream_in[0].tot, _options.compression);
 				 }
 				break;		
+			case Options::FORMAT::FRAMED: {
+					// TCP sends headers and stream memory without copying
+					if (_options.type == Socket::TCP && _options.batch <= 1 && _options.batch_bytes == 0) {
+						prepareFrames (stream_in_num, stream_in);
+						result = _socket->sendv (2 * stream_in_num, _parts, _part_sizes);
+					} else {
+						batchFrames (stream_in_num, stream_in);
+						if (_batch_count >= _options.batch
+							|| (_options.batch_bytes > 0 && _batch_bytes >= _options.batch_bytes)
+							|| (_options.batch_delay > 0 && _frame->GetElapsedTimeMs () - _batch_time >= _options.batch_delay)) {
+							result = sendBatch ();
+						}
+					}
+				}
+				break;
 		}
 	}
 
 	SSI_DBG (SSI_LOG_LEVEL_DEBUG, "sent %d bytes", result);
 };
 
+void SocketWriter::prepareFrames (ssi_size_t stream_in_num,
+	ssi_stream_t stream_in[]) {
+
+	for (ssi_size_t i = 0; i < stream_in_num; i++) {
+		_headers[i].num = stream_in[i].num;
+		_headers[i].time = stream_in[i].time;
+		_parts[2 * i] = &_headers[i];
+		_part_sizes[2 * i] = sizeof (SocketFrameHeader);
+		_parts[2 * i + 1] = stream_in[i].ptr;
+		_part_sizes[2 * i + 1] = stream_in[i].num * stream_in[i].dim * stream_in[i].byte;
+	}
+}
+
+void SocketWriter::batchFrames (ssi_size_t stream_in_num,
+	ssi_stream_t stream_in[]) {
+
+	prepareFrames (stream_in_num, stream_in);
+
+	ssi_size_t bytes = 0;
+	for (ssi_size_t i = 0; i < 2 * stream_in_num; i++) {
+		bytes += _part_sizes[i];
+	}
+
+	// a datagram must not exceed the maximum packet size
+	if (_options.type == Socket::UDP && _batch_bytes > 0 && _batch_bytes + bytes > Socket::MAX_MTU_SIZE) {
+		sendBatch ();
+	}
+
+	if (_batch_bytes + bytes > _batch_size) {
+		ssi_size_t size = 2 * (_batch_bytes + bytes);
+		ssi_byte_t *batch = new ssi_byte_t[size];
+		if (_batch_bytes > 0) {
+			memcpy (batch, _batch, _batch_bytes);
+		}
+		delete[] _batch;
+		_batch = batch;
+		_batch_size = size;
+	}
+
+	for (ssi_size_t i = 0; i < 2 * stream_in_num; i++) {
+		memcpy (_batch + _batch_bytes, _parts[i], _part_sizes[i]);
+		_batch_bytes += _part_sizes[i];
+	}
+
+	if (_batch_count++ == 0) {
+		_batch_time = _frame->GetElapsedTimeMs ();
+	}
+}
+
+int SocketWriter::sendBatch () {
+
+	int result = 0;
+
+	if (_batch_count > 0) {
+		result = _socket->send (_batch, _batch_bytes);
+		_batch_bytes = 0;
+		_batch_count = 0;
+	}
+
+	return result;
+}
+
 void SocketWriter::consume_flush (ssi_size_t stream_in_num,
 	ssi_stream_t stream_in[]) {
 
+	if (_options.format == Options::FORMAT::FRAMED && _socket && _socket->isConnected ()) {
+		sendBatch ();
+	}
+
+	delete[] _headers; _headers = 0;
+	delete[] _parts; _parts = 0;
+	delete[] _part_sizes; _part_sizes = 0;
+	delete[] _batch; _batch = 0;
+	_batch_size = 0;
+	_batch_bytes = 0;
+	_batch_count = 0;
+
 	delete _socket_osc; _socket_osc = 0;
 	delete _socket_img; _socket_img = 0;
 	delete _socket; _socket = 0;
@@ -26,6 +26,8 @@
 
 #include "ssi.h"
 #include "MyOscListener.h"
+#include "ioput/file/AsciiNumber.h"
+#include <random>
 using namespace ssi;
 
 #ifdef USE_SSI_LEAK_DETECTOR
@@ -41,6 +43,7 @@ bool ex_file(void *arg);
 bool ex_lz4(void *arg);
 bool ex_filepath(void *arg);
 bool ex_memory(void *arg);
+bool ex_number(void *arg);
 bool ex_csv(void *arg);
 bool ex_writer(void *arg);
 bool ex_simulator(void *arg);
@@ -53,6 +56,7 @@ bool ex_sender(void *arg);
 bool ex_sender_events(void *arg);
 bool ex_sender_video(void *arg);
 bool ex_sender_file(void *arg);
+bool ex_shared_memory(void *arg);
 
 void test (File &file, int *data_out, ssi_size_t size);
 
@@ -83,6 +87,7 @@ int main () {
 	ex.add(&ex_file, 0, "FILE", "How to use 'File' to write to an ascii/binary file.");
 	ex.add(&ex_lz4, 0, "FILE-LZ4", "How to use 'File' to write to a compressed file.");
 	ex.add(&ex_memory, 0, "MEMORY", "How to use 'FileMem' to write into memory.");
+	ex.add(&ex_number, 0, "NUMBER", "Checks that 'AsciiNumber' reads back what it prints.");
 	ex.add(&ex_writer, 0, "WRITER", "How to use 'FileWriter' to store a stream to a file from a pipeline.");
 	ex.add(&ex_stream, 0, "STREAM", "How to write/read a stream to a file.");
 	ex.add(&ex_event, 0, "EVENT", "How to write/read events to a file.");
@@ -96,6 +101,7 @@ int main () {
 	ex.add(&ex_sender, &type_tcp, "STREAM TCP", "How to stream a signal from a pipeline using TCP.");
 	ex.add(&ex_sender_events, &type_tcp, "SEND EVENTS TCP", "How to send events from a pipeline using TCP.");
 	ex.add(&ex_sender_video, 0, "STREAM VIDEO", "How to stream a video from a pipeline.");
+	ex.add(&ex_shared_memory, 0, "SHARED MEMORY", "How to pass a stream to another process through shared memory.");
 	//ex.add(&ex_sender_file, 0, "FILE", "How to transfer the content of a file.");
 	ex.show();
 
@@ -278,6 +284,53 @@ bool ex_memory(void *arg) {
 	return true;
 }
 
+template<class T, class B>
+ssi_size_t number_check (std::mt19937_64 &generator, ssi_size_t n_tests, T (*reference) (const char *, char **)) {
+
+	ssi_char_t buffer[AsciiNumber::MAX_CHARS + 1];
+	ssi_size_t n_failed = 0;
+
+	for (ssi_size_t i = 0; i < n_tests; i++) {
+
+		B bits = ssi_cast (B, generator ());
+		T value;
+		memcpy (&value, &bits, sizeof (T));
+		if (value != value) {
+			continue; // nan
+		}
+
+		ssi_size_t n = AsciiNumber::Print (value, buffer);
+		buffer[n] = '\0';
+
+		const ssi_char_t *str = buffer;
+		T parsed = 0;
+		bool ok = AsciiNumber::Parse (str, buffer + n, parsed) && str == buffer + n;
+		T expected = reference (buffer, 0);
+
+		if (!ok || memcmp (&parsed, &value, sizeof (T)) != 0 || memcmp (&expected, &value, sizeof (T)) != 0) {
+			if (n_failed++ < 10) {
+				ssi_print ("%.17g -> '%s' -> %.17g\n", ssi_cast (double, value), buffer, ssi_cast (double, parsed));
+			}
+		}
+	}
+
+	return n_failed;
+}
+
+bool ex_number(void *arg) {
+
+	ssi_size_t n_tests = 1000000;
+	std::mt19937_64 generator (1234);
+
+	ssi_size_t n_failed_float = number_check<float, uint32_t> (generator, n_tests, strtof);
+	ssi_size_t n_failed_double = number_check<double, uint64_t> (generator, n_tests, strtod);
+
+	ssi_print ("float: %u of %u failed\n", n_failed_float, n_tests);
+	ssi_print ("double: %u of %u failed\n", n_failed_double, n_tests);
+
+	return n_failed_float == 0 && n_failed_double == 0;
+}
+
 bool ex_stream(void *arg) {
 
 	if (!ssi_exists("cursor_bin.stream")) {
@@ -865,6 +918,54 @@ bool ex_sender(void *arg) {
 	return true;
 }
 
+bool ex_shared_memory(void *arg) {
+
+	ITheFramework *frame = Factory::GetFramework();
+
+	Decorator *decorator = ssi_create(Decorator, 0, true);
+	decorator->getOptions()->setOrigin(CONSOLE_WIDTH, 0);
+	frame->AddDecorator(decorator);
+
+	// start mouse
+
+	Mouse *mouse = ssi_create (Mouse, "mouse", true);
+	ITransformable *cursor_p = frame->AddProvider(mouse, SSI_MOUSE_CURSOR_PROVIDER_NAME);
+	frame->AddSensor(mouse);
+
+	// writer and reader would usually run in different processes
+
+	SharedMemoryWriter *shm_writer = ssi_create (SharedMemoryWriter, 0, true);
+	shm_writer->getOptions()->setName("mouse");
+	frame->AddConsumer(cursor_p, shm_writer, "0.1s");
+
+	SharedMemoryReader *shm_reader = ssi_create (SharedMemoryReader, 0, true);
+	shm_reader->getOptions()->setName("mouse");
+	shm_reader->getOptions()->setSampleInfo(cursor_p->getSampleRate(), cursor_p->getSampleDimension(), cursor_p->getSampleBytes(), cursor_p->getSampleType());
+	ITransformable *shm_reader_p = frame->AddProvider(shm_reader, SSI_SHAREDMEMORYREADER_PROVIDER_NAME);
+	frame->AddSensor(shm_reader);
+
+	SignalPainter *plot;
+
+	plot = ssi_create_id(SignalPainter, 0, "plot");
+	plot->getOptions()->size = 10;
+	plot->getOptions()->setTitle("Local Sensor");
+	frame->AddConsumer(cursor_p, plot, "5");
+
+	plot = ssi_create_id(SignalPainter, 0, "plot");
+	plot->getOptions()->size = 10;
+	plot->getOptions()->setTitle("Shared Memory Reader");
+	frame->AddConsumer(shm_reader_p, plot, "5");
+
+	decorator->add("plot*", 0, 0, 400, CONSOLE_HEIGHT);
+
+	frame->Start();
+	frame->Wait();
+	frame->Stop();
+	frame->Clear();
+
+	return true;
+}
+
 bool ex_sender_events (void *arg) {
 
 	Socket::TYPE *type = ssi_pcast(Socket::TYPE, arg);
@@ -86,6 +86,11 @@ namespace ssi {
 		bool forward(ssi_stream_t &stream,
 			ssi_size_t n_probs,
 			ssi_real_t *probs);
+		bool forward_batch(ssi_size_t n_samples,
+			ssi_size_t n_features,
+			ssi_real_t *features,
+			ssi_size_t n_probs,
+			ssi_real_t *probs);
 		void release();
 		bool save(const ssi_char_t *filepath);
 		bool load(const ssi_char_t *filepath);
@@ -485,6 +485,117 @@ namespace ssi {
 		return true;
 	}
 
+	bool LibLinear::forward_batch(ssi_size_t n_samples,
+		ssi_size_t n_features,
+		ssi_real_t *features,
+		ssi_size_t n_probs,
+		ssi_real_t *probs) {
+
+		if (!isTrained()) {
+			ssi_wrn("not trained");
+			return false;
+		}
+
+		if (n_probs != _n_classes) {
+			ssi_wrn("#classes differs");
+			return false;
+		}
+
+		model *m = (model*)_model;
+		if (n_features != (ssi_size_t)m->nr_feature) {
+			return IModel::forward_batch(n_samples, n_features, features, n_probs, probs);
+		}
+
+		int nr_class = m->nr_class;
+		int nr_w = (nr_class == 2 && m->param.solver_type != MCSVM_CS) ? 1 : nr_class;
+		bool is_prob = check_probability_model(m) != 0;
+		bool is_regression = check_regression_model(m) != 0;
+
+		// decision values of all samples in a single pass over the weight matrix (X * W)
+
+		double *dec_values = new double[n_samples * nr_w];
+		for (ssi_size_t n = 0; n < n_samples; n++) {
+			double *dec = dec_values + n * nr_w;
+			ssi_real_t *x = features + n * n_features;
+			for (int i = 0; i < nr_w; i++) {
+				dec[i] = bias >= 0 ? m->w[n_features * nr_w + i] * bias : 0;
+			}
+			for (ssi_size_t d = 0; d < n_features; d++) {
+				double value = x[d];
+				double *w = m->w + d * nr_w;
+				for (int i = 0; i < nr_w; i++) {
+					dec[i] += w[i] * value;
+				}
+			}
+		}
+
+		for (ssi_size_t n = 0; n < n_samples; n++) {
+
+			double *dec = dec_values + n * nr_w;
+			ssi_real_t *dst = probs + n * n_probs;
+
+			if (n_probs >= 2) // MULTICLASS
+			{
+				if (is_prob)
+				{
+					for (int i = 0; i < nr_w; i++) {
+						dec[i] = 1 / (1 + exp(-dec[i]));
+					}
+					if (nr_class == 2)
+					{
+						dst[0] = (ssi_real_t)dec[0];
+						dst[1] = (ssi_real_t)(1. - dec[0]);
+					}
+					else
+					{
+						double sum = 0;
+						for (int i = 0; i < nr_class; i++) {
+							sum += dec[i];
+						}
+						for (ssi_size_t j = 0; j < _n_classes; j++) {
+							dst[j] = (ssi_real_t)(dec[j] / sum);
+						}
+					}
+				}
+				else if (n_probs == 2)
+				{
+					double label;
+					if (nr_w == 1) {
+						label = dec[0] > 0 ? m->label[0] : m->label[1];
+					} else {
+						label = dec[1] > dec[0] ? m->label[1] : m->label[0];
+					}
+					dst[0] = label == 0 ? 1.0f : 0.0f;
+					dst[1] = label == 1 ? 1.0f : 0.0f;
+				}
+				else
+				{
+					for (ssi_size_t j = 0; j < _n_classes; j++) {
+						dst[j] = (ssi_real_t)dec[j];
+					}
+					ssi_real_t minval, maxval;
+					ssi_minmax(n_probs, 1, dst, &minval, &maxval);
+					ssi_real_t sum = 0;
+					for (ssi_size_t j = 0; j < _n_classes; j++) {
+						dst[j] -= minval;
+						sum += dst[j];
+					}
+					for (ssi_size_t j = 0; j < _n_classes; j++) {
+						dst[j] /= sum;
+					}
+				}
+			}
+			else // REGRESSION
+			{
+				dst[0] = (ssi_real_t)(is_regression ? dec[0] : (dec[0] > 0 ? m->label[0] : m->label[1]));
+			}
+		}
+
+		delete[] dec_values;
+
+		return true;
+	}
+
 	bool LibLinear::load(const ssi_char_t *filepath) {
 
 		release();
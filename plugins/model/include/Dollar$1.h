@@ -79,7 +79,7 @@ public:
 
 	bool train (ISamples &samples,
 		ssi_size_t stream_index);	
-	bool isTrained () { return _dollar1.templates.size () > 0; };
+	bool isTrained () { return _dollar1.size () > 0; };
 	bool forward (ssi_stream_t &stream,
 		ssi_size_t n_probs,
 		ssi_real_t *probs);	
@@ -131,18 +131,39 @@ protected:
 	ssi_real_t eval_h (ssi_size_t n_dims, const ssi_size_t* dims);
 
 	/**
-	 * @brief Initializes all values required by CFS (_corr_matrix, _std_devs, _classIndex, _numAttribs, _numInstances).
+	 * @brief Initializes all values required by CFS (_corr_matrix, _std_devs, _means, _classIndex, _numAttribs, _numInstances).
+	 *
+	 * The correlations with the class are calculated right away.
 	 */
 	void buildEvaluator();
 
+	/**
+	 * @brief Calculates the missing correlations of feature att with all other features in parallel.
+	 *
+	 * @param att The index of the row in _train_instances.
+	 */
+	void correlateRow (ssi_size_t att);
+
+	/**
+	 * @brief Calls correlateRow() for the first k selected features, so eval_h() finds all correlations of a candidate subset.
+	 */
+	void correlateRows (ssi_size_t k);
+
+	static const ssi_size_t ROW_BLOCK_SIZE = 16;
+	struct row_job_t {
+		FloatingCFS *me;
+		ssi_size_t att;
+	};
+	static void RowTask (ssi_size_t index, void *arg);
+
 	/**
 	 * @brief Calculates the correlation of two features specified by att1 and att2.
 	 * 
 	 * The actual correlation is performed by num_num() and num_nom2().
 	 * If one of the specified feature indices is the class index (att[12] == _classIndex) num_nom2() is used, otherwise num_num().
 	 *
-	 * @param att1 The index of the column in _train_instances for the first feature.
-	 * @param att2 The index of the column in _train_instances for the second feature.
+	 * @param att1 The index of the row in _train_instances for the first feature.
+	 * @param att2 The index of the row in _train_instances for the second feature.
 	 * @return The correlation factor of the two features.
 	 */
 
@@ -150,8 +171,8 @@ protected:
 	/**
 	 * @brief Calculates the correlation of two numerical features.
 	 *
-	 * @param att1 The index of the column in _train_instances for the first feature.
-	 * @param att2 The index of the column in _train_instances for the second feature.
+	 * @param att1 The index of the row in _train_instances for the first feature.
+	 * @param att2 The index of the row in _train_instances for the second feature.
 	 * @return The correlation factor of the two features.
 	 */
 	ssi_real_t num_num (ssi_size_t att1, ssi_size_t att2);
@@ -159,8 +180,8 @@ protected:
 	/**
 	 * @brief Calculates the correlation of one feature with the class.
 	 *
-	 * @param att1 The index of the column in _train_instances for the class (nominal feature).
-	 * @param att2 The index of the column in _train_instances for the feature (numeric feature).
+	 * @param att1 The index of the row in _train_instances for the class (nominal feature).
+	 * @param att2 The index of the row in _train_instances for the feature (numeric feature).
 	 * @return The correlation factor of the feature with the class.
 	 */
 	ssi_real_t num_nom2 (ssi_size_t att1, ssi_size_t att2);
@@ -173,8 +194,8 @@ protected:
 	ssi_real_t mean_float(ssi_real_t* fray, ssi_size_t length);
 
 	/**
-	 * @brief returns the mean of the _train_instances at column att (or the mode if att=_classIndex)
-	 * @param att the index of the column in _train_instances
+	 * @brief returns the mean of the _train_instances at row att (or the mode if att=_classIndex)
+	 * @param att the index of the row in _train_instances
 	 */
 	ssi_real_t meanOrMode(ssi_size_t att);
 
@@ -189,9 +210,9 @@ protected:
 	ssi_size_t _n_classes;
 
 	/**
-	 * Matrix of Samples/Features storing the raw feature values.
-	 * First Dimension: Samples
-	 * Second Dimension: Features + ClassId of the sample (index of ClassId: _classIndex)
+	 * Matrix of Features/Samples storing the raw feature values.
+	 * First Dimension: Features + ClassId of the samples (index of ClassId: _classIndex)
+	 * Second Dimension: Samples
 	 */
 	ssi_real_t **_train_instances;
 	/**
@@ -224,6 +245,16 @@ protected:
 	 * The standard deviations of attributes (when using pearsons correlation).
 	 */
 	ssi_real_t *_std_devs;
+
+	/**
+	 * The mean of each attribute (the mode for the class).
+	 */
+	ssi_real_t *_means;
+
+	/**
+	 * Rows of the correlation matrix that are complete (see correlateRow()).
+	 */
+	bool *_correlated;
 };
 
 }
@@ -29,11 +29,17 @@
 
 #include "base/ISelection.h"
 #include "ioput/option/OptionList.h"
+#include "thread/Mutex.h"
+
+#include <map>
+#include <vector>
 
 namespace ssi {
 
 class Trainer;
 class Evaluation;
+class SampleList;
+class WorkerPool;
 
 class FloatingSearch : public ISelection {
 
@@ -58,7 +64,7 @@ public:
 	public:
 
 		Options () 
-			: kfold (2), loo (false), louo (false), split (0), nfirst (0), method (SFS), l (1), r (0), eval (CLASSWISE), nthread (0) {
+			: kfold (2), loo (false), louo (false), split (0), nfirst (0), method (SFS), l (1), r (0), eval (CLASSWISE), nthread (0), cache (false) {
 
 			addOption ("kfold", &kfold, 1, SSI_SIZE, "#folds used during evaluation");
 			addOption ("loo", &loo, 1, SSI_BOOL, "use leave-one-out instead of kfold");
@@ -69,7 +75,8 @@ public:
 			addOption ("l", &l, 1, SSI_SIZE, "plus l");
 			addOption ("r", &r, 1, SSI_SIZE, "minus r");
 			addOption ("eval", &eval, 1, SSI_INT, "evaluation method (0=CLASSWISE, 1=ACCURACY)");
-			addOption ("nthread", &nthread, 1, SSI_INT, "distribute work on n threads");
+			addOption ("nthread", &nthread, 1, SSI_INT, "evaluate candidates in parallel on n threads, each with its own copy of the model (0 or 1 = sequential)");
+			addOption ("cache", &cache, 1, SSI_BOOL, "remember the score of evaluated subsets and do not evaluate them again");
 		};
 
 		ssi_size_t kfold;
@@ -81,6 +88,7 @@ public:
 		EVAL eval;
 		ssi_size_t nthread;
 		ssi_real_t split;
+		bool cache;
 	};
 
 public:
@@ -120,17 +128,24 @@ protected:
 	void sffs_inclusion (ssi_size_t n_keep, ssi_size_t k);
 	ssi_real_t eval_h (Evaluation *eval, Trainer *trainer, ISamples &samples);
 
-	void tp_inclusion (ssi_size_t n_keep, ssi_size_t k, ssi_size_t l, ssi_size_t r);
-	struct tp_eval_h_in_s {
-		ssi_size_t dim;
-		Options *options;
-		Trainer *trainer;
-		ISamples *samples;
-	};
-	struct tp_eval_h_out_s {
-		ssi_real_t result;
+	// scores all subsets that add one dimension to the first k scores (probs[dim] = fill for selected dimensions)
+	void eval_inclusion (ssi_size_t k, ssi_real_t *probs, ssi_real_t fill);
+	// scores all subsets that remove one of the first k scores
+	void eval_exclusion (ssi_size_t k, ssi_real_t *probs);
+	// scores n subsets with n_sel dimensions each, stored one after another in sel
+	void eval_subsets (ssi_size_t n, ssi_size_t n_sel, const ssi_size_t *sel, ssi_real_t *probs);
+
+	struct eval_job_t {
+		FloatingSearch *me;
+		ssi_size_t n_sel;
+		const ssi_size_t *sel;
+		const ssi_size_t *todo;
+		ssi_real_t *probs;
+		ssi_size_t *free_models;
+		ssi_size_t n_free_models;
+		Mutex mutex;
 	};
-	static bool tp_eval_h (ssi_size_t n_in, void *in, ssi_size_t n_out, void *out);
+	static void EvalTask (ssi_size_t index, void *arg);
 
 	FloatingSearch (const ssi_char_t *file);
 	Options _options;
@@ -146,6 +161,15 @@ protected:
 	ssi_size_t _stream_index;
 	ssi_size_t _n_dims;
 
+	// parallel mode: a copy of the samples that is only accessed through get (),
+	// the original model and a clone for every other thread
+	WorkerPool *_pool;
+	SampleList *_list;
+	ssi_size_t *_list_indices;
+	ssi_size_t _n_models;
+	IModel **_models;
+
+	std::map<std::vector<ssi_size_t>, ssi_real_t> _cache;
 };
 
 }
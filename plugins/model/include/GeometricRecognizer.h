@@ -35,6 +35,10 @@
 // of the ACM Symposium on User Interface Software and Technology (UIST '07). Newport,
 // Rhode Island (October 7-10, 2007). New York: ACM Press, pp. 159-168.
 //
+// Li, Y. (2010) Protractor: A fast and accurate gesture recognizer. Proceedings of the
+// ACM Conference on Human Factors in Computing Systems (CHI '10). Atlanta, Georgia
+// (April 10-15, 2010). New York: ACM Press, pp. 2169-2172.
+//
 // *************************************************************************************************
 
 
@@ -56,10 +60,7 @@ namespace ssi
 	protected:
 		//--- These are variables because C++ doesn't (easily) allow
 		//---  constants to be floating point numbers
-		double halfDiagonal;
 		double angleRange;
-		double anglePrecision;
-		double goldenRatio;
 
 		//--- How many points we use to define a shape
 		int numPointsInGesture;
@@ -71,29 +72,41 @@ namespace ssi
 		//--- What we match the input shape against
 		GestureTemplates templates;
 
+		//--- Templates as unit vectors (x0 y0 x1 y1 ...) of 2 * numPointsInGesture
+		//---  floats, stored back to back in the order of 'templates'
+		std::vector<float> vectors;
+		std::vector<int> vectorIds;
+
+		struct kernels_t;
+		static const kernels_t *Resolve();
+		const kernels_t *kernels;
+
+		void   addVector(int gesture_id, const Path2D &points);
+		void   vectorize(const Path2D &points, float *vector, float *perpendicular);
+
 	public:
 		GeometricRecognizer();
 
 		int addTemplate(int gesture_id, Path2D points);
-		Rectangle boundingBox(Path2D points);
-		Point2D centroid(Path2D points);
-		double getDistance(Point2D p1, Point2D p2);
+		void   clear();
+		ssi_size_t size() { return ssi_cast (ssi_size_t, templates.size()); }
+		Rectangle boundingBox(const Path2D &points);
+		Point2D centroid(const Path2D &points);
+		double getDistance(const Point2D &p1, const Point2D &p2);
 		bool   getRotationInvariance() { return shouldIgnoreRotation; }
-		double distanceAtAngle(Path2D points, GestureTemplate aTemplate, double rotation);
-		double distanceAtBestAngle(Path2D points, GestureTemplate T);
-		Path2D normalizePath(Path2D points);
-		double pathDistance(Path2D pts1, Path2D pts2);
-		double pathLength(Path2D points);
-		RecognitionResult recognize(Path2D points);
-		Path2D resample(Path2D points);
-		Path2D rotateBy(Path2D points, double rotation);
-		Path2D rotateToZero(Path2D points);
-		Path2D scaleToSquare(Path2D points);
+		double distanceAtBestAngle(const float *vector, const float *perpendicular, ssi_size_t index);
+		void   normalizePath(Path2D &points);
+		double pathLength(const Path2D &points);
+		RecognitionResult recognize(const Path2D &points);
+		void   resample(Path2D &points);
+		void   rotateBy(Path2D &points, double rotation);
+		void   rotateToZero(Path2D &points);
+		void   scaleToSquare(Path2D &points);
 		void   setRotationInvariance(bool ignoreRotation);
-		Path2D translateToOrigin(Path2D points);
+		void   translateToOrigin(Path2D &points);
 
 		/// 2010.05.19 added by Johannes 
-		bool recognizeBestPerClass (Path2D points, ssi_size_t n_classes, ssi_real_t *scores);
+		bool recognizeBestPerClass (const Path2D &points, ssi_size_t n_classes, ssi_real_t *scores);
 
 		void save (FILE *file);
 		void load (FILE *file);
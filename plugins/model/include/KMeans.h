@@ -45,21 +45,32 @@ namespace ssi {
 
 class KMeans : public IModel {	
 
+public:
+
+	enum METHOD {
+		KDTREE = 0,	// exact, filtering on a kd-tree
+		LLOYD,		// exact, triangle inequality bounds, parallel
+		MINIBATCH	// approximate, updates centers from small random batches
+	};
+
 public:
 
 	class Options : public OptionList {
 
 	public:
 
-		Options () : k (5), iter (1), pp (true), smote (false), norm (false), random_seed(true), seed(1) {
+		Options () : k (5), iter (1), pp (true), smote (false), norm (false), random_seed(true), seed(1), method (LLOYD), batch (1024), steps (300) {
 
 			addOption ("k", &k, 1, SSI_SIZE, "number of clusters");			
-			addOption ("iter", &iter, 1, SSI_INT, "number of times to independently run k-means with different starting clusters");			
+			addOption ("iter", &iter, 1, SSI_INT, "number of times to independently run k-means with different starting clusters (run in parallel unless method=0)");			
 			addOption ("pp", &pp, 1, SSI_BOOL, "use kmeans++ instead of kmeans");
 			addOption ("smote", &smote, 1, SSI_BOOL, "use smote to over sample under represented classes");
 			addOption ("norm", &norm, 1, SSI_BOOL, "apply normalization in interval [-1,1]");
 			addOption ("random_seed", &random_seed, 1, SSI_BOOL, "apply random seed to center selection");
 			addOption ("seed", &seed, 1, SSI_INT, "apply seed when not using randomized center selection");
+			addOption ("method", &method, 1, SSI_INT, "method (0=KDTREE, 1=LLOYD, 2=MINIBATCH)");
+			addOption ("batch", &batch, 1, SSI_SIZE, "#samples per batch (MINIBATCH only)");
+			addOption ("steps", &steps, 1, SSI_SIZE, "max #iterations (LLOYD) or #batches (MINIBATCH)");
 		};
 
 		ssi_size_t k;
@@ -69,6 +80,9 @@ public:
 		bool norm;
 		bool random_seed;
 		ssi_size_t seed;
+		METHOD method;
+		ssi_size_t batch;
+		ssi_size_t steps;
 	};
 
 public:
@@ -99,6 +113,7 @@ public:
 	ssi_real_t *const*getClusters () { return _clusters; }; // clusters	
 	ssi_size_t getAssignmentsSize () { return _n_samples; };
 	const int *getAssignments () { return _assignments; }; // assigments
+	ssi_real_t getCost () { return _cost; }; // sum of squared distances to the assigned clusters
 	ssi_size_t getIndicesPerClusterSize (ssi_size_t cluster) { return _n_indices_per_cluster[cluster]; }; // number of training samples in cluster
 	const ssi_size_t *getIndicesPerCluster (ssi_size_t cluster) { return _indices_per_cluster[cluster]; }; // indices per cluster
 	
@@ -122,6 +137,8 @@ protected:
 	ssi_real_t *_norm_as;
 	ssi_real_t *_norm_bs;
 
+	ssi_real_t _cost;
+
 protected:
 
 	// Sets preferences for how much logging is done and where it is outputted, when k-means is run.
@@ -150,6 +167,14 @@ protected:
 	static Scalar RunKMeansPlusPlus(int n, int k, int d, Scalar *points, int attempts,
 							 Scalar *clusters, int *assignments);
 
+	// Runs LLOYD or MINIBATCH on the given set of points. Attempts are distributed on the
+	// shared worker pool, a single attempt is split into blocks of points instead. Each
+	// attempt draws from its own generator seeded from seed and the attempt index.
+	// Set RunKMeans for info on the other parameters.
+	static Scalar RunKMeansParallel(int n, int k, int d, Scalar *points, int attempts, bool pp,
+							 METHOD method, int batch, int steps, unsigned int seed,
+							 Scalar *clusters, int *assignments);
+
 };
 
 }
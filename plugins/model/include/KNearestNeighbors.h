@@ -69,7 +69,12 @@ public:
 	bool isTrained () { return _data != 0; };
 	bool forward (ssi_stream_t &stream,
 		ssi_size_t n_probs,
-		ssi_real_t *probs);	
+		ssi_real_t *probs);
+	bool forward_batch (ssi_size_t n_samples,
+		ssi_size_t n_features,
+		ssi_real_t *features,
+		ssi_size_t n_probs,
+		ssi_real_t *probs);
 	void release ();
 	bool save (const ssi_char_t *filepath);
 	bool load (const ssi_char_t *filepath);
@@ -91,6 +96,14 @@ protected:
 	ssi_size_t _n_features;
 	ssi_real_t **_data;
 	ssi_size_t *_classes;
+
+	void forward_h (ssi_real_t *sample,
+		ssi_size_t n_probs,
+		ssi_real_t *probs,
+		ssi_size_t *indices,
+		ssi_real_t *distances,
+		ssi_size_t *counter,
+		ssi_real_t *avgdist);
 };
 
 }
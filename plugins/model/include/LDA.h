@@ -76,7 +76,12 @@ public:
 	bool isTrained () { return _covinv != 0; };
 	bool forward (ssi_stream_t &stream,
 		ssi_size_t n_probs,
-		ssi_real_t *probs);	
+		ssi_real_t *probs);
+	bool forward_batch (ssi_size_t n_samples,
+		ssi_size_t n_features,
+		ssi_real_t *features,
+		ssi_size_t n_probs,
+		ssi_real_t *probs);
 	void release ();
 	bool save (const ssi_char_t *filepath);
 	bool load (const ssi_char_t *filepath);
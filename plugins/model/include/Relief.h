@@ -96,6 +96,19 @@ protected:
 
 	ssi_real_t dist (ssi_real_t *x1, ssi_real_t *x2, ssi_size_t n_dim);
 
+	// nearest hit and miss are searched for each sample in parallel,
+	// if dists is set, the distance matrix is filled first
+	struct nearest_job_t {
+		Relief *me;
+		ssi_real_t **dists;
+		ssi_size_t *hits;
+		ssi_real_t *hits_val;
+		ssi_size_t *miss;
+		ssi_real_t *miss_val;
+	};
+	static void DistTask (ssi_size_t index, void *arg);
+	static void NearestTask (ssi_size_t index, void *arg);
+
 	ssi_size_t _n_scores;
 	score *_scores;
 };
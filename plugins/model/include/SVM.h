@@ -75,6 +75,7 @@ public:
 			params.weight_label = 0;
 			params.weight = 0;
 			params.multicore = false;
+			params.dense = true;
 
 			addOption ("svm", &params.svm_type, 1, SSI_INT, "SVM type ( C-SVC=0, nu-SVC=1)"); // , one-class SVM=2, epsilon-SVR=3, nu-SVR=4)");
 			addOption ("kernel", &params.kernel_type, 1, SSI_INT, "Kernel type ( 0=linear: u'*v, 1=polynomial: (gamma*u'*v + coef0)^degree), 2=radial basis function: exp(-gamma*|u-v|^2), 3=sigmoid: tanh(gamma*u'*v + coef0)");
@@ -91,6 +92,7 @@ public:
 			addOption("balance", &balance, 1, SSI_INT, "balance #samples per class (0=off, 1=remove surplus, 2=create missing)");
 
 			addOption("multicore", &params.multicore, 1, SSI_BOOL, "use all available CPU cores");
+			addOption("dense", &params.dense, 1, SSI_BOOL, "keep samples and support vectors in dense arrays and use SIMD kernels (not for precomputed kernels)");
 			
 		};
 
@@ -114,7 +116,12 @@ public:
 	bool isTrained () { return _model != 0; };
 	bool forward (ssi_stream_t &stream,
 		ssi_size_t n_probs,
-		ssi_real_t *probs);	
+		ssi_real_t *probs);
+	bool forward_batch (ssi_size_t n_samples,
+		ssi_size_t n_features,
+		ssi_real_t *features,
+		ssi_size_t n_probs,
+		ssi_real_t *probs);
 	void release ();
 	bool save (const ssi_char_t *filepath);
 	bool load (const ssi_char_t *filepath);
@@ -140,8 +147,15 @@ protected:
 	svm_model *_model;
 	svm_problem *_problem;
 
+	// buffers for dense prediction
+	float *_x_dense;
+	double *_prob_estimates;
+
 	void init_class_names (ISamples &samples);
 	void free_class_names ();
+	void init_dense ();
+	void scale_dense (const ssi_real_t *in, float *out);
+	void copy_probs (const double *prob_estimates, ssi_real_t *probs);
 	bool readLine (FILE *fp, ssi_size_t num, ssi_char_t *string);
 		
 	static void create_scaling (struct svm_problem problem, int n_features, double *_max, double *_min) {
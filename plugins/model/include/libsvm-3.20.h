@@ -45,6 +45,7 @@ struct svm_parameter
 	int shrinking;	/* use the shrinking heuristics */
 	int probability; /* do probability estimates */
 	bool multicore; /* use all CPU cores */
+	bool dense; /* keep training samples as dense float arrays and use SIMD kernels */
 };
 
 //
@@ -70,6 +71,9 @@ struct svm_model
 	/* XXX */
 	int free_sv;		/* 1 if svm_model is created by svm_load_model*/
 				/* 0 if svm_model is created by svm_train */
+
+	int dense_dim;		/* dimension of dense support vectors, 0 if not densified */
+	float *dense_SV;	/* SVs as contiguous matrix (dense_SV[l*dense_dim]), see svm_densify_model */
 };
 
 struct svm_model *svm_train(const struct svm_problem *prob, const struct svm_parameter *param);
@@ -101,6 +105,11 @@ void svm_set_print_string_function(void (*print_func)(const char *));
 svm_model *svm_load_model_h(FILE *fp); //Andreas: added
 void svm_save_model_h(FILE *fp, const svm_model *model); //Andreas: added
 
+int svm_densify_model(struct svm_model *model, int dim); //SSI: added
+double svm_predict_values_dense(const struct svm_model *model, const float *x, double* dec_values); //SSI: added
+double svm_predict_probability_dense(const struct svm_model *model, const float *x, double* prob_estimates); //SSI: added
+void svm_predict_probability_dense_batch(const struct svm_model *model, int n, const float *x, double* prob_estimates); //SSI: added
+
 
 #ifdef __cplusplus
 }
@@ -65,7 +65,7 @@ Dollar$1::~Dollar$1 () {
 
 void Dollar$1::release () {
 
-	_dollar1.templates.clear ();
+	_dollar1.clear ();
 	_n_classes = 0;
 }
 
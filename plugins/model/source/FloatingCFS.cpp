@@ -25,8 +25,9 @@
 //*************************************************************************************************
 
 #include "FloatingCFS.h"
-#include "Evaluation.h"
-#include "Trainer.h"
+#include "thread/WorkerPool.h"
+
+#include "ssistdMinMaxWrapper.h"
 
 namespace ssi {
 
@@ -42,6 +43,8 @@ FloatingCFS::FloatingCFS (const ssi_char_t *file) :
 		_train_instances (0),
 		_corr_matrix (0),
 		_std_devs (0),
+		_means (0),
+		_correlated (0),
 		_numAttribs (0),
 		_numInstances (0),
 		_classIndex (0)		
@@ -123,7 +126,7 @@ void FloatingCFS::release () {
 	// CFS
 	if (_train_instances)
 	{
-		for (ssi_size_t i = 0; i < _numInstances; i++)
+		for (ssi_size_t i = 0; i < _numAttribs; i++)
 		{
 			delete[] _train_instances[i];
 			_train_instances[i] = 0;
@@ -144,6 +147,10 @@ void FloatingCFS::release () {
 	}
 	delete[] _std_devs;
 	_std_devs = 0;
+	delete[] _means;
+	_means = 0;
+	delete[] _correlated;
+	_correlated = 0;
 }
 
 
@@ -211,6 +218,9 @@ void FloatingCFS::inclusion (ssi_size_t n_keep, ssi_size_t k, ssi_size_t l, ssi_
 				ssi_print (" ]\n");
 			}
 
+			// Korrelationen der bereits vorhandenen Features berechnen
+			correlateRows (k);
+
 			// Neues Feature hinzufgen
 			ssi_size_t *sel = new ssi_size_t[k+1];
 			for (ssi_size_t x = 0; x < k; x++) {
@@ -289,6 +299,8 @@ void FloatingCFS::exclusion (ssi_size_t n_keep, ssi_size_t k, ssi_size_t l, ssi_
 				ssi_print (" ]\n");
 			}
 
+			correlateRows (k);
+
 			// schlechtestes Feature entfernen
 			for (ssi_size_t ndim = 0; ndim < k; ndim++) { 
 				ssi_size_t *sel = new ssi_size_t[k-1]; 
@@ -368,8 +380,6 @@ bool FloatingCFS::sffs (ssi_size_t n_keep) {
 void FloatingCFS::sffs_inclusion (ssi_size_t n_keep, ssi_size_t k) {
 
 	ssi_real_t *probs = new ssi_real_t[_n_dims];
-	Evaluation eval;
-	Trainer trainer (_model, _stream_index);
 
 	bool exists;
 
@@ -382,6 +392,8 @@ void FloatingCFS::sffs_inclusion (ssi_size_t n_keep, ssi_size_t k) {
 		ssi_print (" ]\n");
 	}
 
+	correlateRows (k);
+
 	// Neues Feature hinzufgen
 	for (ssi_size_t ndim = 0; ndim < _n_dims; ndim++) { 
 
@@ -447,6 +459,8 @@ void FloatingCFS::sffs_exclusion (ssi_size_t n_keep, ssi_size_t k, ssi_real_t pr
 		ssi_print (" ]\n");
 	}
 
+	correlateRows (k);
+
 	// jeweils ein Feature entfernen
 	for (ssi_size_t ndim = 0; ndim < k; ndim++) { 
 		ssi_size_t *sel = new ssi_size_t[k-1]; 
@@ -516,39 +530,85 @@ void FloatingCFS::buildEvaluator()
 	_numInstances = _samples->getSize ();
 
 	// Create the _train_instances array
-	_train_instances = new ssi_real_t*[_numInstances];
+	_train_instances = new ssi_real_t*[_numAttribs];
+	for (ssi_size_t j = 0; j < _numAttribs; j++)
+	{
+		_train_instances[j] = new ssi_real_t[_numInstances];
+	}
 	_samples->reset ();
 	ssi_size_t i = 0;
 	ssi_sample_t *sample;
 	while (sample = _samples->next ())
 	{
-		_train_instances[i] = new ssi_real_t[_numAttribs];
-
 		// Initialize the matrix with Feature values
 		ssi_real_t *ptr = ssi_pcast(ssi_real_t, sample->streams[_stream_index]->ptr);
 		for (ssi_size_t j = 0; j < _n_dims; j++)
 		{
-			_train_instances[i][j] = *ptr++;
+			_train_instances[j][i] = *ptr++;
 		}
 
 		// Save class index as last element
-		_train_instances[i][_classIndex] = ssi_cast (ssi_real_t, sample->class_id);
+		_train_instances[_classIndex][i] = ssi_cast (ssi_real_t, sample->class_id);
 		i++;
 	}
 
-	// Create correlation arrays
+	// Means and standard deviations, attributes without variance keep a standard deviation of 1
+	_means = new ssi_real_t[_numAttribs];
 	_std_devs = new ssi_real_t[_numAttribs];
+	for (ssi_size_t j = 0; j < _numAttribs; j++)
+	{
+		_means[j] = meanOrMode (j);
+		_std_devs[j] = 1.0;
+	}
+	for (ssi_size_t j = 0; j < _n_dims; j++)
+	{
+		ssi_real_t diff, sx = 0.0;
+		for (ssi_size_t k = 0; k < _numInstances; k++)
+		{
+			diff = _train_instances[j][k] - _means[j];
+			sx += diff * diff;
+		}
+		if (sx != 0.0)
+		{
+			_std_devs[j] = sqrt (sx / _numInstances);
+		}
+	}
+
+	// Weighted variance of the class
+	ssi_real_t *prior_nom = new ssi_real_t[_n_classes];
+	for (ssi_size_t c = 0; c < _n_classes; c++)
+	{
+		prior_nom[c] = 0.0;
+	}
+	for (ssi_size_t k = 0; k < _numInstances; k++)
+	{
+		prior_nom[ssi_cast (ssi_size_t, _train_instances[_classIndex][k])]++;
+	}
+	ssi_real_t temp = 0.0;
+	for (ssi_size_t c = 0; c < _n_classes; c++)
+	{
+		ssi_real_t p = prior_nom[c] / _numInstances;
+		temp += p * (prior_nom[c] * (1.0f - p) * (1.0f - p) + (_numInstances - prior_nom[c]) * p * p) / _numInstances;
+	}
+	if (temp != 0.0)
+	{
+		_std_devs[_classIndex] = sqrt (temp);
+	}
+	delete[] prior_nom;
+
+	// Create correlation arrays
 	_corr_matrix = new ssi_real_t*[_numAttribs];
+	_correlated = new bool[_numAttribs];
 	for (ssi_size_t i = 0; i < _numAttribs; i++)
 	{
 		_corr_matrix[i] = new ssi_real_t[i + 1];
+		_correlated[i] = false;
 	}
 
-	// Feature correlation with itself and default standard deviation.
+	// Feature correlation with itself.
 	for (ssi_size_t i = 0; i < _numAttribs; i++)
 	{
 		_corr_matrix[i][i] = 1.0;
-		_std_devs[i] = 1.0;
 	}
 
 	// Initialize all other values with the largest negative value.
@@ -559,6 +619,57 @@ void FloatingCFS::buildEvaluator()
 			_corr_matrix[i][j] = -FLT_MAX;
 		}
 	}
+
+	// Every subset needs the correlations with the class
+	correlateRow (_classIndex);
+}
+
+void FloatingCFS::correlateRow (ssi_size_t att)
+{
+	if (_correlated[att])
+	{
+		return;
+	}
+
+	row_job_t job;
+	job.me = this;
+	job.att = att;
+	ssi_size_t n_blocks = (_numAttribs + ROW_BLOCK_SIZE - 1) / ROW_BLOCK_SIZE;
+	WorkerPool::GetShared ()->run (n_blocks, RowTask, &job);
+
+	_correlated[att] = true;
+}
+
+void FloatingCFS::correlateRows (ssi_size_t k)
+{
+	for (ssi_size_t i = 0; i < k; i++)
+	{
+		correlateRow (_scores[i].index);
+	}
+}
+
+void FloatingCFS::RowTask (ssi_size_t index, void *arg)
+{
+	row_job_t &job = *ssi_pcast (row_job_t, arg);
+	FloatingCFS *me = job.me;
+	ssi_size_t att = job.att;
+
+	// each task owns the entries of its block, so no entry is written twice
+	ssi_size_t from = index * ROW_BLOCK_SIZE;
+	ssi_size_t to = min (from + ROW_BLOCK_SIZE, me->_numAttribs);
+	for (ssi_size_t j = from; j < to; j++)
+	{
+		if (j == att)
+		{
+			continue;
+		}
+		ssi_size_t larger = j > att ? j : att;
+		ssi_size_t smaller = j > att ? att : j;
+		if (me->_corr_matrix[larger][smaller] == -FLT_MAX)
+		{
+			me->_corr_matrix[larger][smaller] = me->correlate (larger, smaller);
+		}
+	}
 }
 
 ssi_real_t FloatingCFS::eval_h (ssi_size_t n_dims, const ssi_size_t* dims)
@@ -670,34 +781,20 @@ ssi_real_t FloatingCFS::num_num (ssi_size_t att1, ssi_size_t att2)
 	}
 
     ssi_real_t diff1, diff2, num = 0.0, sx = 0.0, sy = 0.0;
-    ssi_real_t mx = meanOrMode(att1);
-    ssi_real_t my = meanOrMode(att2);
+    ssi_real_t mx = _means[att1];
+    ssi_real_t my = _means[att2];
+	const ssi_real_t *x = _train_instances[att1];
+	const ssi_real_t *y = _train_instances[att2];
 
     for (ssi_size_t i = 0; i < _numInstances; i++)
 	{
-        diff1 = _train_instances[i][att1] - mx;
-        diff2 = _train_instances[i][att2] - my;
+        diff1 = x[i] - mx;
+        diff2 = y[i] - my;
         num += diff1 * diff2;
         sx += diff1 * diff1;
         sy += diff2 * diff2;
     }
 
-    if (sx != 0.0)
-	{
-        if (_std_devs[att1] == 1.0)
-		{
-            _std_devs[att1] = sqrt (sx / _numInstances);
-        }
-    }
-
-    if (sy != 0.0)
-	{
-        if (_std_devs[att2] == 1.0)
-		{
-            _std_devs[att2] = sqrt (sy / _numInstances);
-        }
-    }
-
     if ((sx * sy) > 0.0)
 	{
         return abs (num / sqrt (sx * sy));
@@ -723,11 +820,12 @@ ssi_real_t FloatingCFS::num_nom2 (ssi_size_t att1, ssi_size_t att2)
 {
 	ssi_size_t i, ii, k;
 	ssi_real_t temp;
-	ssi_size_t mx = ssi_cast (ssi_size_t, meanOrMode(att1));
-	ssi_real_t my = meanOrMode(att2);
+	ssi_real_t my = _means[att2];
 	ssi_real_t stdv_num = 0.0;
 	ssi_real_t diff1, diff2;
 	ssi_real_t r = 0.0, rr;
+	const ssi_real_t *x = _train_instances[att1];
+	const ssi_real_t *y = _train_instances[att2];
 
 	//	h?
 //	int nx = (!m_missingSeperate) ? _samples.attribute(att1).numValues() : _samples.attribute(att1).numValues() + 1;
@@ -743,7 +841,7 @@ ssi_real_t FloatingCFS::num_nom2 (ssi_size_t att1, ssi_size_t att2)
 
 	// calculate frequencies (and means) of the values of the nominal attribute
 	for (i = 0; i < _numInstances; i++) {
-		ii = ssi_cast (ssi_size_t, _train_instances[i][att1]);
+		ii = ssi_cast (ssi_size_t, x[i]);
 
 		// increment freq for nominal
 		prior_nom[ii]++;
@@ -753,13 +851,13 @@ ssi_real_t FloatingCFS::num_nom2 (ssi_size_t att1, ssi_size_t att2)
 		//inst = _samples.instance(k);
 		// std dev of numeric attribute
 		//diff2 =  (inst.value(att2) - my);
-		diff2 =  (_train_instances[k][att2] - my);
+		diff2 =  (y[k] - my);
 		stdv_num += (diff2 * diff2);
 
 		// 
 		for (i = 0; i < nx; i++) {
 			
-			temp = (i == _train_instances[k][att1]) ? 1.0f : 0.0f;
+			temp = (i == x[k]) ? 1.0f : 0.0f;
 			
 			diff1 = (temp - (prior_nom[i] / _numInstances));
 			stdvs_nom[i] += (diff1 * diff1);
@@ -768,10 +866,7 @@ ssi_real_t FloatingCFS::num_nom2 (ssi_size_t att1, ssi_size_t att2)
 	}
 
 	// calculate weighted correlation
-	for (i = 0, temp = 0.0; i < nx; i++) {
-		// calculate the weighted variance of the nominal
-		temp += ((prior_nom[i] / _numInstances) * (stdvs_nom[i] / _numInstances));
-
+	for (i = 0; i < nx; i++) {
 		if ((stdvs_nom[i] * stdv_num) > 0.0) {
 			//System.out.println("Stdv :"+stdvs_nom[i]);
 			rr = abs (covs[i] / (sqrt(stdvs_nom[i] * stdv_num)));
@@ -789,20 +884,6 @@ ssi_real_t FloatingCFS::num_nom2 (ssi_size_t att1, ssi_size_t att2)
 		}
 	}
 
-	// set the standard deviations for these attributes if necessary
-	// if ((att1 != classIndex) && (att2 != classIndex)) // =============
-	if (temp != 0.0) {
-		if (_std_devs[att1] == 1.0) {
-			_std_devs[att1] = sqrt(temp);
-		}
-	}
-
-	if (stdv_num != 0.0) {
-		if (_std_devs[att2] == 1.0) {
-			_std_devs[att2] = sqrt((stdv_num / _numInstances));
-		}
-	}
-
 	if (r == 0.0) {
 		if (att1 != _classIndex && att2 != _classIndex) {
 			r = 1.0;
@@ -836,7 +917,7 @@ ssi_real_t FloatingCFS::meanOrMode(ssi_size_t att) {
 			anz[i] = 0;
 		}
 		for (ssi_size_t i=0; i<_numInstances; i++) {
-			anz[(ssi_size_t)_train_instances[i][att]]++;
+			anz[(ssi_size_t)_train_instances[att][i]]++;
 		}
 		int maxindex = 0;
 		for (ssi_size_t i = 1; i < _n_classes; i++) {
@@ -856,12 +937,7 @@ ssi_real_t FloatingCFS::meanOrMode(ssi_size_t att) {
 			return 0;
 		}
 
-		ssi_real_t werte = 0;
-		for (ssi_size_t i = 0; i < _numInstances; i++)
-		{
-			werte += _train_instances[i][att];
-		}
-		return werte / _numInstances;
+		return mean_float (_train_instances[att], _numInstances);
 	}
 }
 
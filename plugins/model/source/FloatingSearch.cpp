@@ -28,8 +28,12 @@
 #include "Trainer.h"
 #include "Evaluation.h"
 #include "ISSelectDim.h"
+#include "ISSelectSample.h"
 #include "model/ModelTools.h"
-#include "thread/ThreadPool.h"
+#include "thread/WorkerPool.h"
+#include "thread/Lock.h"
+
+#include <algorithm>
 
 namespace ssi {
 
@@ -40,7 +44,12 @@ FloatingSearch::FloatingSearch (const ssi_char_t *file) :
 	_n_dims (0),
 	_n_scores (0),
 	_scores (0),
-	_samples (0) {
+	_samples (0),
+	_pool (0),
+	_list (0),
+	_list_indices (0),
+	_n_models (0),
+	_models (0) {
 
 
 	ssi_log_level = SSI_LOG_LEVEL_DEFAULT;
@@ -80,6 +89,33 @@ bool FloatingSearch::train (ISamples &samples,
 	_stream_index = stream_index;	
 	_samples = &samples;
 
+	_n_models = 1;
+	if (_options.nthread > 1) {
+
+		// tasks must not share an iterator, so candidates are selected from a copy that is read through get ()
+		_list = new SampleList ();
+		ModelTools::CopySampleList (samples, *_list);
+		_list_indices = new ssi_size_t[_list->getSize ()];
+		for (ssi_size_t i = 0; i < _list->getSize (); i++) {
+			_list_indices[i] = i;
+		}
+
+		// first thread uses the original model, the others get a copy
+		_pool = new WorkerPool ("fsearch", _options.nthread);
+		_models = new IModel *[_pool->size ()];
+		_models[0] = _model;
+		for (_n_models = 1; _n_models < _pool->size (); _n_models++) {
+			if (!(_models[_n_models] = ModelTools::CloneModel (_model))) {
+				ssi_wrn ("could not create a copy of '%s', evaluate candidates on calling thread", _model->getName ());
+				for (ssi_size_t i = 1; i < _n_models; i++) {
+					delete _models[i];
+				}
+				_n_models = 1;
+				break;
+			}
+		}
+	}
+
 	switch (_options.method) {
 		case SFS:
 			lr_search (_n_scores, 1, 0);
@@ -113,6 +149,17 @@ void FloatingSearch::release () {
 	delete[] _scores; _scores = 0;
 	_n_scores = 0;
 	_samples = 0;
+
+	for (ssi_size_t i = 1; i < _n_models; i++) {
+		delete _models[i];
+	}
+	delete[] _models; _models = 0;
+	_n_models = 0;
+	delete _pool; _pool = 0;
+	delete _list; _list = 0;
+	delete[] _list_indices; _list_indices = 0;
+
+	_cache.clear ();
 }
 
 
@@ -130,11 +177,7 @@ bool FloatingSearch::lr_search (ssi_size_t n_keep, ssi_size_t l, ssi_size_t r) {
 	// Initialisierung
 	if ( l > r ) {
 		k = 0;
-		if (_options.nthread > 0) {
-			tp_inclusion (n_keep, k, l, r);
-		} else {
-			inclusion (n_keep, k, l, r);
-		}
+		inclusion (n_keep, k, l, r);
 	}
 	else if ( l < r ) {
 		k = _n_dims;
@@ -167,10 +210,6 @@ void FloatingSearch::inclusion (ssi_size_t n_keep, ssi_size_t k, ssi_size_t l, s
 	if (l > 0) {
 
 		ssi_real_t *probs = new ssi_real_t[_n_dims];
-		Evaluation eval;
-		Trainer trainer (_model, _stream_index);
-
-		bool exists; 
 
 		ssi_msg (SSI_LOG_LEVEL_DETAIL, "inclusion: k=%u l=%u", k, l);
 
@@ -187,170 +226,7 @@ void FloatingSearch::inclusion (ssi_size_t n_keep, ssi_size_t k, ssi_size_t l, s
 			}
 
 			// Neues Feature hinzufgen
-			ssi_size_t *sel = new ssi_size_t[k+1];
-			for (ssi_size_t x = 0; x < k; x++) {
-				sel[x] = _scores[x].index;
-			}
-
-			for (ssi_size_t ndim = 0; ndim < _n_dims; ndim++) { 
-				
-				// Bereits vorhandene Features berspringen
-				exists = false;
-				for (ssi_size_t j = 0; j < k; j++) {
-					if (_scores[j].index == ndim) {
-						exists = true;
-						probs[ndim] = -FLT_MAX;
-					}
-
-				}
-				
-				// Feature noch nicht enthalten
-				if (!exists) {
-
-					sel[k] = ndim;
-					ISSelectDim samples_s (_samples);
-					samples_s.setSelection (_stream_index, k + 1, sel);
-					probs[ndim] = eval_h (&eval, &trainer, samples_s);					
-
-					if (ssi_log_level >= SSI_LOG_LEVEL_DEBUG) {
-						ssi_print ("+%u=%.2f\n", ndim, probs[ndim]);
-					}
-				}
-			}
-			delete[] sel;
-
-			// Whle das beste Feature
-			ssi_real_t max_val = probs[0];
-			ssi_size_t max_ind = 0;
-			for (ssi_size_t ndim = 1; ndim < _n_dims; ndim++) {
-				if (probs[ndim] > max_val) {
-					max_val = probs[ndim];
-					max_ind = ndim;
-				}
-			}
-			_scores[k].index = max_ind;
-			_scores[k].value = max_val;
-			probs[max_ind] = -FLT_MAX;
-
-			ssi_msg (SSI_LOG_LEVEL_DETAIL, "add: %u=%.2f", max_ind, max_val);
-
-			k++;
-			i++;
-		}
-
-		delete[] probs;
-	}
-
-	if (k != n_keep)
-		exclusion (n_keep, k, l, r);
-}
-
-void FloatingSearch::tp_inclusion (ssi_size_t n_keep, ssi_size_t k, ssi_size_t l, ssi_size_t r) {
-
-	if (l > 0) {
-
-		ssi::ThreadPool tp ("inclusion", _options.nthread);
-
-		ssi_real_t *probs = new ssi_real_t[_n_dims];
-		Trainer trainer (_model, _stream_index);
-
-		bool exists; 
-
-		ssi_msg (SSI_LOG_LEVEL_DETAIL, "inclusion (tp): k=%u l=%u", k, l);
-
-		// Fge l neue Features hinzu
-		ssi_size_t i = 0;
-		while( (k != n_keep) && i < l ) 
-		{
-			if (ssi_log_level >= SSI_LOG_LEVEL_DEBUG) {
-				ssi_print ("selected: [");
-				for (ssi_size_t c = 0; c < k; c++) {
-					ssi_print (" %u", _scores[c].index);
-				}
-				ssi_print (" ]\n");
-			}
-
-			// Neues Feature hinzufgen
-			ssi_size_t *sel = new ssi_size_t[k+1];
-			for (ssi_size_t x = 0; x < k; x++) {
-				sel[x] = _scores[x].index;
-			}
-
-			for (ssi_size_t ndim = 0; ndim < _n_dims; ndim++) { 
-				
-				// Bereits vorhandene Features berspringen
-				exists = false;
-				for (ssi_size_t j = 0; j < k; j++) {
-					if (_scores[j].index == ndim) {
-						exists = true;
-						probs[ndim] = -FLT_MAX;
-					}
-
-				}
-				
-				// Feature noch nicht enthalten
-				if (!exists) {
-
-					sel[k] = ndim;
-					ISSelectDim samples_s (_samples);
-					samples_s.setSelection (_stream_index, k + 1, sel);
-					//probs[ndim] = eval_h (eval, trainer, samples_s);		
-
-					if (!trainer.isTrained ()) {
-						trainer.train (samples_s);
-						trainer.save ("~tp_inclusion");
-					}
-
-					tp_eval_h_in_s *in = new tp_eval_h_in_s;
-					in->dim = ndim;
-					in->options = &_options;
-					SampleList *samples = new SampleList ();
-					ModelTools::CopySampleList (samples_s, *samples);
-					in->samples = samples;
-					Trainer *trainer = new Trainer ();
-					if (!Trainer::Load (*trainer, "~tp_inclusion")) {
-						ssi_err ("could not load temporal copy of trainer '%s'", "~tp_inclusion");
-					}
-					in->trainer = trainer;
-
-					tp_eval_h_out_s *out = new tp_eval_h_out_s;
-					out->result = 0.0f;
-
-					ThreadPool::job_s job;
-					job.n_in = sizeof (*in);
-					job.in = in;
-					job.n_out = sizeof (*out);
-					job.out = out;
-					job.job = FloatingSearch::tp_eval_h;
-
-					tp.add (job);
-
-					if (ssi_log_level >= SSI_LOG_LEVEL_DEBUG) {
-						ssi_print ("+%u=%.2f\n", ndim, probs[ndim]);
-					}
-				}
-			}
-
-			tp.work ();
-
-			ThreadPool::job_s job;
-			for (ssi_size_t njob = 0; njob < tp.size (); njob++) {
-
-				job = tp.get (njob);
-				tp_eval_h_in_s *in = ssi_pcast (tp_eval_h_in_s, job.in);
-				tp_eval_h_out_s *out = ssi_pcast (tp_eval_h_out_s, job.out);
-
-				probs[in->dim] = out->result;
-
-				delete in->samples;
-				delete in->trainer;
-				delete in;
-				delete out;
-			}
-
-			tp.clear ();
-
-			delete[] sel;
+			eval_inclusion (k, probs, -FLT_MAX);
 
 			// Whle das beste Feature
 			ssi_real_t max_val = probs[0];
@@ -378,15 +254,11 @@ void FloatingSearch::tp_inclusion (ssi_size_t n_keep, ssi_size_t k, ssi_size_t l
 		exclusion (n_keep, k, l, r);
 }
 
-
-
 void FloatingSearch::exclusion (ssi_size_t n_keep, ssi_size_t k, ssi_size_t l, ssi_size_t r) {
 
 	if (r > 0) {
 
 		ssi_real_t *probs = new ssi_real_t[_n_dims];
-		Evaluation eval;
-		Trainer trainer (_model, _stream_index);
 
 		ssi_msg (SSI_LOG_LEVEL_DETAIL, "exclusion: k=%u r=%u", k, r);
 
@@ -404,29 +276,7 @@ void FloatingSearch::exclusion (ssi_size_t n_keep, ssi_size_t k, ssi_size_t l, s
 			}
 
 			// schlechtestes Feature entfernen
-			for (ssi_size_t ndim = 0; ndim < k; ndim++) { 
-				ssi_size_t *sel = new ssi_size_t[k-1]; 
-
-				// entfernt ein Feature 
-				ssi_size_t src = 0;
-				ssi_size_t des = 0;
-				for (ssi_size_t j = 0; j < k; j++) {
-					if (j != ndim) 
-						sel[des++] = _scores[src++].index;
-					else {
-						src++;
-					}
-				}
-				ISSelectDim samples_s (_samples);
-				samples_s.setSelection (_stream_index, k-1, sel);
-				probs[ndim] = eval_h (&eval, &trainer, samples_s);
-
-				if (ssi_log_level >= SSI_LOG_LEVEL_DEBUG) {
-					ssi_print ("-%u=%.2f\n", _scores[ndim].index, probs[ndim]);
-				}
-
-				delete[] sel;
-			}
+			eval_exclusion (k, probs);
 
 			// Whle das schlechteste Feature
 			ssi_real_t max_val = probs[0];
@@ -461,11 +311,7 @@ void FloatingSearch::exclusion (ssi_size_t n_keep, ssi_size_t k, ssi_size_t l, s
 	}
 
 	if (k != n_keep) {
-		if (_options.nthread > 0) {
-			tp_inclusion (n_keep, k, l, r);
-		} else {
-			inclusion (n_keep, k, l, r);
-		}
+		inclusion (n_keep, k, l, r);
 	}
 }
 
@@ -489,10 +335,6 @@ bool FloatingSearch::sffs (ssi_size_t n_keep) {
 void FloatingSearch::sffs_inclusion (ssi_size_t n_keep, ssi_size_t k) {
 
 	ssi_real_t *probs = new ssi_real_t[_n_dims];
-	Evaluation eval;
-	Trainer trainer (_model, _stream_index);
-
-	bool exists;
 
 	ssi_msg (SSI_LOG_LEVEL_DETAIL, "inclusion: k=%u\n", k);
 	if (ssi_log_level >= SSI_LOG_LEVEL_DEBUG) {
@@ -504,35 +346,7 @@ void FloatingSearch::sffs_inclusion (ssi_size_t n_keep, ssi_size_t k) {
 	}
 
 	// Neues Feature hinzufgen
-	for (ssi_size_t ndim = 0; ndim < _n_dims; ndim++) { 
-		
-		// Vorhandene Features berspringen
-		exists = false;
-		for (ssi_size_t j = 0; j < k; j++) {
-			if (_scores[j].index == ndim) {
-				exists = true;
-				probs[ndim] = 0;
-			}
-
-		}
-		
-		if (!exists) {
-			ssi_size_t *sel = new ssi_size_t[k+1];
-			for (ssi_size_t i = 0; i < k+1; i++)
-				sel[i] = _scores[i].index;
-
-			sel[k] = ndim;
-			ISSelectDim samples_s (_samples);
-			bool b = samples_s.setSelection (_stream_index, k + 1, sel);
-			probs[ndim] = eval_h (&eval, &trainer, samples_s);
-
-			if (ssi_log_level >= SSI_LOG_LEVEL_DEBUG) {
-				ssi_print ("+%u=%.2f\n", ndim, probs[ndim]);
-			}
-
-			delete[] sel;
-		}
-	}
+	eval_inclusion (k, probs, 0);
 
 	// Whle das beste Feature
 	ssi_real_t max_val = probs[0];
@@ -560,8 +374,6 @@ void FloatingSearch::sffs_inclusion (ssi_size_t n_keep, ssi_size_t k) {
 void FloatingSearch::sffs_exclusion (ssi_size_t n_keep, ssi_size_t k, ssi_real_t prev_eval) {
 	
 	ssi_real_t *probs = new ssi_real_t[_n_dims];
-	Evaluation eval;
-	Trainer trainer (_model, _stream_index);
 
 	ssi_msg (SSI_LOG_LEVEL_DETAIL, "exclusion: k=%u p=%.2f\n", k, prev_eval);
 	if (ssi_log_level >= SSI_LOG_LEVEL_DEBUG) {
@@ -573,30 +385,7 @@ void FloatingSearch::sffs_exclusion (ssi_size_t n_keep, ssi_size_t k, ssi_real_t
 	}
 
 	// jeweils ein Feature entfernen
-	for (ssi_size_t ndim = 0; ndim < k; ndim++) { 
-		ssi_size_t *sel = new ssi_size_t[k-1]; 
-
-		// entfernt ein Feature 
-		ssi_size_t src = 0;
-		ssi_size_t des = 0;
-		for (ssi_size_t j = 0; j < k; j++) {
-			if (j != ndim) 
-				sel[des++] = _scores[src++].index;
-			else {
-				src++;
-			}
-		}
-
-		ISSelectDim samples_s (_samples);
-		samples_s.setSelection (_stream_index, k-1, sel);
-		probs[ndim] = eval_h (&eval, &trainer, samples_s);
-
-		if (ssi_log_level >= SSI_LOG_LEVEL_DEBUG) {
-			ssi_print ("-%u=%.2f\n", _scores[ndim].index, probs[ndim]);
-		}
-
-		delete[] sel;
-	}
+	eval_exclusion (k, probs);
 
 	// Whle das schlechteste Feature
 	ssi_real_t max_val = probs[0];
@@ -631,6 +420,155 @@ void FloatingSearch::sffs_exclusion (ssi_size_t n_keep, ssi_size_t k, ssi_real_t
 	}
 }
 
+void FloatingSearch::eval_inclusion (ssi_size_t k, ssi_real_t *probs, ssi_real_t fill) {
+
+	// Bereits vorhandene Features berspringen
+	ssi_size_t *cand = new ssi_size_t[_n_dims];
+	ssi_size_t n_cand = 0;
+	for (ssi_size_t ndim = 0; ndim < _n_dims; ndim++) {
+		bool exists = false;
+		for (ssi_size_t j = 0; j < k; j++) {
+			if (_scores[j].index == ndim) {
+				exists = true;
+			}
+		}
+		if (exists) {
+			probs[ndim] = fill;
+		} else {
+			cand[n_cand++] = ndim;
+		}
+	}
+
+	ssi_size_t *sel = new ssi_size_t[n_cand * (k+1)];
+	ssi_real_t *values = new ssi_real_t[n_cand];
+	for (ssi_size_t c = 0; c < n_cand; c++) {
+		for (ssi_size_t x = 0; x < k; x++) {
+			sel[c * (k+1) + x] = _scores[x].index;
+		}
+		sel[c * (k+1) + k] = cand[c];
+	}
+
+	eval_subsets (n_cand, k+1, sel, values);
+
+	for (ssi_size_t c = 0; c < n_cand; c++) {
+		probs[cand[c]] = values[c];
+		if (ssi_log_level >= SSI_LOG_LEVEL_DEBUG) {
+			ssi_print ("+%u=%.2f\n", cand[c], values[c]);
+		}
+	}
+
+	delete[] cand;
+	delete[] sel;
+	delete[] values;
+}
+
+void FloatingSearch::eval_exclusion (ssi_size_t k, ssi_real_t *probs) {
+
+	// entfernt jeweils ein Feature
+	ssi_size_t *sel = new ssi_size_t[k * (k-1)];
+	for (ssi_size_t ndim = 0; ndim < k; ndim++) {
+		ssi_size_t des = ndim * (k-1);
+		for (ssi_size_t j = 0; j < k; j++) {
+			if (j != ndim) {
+				sel[des++] = _scores[j].index;
+			}
+		}
+	}
+
+	eval_subsets (k, k-1, sel, probs);
+
+	if (ssi_log_level >= SSI_LOG_LEVEL_DEBUG) {
+		for (ssi_size_t ndim = 0; ndim < k; ndim++) {
+			ssi_print ("-%u=%.2f\n", _scores[ndim].index, probs[ndim]);
+		}
+	}
+
+	delete[] sel;
+}
+
+void FloatingSearch::eval_subsets (ssi_size_t n, ssi_size_t n_sel, const ssi_size_t *sel, ssi_real_t *probs) {
+
+	// look up subsets that have been scored before
+	ssi_size_t *todo = new ssi_size_t[n];
+	ssi_size_t n_todo = 0;
+	for (ssi_size_t i = 0; i < n; i++) {
+		if (_options.cache) {
+			std::vector<ssi_size_t> key (sel + i * n_sel, sel + (i+1) * n_sel);
+			std::sort (key.begin (), key.end ());
+			std::map<std::vector<ssi_size_t>, ssi_real_t>::iterator it = _cache.find (key);
+			if (it != _cache.end ()) {
+				probs[i] = it->second;
+				continue;
+			}
+		}
+		todo[n_todo++] = i;
+	}
+
+	eval_job_t job;
+	job.me = this;
+	job.n_sel = n_sel;
+	job.sel = sel;
+	job.todo = todo;
+	job.probs = probs;
+	job.free_models = new ssi_size_t[_n_models];
+	job.n_free_models = _n_models;
+	for (ssi_size_t i = 0; i < _n_models; i++) {
+		job.free_models[i] = i;
+	}
+
+	if (_n_models > 1) {
+		_pool->run (n_todo, EvalTask, &job);
+	} else {
+		for (ssi_size_t i = 0; i < n_todo; i++) {
+			EvalTask (i, &job);
+		}
+	}
+
+	if (_options.cache) {
+		for (ssi_size_t i = 0; i < n_todo; i++) {
+			std::vector<ssi_size_t> key (sel + todo[i] * n_sel, sel + (todo[i]+1) * n_sel);
+			std::sort (key.begin (), key.end ());
+			_cache[key] = probs[todo[i]];
+		}
+	}
+
+	delete[] todo;
+	delete[] job.free_models;
+}
+
+void FloatingSearch::EvalTask (ssi_size_t index, void *arg) {
+
+	eval_job_t &job = *ssi_pcast (eval_job_t, arg);
+	FloatingSearch *me = job.me;
+	ssi_size_t i = job.todo[index];
+
+	// at most one task per thread is running, so a model is always available
+	ssi_size_t model = 0;
+	{
+		Lock lock (job.mutex);
+		model = job.free_models[--job.n_free_models];
+	}
+
+	Evaluation eval;
+	Trainer trainer (me->_models ? me->_models[model] : me->_model, me->_stream_index);
+	if (me->_list) {
+		ISSelectSample samples_all (me->_list);
+		samples_all.setSelection (me->_list->getSize (), me->_list_indices);
+		ISSelectDim samples_s (&samples_all);
+		samples_s.setSelection (me->_stream_index, job.n_sel, job.sel + i * job.n_sel);
+		job.probs[i] = me->eval_h (&eval, &trainer, samples_s);
+	} else {
+		ISSelectDim samples_s (me->_samples);
+		samples_s.setSelection (me->_stream_index, job.n_sel, job.sel + i * job.n_sel);
+		job.probs[i] = me->eval_h (&eval, &trainer, samples_s);
+	}
+
+	{
+		Lock lock (job.mutex);
+		job.free_models[job.n_free_models++] = model;
+	}
+}
+
 SSI_INLINE ssi_real_t FloatingSearch::eval_h (Evaluation *eval, Trainer *trainer, ISamples &samples) {
 
 	if (_options.loo) {
@@ -646,33 +584,4 @@ SSI_INLINE ssi_real_t FloatingSearch::eval_h (Evaluation *eval, Trainer *trainer
 	return _options.eval == FloatingSearch::CLASSWISE ? eval->get_classwise_prob () : eval->get_accuracy_prob ();
 }
 
-SSI_INLINE bool FloatingSearch::tp_eval_h (ssi_size_t n_in, void *in, ssi_size_t n_out, void *out) {
-
-	SSI_ASSERT (sizeof (tp_eval_h_in_s) == n_in);
-	SSI_ASSERT (sizeof (tp_eval_h_out_s) == n_out);
-
-	tp_eval_h_in_s *in_s = ssi_pcast (tp_eval_h_in_s, in);
-	Options *options = in_s->options;
-	Evaluation eval;
-	Trainer *trainer = in_s->trainer;
-	ISamples *samples = in_s->samples;
-
-	if (options->loo) {
-		eval.evalLOO (trainer, *samples);
-	} else if (options->louo) {
-		eval.evalLOUO (trainer, *samples);
-	} else if (options->split > 0 && options->split < 1) {
-		eval.evalSplit (trainer, *samples, options->split);
-	} else {
-		eval.evalKFold (trainer, *samples, options->kfold);
-	}
-	
-	ssi_real_t result = options->eval == FloatingSearch::CLASSWISE ? eval.get_classwise_prob () : eval.get_accuracy_prob ();
-
-	tp_eval_h_out_s *out_s = ssi_pcast (tp_eval_h_out_s, out);
-	out_s->result = result;
-	
-	return true;
-}
-
 }
@@ -35,9 +35,27 @@
 // of the ACM Symposium on User Interface Software and Technology (UIST '07). Newport,
 // Rhode Island (October 7-10, 2007). New York: ACM Press, pp. 159-168.
 //
+// Li, Y. (2010) Protractor: A fast and accurate gesture recognizer. Proceedings of the
+// ACM Conference on Human Factors in Computing Systems (CHI '10). Atlanta, Georgia
+// (April 10-15, 2010). New York: ACM Press, pp. 2169-2172.
+//
 // *************************************************************************************************
 
 #include "GeometricRecognizer.h"
+#include "signal/TypeCast.h"
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+	#define SSI_GEOMETRICRECOGNIZER_X86
+	#include <emmintrin.h>
+	#if defined(_MSC_VER)
+		#define SSI_GEOMETRICRECOGNIZER_TARGET(x)
+	#else
+		#define SSI_GEOMETRICRECOGNIZER_TARGET(x) __attribute__((target(x)))
+	#endif
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__) || defined(__aarch64__)
+	#define SSI_GEOMETRICRECOGNIZER_NEON
+	#include <arm_neon.h>
+#endif
 
 #ifdef USE_SSI_LEAK_DETECTOR
 	#include "SSI_LeakWatcher.h"
@@ -50,10 +68,96 @@
 
 //#define MAX_DOUBLE std::numeric_limits<double>::max();
 #define MAX_DOUBLE DBL_MAX
+#define MAX_ANGLE 3.14159265358979323846
 
 namespace ssi
 {
 
+struct GeometricRecognizer::kernels_t {
+	// a = sum of t * q, b = sum of t * p
+	void (*dot2) (ssi_size_t n, const float *t, const float *q, const float *p, float &a, float &b);
+};
+
+static void dot2_scalar (ssi_size_t n, const float *t, const float *q, const float *p, float &a, float &b) {
+
+	float sa = 0, sb = 0;
+	for (ssi_size_t i = 0; i < n; i++) {
+		sa += t[i] * q[i];
+		sb += t[i] * p[i];
+	}
+
+	a = sa;
+	b = sb;
+}
+
+#ifdef SSI_GEOMETRICRECOGNIZER_X86
+
+SSI_GEOMETRICRECOGNIZER_TARGET("sse2")
+static void dot2_sse2 (ssi_size_t n, const float *t, const float *q, const float *p, float &a, float &b) {
+
+	__m128 acc_a = _mm_setzero_ps ();
+	__m128 acc_b = _mm_setzero_ps ();
+
+	ssi_size_t i = 0;
+	for (; i + 4 <= n; i += 4) {
+		__m128 x = _mm_loadu_ps (t + i);
+		acc_a = _mm_add_ps (acc_a, _mm_mul_ps (x, _mm_loadu_ps (q + i)));
+		acc_b = _mm_add_ps (acc_b, _mm_mul_ps (x, _mm_loadu_ps (p + i)));
+	}
+
+	float sum_a[4], sum_b[4];
+	_mm_storeu_ps (sum_a, acc_a);
+	_mm_storeu_ps (sum_b, acc_b);
+
+	dot2_scalar (n - i, t + i, q + i, p + i, a, b);
+	a += (sum_a[0] + sum_a[1]) + (sum_a[2] + sum_a[3]);
+	b += (sum_b[0] + sum_b[1]) + (sum_b[2] + sum_b[3]);
+}
+
+#endif
+
+#ifdef SSI_GEOMETRICRECOGNIZER_NEON
+
+static void dot2_neon (ssi_size_t n, const float *t, const float *q, const float *p, float &a, float &b) {
+
+	float32x4_t acc_a = vdupq_n_f32 (0);
+	float32x4_t acc_b = vdupq_n_f32 (0);
+
+	ssi_size_t i = 0;
+	for (; i + 4 <= n; i += 4) {
+		float32x4_t x = vld1q_f32 (t + i);
+		acc_a = vmlaq_f32 (acc_a, x, vld1q_f32 (q + i));
+		acc_b = vmlaq_f32 (acc_b, x, vld1q_f32 (p + i));
+	}
+
+	float32x2_t sum_a = vadd_f32 (vget_low_f32 (acc_a), vget_high_f32 (acc_a));
+	float32x2_t sum_b = vadd_f32 (vget_low_f32 (acc_b), vget_high_f32 (acc_b));
+
+	dot2_scalar (n - i, t + i, q + i, p + i, a, b);
+	a += vget_lane_f32 (vpadd_f32 (sum_a, sum_a), 0);
+	b += vget_lane_f32 (vpadd_f32 (sum_b, sum_b), 0);
+}
+
+#endif
+
+const GeometricRecognizer::kernels_t *GeometricRecognizer::Resolve()
+{
+#if defined(SSI_GEOMETRICRECOGNIZER_X86)
+	if (TypeCast::GetCpuFeatures () & TypeCast::SSE2) {
+		static const kernels_t kernels = { dot2_sse2 };
+		return &kernels;
+	}
+#elif defined(SSI_GEOMETRICRECOGNIZER_NEON)
+	if (TypeCast::GetCpuFeatures () & TypeCast::NEON) {
+		static const kernels_t kernels = { dot2_neon };
+		return &kernels;
+	}
+#endif
+
+	static const kernels_t kernels = { dot2_scalar };
+	return &kernels;
+}
+
 GeometricRecognizer::GeometricRecognizer()
 {
 	//--- How many templates do we have to compare the user's gesture against?
@@ -66,9 +170,6 @@ GeometricRecognizer::GeometricRecognizer()
 	//--- That way we don't have to worry about the symbol the user drew
 	//---  being smaller or larger than the one in the template
 	squareSize = 250;
-	//--- 1/2 max distance across a square, which is the maximum distance
-	//---  a point can be from the center of the gesture
-	halfDiagonal = 0.5 * sqrt((250.0 * 250.0) + (250.0 * 250.0));
 	//--- Before matching, we rotate the symbol the user drew so that the 
 	//---  start point is at degree 0 (right side of symbol). That's how 
 	//---  the templates are rotated so it makes matching easier
@@ -76,15 +177,15 @@ GeometricRecognizer::GeometricRecognizer()
 	//---  which we might not want. Using this, we can't tell the difference
 	//---  between squares and diamonds (which is just a rotated square)
 	setRotationInvariance(false);
-	anglePrecision = 2.0;
-	//--- A magic number used in pre-processing the symbols
-	goldenRatio    = 0.5 * (-1.0 + sqrt(5.0));
+	//--- Dot products run on SIMD units if available
+	kernels = Resolve();
 }
 
 int GeometricRecognizer::addTemplate(int gesture_id, Path2D points)
 {
-	points = normalizePath(points);
+	normalizePath(points);
 
+	addVector(gesture_id, points);
 	templates.push_back(GestureTemplate(gesture_id, points));
 
 	//--- Let them know how many examples of this template we have now
@@ -98,16 +199,35 @@ int GeometricRecognizer::addTemplate(int gesture_id, Path2D points)
 	return numInstancesOfGesture;
 }
 
-Rectangle GeometricRecognizer::boundingBox(Path2D points)
+void GeometricRecognizer::addVector(int gesture_id, const Path2D &points)
+{
+	ssi_size_t n = 2 * numPointsInGesture;
+	ssi_size_t offset = ssi_cast (ssi_size_t, vectorIds.size()) * n;
+
+	//--- Perpendicular half is only needed for the query
+	std::vector<float> perpendicular(n);
+	vectors.resize(offset + n);
+	vectorize(points, &vectors[offset], &perpendicular[0]);
+	vectorIds.push_back(gesture_id);
+}
+
+void GeometricRecognizer::clear()
+{
+	templates.clear();
+	vectors.clear();
+	vectorIds.clear();
+}
+
+Rectangle GeometricRecognizer::boundingBox(const Path2D &points)
 {
 	double minX =  MAX_DOUBLE;
 	double maxX = -MAX_DOUBLE;
 	double minY =  MAX_DOUBLE; 
 	double maxY = -MAX_DOUBLE;
 
-	for (Path2DIterator i = points.begin(); i != points.end(); i++)
+	for (Path2D::const_iterator i = points.begin(); i != points.end(); i++)
 	{
-		Point2D point = *i;
+		const Point2D &point = *i;
 		if (point.x < minX)
 			minX = point.x;
 		if (point.x > maxX)
@@ -121,21 +241,20 @@ Rectangle GeometricRecognizer::boundingBox(Path2D points)
 	return bounds;
 }
 
-Point2D GeometricRecognizer::centroid(Path2D points)
+Point2D GeometricRecognizer::centroid(const Path2D &points)
 {
 	double x = 0.0, y = 0.0;
-	for (Path2DIterator i = points.begin(); i != points.end(); i++)
+	for (Path2D::const_iterator i = points.begin(); i != points.end(); i++)
 	{
-		Point2D point = *i;
-		x += point.x;
-		y += point.y;
+		x += i->x;
+		y += i->y;
 	}
 	x /= points.size();
 	y /= points.size();
 	return Point2D(x, y);
 }	
 
-double GeometricRecognizer::getDistance(Point2D p1, Point2D p2)
+double GeometricRecognizer::getDistance(const Point2D &p1, const Point2D &p2)
 {
 	double dx = p2.x - p1.x;
 	double dy = p2.y - p1.y;
@@ -143,45 +262,37 @@ double GeometricRecognizer::getDistance(Point2D p1, Point2D p2)
 	return distance;
 }
 
-double GeometricRecognizer::distanceAtAngle(
-	Path2D points, GestureTemplate aTemplate, double rotation)
-{
-	Path2D newPoints = rotateBy(points, rotation);
-	return pathDistance(newPoints, aTemplate.points);
-}	
-
+/**
+ * Protractor: the cosine similarity between the template t and the query q
+ *  rotated by theta is a * cos(theta) + b * sin(theta), with a = t . q and
+ *  b = t . p, where p is q rotated by 90 degrees. Its maximum lies at
+ *  theta = atan2(b, a), which we clamp to +/- angleRange as the golden
+ *  section search of $1 did. Returns the angle between the two vectors.
+ */
 double GeometricRecognizer::distanceAtBestAngle(
-	Path2D points, GestureTemplate aTemplate)
+	const float *vector, const float *perpendicular, ssi_size_t index)
 {
-	double startRange = -angleRange;
-	double endRange   =  angleRange;
-	double x1 = goldenRatio * startRange + (1.0 - goldenRatio) * endRange;
-	double f1 = distanceAtAngle(points, aTemplate, x1);
-	double x2 = (1.0 - goldenRatio) * startRange + goldenRatio * endRange;
-	double f2 = distanceAtAngle(points, aTemplate, x2);
-	while (abs(endRange - startRange) > anglePrecision)
-	{
-		if (f1 < f2)
-		{
-			endRange = x2;
-			x2 = x1;
-			f2 = f1;
-			x1 = goldenRatio * startRange + (1.0 - goldenRatio) * endRange;
-			f1 = distanceAtAngle(points, aTemplate, x1);
-		}
-		else
-		{
-			startRange = x1;
-			x1 = x2;
-			f1 = f2;
-			x2 = (1.0 - goldenRatio) * startRange + goldenRatio * endRange;
-			f2 = distanceAtAngle(points, aTemplate, x2);
-		}
-	}
-	return f1 <= f2 ? f1 : f2;
+	ssi_size_t n = 2 * numPointsInGesture;
+
+	float a = 0, b = 0;
+	kernels->dot2(n, &vectors[index * n], vector, perpendicular, a, b);
+
+	double angle = atan2(b, a);
+	if (angle > angleRange)
+		angle = angleRange;
+	else if (angle < -angleRange)
+		angle = -angleRange;
+
+	double similarity = a * cos(angle) + b * sin(angle);
+	if (similarity > 1.0)
+		similarity = 1.0;
+	else if (similarity < -1.0)
+		similarity = -1.0;
+
+	return acos(similarity);
 }
 
-Path2D GeometricRecognizer::normalizePath(Path2D points)
+void GeometricRecognizer::normalizePath(Path2D &points)
 {
 	/* Recognition algorithm from 
 		http://faculty.washington.edu/wobbrock/pubs/uist-07.1.pdf
@@ -189,38 +300,27 @@ Path2D GeometricRecognizer::normalizePath(Path2D points)
 		Step 2: Rotate Once Based on the "Indicative Angle"
 		Step 3: Scale and Translate
 		Step 4: Find the Optimal Angle for the Best Score
+		        (closed form as in Protractor, see distanceAtBestAngle)
 	*/
 	// TODO: Switch to $N algorithm so can handle 1D shapes
 
 	//--- Make everyone have the same number of points (anchor points)
-	points = resample(points);
+	resample(points);
 	//--- Pretend that all gestures began moving from right hand side
 	//---  (degree 0). Makes matching two items easier if they're
 	//---  rotated the same
 	if (getRotationInvariance())
-		points = rotateToZero(points);
+		rotateToZero(points);
 	//--- Pretend all shapes are the same size. 
 	//--- Note that since this is a square, our new shape probably
 	//---  won't be the same aspect ratio
-	points = scaleToSquare(points);
+	scaleToSquare(points);
 	//--- Move the shape until its center is at 0,0 so that everyone
 	//---  is in the same coordinate system
-	points = translateToOrigin(points);
-
-	return points;
-}
-
-double GeometricRecognizer::pathDistance(Path2D pts1, Path2D pts2)
-{
-	// assumes pts1.size == pts2.size
-
-	double distance = 0.0;
-	for (int i = 0; i < (int)pts1.size(); i++) 
-		distance += getDistance(pts1[i], pts2[i]);
-	return (distance / pts1.size());
+	translateToOrigin(points);
 }
 
-double GeometricRecognizer::pathLength(Path2D points)
+double GeometricRecognizer::pathLength(const Path2D &points)
 {
 	double distance = 0;
 	for (int i = 1; i < (int)points.size(); i++)
@@ -228,7 +328,7 @@ double GeometricRecognizer::pathLength(Path2D points)
 	return distance;
 }
 
-RecognitionResult GeometricRecognizer::recognize(Path2D points)
+RecognitionResult GeometricRecognizer::recognize(const Path2D &points)
 {
 	//--- Make sure we have some templates to compare this to
 	//---  or else recognition will be impossible
@@ -237,8 +337,17 @@ RecognitionResult GeometricRecognizer::recognize(Path2D points)
 		ssi_wrn ("no templates loaded so no symbols to match");
 		return RecognitionResult(GestureTemplate::UNKOWN_GESTURE_ID, 0);
 	}
+	if (points.empty())
+	{
+		ssi_wrn ("empty path");
+		return RecognitionResult(GestureTemplate::UNKOWN_GESTURE_ID, 0);
+	}
 
-	points = normalizePath(points);
+	Path2D path(points);
+	normalizePath(path);
+
+	std::vector<float> query(4 * numPointsInGesture);
+	vectorize(path, &query[0], &query[2 * numPointsInGesture]);
 
 	//--- Initialize best distance to the largest possible number
 	//--- That way everything will be better than that
@@ -247,13 +356,11 @@ RecognitionResult GeometricRecognizer::recognize(Path2D points)
 	int indexOfBestMatch = -1;
 
 	//--- Check the shape passed in against every shape in our database
-	for (int i = 0; i < (int)templates.size(); i++)
+	for (int i = 0; i < (int)vectorIds.size(); i++)
 	{
-		//--- Calculate the total distance of each point in the passed in
-		//---  shape against the corresponding point in the template
-		//--- We'll rotate the shape a few degrees in each direction to
-		//---  see if that produces a better match
-		double distance = distanceAtBestAngle(points, templates[i]);
+		//--- Calculate the angle between the passed in shape and the
+		//---  template after rotating it to the best matching angle
+		double distance = distanceAtBestAngle(&query[0], &query[2 * numPointsInGesture], i);
 		if (distance < bestDistance)
 		{
 			bestDistance     = distance;
@@ -261,13 +368,6 @@ RecognitionResult GeometricRecognizer::recognize(Path2D points)
 		}
 	}
 
-	//--- Turn the distance into a percentage by dividing it by 
-	//---  half the maximum possible distance (across the diagonal 
-	//---  of the square we scaled everything too)
-	//--- Distance = hwo different they are
-	//--- Subtract that from 1 (100%) to get the similarity
-	double score = 1.0 - (bestDistance / halfDiagonal);
-
 	//--- Make sure we actually found a good match
 	//--- Sometimes we don't, like when the user doesn't draw enough points
 	if (-1 == indexOfBestMatch)
@@ -276,12 +376,17 @@ RecognitionResult GeometricRecognizer::recognize(Path2D points)
 		return RecognitionResult(GestureTemplate::UNKOWN_GESTURE_ID, 0);
 	}
 
-	RecognitionResult bestMatch(templates[indexOfBestMatch].gesture_id, score);
+	//--- Turn the angle into a percentage by dividing it by the
+	//---  maximum possible angle between two vectors
+	//--- Subtract that from 1 (100%) to get the similarity
+	double score = 1.0 - (bestDistance / MAX_ANGLE);
+
+	RecognitionResult bestMatch(vectorIds[indexOfBestMatch], score);
 	return bestMatch;
 };
 
 /// 2010.05.19 added by Johannes 
-bool GeometricRecognizer::recognizeBestPerClass (Path2D points, ssi_size_t n_classes, ssi_real_t *scores)
+bool GeometricRecognizer::recognizeBestPerClass (const Path2D &points, ssi_size_t n_classes, ssi_real_t *scores)
 {
 	//--- Make sure we have some templates to compare this to
 	//---  or else recognition will be impossible
@@ -290,43 +395,48 @@ bool GeometricRecognizer::recognizeBestPerClass (Path2D points, ssi_size_t n_cla
 		ssi_wrn ("no templates loaded so no symbols to match");
 		return false;
 	}
+	if (points.empty())
+	{
+		ssi_wrn ("empty path");
+		return false;
+	}
 
-	points = normalizePath(points);
+	Path2D path(points);
+	normalizePath(path);
 
-	//--- Initialize best distance to the largest possible number
-	//--- That way everything will be better than that
+	std::vector<float> query(4 * numPointsInGesture);
+	vectorize(path, &query[0], &query[2 * numPointsInGesture]);
+
+	//--- Initialize best distance to the largest possible angle
+	//--- so classes without templates get a score of 0
 	double *bestDistance = new double[n_classes];
 	for (ssi_size_t i = 0; i < n_classes; i++) {
-		bestDistance[i] = MAX_DOUBLE;
+		bestDistance[i] = MAX_ANGLE;
 	}
 
 	//--- Check the shape passed in against every shape in our database
-	for (int i = 0; i < (int)templates.size(); i++)
+	for (int i = 0; i < (int)vectorIds.size(); i++)
 	{
-		//--- Calculate the total distance of each point in the passed in
-		//---  shape against the corresponding point in the template
-		//--- We'll rotate the shape a few degrees in each direction to
-		//---  see if that produces a better match
-		double distance = distanceAtBestAngle(points, templates[i]);
-		int id = templates[i].gesture_id;
-		if (ssi_cast (ssi_size_t, id) > n_classes) {
+		int id = vectorIds[i];
+		if (id < 0 || ssi_cast (ssi_size_t, id) >= n_classes) {
 			delete[] bestDistance;
 			ssi_wrn ("gesture id exceeds #classes");
 			return false;
 		}
+		//--- Calculate the angle between the passed in shape and the
+		//---  template after rotating it to the best matching angle
+		double distance = distanceAtBestAngle(&query[0], &query[2 * numPointsInGesture], i);
 		if (distance < bestDistance[id])
 		{
 			bestDistance[id]     = distance;
 		}
 	}
 
-	//--- Turn the distance into a percentage by dividing it by 
-	//---  half the maximum possible distance (across the diagonal 
-	//---  of the square we scaled everything too)
-	//--- Distance = hwo different they are
+	//--- Turn the angle into a percentage by dividing it by the
+	//---  maximum possible angle between two vectors
 	//--- Subtract that from 1 (100%) to get the similarity
 	for (ssi_size_t i = 0; i < n_classes; i++) {
-		scores[i] = ssi_cast (ssi_real_t, 1.0 - (bestDistance[i] / halfDiagonal));
+		scores[i] = ssi_cast (ssi_real_t, 1.0 - (bestDistance[i] / MAX_ANGLE));
 	}
 
 	delete[] bestDistance;
@@ -334,41 +444,50 @@ bool GeometricRecognizer::recognizeBestPerClass (Path2D points, ssi_size_t n_cla
 	return true;
 };
 
-Path2D GeometricRecognizer::resample(Path2D points)
+void GeometricRecognizer::resample(Path2D &points)
 {
+	if (points.empty())
+		return;
+
 	double interval = pathLength(points) / (numPointsInGesture - 1); // interval length
 	double D = 0.0;
 	Path2D newPoints;
+	newPoints.reserve(numPointsInGesture);
 
 	//--- Store first point since we'll never resample it out of existence
 	newPoints.push_back(points.front());
-    for(int i = 1; i < (int)points.size(); i++)
+	if (interval > 0.0)
 	{
-		Point2D currentPoint  = points[i];
-		Point2D previousPoint = points[i-1];
-		double d = getDistance(previousPoint, currentPoint);
-		if ((D + d) >= interval)
+		Point2D previousPoint = points.front();
+		for (int i = 1; i < (int)points.size(); i++)
 		{
-			double qx = previousPoint.x + ((interval - D) / d) * (currentPoint.x - previousPoint.x);
-			double qy = previousPoint.y + ((interval - D) / d) * (currentPoint.y - previousPoint.y);
-			Point2D point(qx, qy);
-			newPoints.push_back(point);
-			points.insert(points.begin() + i, point);
-			D = 0.0;
+			const Point2D &currentPoint = points[i];
+			double d = getDistance(previousPoint, currentPoint);
+			//--- Add a point for each interval we cross between the two points
+			while (d > 0.0 && (D + d) >= interval && (int)newPoints.size() < numPointsInGesture)
+			{
+				double qx = previousPoint.x + ((interval - D) / d) * (currentPoint.x - previousPoint.x);
+				double qy = previousPoint.y + ((interval - D) / d) * (currentPoint.y - previousPoint.y);
+				previousPoint = Point2D(qx, qy);
+				newPoints.push_back(previousPoint);
+				d = getDistance(previousPoint, currentPoint);
+				D = 0.0;
+			}
+			D += d;
+			previousPoint = currentPoint;
 		}
-		else D += d;
 	}
 
 	// somtimes we fall a rounding-error short of adding the last point, so add it if so
-	if (newPoints.size() == (numPointsInGesture - 1))
+	while ((int)newPoints.size() < numPointsInGesture)
 	{
 		newPoints.push_back(points.back());
 	}
 
-	return newPoints;
+	points.swap(newPoints);
 }
 
-Path2D GeometricRecognizer::rotateBy(Path2D points, double rotation) 
+void GeometricRecognizer::rotateBy(Path2D &points, double rotation) 
 {
 	Point2D c     = centroid(points);
 	//--- can't name cos; creates compiler error since VC++ can't
@@ -376,43 +495,36 @@ Path2D GeometricRecognizer::rotateBy(Path2D points, double rotation)
 	double cosine = cos(rotation);	
 	double sine   = sin(rotation);
 	
-	Path2D newPoints;
 	for (Path2DIterator i = points.begin(); i != points.end(); i++)
 	{
-		Point2D point = *i;
-		double qx = (point.x - c.x) * cosine - (point.y - c.y) * sine   + c.x;
-		double qy = (point.x - c.x) * sine   + (point.y - c.y) * cosine + c.y;
-		newPoints.push_back(Point2D(qx, qy));
+		double dx = i->x - c.x;
+		double dy = i->y - c.y;
+		i->x = dx * cosine - dy * sine   + c.x;
+		i->y = dx * sine   + dy * cosine + c.y;
 	}
-	return newPoints;
 }
 
-Path2D GeometricRecognizer::rotateToZero(Path2D points)
+void GeometricRecognizer::rotateToZero(Path2D &points)
 {
 	Point2D c = centroid(points);
 	double rotation = atan2(c.y - points[0].y, c.x - points[0].x);
-	return rotateBy(points, -rotation);
+	rotateBy(points, -rotation);
 }
 
-Path2D GeometricRecognizer::scaleToSquare(Path2D points)
+void GeometricRecognizer::scaleToSquare(Path2D &points)
 {
 	//--- Figure out the smallest box that can contain the path
 	ssi::Rectangle box = boundingBox(points);
-	Path2D newPoints;
+	//--- Scale the points to fit the main box
+	//--- So if we wanted everything 100x100 and this was 50x50,
+	//---  we'd multiply every point by 2
+	double scaleX = this->squareSize / box.width;
+	double scaleY = this->squareSize / box.height;
 	for (Path2DIterator i = points.begin(); i != points.end(); i++)
 	{
-		Point2D point = *i;
-		//--- Scale the points to fit the main box
-		//--- So if we wanted everything 100x100 and this was 50x50,
-		//---  we'd multiply every point by 2
-		double scaledX = point.x * (this->squareSize / box.width);
-		double scaledY = point.y * (this->squareSize / box.height);
-		//--- Why are we adding them to a new list rather than 
-		//---  just scaling them in-place?
-		// TODO: try scaling in place (once you know this way works)
-		newPoints.push_back(Point2D(scaledX, scaledY));
+		i->x *= scaleX;
+		i->y *= scaleY;
 	}
-	return newPoints;
 }
 
 /*
@@ -454,18 +566,46 @@ void GeometricRecognizer::setRotationInvariance(bool ignoreRotation)
  *  would have a hard time matching shapes drawn at the bottom
  *  of the screen
  */
-Path2D GeometricRecognizer::translateToOrigin(Path2D points)
+void GeometricRecognizer::translateToOrigin(Path2D &points)
 {
 	Point2D c = centroid(points);
-	Path2D newPoints;
 	for (Path2DIterator i = points.begin(); i != points.end(); i++)
 	{
-		Point2D point = *i;
-		double qx = point.x - c.x;
-		double qy = point.y - c.y;
-		newPoints.push_back(Point2D(qx, qy));
+		i->x -= c.x;
+		i->y -= c.y;
+	}
+}
+
+/**
+ * Flatten a normalized path to a unit vector (x0 y0 x1 y1 ...) and the
+ *  same vector rotated by 90 degrees (-y0 x0 -y1 x1 ...). Paths of old
+ *  models with a different number of points are padded with their last
+ *  point or cut.
+ */
+void GeometricRecognizer::vectorize(const Path2D &points, float *vector, float *perpendicular)
+{
+	ssi_size_t n = numPointsInGesture;
+	ssi_size_t size = ssi_cast (ssi_size_t, points.size());
+
+	double norm = 0.0;
+	for (ssi_size_t i = 0; i < n; i++)
+	{
+		const Point2D &point = size == 0 ? Point2D() : points[i < size ? i : size - 1];
+		vector[2 * i]     = ssi_cast (float, point.x);
+		vector[2 * i + 1] = ssi_cast (float, point.y);
+		norm += point.x * point.x + point.y * point.y;
+	}
+
+	float scale = norm > 0.0 ? ssi_cast (float, 1.0 / sqrt(norm)) : 0.0f;
+	for (ssi_size_t i = 0; i < n; i++)
+	{
+		float x = vector[2 * i] * scale;
+		float y = vector[2 * i + 1] * scale;
+		vector[2 * i]            = x;
+		vector[2 * i + 1]        = y;
+		perpendicular[2 * i]     = -y;
+		perpendicular[2 * i + 1] = x;
 	}
-	return newPoints;
 }
 
 void GeometricRecognizer::save (FILE *file) {
@@ -481,13 +621,14 @@ void GeometricRecognizer::save (FILE *file) {
 }
 void GeometricRecognizer::load (FILE *file) {
 
-	templates.clear ();
+	clear ();
 
 	ssi_size_t size = 0;
 	fread (&size, sizeof (size), 1, file);
 	for (ssi_size_t i = 0; i < size; i++) {
 		GestureTemplate gesture;
 		gesture.load (file);
+		addVector (gesture.gesture_id, gesture.points);
 		templates.push_back (gesture);
 	}
 }
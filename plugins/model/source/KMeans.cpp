@@ -36,9 +36,26 @@
 #include "model/ModelTools.h"
 #include "ioput/file/File.h"
 #include "ISOverSample.h"
+#include "thread/WorkerPool.h"
+#include "thread/Lock.h"
+#include "signal/TypeCast.h"
 #include <sstream>
 #include <time.h>
 #include <vector>
+#include <limits>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+	#define SSI_KMEANS_X86
+	#include <emmintrin.h>
+	#if defined(_MSC_VER)
+		#define SSI_KMEANS_TARGET(x)
+	#else
+		#define SSI_KMEANS_TARGET(x) __attribute__((target(x)))
+	#endif
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__) || defined(__aarch64__)
+	#define SSI_KMEANS_NEON
+	#include <arm_neon.h>
+#endif
 
 #ifdef USE_SSI_LEAK_DETECTOR
 	#include "SSI_LeakWatcher.h"
@@ -62,6 +79,7 @@ KMeans::KMeans (const ssi_char_t *file)
 	_norm (false),
 	_norm_as (0),
 	_norm_bs (0),
+	_cost (0),
 	_file (0) {	
 
 	if (file) {
@@ -150,16 +168,18 @@ bool KMeans::train (ISamples &samples, ssi_size_t stream_index) {
 	int k = ssi_cast (int, _n_clusters);
 	int d = ssi_cast (int, _n_features);
 	int attempts = ssi_cast (int, _options.iter);
-	if(_options.random_seed){
-		srand ( ssi_size_t(time(NULL)) );
-	}else{
-		srand ( _options.seed );
-	}
-	if (_options.pp) {
-		cost = RunKMeansPlusPlus (n, k, d, matrix[0], attempts, _clusters[0], _assignments);
+	unsigned int seed = _options.random_seed ? ssi_cast (unsigned int, time (NULL)) : ssi_cast (unsigned int, _options.seed);
+	if (_options.method == LLOYD || _options.method == MINIBATCH) {
+		cost = RunKMeansParallel (n, k, d, matrix[0], attempts, _options.pp, _options.method, ssi_cast (int, _options.batch), ssi_cast (int, _options.steps), seed, _clusters[0], _assignments);
 	} else {
-		cost = RunKMeans (n, k, d, matrix[0], attempts, _clusters[0], _assignments);
+		srand (seed);
+		if (_options.pp) {
+			cost = RunKMeansPlusPlus (n, k, d, matrix[0], attempts, _clusters[0], _assignments);
+		} else {
+			cost = RunKMeans (n, k, d, matrix[0], attempts, _clusters[0], _assignments);
+		}
 	}
+	_cost = cost;
 
 	// DEBUG
 /*
@@ -364,6 +384,7 @@ void KMeans::release () {
 	_n_samples = 0;
 	_n_clusters = 0;
 	_n_features = 0;	
+	_cost = 0;
 }
 
 
@@ -530,4 +551,705 @@ Scalar KMeans::RunKMeansPlusPlus(int n, int k, int d, Scalar *points, int attemp
   return min_cost;
 }
 
+//SSI: added LLOYD and MINIBATCH, see KMeans.h
+
+// points per task
+static const int KMEANS_BLOCK_SIZE = 1024;
+
+struct kmeans_kernels_t {
+	// squared euclidean distance
+	Scalar (*dist2) (int d, const Scalar *a, const Scalar *b);
+};
+
+static Scalar dist2_scalar (int d, const Scalar *a, const Scalar *b) {
+
+	Scalar sum = 0;
+	for (int i = 0; i < d; i++) {
+		Scalar diff = a[i] - b[i];
+		sum += diff * diff;
+	}
+
+	return sum;
+}
+
+#ifdef SSI_KMEANS_X86
+
+SSI_KMEANS_TARGET("sse2")
+static Scalar dist2_sse2 (int d, const Scalar *a, const Scalar *b) {
+
+	__m128 acc = _mm_setzero_ps ();
+
+	int i = 0;
+	for (; i + 4 <= d; i += 4) {
+		__m128 diff = _mm_sub_ps (_mm_loadu_ps (a + i), _mm_loadu_ps (b + i));
+		acc = _mm_add_ps (acc, _mm_mul_ps (diff, diff));
+	}
+
+	float sum[4];
+	_mm_storeu_ps (sum, acc);
+
+	return dist2_scalar (d - i, a + i, b + i) + (sum[0] + sum[1]) + (sum[2] + sum[3]);
+}
+
+#endif
+
+#ifdef SSI_KMEANS_NEON
+
+static Scalar dist2_neon (int d, const Scalar *a, const Scalar *b) {
+
+	float32x4_t acc = vdupq_n_f32 (0);
+
+	int i = 0;
+	for (; i + 4 <= d; i += 4) {
+		float32x4_t diff = vsubq_f32 (vld1q_f32 (a + i), vld1q_f32 (b + i));
+		acc = vmlaq_f32 (acc, diff, diff);
+	}
+
+	float32x2_t sum = vadd_f32 (vget_low_f32 (acc), vget_high_f32 (acc));
+
+	return dist2_scalar (d - i, a + i, b + i) + vget_lane_f32 (vpadd_f32 (sum, sum), 0);
+}
+
+#endif
+
+static const kmeans_kernels_t *KMeans_Resolve () {
+
+#if defined(SSI_KMEANS_X86)
+	if (TypeCast::GetCpuFeatures () & TypeCast::SSE2) {
+		static const kmeans_kernels_t kernels = { dist2_sse2 };
+		return &kernels;
+	}
+#elif defined(SSI_KMEANS_NEON)
+	if (TypeCast::GetCpuFeatures () & TypeCast::NEON) {
+		static const kmeans_kernels_t kernels = { dist2_neon };
+		return &kernels;
+	}
+#endif
+
+	static const kmeans_kernels_t kernels = { dist2_scalar };
+	return &kernels;
+}
+
+// 64 bit linear congruential generator, the upper half is used
+static unsigned int KMeans_Random (unsigned long long &state) {
+	state = state * 6364136223846793005ULL + 1442695040888963407ULL;
+	return ssi_cast (unsigned int, state >> 32);
+}
+
+// random number in [0, n)
+static int KMeans_RandomInt (unsigned long long &state, int n) {
+	return ssi_cast (int, (ssi_cast (unsigned long long, KMeans_Random (state)) * n) >> 32);
+}
+
+// random number in [0, 1)
+static double KMeans_RandomReal (unsigned long long &state) {
+	return KMeans_Random (state) / 4294967296.0;
+}
+
+// state of a single attempt
+struct kmeans_run_t {
+
+	int n, k, d;
+	const Scalar *points;
+	bool pp;
+	KMeans::METHOD method;
+	int batch;
+	int steps;
+	const kmeans_kernels_t *kernels;
+	WorkerPool *pool;
+	bool parallel;
+
+	unsigned long long state;
+	Scalar *centers;
+	int *assignments;
+	Scalar cost;
+
+	// k-means++ seeding
+	const int *seed_indices;
+	int seed_center;
+	Scalar *seed_dists;
+	double *seed_sums;
+
+	// LLOYD, bounds as described in Hamerly, 'Making k-means even faster', 2010
+	Scalar *upper;
+	Scalar *lower;
+	Scalar *half;
+	Scalar *shift;
+	Scalar max_shift;
+	Scalar second_shift;
+	int max_shift_index;
+
+	// points looked up in NearestTask
+	const int *nearest_indices;
+	int *nearest_assignments;
+
+	// one accumulator per thread
+	int n_slots;
+	double *slot_sums;
+	int *slot_counts;
+	int *slot_changed;
+	double *slot_cost;
+	int *free_slots;
+	int n_free_slots;
+	Mutex mutex;
+};
+
+static int KMeans_GetSlot (kmeans_run_t &run) {
+
+	// at most one task per thread is running, so a slot is always available
+	Lock lock (run.mutex);
+	return run.free_slots[--run.n_free_slots];
+}
+
+static void KMeans_PutSlot (kmeans_run_t &run, int slot) {
+
+	Lock lock (run.mutex);
+	run.free_slots[run.n_free_slots++] = slot;
+}
+
+static void KMeans_InitSlots (kmeans_run_t &run, bool sums) {
+
+	run.n_slots = run.parallel ? ssi_cast (int, run.pool->size ()) : 1;
+	run.slot_sums = 0;
+	run.slot_counts = 0;
+	if (sums) {
+		run.slot_sums = new double[run.n_slots * run.k * run.d];
+		run.slot_counts = new int[run.n_slots * run.k];
+		memset (run.slot_sums, 0, sizeof (double) * run.n_slots * run.k * run.d);
+		memset (run.slot_counts, 0, sizeof (int) * run.n_slots * run.k);
+	}
+	run.slot_changed = new int[run.n_slots];
+	run.slot_cost = new double[run.n_slots];
+	run.free_slots = new int[run.n_slots];
+	for (int i = 0; i < run.n_slots; i++) {
+		run.slot_changed[i] = 0;
+		run.slot_cost[i] = 0;
+		run.free_slots[i] = i;
+	}
+	run.n_free_slots = run.n_slots;
+}
+
+static void KMeans_ReleaseSlots (kmeans_run_t &run) {
+
+	delete[] run.slot_sums; run.slot_sums = 0;
+	delete[] run.slot_counts; run.slot_counts = 0;
+	delete[] run.slot_changed; run.slot_changed = 0;
+	delete[] run.slot_cost; run.slot_cost = 0;
+	delete[] run.free_slots; run.free_slots = 0;
+}
+
+static double KMeans_SumCost (kmeans_run_t &run) {
+
+	double cost = 0;
+	for (int i = 0; i < run.n_slots; i++) {
+		cost += run.slot_cost[i];
+		run.slot_cost[i] = 0;
+	}
+
+	return cost;
+}
+
+// calls task for each block of n points
+static void KMeans_ForEachBlock (kmeans_run_t &run, int n, WorkerPool::task_t task) {
+
+	ssi_size_t n_blocks = ssi_cast (ssi_size_t, (n + KMEANS_BLOCK_SIZE - 1) / KMEANS_BLOCK_SIZE);
+	if (run.parallel && n_blocks > 1) {
+		run.pool->run (n_blocks, task, &run);
+	} else {
+		for (ssi_size_t i = 0; i < n_blocks; i++) {
+			task (i, &run);
+		}
+	}
+}
+
+// finds the closest and the second closest center (squared distances)
+static void KMeans_Nearest (const kmeans_run_t &run, const Scalar *x, int &best, Scalar &best_dist, Scalar &second_dist) {
+
+	best = 0;
+	best_dist = second_dist = FLT_MAX;
+	const Scalar *center = run.centers;
+	for (int j = 0; j < run.k; j++, center += run.d) {
+		Scalar dist = run.kernels->dist2 (run.d, x, center);
+		if (dist < best_dist) {
+			second_dist = best_dist;
+			best_dist = dist;
+			best = j;
+		} else if (dist < second_dist) {
+			second_dist = dist;
+		}
+	}
+}
+
+static void KMeans_SeedTask (ssi_size_t index, void *arg) {
+
+	kmeans_run_t &run = *ssi_pcast (kmeans_run_t, arg);
+
+	int from = ssi_cast (int, index) * KMEANS_BLOCK_SIZE;
+	int to = from + KMEANS_BLOCK_SIZE < run.n ? from + KMEANS_BLOCK_SIZE : run.n;
+	const Scalar *center = run.centers + run.seed_center * run.d;
+
+	double sum = 0;
+	for (int i = from; i < to; i++) {
+		int point = run.seed_indices ? run.seed_indices[i] : i;
+		Scalar dist = run.kernels->dist2 (run.d, run.points + point * run.d, center);
+		if (run.seed_center == 0 || dist < run.seed_dists[i]) {
+			run.seed_dists[i] = dist;
+		}
+		sum += run.seed_dists[i];
+	}
+	run.seed_sums[index] = sum;
+}
+
+// picks k distinct points, or uses k-means++ seeding if pp is set
+static void KMeans_Seed (kmeans_run_t &run, const int *indices, int n) {
+
+	int k = run.k;
+	int d = run.d;
+
+	if (!run.pp) {
+		int *unused = new int[n];
+		for (int i = 0; i < n; i++) {
+			unused[i] = i;
+		}
+		for (int i = 0; i < k; i++) {
+			int j = i + KMeans_RandomInt (run.state, n - i);
+			int point = indices ? indices[unused[j]] : unused[j];
+			memcpy (run.centers + i * d, run.points + point * d, sizeof (Scalar) * d);
+			unused[j] = unused[i];
+		}
+		delete[] unused;
+		return;
+	}
+
+	// kmeans_run_t::n is the number of candidates while seeding
+	int n_points = run.n;
+	run.n = n;
+	run.seed_indices = indices;
+	run.seed_dists = new Scalar[n];
+	int n_blocks = (n + KMEANS_BLOCK_SIZE - 1) / KMEANS_BLOCK_SIZE;
+	run.seed_sums = new double[n_blocks];
+
+	int point = KMeans_RandomInt (run.state, n);
+	memcpy (run.centers, run.points + (indices ? indices[point] : point) * d, sizeof (Scalar) * d);
+
+	for (int c = 1; c < k; c++) {
+
+		run.seed_center = c - 1;
+		KMeans_ForEachBlock (run, n, KMeans_SeedTask);
+
+		// choose next center with probability proportional to its squared distance
+		double total = 0;
+		for (int b = 0; b < n_blocks; b++) {
+			total += run.seed_sums[b];
+		}
+		point = -1;
+		if (total > 0) {
+			double r = KMeans_RandomReal (run.state) * total;
+			int b = 0;
+			while (b < n_blocks - 1 && r >= run.seed_sums[b]) {
+				r -= run.seed_sums[b++];
+			}
+			int to = (b + 1) * KMEANS_BLOCK_SIZE < n ? (b + 1) * KMEANS_BLOCK_SIZE : n;
+			for (int i = b * KMEANS_BLOCK_SIZE; i < to; i++) {
+				if (run.seed_dists[i] > 0) {
+					point = i;
+					if (r < run.seed_dists[i]) {
+						break;
+					}
+					r -= run.seed_dists[i];
+				}
+			}
+		}
+		if (point < 0) {
+			point = KMeans_RandomInt (run.state, n);
+		}
+		memcpy (run.centers + c * d, run.points + (indices ? indices[point] : point) * d, sizeof (Scalar) * d);
+	}
+
+	delete[] run.seed_dists; run.seed_dists = 0;
+	delete[] run.seed_sums; run.seed_sums = 0;
+	run.seed_indices = 0;
+	run.n = n_points;
+}
+
+static void KMeans_HalfTask (ssi_size_t index, void *arg) {
+
+	kmeans_run_t &run = *ssi_pcast (kmeans_run_t, arg);
+
+	int j = ssi_cast (int, index);
+	const Scalar *center = run.centers + j * run.d;
+	Scalar min_dist = FLT_MAX;
+	for (int i = 0; i < run.k; i++) {
+		if (i != j) {
+			Scalar dist = run.kernels->dist2 (run.d, center, run.centers + i * run.d);
+			if (dist < min_dist) {
+				min_dist = dist;
+			}
+		}
+	}
+	run.half[j] = 0.5f * sqrt (min_dist);
+}
+
+static void KMeans_BoundsTask (ssi_size_t index, void *arg) {
+
+	kmeans_run_t &run = *ssi_pcast (kmeans_run_t, arg);
+
+	int k = run.k;
+	int d = run.d;
+	int from = ssi_cast (int, index) * KMEANS_BLOCK_SIZE;
+	int to = from + KMEANS_BLOCK_SIZE < run.n ? from + KMEANS_BLOCK_SIZE : run.n;
+
+	int slot = KMeans_GetSlot (run);
+	double *sums = run.slot_sums + slot * k * d;
+	int *counts = run.slot_counts + slot * k;
+	int changed = 0;
+
+	for (int i = from; i < to; i++) {
+
+		const Scalar *x = run.points + i * d;
+		int a = run.assignments[i];
+
+		// skip point if bounds prove that its center is still the closest
+		if (a >= 0) {
+			run.upper[i] += run.shift[a];
+			run.lower[i] -= a == run.max_shift_index ? run.second_shift : run.max_shift;
+			Scalar bound = run.half[a] > run.lower[i] ? run.half[a] : run.lower[i];
+			if (run.upper[i] <= bound) {
+				continue;
+			}
+			run.upper[i] = sqrt (run.kernels->dist2 (d, x, run.centers + a * d));
+			if (run.upper[i] <= bound) {
+				continue;
+			}
+		}
+
+		int best;
+		Scalar best_dist, second_dist;
+		KMeans_Nearest (run, x, best, best_dist, second_dist);
+		run.upper[i] = sqrt (best_dist);
+		run.lower[i] = sqrt (second_dist);
+
+		if (best != a) {
+			if (a >= 0) {
+				counts[a]--;
+				double *sum = sums + a * d;
+				for (int j = 0; j < d; j++) {
+					sum[j] -= x[j];
+				}
+			}
+			counts[best]++;
+			double *sum = sums + best * d;
+			for (int j = 0; j < d; j++) {
+				sum[j] += x[j];
+			}
+			run.assignments[i] = best;
+			changed++;
+		}
+	}
+
+	run.slot_changed[slot] += changed;
+	KMeans_PutSlot (run, slot);
+}
+
+static void KMeans_CostTask (ssi_size_t index, void *arg) {
+
+	kmeans_run_t &run = *ssi_pcast (kmeans_run_t, arg);
+
+	int from = ssi_cast (int, index) * KMEANS_BLOCK_SIZE;
+	int to = from + KMEANS_BLOCK_SIZE < run.n ? from + KMEANS_BLOCK_SIZE : run.n;
+
+	double cost = 0;
+	for (int i = from; i < to; i++) {
+		cost += run.kernels->dist2 (run.d, run.points + i * run.d, run.centers + run.assignments[i] * run.d);
+	}
+
+	int slot = KMeans_GetSlot (run);
+	run.slot_cost[slot] += cost;
+	KMeans_PutSlot (run, slot);
+}
+
+static void KMeans_NearestTask (ssi_size_t index, void *arg) {
+
+	kmeans_run_t &run = *ssi_pcast (kmeans_run_t, arg);
+
+	int n = run.nearest_indices ? run.batch : run.n;
+	int from = ssi_cast (int, index) * KMEANS_BLOCK_SIZE;
+	int to = from + KMEANS_BLOCK_SIZE < n ? from + KMEANS_BLOCK_SIZE : n;
+
+	double cost = 0;
+	for (int i = from; i < to; i++) {
+		int point = run.nearest_indices ? run.nearest_indices[i] : i;
+		Scalar best_dist, second_dist;
+		KMeans_Nearest (run, run.points + point * run.d, run.nearest_assignments[i], best_dist, second_dist);
+		cost += best_dist;
+	}
+
+	int slot = KMeans_GetSlot (run);
+	run.slot_cost[slot] += cost;
+	KMeans_PutSlot (run, slot);
+}
+
+static void KMeans_Lloyd (kmeans_run_t &run) {
+
+	int n = run.n;
+	int k = run.k;
+	int d = run.d;
+
+	KMeans_Seed (run, 0, n);
+
+	run.upper = new Scalar[n];
+	run.lower = new Scalar[n];
+	run.half = new Scalar[k];
+	run.shift = new Scalar[k];
+	for (int i = 0; i < n; i++) {
+		run.assignments[i] = -1;
+	}
+	for (int j = 0; j < k; j++) {
+		run.shift[j] = 0;
+	}
+	run.max_shift = run.second_shift = 0;
+	run.max_shift_index = -1;
+
+	double *sums = new double[k * d];
+	int *counts = new int[k];
+	memset (sums, 0, sizeof (double) * k * d);
+	memset (counts, 0, sizeof (int) * k);
+	KMeans_InitSlots (run, true);
+
+	for (int step = 0; step < run.steps; step++) {
+
+		if (run.parallel && k > 1) {
+			run.pool->run (k, KMeans_HalfTask, &run);
+		} else {
+			for (int j = 0; j < k; j++) {
+				KMeans_HalfTask (j, &run);
+			}
+		}
+
+		KMeans_ForEachBlock (run, n, KMeans_BoundsTask);
+
+		// merge changes of all threads
+		int changed = 0;
+		for (int s = 0; s < run.n_slots; s++) {
+			changed += run.slot_changed[s];
+			run.slot_changed[s] = 0;
+			double *slot_sums = run.slot_sums + s * k * d;
+			int *slot_counts = run.slot_counts + s * k;
+			for (int i = 0; i < k * d; i++) {
+				sums[i] += slot_sums[i];
+				slot_sums[i] = 0;
+			}
+			for (int j = 0; j < k; j++) {
+				counts[j] += slot_counts[j];
+				slot_counts[j] = 0;
+			}
+		}
+		if (changed == 0) {
+			break;
+		}
+
+		// move centers, empty clusters keep their position
+		run.max_shift = run.second_shift = 0;
+		run.max_shift_index = -1;
+		for (int j = 0; j < k; j++) {
+			run.shift[j] = 0;
+			if (counts[j] > 0) {
+				Scalar *center = run.centers + j * d;
+				const double *sum = sums + j * d;
+				Scalar dist = 0;
+				for (int i = 0; i < d; i++) {
+					Scalar value = ssi_cast (Scalar, sum[i] / counts[j]);
+					dist += (value - center[i]) * (value - center[i]);
+					center[i] = value;
+				}
+				run.shift[j] = sqrt (dist);
+			}
+			if (run.shift[j] > run.max_shift) {
+				run.second_shift = run.max_shift;
+				run.max_shift = run.shift[j];
+				run.max_shift_index = j;
+			} else if (run.shift[j] > run.second_shift) {
+				run.second_shift = run.shift[j];
+			}
+		}
+	}
+
+	KMeans_ForEachBlock (run, n, KMeans_CostTask);
+	run.cost = ssi_cast (Scalar, KMeans_SumCost (run));
+
+	KMeans_ReleaseSlots (run);
+	delete[] sums;
+	delete[] counts;
+	delete[] run.upper; run.upper = 0;
+	delete[] run.lower; run.lower = 0;
+	delete[] run.half; run.half = 0;
+	delete[] run.shift; run.shift = 0;
+}
+
+// see Sculley, 'Web-scale k-means clustering', 2010
+static void KMeans_MiniBatch (kmeans_run_t &run) {
+
+	int n = run.n;
+	int k = run.k;
+	int d = run.d;
+
+	// seed on a random subset that is large compared to a batch
+	int n_seed = 3 * run.batch > k ? 3 * run.batch : k;
+	if (n_seed < n) {
+		int *indices = new int[n];
+		for (int i = 0; i < n; i++) {
+			indices[i] = i;
+		}
+		for (int i = 0; i < n_seed; i++) {
+			int j = i + KMeans_RandomInt (run.state, n - i);
+			int tmp = indices[i];
+			indices[i] = indices[j];
+			indices[j] = tmp;
+		}
+		KMeans_Seed (run, indices, n_seed);
+		delete[] indices;
+	} else {
+		KMeans_Seed (run, 0, n);
+	}
+
+	KMeans_InitSlots (run, false);
+
+	int *counts = new int[k];
+	memset (counts, 0, sizeof (int) * k);
+	int *indices = new int[run.batch];
+	int *assignments = new int[run.batch];
+	run.nearest_indices = indices;
+	run.nearest_assignments = assignments;
+
+	for (int step = 0; step < run.steps; step++) {
+
+		for (int i = 0; i < run.batch; i++) {
+			indices[i] = KMeans_RandomInt (run.state, n);
+		}
+		KMeans_ForEachBlock (run, run.batch, KMeans_NearestTask);
+
+		// gradient step with a learning rate of 1 / #points seen by the center
+		for (int i = 0; i < run.batch; i++) {
+			int j = assignments[i];
+			Scalar eta = 1.0f / ++counts[j];
+			Scalar *center = run.centers + j * d;
+			const Scalar *x = run.points + indices[i] * d;
+			for (int l = 0; l < d; l++) {
+				center[l] += eta * (x[l] - center[l]);
+			}
+		}
+	}
+	KMeans_SumCost (run);
+
+	delete[] counts;
+	delete[] indices;
+	delete[] assignments;
+
+	// final assignment of all points
+	run.nearest_indices = 0;
+	run.nearest_assignments = run.assignments;
+	KMeans_ForEachBlock (run, n, KMeans_NearestTask);
+	run.cost = ssi_cast (Scalar, KMeans_SumCost (run));
+	run.nearest_assignments = 0;
+
+	KMeans_ReleaseSlots (run);
+}
+
+static void KMeans_Attempt (kmeans_run_t &run) {
+
+	if (run.method == KMeans::MINIBATCH) {
+		KMeans_MiniBatch (run);
+	} else {
+		KMeans_Lloyd (run);
+	}
+}
+
+static void KMeans_AttemptTask (ssi_size_t index, void *arg) {
+
+	kmeans_run_t *runs = ssi_pcast (kmeans_run_t, arg);
+	KMeans_Attempt (runs[index]);
+}
+
+// See KMeans.h
+Scalar KMeans::RunKMeansParallel(int n, int k, int d, Scalar *points, int attempts, bool pp,
+	METHOD method, int batch, int steps, unsigned int seed,
+	Scalar *ret_clusters, int *ret_assignment) {
+
+	KM_ASSERT(k >= 1);
+
+	// Handle k > n
+	if (k > n) {
+		for (int i = n * d; i < k * d; i++) {
+			ret_clusters[i] = std::numeric_limits<Scalar>::quiet_NaN ();
+		}
+		k = n;
+	}
+	if (attempts < 1) {
+		attempts = 1;
+	}
+
+	LOG(false, "Running " << (method == MINIBATCH ? "mini-batch " : "") << "k-means on " << n << " points..." << std::endl);
+	double start_time = GetSeconds();
+
+	WorkerPool *pool = WorkerPool::GetShared ();
+	const kmeans_kernels_t *kernels = KMeans_Resolve ();
+
+	kmeans_run_t *runs = new kmeans_run_t[attempts];
+	for (int a = 0; a < attempts; a++) {
+		kmeans_run_t &run = runs[a];
+		run.n = n;
+		run.k = k;
+		run.d = d;
+		run.points = points;
+		run.pp = pp;
+		run.method = method;
+		run.batch = batch > 0 ? batch : 1;
+		run.steps = steps > 0 ? steps : 1;
+		run.kernels = kernels;
+		run.pool = pool;
+		run.parallel = attempts == 1;
+		run.state = (ssi_cast (unsigned long long, seed) << 32) | ssi_cast (unsigned int, a);
+		KMeans_Random (run.state);
+		run.centers = new Scalar[k * d];
+		run.assignments = new int[n];
+		run.cost = 0;
+		run.seed_indices = 0;
+		run.seed_dists = 0;
+		run.seed_sums = 0;
+		run.nearest_indices = 0;
+		run.nearest_assignments = 0;
+	}
+
+	// either run attempts in parallel, or split each attempt into blocks of points
+	if (attempts > 1) {
+		pool->run (attempts, KMeans_AttemptTask, runs);
+	} else {
+		KMeans_Attempt (runs[0]);
+	}
+
+	int best = 0;
+	for (int a = 1; a < attempts; a++) {
+		if (runs[a].cost < runs[best].cost) {
+			best = a;
+		}
+	}
+	if (ret_clusters) {
+		memcpy (ret_clusters, runs[best].centers, sizeof (Scalar) * k * d);
+	}
+	if (ret_assignment) {
+		memcpy (ret_assignment, runs[best].assignments, sizeof (int) * n);
+	}
+	Scalar min_cost = runs[best].cost;
+
+	LOG(false, "Completed " << attempts << " runs: cost=" << min_cost << " (" << (GetSeconds() - start_time) << " seconds)" << std::endl);
+
+	for (int a = 0; a < attempts; a++) {
+		delete[] runs[a].centers;
+		delete[] runs[a].assignments;
+	}
+	delete[] runs;
+
+	return min_cost;
+}
+
 }
@@ -125,25 +125,81 @@ bool KNearestNeighbors::forward (ssi_stream_t &stream,
 	ssi_size_t k = _options.k;
 	ssi_size_t *indices = new ssi_size_t[k];
 	ssi_real_t *distances = new ssi_real_t[k];
+	ssi_size_t *counter = new ssi_size_t[_n_classes];
+	ssi_real_t *avgdist = new ssi_real_t[_n_classes];
 	ssi_real_t *sample = ssi_pcast (ssi_real_t, stream.ptr);
 
+	forward_h (sample, n_probs, probs, indices, distances, counter, avgdist);
+
+	delete[] counter;
+	delete[] avgdist;
+	delete[] indices;
+	delete[] distances;
+
+	return true;
+}
+
+bool KNearestNeighbors::forward_batch (ssi_size_t n_samples,
+	ssi_size_t n_features,
+	ssi_real_t *features,
+	ssi_size_t n_probs,
+	ssi_real_t *probs) {
+
+	if (!_data) {
+		ssi_wrn ("not trained");
+		return false;
+	}
+
+	if (n_probs != _n_classes) {
+		ssi_wrn ("#classes differs");
+		return false;
+	}
+
+	if (n_features != _n_features) {
+		ssi_wrn ("feature dimension differs");
+		return false;
+	}
+
+	// scratch buffers are shared by all samples
+
+	ssi_size_t k = _options.k;
+	ssi_size_t *indices = new ssi_size_t[k];
+	ssi_real_t *distances = new ssi_real_t[k];
+	ssi_size_t *counter = new ssi_size_t[_n_classes];
+	ssi_real_t *avgdist = new ssi_real_t[_n_classes];
+
+	for (ssi_size_t n = 0; n < n_samples; n++) {
+		forward_h (features + n * n_features, n_probs, probs + n * n_probs, indices, distances, counter, avgdist);
+	}
+
+	delete[] counter;
+	delete[] avgdist;
+	delete[] indices;
+	delete[] distances;
+
+	return true;
+}
+
+void KNearestNeighbors::forward_h (ssi_real_t *sample,
+	ssi_size_t n_probs,
+	ssi_real_t *probs,
+	ssi_size_t *indices,
+	ssi_real_t *distances,
+	ssi_size_t *counter,
+	ssi_real_t *avgdist) {
+
+	ssi_size_t k = _options.k;
+
 	// find k nearest neighbors
 
 	FindNN::Find (_n_samples, _n_features, sample, _data, k, indices, distances);
-	
-	// map indices to classes
-	ssi_size_t *nearest = new ssi_size_t[k];
-	for (ssi_size_t i = 0; i < k; i++) {
-		nearest[i] = _classes[indices[i]];
-	}
 
 	// count nn
-	ssi_size_t *counter = new ssi_size_t[_n_classes];
 	for (ssi_size_t i = 0; i < n_probs; i++) {		
 		counter[i] = 0;
 	}
 	for (ssi_size_t i = 0; i < k; i++) {
-		counter[nearest[i]]++;
+		counter[_classes[indices[i]]]++;
 	}
 
 	if (_options.distsum) {
@@ -161,13 +217,13 @@ bool KNearestNeighbors::forward (ssi_stream_t &stream,
 
 		if (!all_in_one) {
 
-			ssi_real_t *avgdist = new ssi_real_t[_n_classes];
 			ssi_real_t distsum = 0;
 			for (ssi_size_t i = 0; i < _n_classes; i++) {		
 				avgdist[i] = 0;
 			}
-			for (ssi_size_t i = 0; i < k; i++) {			
-				avgdist[nearest[i]] += distances[i] / counter[nearest[i]];			
+			for (ssi_size_t i = 0; i < k; i++) {
+				ssi_size_t nearest = _classes[indices[i]];
+				avgdist[nearest] += distances[i] / counter[nearest];			
 			}
 			for (ssi_size_t i = 0; i < _n_classes; i++) {			
 				distsum += avgdist[i];
@@ -184,8 +240,6 @@ bool KNearestNeighbors::forward (ssi_stream_t &stream,
 			for (ssi_size_t i = 0; i < _n_classes; i++) {
 				probs[i] /= probsum;
 			}
-
-			delete[] avgdist;
 		}
 
 	} else {
@@ -194,13 +248,6 @@ bool KNearestNeighbors::forward (ssi_stream_t &stream,
 			probs[i] = ssi_cast (ssi_real_t, counter[i]) / ssi_cast (ssi_real_t, k);
 		}
 	}
-
-	delete[] nearest;
-	delete[] counter;
-	delete[] indices;
-	delete[] distances;
-
-	return true;
 }
 
 bool KNearestNeighbors::load (const ssi_char_t *filepath) {
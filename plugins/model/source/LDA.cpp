@@ -245,6 +245,89 @@ bool LDA::forward (ssi_stream_t &stream,
 	return true;
 }
 
+bool LDA::forward_batch (ssi_size_t n_samples,
+	ssi_size_t n_features,
+	ssi_real_t *features,
+	ssi_size_t n_probs,
+	ssi_real_t *probs) {
+
+	if (!isTrained ()) {
+		ssi_wrn ("not trained");
+		return false;
+	}
+
+	if (n_probs != _n_classes) {
+		ssi_wrn ("#classes differs");
+		return false;
+	}
+
+	if (n_features != _n_features) {
+		ssi_wrn ("feature dimension differs");
+		return false;
+	}
+
+	ae_int_t dim = _covinv->cols;
+
+	// unfold upper triangle of inverse covariance into a contiguous symmetric matrix once
+
+	double *covinv = new double[dim * dim];
+	for (ae_int_t i = 0; i < dim; i++) {
+		for (ae_int_t j = 0; j < dim; j++) {
+			covinv[i * dim + j] = i > j ? _covinv->ptr.pp_double[j][i] : _covinv->ptr.pp_double[i][j];
+		}
+	}
+
+	double *sample = new double[dim];
+	double *diff = new double[dim];
+
+	for (ssi_size_t n = 0; n < n_samples; n++) {
+
+		ssi_real_t *ptr = features + n * n_features;
+		for (ae_int_t i = 0; i < dim; i++) {
+			sample[i] = ssi_cast (double, ptr[i]);
+		}
+		if (_options.scale) {
+			for (ae_int_t i = 0; i < dim; i++) {
+				sample[i] = (sample[i] - _min[i]) / (_max[i] - _min[i]);
+			}
+		}
+
+		ssi_real_t *dst = probs + n * n_probs;
+		for (ssi_size_t c = 0; c < n_probs; c++) {
+			double *mean = _meanc[c]->ptr.p_double;
+			for (ae_int_t i = 0; i < dim; i++) {
+				diff[i] = sample[i] - mean[i];
+			}
+			double result = 0;
+			for (ae_int_t i = 0; i < dim; i++) {
+				double *row = covinv + i * dim;
+				double sum = 0;
+				for (ae_int_t j = 0; j < dim; j++) {
+					sum += diff[j] * row[j];
+				}
+				result += diff[i] * sum;
+			}
+			dst[c] = - ssi_cast (ssi_real_t, result);
+		}
+
+		if (_options.norm) {
+			ssi_real_t sum = 0;
+			for (ssi_size_t j = 0; j < n_probs; j++) {
+				sum += dst[j];
+			}
+			for (ssi_size_t j = 0; j < n_probs; j++) {
+				dst[j] = 1.0f - (dst[j] / sum);
+			}
+		}
+	}
+
+	delete[] covinv;
+	delete[] sample;
+	delete[] diff;
+
+	return true;
+}
+
 bool LDA::load (const ssi_char_t *filepath) {
 
 	release ();
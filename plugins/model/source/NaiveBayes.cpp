@@ -257,6 +257,86 @@ bool NaiveBayes::forward (ssi_stream_t &stream,
 	return true;
 }
 
+bool NaiveBayes::forward_batch (ssi_size_t n_samples,
+	ssi_size_t n_features,
+	ssi_real_t *features,
+	ssi_size_t n_probs,
+	ssi_real_t *probs) {
+
+	if (!isTrained ()) {
+		ssi_wrn ("not trained");
+		return false;
+	}
+
+	if (n_probs != _n_classes) {
+		ssi_wrn ("#classes differs");
+		return false;
+	}
+
+	if (n_features != _n_features) {
+		ssi_wrn ("feature dimension differs");
+		return false;
+	}
+
+	if (!_options.log) {
+		return IModel::forward_batch (n_samples, n_features, features, n_probs, probs);
+	}
+
+	// precompute per class constant term and inverse variances once for all samples
+
+	bool prior = _options.prior;
+	ssi_real_t *bias = new ssi_real_t[_n_classes];
+	ssi_real_t *inv = new ssi_real_t[_n_classes * _n_features];
+	for (ssi_size_t nclass = 0; nclass < _n_classes; nclass++) {
+		bias[nclass] = prior ? SSI_NAIVEBAYES_LOG(_class_probs[nclass]) : 0;
+		ssi_real_t *invptr = inv + nclass * _n_features;
+		for (ssi_size_t nfeat = 0; nfeat < _n_features; nfeat++) {
+			ssi_real_t stddev = _std_dev[nclass][nfeat];
+			if (stddev == 0) {
+				invptr[nfeat] = 0;
+				continue;
+			}
+			ssi_real_t sqr = stddev * stddev;
+			bias[nclass] -= SSI_NAIVEBAYES_LOG(stddev);
+			invptr[nfeat] = 1.0f / (2 * (sqr != 0 ? sqr : FLT_MIN));
+		}
+	}
+
+	for (ssi_size_t n = 0; n < n_samples; n++) {
+
+		ssi_real_t *sample = features + n * _n_features;
+		ssi_real_t *dst = probs + n * n_probs;
+		ssi_real_t sum = 0;
+
+		for (ssi_size_t nclass = 0; nclass < _n_classes; nclass++) {
+			ssi_real_t *mean = _means[nclass];
+			ssi_real_t *invptr = inv + nclass * _n_features;
+			ssi_real_t prob = bias[nclass];
+			for (ssi_size_t nfeat = 0; nfeat < _n_features; nfeat++) {
+				ssi_real_t temp = sample[nfeat] - mean[nfeat];
+				prob -= temp * temp * invptr[nfeat];
+			}
+			dst[nclass] = exp (prob / _n_features);
+			sum += dst[nclass];
+		}
+
+		if (sum == 0) {
+			for (ssi_size_t j = 0; j < n_probs; j++) {
+				dst[j] = 1.0f / n_probs;
+			}
+		} else {
+			for (ssi_size_t j = 0; j < n_probs; j++) {
+				dst[j] /= sum;
+			}
+		}
+	}
+
+	delete[] bias;
+	delete[] inv;
+
+	return true;
+}
+
 bool NaiveBayes::load (const ssi_char_t *filepath) {
 
 	release ();
@@ -25,6 +25,7 @@
 //*************************************************************************************************
 
 #include "Relief.h"
+#include "thread/WorkerPool.h"
 
 #include "ssistdMinMaxWrapper.h"
 
@@ -74,28 +75,20 @@ bool Relief::train (ISamples &samples,
 		weights[i] = 0;
 	}
 
+	// search nearest hit and miss of every sample in parallel
+	nearest_job_t job;
+	job.me = this;
+	job.dists = 0;
+	job.hits = hits;
+	job.hits_val = hits_val;
+	job.miss = miss;
+	job.miss_val = miss_val;
+
+	WorkerPool *pool = WorkerPool::GetShared ();
+
 	if (_options.mem) {
 
-		for (ssi_size_t i = 0; i < _n_samples; i++) {		
-			hits_val[i] = FLT_MAX;		
-			miss_val[i] = FLT_MAX;
-			for (ssi_size_t j = 0; j < _n_samples; j++) {
-				if (i == j) {
-					continue;
-				}
-				ssi_real_t d = dist (_features[i], _features[j], _n_features);
-				if (_classes[i] == _classes[j]) {
-					if (d < hits_val[i]) {
-						hits_val[i] = d;
-						hits[i] = j;
-					}
-				} else if (d < miss_val[i]) {
-					miss_val[i] = d;
-					miss[i] = j;
-				}			
-			}		
-			//ssi_print ("progress=%.2f%%\n", (100.0f * i) / _n_samples);
-		}
+		pool->run (_n_samples, NearestTask, &job);
 
 	} else {
 
@@ -104,28 +97,9 @@ bool Relief::train (ISamples &samples,
 			dists[i] = new ssi_real_t[_n_samples]; 
 		}
 
-		for (ssi_size_t i = 0; i < _n_samples; i++) {
-			dists[i][i] = FLT_MAX;
-			for (ssi_size_t j = i+1; j < _n_samples; j++) {			
-				dists[i][j] = dists[j][i] = dist (_features[i], _features[j], _n_features);			
-			}
-		}
-
-		for (ssi_size_t i = 0; i < _n_samples; i++) {		
-			hits_val[i] = FLT_MAX;		
-			miss_val[i] = FLT_MAX;
-			for (ssi_size_t j = 0; j < _n_samples; j++) {
-				if (_classes[i] == _classes[j]) {
-					if (dists[i][j] < hits_val[i]) {
-						hits_val[i] = dists[i][j];
-						hits[i] = j;
-					}
-				} else if (dists[i][j] < miss_val[i]) {
-					miss_val[i] = dists[i][j];
-					miss[i] = j;
-				}			
-			}		
-		}
+		job.dists = dists;
+		pool->run (_n_samples, DistTask, &job);
+		pool->run (_n_samples, NearestTask, &job);
 
 		for (ssi_size_t i = 0; i < _n_samples; i++) {
 			delete[] dists[i]; 
@@ -236,6 +210,45 @@ void Relief::matrix (ISamples &samples, ssi_size_t stream_index) {
 	}
 }
 
+void Relief::DistTask (ssi_size_t index, void *arg) {
+
+	nearest_job_t &job = *ssi_pcast (nearest_job_t, arg);
+	Relief *me = job.me;
+	ssi_real_t **dists = job.dists;
+
+	// row i fills the upper part and mirrors it, so no entry is written twice
+	ssi_size_t i = index;
+	dists[i][i] = FLT_MAX;
+	for (ssi_size_t j = i+1; j < me->_n_samples; j++) {
+		dists[i][j] = dists[j][i] = me->dist (me->_features[i], me->_features[j], me->_n_features);
+	}
+}
+
+void Relief::NearestTask (ssi_size_t index, void *arg) {
+
+	nearest_job_t &job = *ssi_pcast (nearest_job_t, arg);
+	Relief *me = job.me;
+
+	ssi_size_t i = index;
+	job.hits_val[i] = FLT_MAX;
+	job.miss_val[i] = FLT_MAX;
+	for (ssi_size_t j = 0; j < me->_n_samples; j++) {
+		if (i == j) {
+			continue;
+		}
+		ssi_real_t d = job.dists ? job.dists[i][j] : me->dist (me->_features[i], me->_features[j], me->_n_features);
+		if (me->_classes[i] == me->_classes[j]) {
+			if (d < job.hits_val[i]) {
+				job.hits_val[i] = d;
+				job.hits[i] = j;
+			}
+		} else if (d < job.miss_val[i]) {
+			job.miss_val[i] = d;
+			job.miss[i] = j;
+		}
+	}
+}
+
 SSI_INLINE ssi_real_t Relief::dist (ssi_real_t *x1, ssi_real_t *x2, ssi_size_t n_dim) {
 
 	ssi_real_t retVal = 0.0f;
@@ -50,7 +50,9 @@ SVM::SVM (const ssi_char_t *file)
 	_min (0),
 	_class_names (0),
 	_problem (0),
-	_n_samples (0) {
+	_n_samples (0),
+	_x_dense (0),
+	_prob_estimates (0) {
 
 	if (file) {
 		if (!OptionList::LoadXML (file, _options)) {
@@ -87,6 +89,8 @@ void SVM::release () {
 	}
 	delete[] _max; _max = 0;
 	delete[] _min; _min = 0;
+	delete[] _x_dense; _x_dense = 0;
+	delete[] _prob_estimates; _prob_estimates = 0;
 
 	//svm_destroy_param (&_options.params);
 
@@ -117,6 +121,49 @@ void SVM::free_class_names () {
 	}	
 }
 
+void SVM::init_dense () {
+
+	delete[] _x_dense; _x_dense = 0;
+	delete[] _prob_estimates; _prob_estimates = 0;
+
+	if (_options.params.dense && svm_densify_model (_model, ssi_cast (int, _n_features))) {
+		_x_dense = new float[_n_features];
+		_prob_estimates = new double[_model->nr_class];
+		ssi_msg (SSI_LOG_LEVEL_DETAIL, "dense support vectors (%d x %u)", _model->l, _n_features);
+	}
+}
+
+void SVM::scale_dense (const ssi_real_t *in, float *out) {
+
+	// same as scale_instance(), but zeros are kept
+	for (ssi_size_t j = 0; j < _n_features; j++) {
+		double temp = in[j];
+		if (_max[j] - _min[j]) {
+			temp = SSI_SVM_SCALE_LOWER + (SSI_SVM_SCALE_UPPER - SSI_SVM_SCALE_LOWER)*(temp - _min[j]) / (_max[j] - _min[j]);
+		} else {
+			temp = SSI_SVM_SCALE_LOWER + (SSI_SVM_SCALE_UPPER - SSI_SVM_SCALE_LOWER)*(temp - _min[j]) / FLT_MIN;
+		}
+		out[j] = ssi_cast (float, temp);
+	}
+}
+
+void SVM::copy_probs (const double *prob_estimates, ssi_real_t *probs) {
+
+	// model may know less classes than the sample list it was trained on
+	for (ssi_size_t j = 0; j < _n_classes; j++) {
+		probs[j] = 0;
+	}
+
+	ssi_real_t sum = 0;
+	for (int i = 0; i < _model->nr_class; i++) {
+		probs[_model->label[i]] = ssi_cast (ssi_real_t, prob_estimates[i]);
+		sum += probs[_model->label[i]];
+	}
+	for (ssi_size_t j = 0; j < _n_classes; j++) {
+		probs[j] /= sum;
+	}
+}
+
 bool SVM::train (ISamples &samples,
 	ssi_size_t stream_index) {
 
@@ -213,6 +260,7 @@ bool SVM::train (ISamples &samples,
 	}
 
 	_model = svm_train (_problem, &_options.params);
+	init_dense ();
 
 	switch (_options.balance) {
 	case BALANCE::OVER: {
@@ -252,6 +300,13 @@ bool SVM::forward (ssi_stream_t &stream,
 		return false;
 	}
 
+	if (_model->dense_SV) {
+		scale_dense (ssi_pcast (ssi_real_t, stream.ptr), _x_dense);
+		svm_predict_probability_dense (_model, _x_dense, _prob_estimates);
+		copy_probs (_prob_estimates, probs);
+		return true;
+	}
+
 	svm_node *x = new svm_node[_n_features+1];
 	float *ptr = ssi_pcast (float, stream.ptr);
     for (ssi_size_t i = 0; i < _n_features; i++) {
@@ -265,15 +320,78 @@ bool SVM::forward (ssi_stream_t &stream,
 
 	double *prob_estimates = new double[_n_classes];
 	svm_predict_probability (_model, x, prob_estimates);
+	copy_probs (prob_estimates, probs);
 
-	ssi_real_t sum = 0;
-	for (ssi_size_t i = 0; i < _n_classes; i++) {
-		probs[_model->label[i]] = ssi_cast (ssi_real_t, prob_estimates[i]);
-		sum += probs[_model->label[i]];
+	delete[] x;
+	delete[] prob_estimates;
+
+	return true;
+}
+
+bool SVM::forward_batch (ssi_size_t n_samples,
+	ssi_size_t n_features,
+	ssi_real_t *features,
+	ssi_size_t n_probs,
+	ssi_real_t *probs) {
+
+	if (!isTrained ()) {
+		ssi_wrn ("not trained");
+		return false;
 	}
 
-	for (ssi_size_t j = 0; j < _n_classes; j++) {
-		probs[j]/=sum;
+	if (n_probs != _n_classes) {
+		ssi_wrn ("#classes differs");
+		return false;
+	}
+
+	if (n_features != _n_features) {
+		ssi_wrn ("feature dimension differs");
+		return false;
+	}
+
+	// dense samples are scaled into one matrix and predicted in blocks
+
+	if (_model->dense_SV) {
+		float *x = new float[n_samples * _n_features];
+		double *prob_estimates = new double[n_samples * _model->nr_class];
+		for (ssi_size_t n = 0; n < n_samples; n++) {
+			scale_dense (features + n * _n_features, x + n * _n_features);
+		}
+		svm_predict_probability_dense_batch (_model, ssi_cast (int, n_samples), x, prob_estimates);
+		for (ssi_size_t n = 0; n < n_samples; n++) {
+			copy_probs (prob_estimates + n * _model->nr_class, probs + n * n_probs);
+		}
+		delete[] x;
+		delete[] prob_estimates;
+		return true;
+	}
+
+	// node and probability buffers are shared by all samples,
+	// scaling is applied directly while filling the nodes
+
+	svm_node *x = new svm_node[_n_features+1];
+	double *prob_estimates = new double[_n_classes];
+
+	for (ssi_size_t n = 0; n < n_samples; n++) {
+
+		ssi_real_t *ptr = features + n * _n_features;
+		ssi_size_t n_idx = 0;
+		for (ssi_size_t j = 0; j < _n_features; j++) {
+			double temp = *ptr++;
+			if (_max[j] - _min[j]) {
+				temp = SSI_SVM_SCALE_LOWER + (SSI_SVM_SCALE_UPPER - SSI_SVM_SCALE_LOWER)*(temp - _min[j]) / (_max[j] - _min[j]);
+			} else {
+				temp = SSI_SVM_SCALE_LOWER + (SSI_SVM_SCALE_UPPER - SSI_SVM_SCALE_LOWER)*(temp - _min[j]) / FLT_MIN;
+			}
+			if (temp) {
+				x[n_idx].index = j + 1;
+				x[n_idx++].value = temp;
+			}
+		}
+		x[n_idx].index = -1;
+
+		svm_predict_probability (_model, x, prob_estimates);
+		copy_probs (prob_estimates, probs + n * n_probs);
 	}
 
 	delete[] x;
@@ -340,6 +458,9 @@ bool SVM::load (const ssi_char_t *filepath) {
 
 	if (_model = svm_load_model_h(fp)) {
 		_n_classes = _model->nr_class;
+		_model->param.multicore = _options.params.multicore;
+		_model->param.dense = _options.params.dense;
+		init_dense ();
 		fclose(fp);
 		return true;
 	}
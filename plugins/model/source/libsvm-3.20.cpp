@@ -8,6 +8,13 @@
 #include <limits.h>
 #include <locale.h>
 #include "libsvm-3.20.h"
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define LIBSVM_DENSE_SSE2
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__) || defined(__aarch64__)
+#define LIBSVM_DENSE_NEON
+#include <arm_neon.h>
+#endif
 int libsvm_version = LIBSVM_VERSION;
 bool _use_openmp = false;
 typedef float Qfloat;
@@ -39,6 +46,108 @@ static inline double powi(double base, int times)
 #define TAU 1e-12
 #define Malloc(type,n) (type *)malloc((n)*sizeof(type))
 
+//
+// Dense vectors (SSI: added)
+//
+static double dense_dot(int n, const float *x, const float *y)
+{
+	int i = 0;
+	float sum = 0;
+#if defined(LIBSVM_DENSE_SSE2)
+	__m128 acc0 = _mm_setzero_ps(), acc1 = _mm_setzero_ps();
+	for(; i+8<=n; i+=8)
+	{
+		acc0 = _mm_add_ps(acc0, _mm_mul_ps(_mm_loadu_ps(x+i), _mm_loadu_ps(y+i)));
+		acc1 = _mm_add_ps(acc1, _mm_mul_ps(_mm_loadu_ps(x+i+4), _mm_loadu_ps(y+i+4)));
+	}
+	float part[4];
+	_mm_storeu_ps(part, _mm_add_ps(acc0, acc1));
+	sum = (part[0] + part[1]) + (part[2] + part[3]);
+#elif defined(LIBSVM_DENSE_NEON)
+	float32x4_t acc0 = vdupq_n_f32(0), acc1 = vdupq_n_f32(0);
+	for(; i+8<=n; i+=8)
+	{
+		acc0 = vmlaq_f32(acc0, vld1q_f32(x+i), vld1q_f32(y+i));
+		acc1 = vmlaq_f32(acc1, vld1q_f32(x+i+4), vld1q_f32(y+i+4));
+	}
+	float32x4_t acc = vaddq_f32(acc0, acc1);
+	float32x2_t part = vadd_f32(vget_low_f32(acc), vget_high_f32(acc));
+	sum = vget_lane_f32(vpadd_f32(part, part), 0);
+#endif
+	for(; i<n; i++)
+		sum += x[i] * y[i];
+	return sum;
+}
+
+static double dense_dist2(int n, const float *x, const float *y)
+{
+	int i = 0;
+	float sum = 0;
+#if defined(LIBSVM_DENSE_SSE2)
+	__m128 acc0 = _mm_setzero_ps(), acc1 = _mm_setzero_ps();
+	for(; i+8<=n; i+=8)
+	{
+		__m128 d0 = _mm_sub_ps(_mm_loadu_ps(x+i), _mm_loadu_ps(y+i));
+		__m128 d1 = _mm_sub_ps(_mm_loadu_ps(x+i+4), _mm_loadu_ps(y+i+4));
+		acc0 = _mm_add_ps(acc0, _mm_mul_ps(d0, d0));
+		acc1 = _mm_add_ps(acc1, _mm_mul_ps(d1, d1));
+	}
+	float part[4];
+	_mm_storeu_ps(part, _mm_add_ps(acc0, acc1));
+	sum = (part[0] + part[1]) + (part[2] + part[3]);
+#elif defined(LIBSVM_DENSE_NEON)
+	float32x4_t acc0 = vdupq_n_f32(0), acc1 = vdupq_n_f32(0);
+	for(; i+8<=n; i+=8)
+	{
+		float32x4_t d0 = vsubq_f32(vld1q_f32(x+i), vld1q_f32(y+i));
+		float32x4_t d1 = vsubq_f32(vld1q_f32(x+i+4), vld1q_f32(y+i+4));
+		acc0 = vmlaq_f32(acc0, d0, d0);
+		acc1 = vmlaq_f32(acc1, d1, d1);
+	}
+	float32x4_t acc = vaddq_f32(acc0, acc1);
+	float32x2_t part = vadd_f32(vget_low_f32(acc), vget_high_f32(acc));
+	sum = vget_lane_f32(vpadd_f32(part, part), 0);
+#endif
+	for(; i<n; i++)
+	{
+		float d = x[i] - y[i];
+		sum += d * d;
+	}
+	return sum;
+}
+
+static double dense_k_function(const float *x, const float *y, int n, const svm_parameter& param)
+{
+	switch(param.kernel_type)
+	{
+		case LINEAR:
+			return dense_dot(n,x,y);
+		case POLY:
+			return powi(param.gamma*dense_dot(n,x,y)+param.coef0,param.degree);
+		case RBF:
+			return exp(-param.gamma*dense_dist2(n,x,y));
+		case SIGMOID:
+			return tanh(param.gamma*dense_dot(n,x,y)+param.coef0);
+		default:
+			return 0;  // precomputed kernels are never densified
+	}
+}
+
+// copies sparse vectors into a zero-initialized l x dim matrix, indices > dim are skipped
+static float *dense_from_nodes(int l, const svm_node * const *x, int dim)
+{
+	float *data = Malloc(float,(size_t)l*dim);
+	memset(data,0,sizeof(float)*(size_t)l*dim);
+	for(int i=0;i<l;i++)
+	{
+		float *row = data + (size_t)i*dim;
+		for(const svm_node *p=x[i];p->index!=-1;p++)
+			if(p->index >= 1 && p->index <= dim)
+				row[p->index-1] = (float)p->value;
+	}
+	return data;
+}
+
 static void print_string_stdout(const char *s)
 {
 #ifdef DEBUG
@@ -215,6 +324,7 @@ public:
 	{
 		swap(x[i],x[j]);
 		if(x_square) swap(x_square[i],x_square[j]);
+		if(x_dense) swap(x_dense[i],x_dense[j]);
 	}
 protected:
 
@@ -224,6 +334,11 @@ private:
 	const svm_node **x;
 	double *x_square;
 
+	// dense copy of x (rows point into x_dense_data)
+	const float **x_dense;
+	float *x_dense_data;
+	int dim;
+
 	// svm_parameter
 	const int kernel_type;
 	const int degree;
@@ -251,6 +366,22 @@ private:
 	{
 		return x[i][(int)(x[j][0].value)].value;
 	}
+	double kernel_linear_dense(int i, int j) const
+	{
+		return dense_dot(dim,x_dense[i],x_dense[j]);
+	}
+	double kernel_poly_dense(int i, int j) const
+	{
+		return powi(gamma*dense_dot(dim,x_dense[i],x_dense[j])+coef0,degree);
+	}
+	double kernel_rbf_dense(int i, int j) const
+	{
+		return exp(-gamma*dense_dist2(dim,x_dense[i],x_dense[j]));
+	}
+	double kernel_sigmoid_dense(int i, int j) const
+	{
+		return tanh(gamma*dense_dot(dim,x_dense[i],x_dense[j])+coef0);
+	}
 };
 
 Kernel::Kernel(int l, svm_node * const * x_, const svm_parameter& param)
@@ -278,20 +409,52 @@ Kernel::Kernel(int l, svm_node * const * x_, const svm_parameter& param)
 
 	clone(x,x_,l);
 
-	if(kernel_type == RBF)
+	x_square = 0;
+	x_dense = 0;
+	x_dense_data = 0;
+	dim = 0;
+
+	if(param.dense && kernel_type != PRECOMPUTED)
+	{
+		for(int i=0;i<l;i++)
+			for(const svm_node *p=x[i];p->index!=-1;p++)
+				if(p->index > dim)
+					dim = p->index;
+		x_dense_data = dense_from_nodes(l,x,dim);
+		x_dense = new const float *[l];
+		for(int i=0;i<l;i++)
+			x_dense[i] = x_dense_data + (size_t)i*dim;
+
+		switch(kernel_type)
+		{
+			case LINEAR:
+				kernel_function = &Kernel::kernel_linear_dense;
+				break;
+			case POLY:
+				kernel_function = &Kernel::kernel_poly_dense;
+				break;
+			case RBF:
+				kernel_function = &Kernel::kernel_rbf_dense;
+				break;
+			case SIGMOID:
+				kernel_function = &Kernel::kernel_sigmoid_dense;
+				break;
+		}
+	}
+	else if(kernel_type == RBF)
 	{
 		x_square = new double[l];
 		for(int i=0;i<l;i++)
 			x_square[i] = dot(x[i],x[i]);
 	}
-	else
-		x_square = 0;
 }
 
 Kernel::~Kernel()
 {
 	delete[] x;
 	delete[] x_square;
+	delete[] x_dense;
+	free(x_dense_data);
 }
 
 double Kernel::dot(const svm_node *px, const svm_node *py)
@@ -1345,8 +1508,15 @@ public:
 		int start, j;
 		if((start = cache->get_data(i,&data,len)) < len)
 		{
-			for(j=start;j<len;j++)
-				data[j] = (Qfloat)(this->*kernel_function)(i,j);
+			if (_use_openmp) {
+				#pragma omp parallel for private(j)
+				for (j = start; j<len; j++)
+					data[j] = (Qfloat)(this->*kernel_function)(i, j);
+			}
+			else {
+				for (j = start; j<len; j++)
+					data[j] = (Qfloat)(this->*kernel_function)(i, j);
+			}
 		}
 		return data;
 	}
@@ -1411,8 +1581,15 @@ public:
 		int j, real_i = index[i];
 		if(cache->get_data(real_i,&data,l) < l)
 		{
-			for(j=0;j<l;j++)
-				data[j] = (Qfloat)(this->*kernel_function)(real_i,j);
+			if (_use_openmp) {
+				#pragma omp parallel for private(j)
+				for (j = 0; j<l; j++)
+					data[j] = (Qfloat)(this->*kernel_function)(real_i, j);
+			}
+			else {
+				for (j = 0; j<l; j++)
+					data[j] = (Qfloat)(this->*kernel_function)(real_i, j);
+			}
 		}
 
 		// reorder and copy
@@ -2108,6 +2285,8 @@ svm_model *svm_train(const svm_problem *prob, const svm_parameter *param)
 	svm_model *model = Malloc(svm_model,1);
 	model->param = *param;
 	model->free_sv = 0;	// XXX
+	model->dense_dim = 0;
+	model->dense_SV = NULL;
 
 	_use_openmp = model->param.multicore;
 
@@ -2514,6 +2693,58 @@ double svm_get_svr_probability(const svm_model *model)
 	}
 }
 
+// pairwise decision values from the kernel values of all SVs, returns the label with most votes
+static double predict_values_from_kvalue(const svm_model *model, const double *kvalue, double* dec_values)
+{
+	int i;
+	int nr_class = model->nr_class;
+
+	int *start = Malloc(int,nr_class);
+	start[0] = 0;
+	for(i=1;i<nr_class;i++)
+		start[i] = start[i-1]+model->nSV[i-1];
+
+	int *vote = Malloc(int,nr_class);
+	for(i=0;i<nr_class;i++)
+		vote[i] = 0;
+
+	int p=0;
+	for(i=0;i<nr_class;i++)
+		for(int j=i+1;j<nr_class;j++)
+		{
+			double sum = 0;
+			int si = start[i];
+			int sj = start[j];
+			int ci = model->nSV[i];
+			int cj = model->nSV[j];
+			
+			int k;
+			double *coef1 = model->sv_coef[j-1];
+			double *coef2 = model->sv_coef[i];
+			for(k=0;k<ci;k++)
+				sum += coef1[si+k] * kvalue[si+k];
+			for(k=0;k<cj;k++)
+				sum += coef2[sj+k] * kvalue[sj+k];
+			sum -= model->rho[p];
+			dec_values[p] = sum;
+
+			if(dec_values[p] > 0)
+				++vote[i];
+			else
+				++vote[j];
+			p++;
+		}
+
+	int vote_max_idx = 0;
+	for(i=1;i<nr_class;i++)
+		if(vote[i] > vote[vote_max_idx])
+			vote_max_idx = i;
+
+	free(start);
+	free(vote);
+	return model->label[vote_max_idx];
+}
+
 double svm_predict_values(const svm_model *model, const svm_node *x, double* dec_values)
 {
 	//int i;
@@ -2562,51 +2793,9 @@ double svm_predict_values(const svm_model *model, const svm_node *x, double* dec
 				kvalue[i] = Kernel::k_function(x, model->SV[i], model->param);
 		}
 
-		int *start = Malloc(int,nr_class);
-		start[0] = 0;
-		for(i=1;i<nr_class;i++)
-			start[i] = start[i-1]+model->nSV[i-1];
-
-		int *vote = Malloc(int,nr_class);
-		for(i=0;i<nr_class;i++)
-			vote[i] = 0;
-
-		int p=0;
-		for(i=0;i<nr_class;i++)
-			for(int j=i+1;j<nr_class;j++)
-			{
-				double sum = 0;
-				int si = start[i];
-				int sj = start[j];
-				int ci = model->nSV[i];
-				int cj = model->nSV[j];
-				
-				int k;
-				double *coef1 = model->sv_coef[j-1];
-				double *coef2 = model->sv_coef[i];
-				for(k=0;k<ci;k++)
-					sum += coef1[si+k] * kvalue[si+k];
-				for(k=0;k<cj;k++)
-					sum += coef2[sj+k] * kvalue[sj+k];
-				sum -= model->rho[p];
-				dec_values[p] = sum;
-
-				if(dec_values[p] > 0)
-					++vote[i];
-				else
-					++vote[j];
-				p++;
-			}
-
-		int vote_max_idx = 0;
-		for(i=1;i<nr_class;i++)
-			if(vote[i] > vote[vote_max_idx])
-				vote_max_idx = i;
-
+		double pred_result = predict_values_from_kvalue(model, kvalue, dec_values);
 		free(kvalue);
-		free(start);
-		free(vote);
-		return model->label[vote_max_idx];
+		return pred_result;
 	}
 }
 
@@ -2625,45 +2814,178 @@ double svm_predict(const svm_model *model, const svm_node *x)
 	return pred_result;
 }
 
+// class probabilities from pairwise decision values, returns the most probable label
+static double predict_probability_from_dec_values(const svm_model *model, const double *dec_values, double *prob_estimates)
+{
+	int i;
+	int nr_class = model->nr_class;
+
+	double min_prob=1e-7;
+	double **pairwise_prob=Malloc(double *,nr_class);
+	for(i=0;i<nr_class;i++)
+		pairwise_prob[i]=Malloc(double,nr_class);
+	int k=0;
+	for(i=0;i<nr_class;i++)
+		for(int j=i+1;j<nr_class;j++)
+		{
+			pairwise_prob[i][j]=min(max(sigmoid_predict(dec_values[k],model->probA[k],model->probB[k]),min_prob),1-min_prob);
+			pairwise_prob[j][i]=1-pairwise_prob[i][j];
+			k++;
+		}
+	multiclass_probability(nr_class,pairwise_prob,prob_estimates);
+
+	int prob_max_idx = 0;
+	for(i=1;i<nr_class;i++)
+		if(prob_estimates[i] > prob_estimates[prob_max_idx])
+			prob_max_idx = i;
+	for(i=0;i<nr_class;i++)
+		free(pairwise_prob[i]);
+	free(pairwise_prob);
+	return model->label[prob_max_idx];
+}
+
 double svm_predict_probability(
 	const svm_model *model, const svm_node *x, double *prob_estimates)
 {
 	if ((model->param.svm_type == C_SVC || model->param.svm_type == NU_SVC) &&
 	    model->probA!=NULL && model->probB!=NULL)
 	{
-		int i;
 		int nr_class = model->nr_class;
 		double *dec_values = Malloc(double, nr_class*(nr_class-1)/2);
 		svm_predict_values(model, x, dec_values);
-
-		double min_prob=1e-7;
-		double **pairwise_prob=Malloc(double *,nr_class);
-		for(i=0;i<nr_class;i++)
-			pairwise_prob[i]=Malloc(double,nr_class);
-		int k=0;
-		for(i=0;i<nr_class;i++)
-			for(int j=i+1;j<nr_class;j++)
-			{
-				pairwise_prob[i][j]=min(max(sigmoid_predict(dec_values[k],model->probA[k],model->probB[k]),min_prob),1-min_prob);
-				pairwise_prob[j][i]=1-pairwise_prob[i][j];
-				k++;
-			}
-		multiclass_probability(nr_class,pairwise_prob,prob_estimates);
-
-		int prob_max_idx = 0;
-		for(i=1;i<nr_class;i++)
-			if(prob_estimates[i] > prob_estimates[prob_max_idx])
-				prob_max_idx = i;
-		for(i=0;i<nr_class;i++)
-			free(pairwise_prob[i]);
+		double pred_result = predict_probability_from_dec_values(model, dec_values, prob_estimates);
 		free(dec_values);
-		free(pairwise_prob);
-		return model->label[prob_max_idx];
+		return pred_result;
 	}
 	else 
 		return svm_predict(model, x);
 }
 
+//
+// Dense prediction (SSI: added)
+//
+// svm_densify_model() copies the SVs of a model to a contiguous l x dim
+// float matrix, the *_dense functions then take samples as float arrays of
+// length dim and evaluate kernels with SIMD instructions if available.
+//
+int svm_densify_model(svm_model *model, int dim)
+{
+	free(model->dense_SV);
+	model->dense_SV = NULL;
+	model->dense_dim = 0;
+
+	if(model->param.kernel_type == PRECOMPUTED || dim <= 0)
+		return 0;
+
+	model->dense_SV = dense_from_nodes(model->l, model->SV, dim);
+	model->dense_dim = dim;
+
+	return 1;
+}
+
+static void dense_kvalue(const svm_model *model, const float *x, double *kvalue)
+{
+	int l = model->l;
+	int dim = model->dense_dim;
+	for(int i=0;i<l;i++)
+		kvalue[i] = dense_k_function(x, model->dense_SV + (size_t)i*dim, dim, model->param);
+}
+
+static double predict_values_dense_kvalue(const svm_model *model, const double *kvalue, double* dec_values)
+{
+	if(model->param.svm_type == ONE_CLASS ||
+	   model->param.svm_type == EPSILON_SVR ||
+	   model->param.svm_type == NU_SVR)
+	{
+		double *sv_coef = model->sv_coef[0];
+		double sum = 0;
+		for(int i=0;i<model->l;i++)
+			sum += sv_coef[i] * kvalue[i];
+		sum -= model->rho[0];
+		*dec_values = sum;
+
+		if(model->param.svm_type == ONE_CLASS)
+			return (sum>0)?1:-1;
+		else
+			return sum;
+	}
+	else
+		return predict_values_from_kvalue(model, kvalue, dec_values);
+}
+
+static double predict_probability_dense_kvalue(const svm_model *model, const double *kvalue, double *dec_values, double *prob_estimates)
+{
+	double pred_result = predict_values_dense_kvalue(model, kvalue, dec_values);
+	if ((model->param.svm_type == C_SVC || model->param.svm_type == NU_SVC) &&
+	    model->probA!=NULL && model->probB!=NULL)
+		pred_result = predict_probability_from_dec_values(model, dec_values, prob_estimates);
+	return pred_result;
+}
+
+static int dec_values_size(const svm_model *model)
+{
+	if(model->param.svm_type == ONE_CLASS ||
+	   model->param.svm_type == EPSILON_SVR ||
+	   model->param.svm_type == NU_SVR)
+		return 1;
+	return model->nr_class*(model->nr_class-1)/2;
+}
+
+double svm_predict_values_dense(const svm_model *model, const float *x, double* dec_values)
+{
+	double *kvalue = Malloc(double,model->l);
+	dense_kvalue(model, x, kvalue);
+	double pred_result = predict_values_dense_kvalue(model, kvalue, dec_values);
+	free(kvalue);
+	return pred_result;
+}
+
+double svm_predict_probability_dense(const svm_model *model, const float *x, double *prob_estimates)
+{
+	double *kvalue = Malloc(double,model->l);
+	double *dec_values = Malloc(double,dec_values_size(model));
+	dense_kvalue(model, x, kvalue);
+	double pred_result = predict_probability_dense_kvalue(model, kvalue, dec_values, prob_estimates);
+	free(dec_values);
+	free(kvalue);
+	return pred_result;
+}
+
+// samples are processed in blocks, so each SV is loaded once per block
+#define DENSE_BATCH_BLOCK 8
+
+void svm_predict_probability_dense_batch(const svm_model *model, int n, const float *x, double *prob_estimates)
+{
+	int l = model->l;
+	int dim = model->dense_dim;
+	int nr_class = model->nr_class;
+	int n_blocks = (n + DENSE_BATCH_BLOCK - 1) / DENSE_BATCH_BLOCK;
+
+	int b;
+	#pragma omp parallel for private(b) if(model->param.multicore)
+	for(b=0;b<n_blocks;b++)
+	{
+		int first = b * DENSE_BATCH_BLOCK;
+		int count = min(DENSE_BATCH_BLOCK, n - first);
+
+		double *kvalue = Malloc(double,(size_t)count*l);
+		double *dec_values = Malloc(double,dec_values_size(model));
+
+		for(int i=0;i<l;i++)
+		{
+			const float *sv = model->dense_SV + (size_t)i*dim;
+			for(int k=0;k<count;k++)
+				kvalue[(size_t)k*l+i] = dense_k_function(x + (size_t)(first+k)*dim, sv, dim, model->param);
+		}
+
+		for(int k=0;k<count;k++)
+			predict_probability_dense_kvalue(model, kvalue + (size_t)k*l, dec_values, prob_estimates + (size_t)(first+k)*nr_class);
+
+		free(dec_values);
+		free(kvalue);
+	}
+}
+
 static const char *svm_type_table[] =
 {
 	"c_svc","nu_svc","one_class","epsilon_svr","nu_svr",NULL
@@ -2941,6 +3263,8 @@ svm_model *svm_load_model_h(FILE *fp)
 	model->sv_indices = NULL;
 	model->label = NULL;
 	model->nSV = NULL;
+	model->dense_dim = 0;
+	model->dense_SV = NULL;
 	
 	// read header
 	if (!read_model_header(fp, model))
@@ -3059,6 +3383,10 @@ void svm_free_model_content(svm_model* model_ptr)
 
 	free(model_ptr->nSV);
 	model_ptr->nSV = NULL;
+
+	free(model_ptr->dense_SV);
+	model_ptr->dense_SV = NULL;
+	model_ptr->dense_dim = 0;
 }
 
 void svm_free_and_destroy_model(svm_model** model_ptr_ptr)
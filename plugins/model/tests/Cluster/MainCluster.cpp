@@ -39,9 +39,11 @@ unsigned short COLORS[][3] = {
 };
 
 void ex_kmeans ();
+void ex_benchmark ();
 
 void PlotSamples (ISamples &samples, const ssi_char_t *name);
 void CreateMissingData (SampleList &samples, double prob);
+void CreateClusterSamples (SampleList &samples, ssi_size_t n_clusters, ssi_size_t n_samples_per_cluster, ssi_size_t dim);
 
 #ifdef USE_SSI_LEAK_DETECTOR
 	#include "SSI_LeakWatcher.h"
@@ -69,6 +71,7 @@ int main () {
 	Factory::GetPainter ()->MoveConsole(0,600,600,400);
 
 	ex_kmeans ();
+	ex_benchmark ();
 
 	ssi_print ("\n\n\tpress enter to quit\n\n");
 	getchar ();
@@ -122,6 +125,31 @@ void ex_kmeans () {
 	}
 }
 
+void ex_benchmark () {
+
+	SampleList samples;
+	ssi_size_t n_clusters = 32;
+	CreateClusterSamples (samples, n_clusters, 5000, 16);
+
+	KMeans::METHOD methods[] = { KMeans::KDTREE, KMeans::LLOYD, KMeans::MINIBATCH };
+	const ssi_char_t *names[] = { "KDTREE", "LLOYD", "MINIBATCH" };
+
+	for (ssi_size_t i = 0; i < sizeof (methods) / sizeof (KMeans::METHOD); i++) {
+
+		KMeans *model = ssi_create (KMeans, 0, true);
+		model->getOptions ()->k = n_clusters;
+		model->getOptions ()->iter = 4;
+		model->getOptions ()->random_seed = false;
+		model->getOptions ()->method = methods[i];
+
+		ssi_tic ();
+		model->train (samples, 0);
+		ssi_print ("%s: ", names[i]);
+		ssi_toc_print ();
+		ssi_print (" cost=%.2f\n", model->getCost ());
+	}
+}
+
 void CreateMissingData (SampleList &samples, double prob) {
 
 	ssi_size_t n_streams = samples.getStreamSize ();
@@ -137,6 +165,38 @@ void CreateMissingData (SampleList &samples, double prob) {
 	samples.setMissingData (true);
 }
 
+void CreateClusterSamples (SampleList &samples, ssi_size_t n_clusters, ssi_size_t n_samples_per_cluster, ssi_size_t dim) {
+
+	ssi_size_t user_id = samples.addUserName ("user");
+	ssi_size_t class_id = samples.addClassName ("A");
+
+	ssi_real_t *centers = new ssi_real_t[n_clusters * dim];
+	for (ssi_size_t i = 0; i < n_clusters * dim; i++) {
+		centers[i] = ssi_cast (ssi_real_t, ssi_random (10.0));
+	}
+
+	for (ssi_size_t n_cluster = 0; n_cluster < n_clusters; n_cluster++) {
+		for (ssi_size_t n_sample = 0; n_sample < n_samples_per_cluster; n_sample++) {
+			ssi_sample_t *sample = new ssi_sample_t;
+			sample->class_id = class_id;
+			sample->user_id = user_id;
+			sample->num = 1;
+			sample->score = 0.0f;
+			sample->time = 0;
+			sample->streams = new ssi_stream_t *[1];
+			sample->streams[0] = new ssi_stream_t;
+			ssi_stream_init (*sample->streams[0], 1, dim, sizeof (ssi_real_t), SSI_REAL, 10.0);
+			ssi_real_t *data = ssi_pcast (ssi_real_t, sample->streams[0]->ptr);
+			for (ssi_size_t d = 0; d < dim; d++) {
+				data[d] = ssi_cast (ssi_real_t, ssi_random_distr (centers[n_cluster * dim + d], 0.5));
+			}
+			samples.addSample (sample);
+		}
+	}
+
+	delete[] centers;
+}
+
 void PlotSamples(ISamples &samples, const ssi_char_t *name) {
 
 	ssi_size_t n_classes = samples.getClassSize();
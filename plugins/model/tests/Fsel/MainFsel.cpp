@@ -182,6 +182,7 @@ void ex_fsel () {
 		Trainer trainer (model);
 		FloatingSearch *fsearch = ssi_create (FloatingSearch, 0, true);
 		fsearch->getOptions()->nthread = 5;
+		fsearch->getOptions()->cache = true;
 		ssi_tic ();
 		trainer.setSelection (isalign, fsearch);
 		ssi_print ("\nsfs with multi-threading: ");
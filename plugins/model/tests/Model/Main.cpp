@@ -47,6 +47,7 @@ bool ex_eval(void *arg);
 bool ex_model(void *arg);
 bool ex_fusion(void *arg);
 bool ex_hierarchical(void *arg);
+bool ex_batch(void *arg);
 
 void CreateMissingData (SampleList &samples, double prob);
 
@@ -81,6 +82,7 @@ int main () {
 	exsemble.add(&ex_model, 0, "MODEL", "How to train a single model.");
 	exsemble.add(&ex_hierarchical, 0, "HIERARCHICAL", "How to train a hierarchical model.");
 	exsemble.add(&ex_fusion, 0, "FUSION", "How to train a fusion model.");	
+	exsemble.add(&ex_batch, 0, "BATCH", "How to score many samples at once.");
 	exsemble.show();
 
 	Factory::Clear ();
@@ -432,6 +434,79 @@ bool ex_fusion(void *arg) {
 	return true;
 }
 
+bool ex_batch(void *arg) {
+
+	ssi_size_t n_classes = 4;
+	ssi_size_t n_samples = 500;
+	ssi_size_t n_streams = 1;
+	ssi_real_t train_distr[][3] = { 0.25f, 0.25f, 0.1f, 0.25f, 0.75f, 0.1f, 0.75f, 0.75f, 0.1f, 0.75f, 0.75f, 0.1f };
+	SampleList strain;
+	SampleList sdevel;
+	ModelTools::CreateTestSamples (strain, n_classes, n_samples, n_streams, train_distr, "user");
+	ModelTools::CreateTestSamples (sdevel, n_classes, n_samples, n_streams, train_distr, "user");
+
+	// copy devel samples into a contiguous matrix
+	ssi_size_t n_rows = sdevel.getSize ();
+	ssi_size_t n_features = sdevel.getStream (0).dim;
+	ssi_real_t *features = new ssi_real_t[n_rows * n_features];
+	ssi_real_t *probs = new ssi_real_t[n_rows * n_classes];
+	ssi_real_t *probs_batch = new ssi_real_t[n_rows * n_classes];
+	ssi_sample_t *sample = 0;
+	ssi_real_t *ptr = features;
+	sdevel.reset ();
+	while (sample = sdevel.next ()) {
+		memcpy (ptr, sample->streams[0]->ptr, n_features * sizeof (ssi_real_t));
+		ptr += n_features;
+	}
+
+	IModel *models[] = {
+		ssi_create (SVM, 0, true),
+		ssi_create (KNearestNeighbors, 0, true),
+		ssi_create (NaiveBayes, 0, true),
+		ssi_create (LDA, 0, true),
+	};
+
+	for (ssi_size_t n_model = 0; n_model < sizeof (models) / sizeof (IModel *); n_model++) {
+
+		Trainer trainer (models[n_model]);
+		trainer.train (strain);
+
+		ssi_print ("%s\n", models[n_model]->getName ());
+
+		ssi_tic ();
+		sdevel.reset ();
+		ssi_real_t *dst = probs;
+		while (sample = sdevel.next ()) {
+			trainer.forward_probs (*sample->streams[0], n_classes, dst);
+			dst += n_classes;
+		}
+		ssi_print ("single: ");
+		ssi_toc_print ();
+		ssi_print ("\n");
+
+		ssi_tic ();
+		trainer.forward_batch (n_rows, n_features, features, n_classes, probs_batch);
+		ssi_print ("batch: ");
+		ssi_toc_print ();
+		ssi_print ("\n");
+
+		ssi_real_t max_diff = 0;
+		for (ssi_size_t i = 0; i < n_rows * n_classes; i++) {
+			ssi_real_t diff = ssi_cast (ssi_real_t, fabs (probs[i] - probs_batch[i]));
+			if (diff > max_diff) {
+				max_diff = diff;
+			}
+		}
+		ssi_print ("max difference: %g\n\n", max_diff);
+	}
+
+	delete[] features;
+	delete[] probs;
+	delete[] probs_batch;
+
+	return true;
+}
+
 void CreateMissingData (SampleList &samples, double prob) {
 
 	ssi_size_t n_streams = samples.getStreamSize ();
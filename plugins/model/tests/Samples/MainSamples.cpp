@@ -56,6 +56,7 @@ bool ex_dupl(void *args);
 bool ex_arff(void *args);
 bool ex_trigger(void *args);
 bool ex_elan(void *args);
+bool ex_anno(void *args);
 
 void PlotSamples (ISamples &samples, const ssi_char_t *name);
 void CreateMissingData (SampleList &samples, double prob);
@@ -101,6 +102,7 @@ int main () {
 	exsemble.add(&ex_norm, 0, "NORMALIZE SAMPLES", "");
 	exsemble.add(&ex_dupl, 0, "DUPLICATE SAMPLES", "");
 	exsemble.add(&ex_trigger, 0, "TRIGGER SAMPLES", "");
+	exsemble.add(&ex_anno, 0, "ANNOTATION", "");
 	exsemble.show();
 
 	ssi_print ("\n\n\tpress enter to quit\n\n");
@@ -1030,6 +1032,43 @@ bool ex_elan(void *args) {
 	return true;
 }
 
+bool ex_anno(void *args) {
+
+	// long recording with many short segments
+	Annotation anno;
+	const ssi_char_t *labels[] = { "speech", "laughter", "noise" };
+	ssi_time_t time = 0;
+	for (ssi_size_t i = 0; i < 100000; i++) {
+		time += ssi_random (2.0);
+		ssi_time_t dur = 0.1 + ssi_random (3.0);
+		anno.add (time, time + dur, labels[ssi_random (2u)]);
+		time += dur;
+	}
+	ssi_print ("%u entries until %.2lfs\n", anno.size (), anno.last ()->stop);
+
+	ssi_tic ();
+	Annotation anno_c;
+	ModelTools::ConvertToContinuousAnnotation (anno, anno_c, 0.075, 0.025, 0.5, "none");
+	ssi_print ("continuous: %u frames ", anno_c.size ());
+	ssi_toc_print ();
+	ssi_print ("\n");
+
+	ssi_tic ();
+	std::vector<Annotation::Entry *> entries;
+	ssi_size_t n_found = 0;
+	for (ssi_size_t i = 0; i < 10000; i++) {
+		ssi_time_t from = ssi_random (time);
+		entries.clear ();
+		n_found += anno.getEntries (from, from + 10.0, entries);
+		anno.getEntryAt (from);
+	}
+	ssi_print ("queries: %u entries found ", n_found);
+	ssi_toc_print ();
+	ssi_print ("\n");
+
+	return true;
+}
+
 void CreateMissingData (SampleList &samples, double prob) {
 
 	ssi_size_t n_streams = samples.getStreamSize ();
@@ -73,6 +73,8 @@ Provides Functionals analysis.
 #include "base/IFeature.h"
 #include "OSTools.h"
 #include "ioput/option/OptionList.h"
+#include "thread/WorkerPool.h"
+#include <vector>
 
 //#define PRINT_SAMPLE_NUMBER_DIMENSION
 
@@ -292,6 +294,7 @@ public:
 	public:	ssi_size_t enab_output[FUNCT_ENAB_N][MAX_FEATURES_N]; // 1/0 = enable/disable for an output or an integer (i.e. coeff,no of segments,....)
 			ssi_size_t enab_funct[FUNCT_ENAB_N]; // 1/0 = enable/disable for each functional
 			ssi_size_t nonZeroFunct;
+			bool parallel;
 			ssi_char_t enabled_dimensions[SSI_MAX_CHAR];
 			bool enabled_deltas;
 			const static ssi_size_t masterTimeNorm = TIMENORM_FRAMES;
@@ -361,6 +364,7 @@ public:
 			}
 
 			nonZeroFunct = 0;
+			parallel = false;
 			enabled_deltas = true;
 			enabled_dimensions[0] = '\0';
 			samplepos[0] = '\0';
@@ -395,6 +399,7 @@ public:
 
 			addOption ("nonZeroFuncts", &nonZeroFunct, 1, SSI_INT, "If this is set to 1, functionals are only applied to input values unequal 0. If this is set to 2, functionals are only applied to input values greater than 0.");
 			addOption ("enabledDimensions", enabled_dimensions, SSI_MAX_CHAR, SSI_CHAR, "array of enabled dimensions on which functionals will apply, if left empty all of them will be enabled");
+			addOption ("parallel", &parallel, 1, SSI_BOOL, "process dimensions in parallel on the shared worker pool (ignored if Peaks or Peaks2 are enabled)");
 			
 
 			// Options for functional Crossings
@@ -723,6 +728,15 @@ protected:
 	int counter;
 	bool* dim_in;
 
+	// dimensions are processed independently, Peaks and Peaks2 keep state in the options though
+	static void ProcessDimensionTask (ssi_size_t index, void *arg);
+	WorkerPool *_pool;
+	std::vector<int> _task_dims;
+	ssi_real_t *_task_src;
+	ssi_real_t *_task_dst;
+	int _task_dim;
+	int _task_num;
+
 };
 
 }
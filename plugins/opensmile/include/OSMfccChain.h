@@ -138,6 +138,7 @@ public:
 		}
 
 		ssi_size_t result = _fft->getSampleDimensionOut (sample_dimension_in);
+		result = _fftmag->getSampleDimensionOut (result);
 		result = _chain->getSampleDimensionOut (result);
 
 		return result;
@@ -175,12 +176,13 @@ protected:
 
 	OSTransformFFT *_fft;
 	ssi_stream_t _stream_fft;
+	ssi_stream_t _stream_mag;
 
 	OSFFTmagphase *_fftmag;
 	OSSpecScale *_spect;
 	OSMfcc *_mfcc;
 	IFilter *_deltas;
-	IFilter *_filter[4];
+	IFilter *_filter[3];
 	Chain *_chain;
 };
 
@@ -127,6 +127,7 @@ public:
 		}
 	
 		ssi_size_t result = _fft->getSampleDimensionOut (sample_dimension_in);
+		result = _fftmag->getSampleDimensionOut (result);
 		result = _chain->getSampleDimensionOut (result);
 
 		return result;
@@ -167,6 +168,7 @@ protected:
 
 	OSTransformFFT *_fft;
 	ssi_stream_t _stream_fft;
+	ssi_stream_t _stream_mag;
 	ssi_size_t frame;
 	ssi_size_t delta;
 
@@ -174,7 +176,7 @@ protected:
 	OSSpecScale *_spect;
 	OSPitchShs *_pitch;
 	OSPitchSmoother *_smooth;
-	IFilter *_filter[4];
+	IFilter *_filter[3];
 	Chain *_chain;
 
 	bool _first_call;
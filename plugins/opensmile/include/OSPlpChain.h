@@ -142,6 +142,7 @@ public:
 		}
 
 		ssi_size_t result = _fft->getSampleDimensionOut (sample_dimension_in);
+		result = _fftmag->getSampleDimensionOut (result);
 		result = _chain->getSampleDimensionOut (result);
 
 		return result;
@@ -183,6 +184,7 @@ protected:
 	OSTransformFFT *_fft;
 	ssi_stream_t _stream_fft_out;
 	ssi_stream_t _stream_fft_in;
+	ssi_stream_t _stream_mag_out;
 	ssi_size_t frame;
 	ssi_size_t delta;
 
@@ -190,7 +192,7 @@ protected:
 	OSSpecScale *_spect;
 	OSPlp *_plp;
 	IFilter* _deltas;
-	IFilter *_filter[4];
+	IFilter *_filter[3];
 	Chain *_chain;
 
 	bool _first_call;
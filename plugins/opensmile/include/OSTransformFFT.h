@@ -75,9 +75,12 @@ output: complex values of fft or real signal values (for iFFT)
 #include "OSTools.h"
 #include "ioput/option/OptionList.h"
 
+#include <string>
+
 namespace ssi {
 
 class OSWindow;
+class OSFFTmagphase;
 
 class OSTransformFFT : public IFeature {
 
@@ -88,12 +91,14 @@ public:
 	public:
 
 		Options ()
-			: nfft (1024) {
+			: nfft (1024), cache (true) {
 
 			addOption ("nfft", &nfft, 1, SSI_SIZE, "Frame size on which to apply FFT. Must be a power of 2 and should be LARGER than frame size + delta.");
+			addOption ("cache", &cache, 1, SSI_BOOL, "share spectra with components that use the same settings (see SpectrumCache)");
 		};
 
 		ssi_size_t nfft;
+		bool cache;
 	};
 
 public:
@@ -120,6 +125,14 @@ public:
 		ssi_size_t xtra_stream_in_num = 0,
 		ssi_stream_t xtra_stream_in[] = 0);
 
+	// fft of one frame followed by magphase, frames that were already transformed
+	// by a component with the same settings are taken from SpectrumCache
+	void spectrum (ITransformer::info info,
+		ssi_stream_t &stream_in,
+		ssi_stream_t &stream_fft,
+		OSFFTmagphase &magphase,
+		ssi_stream_t &stream_out);
+
 	virtual OSWindow *getWindow () {
 		return _window;
 	}
@@ -149,6 +162,9 @@ protected:
 	ssi_char_t *_file;
 	ssi_char_t *_file_win;
 
+	static void AppendOptions (std::string &config, IOptions *options);
+	void detachCache ();
+
 	void check_nfft () {
 		if (!smileMath_isPowerOf2(_options.nfft)) {
 			ssi_wrn ("set nfft '%u' to next power of 2", _options.nfft);
@@ -164,6 +180,8 @@ protected:
 
 	long _n_src_win;
 	ssi_real_t *_src_win;
+
+	ssi_size_t _cache_key;
 };
 
 }
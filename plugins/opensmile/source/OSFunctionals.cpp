@@ -74,7 +74,8 @@
 namespace ssi {
 
 OSFunctionals::OSFunctionals (const ssi_char_t *file)
-	: _file (0) {
+	: _file (0),
+	_pool (0) {
 	
 		_options.intializeOptions();
 		for(int i=0 ; i<FUNCT_ENAB_N ; i++) functN[i] = 0;
@@ -104,6 +105,16 @@ void OSFunctionals::transform_enter (ssi_stream_t &stream_in,
 	ssi_stream_t xtra_stream_in[]) {
 
 		T = ssi_cast (ssi_real_t, 1.0/stream_in.sr);
+
+		// Peaks and Peaks2 store intermediate results in the options
+		_pool = 0;
+		if (_options.parallel) {
+			if (_options.enab_funct[FUNCTIONAL_PEAKS] || _options.enab_funct[FUNCTIONAL_PEAKS2]) {
+				ssi_wrn ("dimensions are processed sequentially since Peaks or Peaks2 are enabled");
+			} else {
+				_pool = WorkerPool::GetShared ();
+			}
+		}
 				
 }
 
@@ -2050,6 +2061,21 @@ void OSFunctionals::transform (ITransformer::info info,
 	ssi_real_t *dst = ssi_pcast (ssi_real_t, stream_out.ptr);
 	ssi_real_t *data_in;
 	int nn;
+
+	if (_pool) {
+		_task_dims.clear ();
+		for (int i = 0; i < dim; i++) {
+			if (dim_in[i]) {
+				_task_dims.push_back (i);
+			}
+		}
+		_task_src = src;
+		_task_dst = dst;
+		_task_dim = dim;
+		_task_num = n;
+		_pool->run (ssi_cast (ssi_size_t, _task_dims.size ()), ProcessDimensionTask, this);
+		return;
+	}
 	
 	for(int i=0; i<dim ; i++) {
 
@@ -2076,6 +2102,23 @@ void OSFunctionals::transform (ITransformer::info info,
 
 }
 
+void OSFunctionals::ProcessDimensionTask (ssi_size_t index, void *arg) {
+
+	OSFunctionals *me = ssi_pcast (OSFunctionals, arg);
+
+	int i = me->_task_dims[index];
+	int dim = me->_task_dim;
+	int n = me->_task_num;
+	ssi_real_t *src = me->_task_src;
+
+	ssi_real_t *data_in = (ssi_real_t*) malloc(sizeof(ssi_real_t)*n);
+	for (int j = 0; j < n; j++) {
+		data_in[j] = src[(j*dim)+i];
+	}
+	me->processOneDimension(n, data_in, me->_task_dst + index * me->NFeatures);
+	free (data_in);
+}
+
 int* OSFunctionals::ParseIntSamples (const ssi_char_t *indices, int choice) {
 	
 	if (!indices || indices[0] == '\0') {
@@ -118,10 +118,9 @@ OSMfccChain::OSMfccChain (const ssi_char_t *file)
 
 	}	
 
-	_filter[0] = _fftmag;
-	_filter[1] = _spect;
-	_filter[2] = _mfcc;
-	_filter[3] = _deltas;
+	_filter[0] = _spect;
+	_filter[1] = _mfcc;
+	_filter[2] = _deltas;
 
 }
 
@@ -148,9 +147,9 @@ void OSMfccChain::initChain () {
 	}
 
 	if (_options.deltas_enable){
-		_chain->set ( 4, _filter, 0, 0 );
-	} else {
 		_chain->set ( 3, _filter, 0, 0 );
+	} else {
+		_chain->set ( 2, _filter, 0, 0 );
 	}
 }
 
@@ -170,8 +169,16 @@ void OSMfccChain::transform_enter (ssi_stream_t &stream_in,
 		_fft->getSampleTypeOut (stream_in.type),
 		stream_out.sr);
 
+	ssi_stream_init (_stream_mag,
+		1,
+		_fftmag->getSampleDimensionOut (_stream_fft.dim),
+		_fftmag->getSampleBytesOut (_stream_fft.byte),
+		_fftmag->getSampleTypeOut (_stream_fft.type),
+		stream_out.sr);
+
 	_fft->transform_enter (stream_in, _stream_fft);
-	_chain->transform_enter (_stream_fft, stream_out);
+	_fftmag->transform_enter (_stream_fft, _stream_mag);
+	_chain->transform_enter (_stream_mag, stream_out);
 }
 
 void OSMfccChain::transform (ITransformer::info info,
@@ -180,10 +187,10 @@ void OSMfccChain::transform (ITransformer::info info,
 	ssi_size_t xtra_stream_in_num,
 	ssi_stream_t xtra_stream_in[]) {
 		
-	_fft->transform (info, stream_in, _stream_fft, 0, 0);
+	_fft->spectrum (info, stream_in, _stream_fft, *_fftmag, _stream_mag);
 	info.frame_num = 1;
 	info.delta_num = 0;
-	_chain->transform (info, _stream_fft, stream_out);
+	_chain->transform (info, _stream_mag, stream_out);
 }
 
 void OSMfccChain::transform_flush (ssi_stream_t &stream_in,
@@ -192,8 +199,10 @@ void OSMfccChain::transform_flush (ssi_stream_t &stream_in,
 	ssi_stream_t xtra_stream_in[]) {
 
 	_fft->transform_flush (stream_in, _stream_fft);
+	_fftmag->transform_flush (_stream_fft, _stream_mag);
 	_chain->transform_flush (stream_in, stream_out);
 	ssi_stream_destroy (_stream_fft);
+	ssi_stream_destroy (_stream_mag);
 }
 
 
@@ -109,12 +109,11 @@ OSPitchChain::OSPitchChain (const ssi_char_t *file)
 		ssi_err("could not create chain");
 	}
 
-	_filter[0] = _fftmag;
-	_filter[1] = _spect;
-	_filter[2] = _pitch;
-	_filter[3] = _smooth;
+	_filter[0] = _spect;
+	_filter[1] = _pitch;
+	_filter[2] = _smooth;
 
-	_chain->set ( 4, _filter, 0, 0 );
+	_chain->set ( 3, _filter, 0, 0 );
 
 }
 
@@ -145,7 +144,15 @@ void OSPitchChain::transform_enter (ssi_stream_t &stream_in,
 		_fft->getSampleTypeOut (stream_in.type),
 		stream_out.sr);
 
+	ssi_stream_init (_stream_mag,
+		1,
+		_fftmag->getSampleDimensionOut (_stream_fft.dim),
+		_fftmag->getSampleBytesOut (_stream_fft.byte),
+		_fftmag->getSampleTypeOut (_stream_fft.type),
+		stream_out.sr);
+
 	_fft->transform_enter (stream_in, _stream_fft);
+	_fftmag->transform_enter (_stream_fft, _stream_mag);
 
 	ssi_size_t msize;
 	const void *mdata = _spect->getMetaData (msize);
@@ -153,7 +160,7 @@ void OSPitchChain::transform_enter (ssi_stream_t &stream_in,
 	mdata = _pitch->getMetaData (msize);
 	_smooth->setMetaData (msize, mdata);
 
-	_chain->transform_enter (_stream_fft, stream_out);
+	_chain->transform_enter (_stream_mag, stream_out);
 
 	_first_call = true;
 }
@@ -164,10 +171,10 @@ void OSPitchChain::transform (ITransformer::info info,
 	ssi_size_t xtra_stream_in_num,
 	ssi_stream_t xtra_stream_in[]) {
 	
-	_fft->transform (info, stream_in, _stream_fft, 0, 0);
+	_fft->spectrum (info, stream_in, _stream_fft, *_fftmag, _stream_mag);
 	info.frame_num = 1;
 	info.delta_num = 0;
-	_chain->transform (info, _stream_fft, stream_out);
+	_chain->transform (info, _stream_mag, stream_out);
 }
 
 void OSPitchChain::transform_flush (ssi_stream_t &stream_in,
@@ -176,8 +183,10 @@ void OSPitchChain::transform_flush (ssi_stream_t &stream_in,
 	ssi_stream_t xtra_stream_in[]) {
 
 	_fft->transform_flush (stream_in, _stream_fft);
+	_fftmag->transform_flush (_stream_fft, _stream_mag);
 	_chain->transform_flush (stream_in, stream_out);
 	ssi_stream_destroy (_stream_fft);
+	ssi_stream_destroy (_stream_mag);
 }
 
 
@@ -118,10 +118,9 @@ OSPlpChain::OSPlpChain (const ssi_char_t *file)
 
 	}
 
-	_filter[0] = _fftmag;
-	_filter[1] = _spect;
-	_filter[2] = _plp;
-	_filter[3] = _deltas;
+	_filter[0] = _spect;
+	_filter[1] = _plp;
+	_filter[2] = _deltas;
 }
 
 OSPlpChain::~OSPlpChain () {
@@ -147,10 +146,10 @@ void OSPlpChain::initChain () {
 	}
 
 	if(_options.deltas_enable){		
-		_chain->set ( 4, _filter, 0, 0 );
+		_chain->set ( 3, _filter, 0, 0 );
 	}
 	else {
-		_chain->set ( 3, _filter, 0, 0 );
+		_chain->set ( 2, _filter, 0, 0 );
 	}
 }
 
@@ -171,14 +170,22 @@ void OSPlpChain::transform_enter (ssi_stream_t &stream_in,
 		stream_in.sr);
 
 	ssi_stream_init (_stream_fft_out, 
-		0, 
+		1, 
 		_fft->getSampleDimensionOut (stream_in.dim),
 		_fft->getSampleBytesOut (stream_in.byte),
 		_fft->getSampleTypeOut (stream_in.type),
 		stream_out.sr);
 
+	ssi_stream_init (_stream_mag_out,
+		0,
+		_fftmag->getSampleDimensionOut (_stream_fft_out.dim),
+		_fftmag->getSampleBytesOut (_stream_fft_out.byte),
+		_fftmag->getSampleTypeOut (_stream_fft_out.type),
+		stream_out.sr);
+
 	_fft->transform_enter (stream_in, _stream_fft_out);
-	_chain->transform_enter (_stream_fft_out, stream_out);
+	_fftmag->transform_enter (_stream_fft_out, _stream_mag_out);
+	_chain->transform_enter (_stream_mag_out, stream_out);
 
 	frame = _options.frame;
 	delta = _options.delta;
@@ -204,13 +211,13 @@ void OSPlpChain::transform (ITransformer::info info,
 	}
 
 	ssi_size_t n_shifts = getSampleNumberOut (info.frame_num);
-	ssi_stream_adjust (_stream_fft_out, n_shifts);
+	ssi_stream_adjust (_stream_mag_out, n_shifts);
 	
 	//memcpy (_stream_fft_in.ptr + delta * _stream_fft_in.dim * _stream_fft_in.byte, stream_in.ptr, stream_in.num * _stream_fft_in.dim * _stream_fft_in.byte);
 	//ssi_stream_t from = _stream_fft_in;
 	ssi_stream_t from = stream_in;
 	from.num = frame + delta;
-	ssi_stream_t to = _stream_fft_out;
+	ssi_stream_t to = _stream_mag_out;
 	to.num = 1;
 	
 	ssi_size_t byte_shift_from = from.byte * from.dim * frame;
@@ -222,14 +229,14 @@ void OSPlpChain::transform (ITransformer::info info,
 	tinfo.time = info.time;
 
 	for (ssi_size_t i = 0; i < n_shifts; i++) {			
-		_fft->transform (tinfo, from, to, 0, 0);					
+		_fft->spectrum (tinfo, from, _stream_fft_out, *_fftmag, to);
 		tinfo.time += frame / stream_in.sr;
 
 		from.ptr += byte_shift_from;
 		to.ptr += byte_shift_to;		
 	}
 	
-	_chain->transform (info, _stream_fft_out, stream_out);
+	_chain->transform (info, _stream_mag_out, stream_out);
 
 	//Getting Deltas
 
@@ -249,10 +256,12 @@ void OSPlpChain::transform_flush (ssi_stream_t &stream_in,
 	ssi_stream_t xtra_stream_in[]) {
 
 	_fft->transform_flush (stream_in, _stream_fft_out);
+	_fftmag->transform_flush (_stream_fft_out, _stream_mag_out);
 	_chain->transform_flush (stream_in, stream_out);
 
 	ssi_stream_destroy (_stream_fft_in);
 	ssi_stream_destroy (_stream_fft_out);
+	ssi_stream_destroy (_stream_mag_out);
 }
 
 
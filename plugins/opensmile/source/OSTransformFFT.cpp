@@ -61,7 +61,9 @@
 
 #include "OSTransformFFT.h"
 #include "OSWindow.h"
+#include "OSFFTmagphase.h"
 #include "base/Factory.h"
+#include "signal/SpectrumCache.h"
 #include <fftXg.h>  // fft4g include
 
 #include "ssistdMinMaxWrapper.h"
@@ -84,7 +86,8 @@ OSTransformFFT::OSTransformFFT (const ssi_char_t *file)
 	ip (0),
     w (0),
 	_n_src_win (0),
-	_src_win (0) {
+	_src_win (0),
+	_cache_key (SpectrumCache::INVALID_KEY) {
 
 	if (file) {
 		if (!OptionList::LoadXML (file, _options)) {
@@ -99,6 +102,8 @@ OSTransformFFT::OSTransformFFT (const ssi_char_t *file)
 
 OSTransformFFT::~OSTransformFFT () {
 
+	detachCache ();
+
 	if (_file) {
 		OptionList::SaveXML (_file, _options);
 		delete[] _file;
@@ -115,6 +120,7 @@ void OSTransformFFT::transform_enter (ssi_stream_t &stream_in,
 	ssi_stream_t xtra_stream_in[]) {
 
 	Ndst = _options.nfft;
+	detachCache ();
 		
 	ip = new int[Ndst+2];
 	for (long i = 0; i < Ndst+2; i++) {
@@ -160,6 +166,61 @@ void OSTransformFFT::transform (ITransformer::info info,
 	rdft (Ndst, 1, dst, ip, w);	
 }
 
+void OSTransformFFT::spectrum (ITransformer::info info,
+	ssi_stream_t &stream_in,
+	ssi_stream_t &stream_fft,
+	OSFFTmagphase &magphase,
+	ssi_stream_t &stream_out) {
+
+	SpectrumCache *cache = SpectrumCache::GetShared ();
+
+	// settings that affect the result
+	if (_cache_key == SpectrumCache::INVALID_KEY && _options.cache) {
+		std::string config = GetCreateName ();
+		AppendOptions (config, &_options);
+		config += " OSWindow";
+		AppendOptions (config, _window->getOptions ());
+		config += " OSFFTmagphase";
+		AppendOptions (config, magphase.getOptions ());
+		_cache_key = cache->attach (config.c_str ());
+	}
+
+	// get() and put() return at once if no other component uses the same settings
+	ssi_size_t n_in = stream_in.num * stream_in.dim;
+	ssi_real_t *in = ssi_pcast (ssi_real_t, stream_in.ptr);
+	ssi_real_t *out = ssi_pcast (ssi_real_t, stream_out.ptr);
+
+	if (cache->get (_cache_key, n_in, in, stream_out.dim, out)) {
+		return;
+	}
+
+	transform (info, stream_in, stream_fft, 0, 0);
+	magphase.transform (info, stream_fft, stream_out, 0, 0);
+
+	cache->put (_cache_key, n_in, in, stream_out.dim, out);
+}
+
+void OSTransformFFT::detachCache () {
+
+	if (_cache_key != SpectrumCache::INVALID_KEY) {
+		SpectrumCache::GetShared ()->detach (_cache_key);
+		_cache_key = SpectrumCache::INVALID_KEY;
+	}
+}
+
+void OSTransformFFT::AppendOptions (std::string &config, IOptions *options) {
+
+	for (ssi_size_t i = 0; i < options->getSize (); i++) {
+		ssi_option_t *option = options->getOption (i);
+		ssi_char_t *value = OptionList::ToString (*option);
+		config += ' ';
+		config += option->name;
+		config += '=';
+		config += value;
+		delete[] value;
+	}
+}
+
 void OSTransformFFT::transform_flush (ssi_stream_t &stream_in,
 	ssi_stream_t &stream_out,
 	ssi_size_t xtra_stream_in_num,
@@ -169,6 +230,8 @@ void OSTransformFFT::transform_flush (ssi_stream_t &stream_in,
 	delete[] w; w = 0;
 	delete[] _src_win; _src_win = 0; 
 	_n_src_win = 0;
+
+	detachCache ();
 }
 
 }
@@ -41,6 +41,16 @@ class PythonConsumer : public IConsumer {
 public:
 
 	class Options : public PythonOptions {
+
+	public:
+
+		Options()
+			: batch(1)
+		{
+			addOption("batch", &batch, 1, SSI_SIZE, "number of consecutive frames passed at once to consume() (exposed as frames x samples x dimensions)");
+		};
+
+		ssi_size_t batch;
 	};
 
 public:
@@ -81,6 +91,13 @@ protected:
 
 	void initHelper();
 	PythonHelper *_helper;
+
+	void batch_flush();
+	ssi_size_t _batch_num;
+	ssi_size_t _batch_count;
+	ssi_size_t _batch_stream_num;
+	ssi_stream_t *_batch_streams;
+	IConsumer::info _batch_info;
 };
 
 }
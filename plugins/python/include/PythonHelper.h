@@ -106,7 +106,7 @@ public:
 	bool transform_flush(ssi_stream_t &stream_in, ssi_stream_t &stream_out, ssi_size_t xtra_stream_in_num, ssi_stream_t xtra_stream_in[]);
 
 	bool consume_enter(ssi_size_t stream_in_num, ssi_stream_t stream_in[]);
-	bool consume(IConsumer::info *info, ssi_size_t stream_in_num, ssi_stream_t stream_in[]);
+	bool consume(IConsumer::info *info, ssi_size_t stream_in_num, ssi_stream_t stream_in[], ssi_size_t n_frames = 1);
 	bool consume_flush(ssi_size_t stream_in_num, ssi_stream_t stream_in[]);
 
 	bool setEventListener(IEventListener *listener);
@@ -133,11 +133,14 @@ public:
 
 protected:
 	
+	// keeps the thread state of a calling thread alive between calls,
+	// so acquiring the GIL does not create a new thread state each time
 	struct GIL
 	{
 		GIL();
 		~GIL();
 		int _state;
+		bool _nested;
 	};
 
 	static ssi_char_t *ssi_log_name;
@@ -151,6 +154,7 @@ protected:
 	void options_parse(const ssi_char_t *string, char delim);
 	bool options_apply(const ssi_char_t *key, const ssi_char_t *value);
 	PyObject *stream_to_object(ssi_stream_t *stream);
+	bool stream_rebind_object(PyObject *object, ssi_stream_t *stream);
 	PyObject *stream_to_imageobject(ssi_stream_t *stream, ssi_video_params_t params);
 	PyObject *samplelist_to_object(ISamples &samples, ssi_size_t stream_index);
 	PyObject *labels_to_object(ISamples &samples, ssi_size_t stream_index);
@@ -158,9 +162,11 @@ protected:
 	bool transform_get_help(function_t function, ssi_size_t in, ssi_size_t &out);
 	bool transform_help(function_t function, ssi_stream_t &stream_in, ssi_stream_t &stream_out, ssi_size_t xtra_stream_in_num, ssi_stream_t xtra_stream_in[], ITransformer::info *info = 0);
 	PyObject *transform_args(ssi_stream_t &stream_in, ssi_stream_t &stream_out, ssi_size_t xtra_stream_in_num, ssi_stream_t xtra_stream_in[], ITransformer::info *info = 0);
+	bool transform_args_reuse(PyObject *pArgs, ssi_stream_t &stream_in, ssi_stream_t &stream_out, ssi_size_t xtra_stream_in_num, ssi_stream_t xtra_stream_in[], ITransformer::info *info);
 
-	bool consume_help(function_t function, ssi_size_t stream_in_num, ssi_stream_t stream_in[], IConsumer::info *info = 0);
-	PyObject *consume_args(ssi_size_t stream_in_num, ssi_stream_t stream_in[], IConsumer::info *info = 0);
+	bool consume_help(function_t function, ssi_size_t stream_in_num, ssi_stream_t stream_in[], IConsumer::info *info = 0, ssi_size_t n_frames = 1);
+	PyObject *consume_args(ssi_size_t stream_in_num, ssi_stream_t stream_in[], IConsumer::info *info = 0, ssi_size_t n_frames = 1);
+	bool consume_args_reuse(PyObject *pArgs, ssi_size_t stream_in_num, ssi_stream_t stream_in[], IConsumer::info *info, ssi_size_t n_frames);
 
 	bool listen_send_help(function_t function);
 	PyObject *listen_send_args();
@@ -174,6 +180,7 @@ protected:
 
 	ssi_char_t *_script_name;
 	PyObject *_pFunctions[FUNCTIONS::NUM];
+	PyObject *_pArgs[FUNCTIONS::NUM];
 	PyObject *_pModule;
 	PyObject *_pOptions;
 	PyObject *_pVariables;
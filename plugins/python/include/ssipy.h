@@ -91,6 +91,7 @@ typedef struct _ssipystream {
 	Py_ssize_t byte; // bytes per value
 	ssi_byte_t *ptr; // memory block	
 	int borrowed;    // is memory borrowed?	
+	Py_ssize_t frames; // number of consecutive frames (>1 exposes buffer as frames x num/frames x dim)
 } ssipystream;
 PyAPI_DATA(PyTypeObject) ssipystream_Type;
 
@@ -190,6 +191,7 @@ void ssipychannel_Init(ssipychannel *self, Py_ssize_t dim, Py_ssize_t byte, ssi_
 void ssipystream_Init(ssipystream *self, Py_ssize_t num, Py_ssize_t dim, Py_ssize_t byte, ssi_type_t type, ssi_time_t sr, ssi_time_t time);
 ssipystream *ssipystream_New(Py_ssize_t num, Py_ssize_t dim, ssi_type_t type, ssi_time_t sr, ssi_time_t time);
 ssipystream *ssipystream_From(Py_ssize_t num, Py_ssize_t dim, Py_ssize_t byte, ssi_type_t type, ssi_time_t sr, ssi_time_t time, ssi_byte_t *ptr);
+void ssipystream_Borrow(ssipystream *self, Py_ssize_t num, ssi_time_t time, ssi_byte_t *ptr);
 void ssipystream_Print(ssipystream *self);
 char *ssipystream_ToString(ssipystream *self, Py_ssize_t nmax);
 
@@ -42,7 +42,11 @@ ssi_char_t *PythonConsumer::ssi_log_name = "pyconsumer";
 
 PythonConsumer::PythonConsumer (const ssi_char_t *file)
 	: _file (0), 
-	_helper(0) 
+	_helper(0),
+	_batch_num(0),
+	_batch_count(0),
+	_batch_stream_num(0),
+	_batch_streams(0)
 {
 
 	if (file) {
@@ -79,6 +83,18 @@ void PythonConsumer::consume_enter(ssi_size_t stream_in_num,
 	}
 
 	_helper->consume_enter(stream_in_num, stream_in);
+
+	_batch_count = 0;
+	_batch_num = 0;
+	if (_options.batch > 1)
+	{
+		_batch_stream_num = stream_in_num;
+		_batch_streams = new ssi_stream_t[stream_in_num];
+		for (ssi_size_t i = 0; i < stream_in_num; i++)
+		{
+			ssi_stream_init(_batch_streams[i], 0, stream_in[i].dim, stream_in[i].byte, stream_in[i].type, stream_in[i].sr);
+		}
+	}
 }
 
 void PythonConsumer::consume_flush(ssi_size_t stream_in_num,
@@ -89,6 +105,17 @@ void PythonConsumer::consume_flush(ssi_size_t stream_in_num,
 		initHelper();
 	}
 
+	if (_batch_streams)
+	{
+		batch_flush();
+		for (ssi_size_t i = 0; i < _batch_stream_num; i++)
+		{
+			ssi_stream_destroy(_batch_streams[i]);
+		}
+		delete[] _batch_streams; _batch_streams = 0;
+		_batch_stream_num = 0;
+	}
+
 	_helper->consume_flush(stream_in_num, stream_in);
 }
 
@@ -101,7 +128,63 @@ void PythonConsumer::consume (IConsumer::info info,
 		initHelper();
 	}
 
-	_helper->consume(&info, stream_in_num, stream_in);
+	if (!_batch_streams)
+	{
+		_helper->consume(&info, stream_in_num, stream_in);
+		return;
+	}
+
+	// frames are collected and passed on at once, which requires frames of equal size
+	if (_batch_count > 0 && stream_in[0].num != _batch_num)
+	{
+		batch_flush();
+	}
+
+	if (_batch_count == 0)
+	{
+		_batch_num = stream_in[0].num;
+		_batch_info = info;
+		_batch_info.dur = 0;
+		for (ssi_size_t i = 0; i < _batch_stream_num; i++)
+		{
+			if (_batch_streams[i].num_real < _options.batch * stream_in[i].num)
+			{
+				ssi_stream_adjust(_batch_streams[i], _options.batch * stream_in[i].num);
+			}
+			_batch_streams[i].num = 0;
+			_batch_streams[i].time = stream_in[i].time;
+		}
+	}
+
+	for (ssi_size_t i = 0; i < _batch_stream_num; i++)
+	{
+		ssi_size_t bytes = stream_in[i].num * stream_in[i].dim * stream_in[i].byte;
+		memcpy(_batch_streams[i].ptr + _batch_streams[i].num * _batch_streams[i].dim * _batch_streams[i].byte, stream_in[i].ptr, bytes);
+		_batch_streams[i].num += stream_in[i].num;
+	}
+	_batch_info.dur += info.dur;
+	_batch_count++;
+
+	if (_batch_count == _options.batch)
+	{
+		batch_flush();
+	}
+}
+
+void PythonConsumer::batch_flush()
+{
+	if (_batch_count == 0)
+	{
+		return;
+	}
+
+	for (ssi_size_t i = 0; i < _batch_stream_num; i++)
+	{
+		_batch_streams[i].tot = _batch_streams[i].num * _batch_streams[i].dim * _batch_streams[i].byte;
+	}
+	_helper->consume(&_batch_info, _batch_stream_num, _batch_streams, _batch_count);
+
+	_batch_count = 0;
 }
 
 bool PythonConsumer::setEventListener(IEventListener *listener)
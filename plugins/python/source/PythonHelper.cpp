@@ -70,13 +70,40 @@ namespace ssi {
 	};
 
 	PythonHelper::GIL::GIL()
+		: _state(0),
+		_nested(false)
 	{
-		_state = PyGILState_Ensure();
+		PyThreadState *pState = PyGILState_GetThisThreadState();
+
+		if (PyGILState_Check())
+		{
+			// already holding the lock, e.g. called from within a script
+			_state = PyGILState_Ensure();
+			_nested = true;
+		}
+		else if (pState)
+		{
+			// reuse the thread state of a previous call
+			PyEval_RestoreThread(pState);
+		}
+		else
+		{
+			// first call from this thread, the thread state is created here
+			// and kept alive, otherwise it would be destroyed on release
+			PyGILState_Ensure();
+		}
 	}
 
 	PythonHelper::GIL::~GIL()
 	{
-		PyGILState_Release((PyGILState_STATE)_state);
+		if (_nested)
+		{
+			PyGILState_Release((PyGILState_STATE)_state);
+		}
+		else
+		{
+			PyEval_SaveThread();
+		}
 	}
 
 	PythonHelper::PythonHelper(ssi_char_t *script_name,
@@ -97,6 +124,7 @@ namespace ssi {
 		for (int i = 0; i < FUNCTIONS::NUM; i++)
 		{
 			_pFunctions[i] = 0;
+			_pArgs[i] = 0;
 		}
 
 		_script_name = ssi_strcpy(script_name);
@@ -138,6 +166,7 @@ namespace ssi {
 			{
 				Py_XDECREF(_pFunctions[i]);
 			}
+			Py_XDECREF(_pArgs[i]); _pArgs[i] = 0;
 		}
 		Py_XDECREF(_pBoard); _pBoard = 0;
 		Py_XDECREF(_pVariables); _pVariables = 0;
@@ -256,6 +285,29 @@ namespace ssi {
 		return (PyObject *)ssipystream_From(stream->num, stream->dim, stream->byte, stream->type, stream->sr, stream->time, stream->ptr);
 	}
 
+	bool PythonHelper::stream_rebind_object(PyObject *object, ssi_stream_t *stream)
+	{
+		// an object can only be rebound if the script did not keep a reference to it
+		if (!object || Py_REFCNT(object) != 1 || !PyObject_TypeCheck(object, &ssipystream_Type))
+		{
+			return false;
+		}
+
+		ssipystream *pStream = (ssipystream *)object;
+		if (!pStream->borrowed
+			|| pStream->dim != stream->dim
+			|| pStream->byte != stream->byte
+			|| pStream->type != stream->type
+			|| pStream->sr != stream->sr)
+		{
+			return false;
+		}
+
+		ssipystream_Borrow(pStream, stream->num, stream->time, stream->ptr);
+
+		return true;
+	}
+
 
 
 	PyObject *PythonHelper::samplelist_to_object(ISamples &samples, ssi_size_t stream_index)
@@ -697,6 +749,45 @@ namespace ssi {
 		return pArgs;
 	}
 
+	bool PythonHelper::transform_args_reuse(PyObject *pArgs,
+		ssi_stream_t &stream_in,
+		ssi_stream_t &stream_out,
+		ssi_size_t xtra_stream_in_num,
+		ssi_stream_t xtra_stream_in[],
+		ITransformer::info *info)
+	{
+		if (!pArgs || !info || Py_REFCNT(pArgs) != 1 || PyTuple_GET_SIZE(pArgs) != 7)
+		{
+			return false;
+		}
+
+		PyObject *pInfo = PyTuple_GET_ITEM(pArgs, 0);
+		PyObject *pList_xtra_in = PyTuple_GET_ITEM(pArgs, 3);
+		if (Py_REFCNT(pInfo) != 1
+			|| Py_REFCNT(pList_xtra_in) != 1
+			|| PyTuple_GET_SIZE(pList_xtra_in) != (Py_ssize_t)xtra_stream_in_num)
+		{
+			return false;
+		}
+
+		if (!stream_rebind_object(PyTuple_GET_ITEM(pArgs, 1), &stream_in)
+			|| !stream_rebind_object(PyTuple_GET_ITEM(pArgs, 2), &stream_out))
+		{
+			return false;
+		}
+		for (ssi_size_t i = 0; i < xtra_stream_in_num; i++)
+		{
+			if (!stream_rebind_object(PyTuple_GET_ITEM(pList_xtra_in, i), &xtra_stream_in[i]))
+			{
+				return false;
+			}
+		}
+
+		ssipyinfo_Init((ssipyinfo *)pInfo, info->time, stream_in.num / stream_in.sr, info->frame_num, info->delta_num);
+
+		return true;
+	}
+
 	bool PythonHelper::transform_help(function_t function,
 		ssi_stream_t &stream_in,
 		ssi_stream_t &stream_out,
@@ -718,7 +809,22 @@ namespace ssi {
 
 		bool result = false;
 
-		PyObject *pArgs = transform_args(stream_in, stream_out, xtra_stream_in_num, xtra_stream_in, info);
+		PyObject *pArgs = 0;
+		if (function == FUNCTIONS::TRANSFORM)
+		{
+			// reuse argument tuple of previous call to avoid reallocating it for every frame
+			if (!transform_args_reuse(_pArgs[function], stream_in, stream_out, xtra_stream_in_num, xtra_stream_in, info))
+			{
+				Py_XDECREF(_pArgs[function]);
+				_pArgs[function] = transform_args(stream_in, stream_out, xtra_stream_in_num, xtra_stream_in, info);
+			}
+			pArgs = _pArgs[function];
+			Py_INCREF(pArgs);
+		}
+		else
+		{
+			pArgs = transform_args(stream_in, stream_out, xtra_stream_in_num, xtra_stream_in, info);
+		}
 		PyObject *pValue = call_function(function, pArgs);
 		Py_DECREF(pArgs);
 
@@ -759,7 +865,8 @@ namespace ssi {
 	// consumer
 	PyObject *PythonHelper::consume_args(ssi_size_t stream_in_num,
 		ssi_stream_t stream_in[],
-		IConsumer::info *info)
+		IConsumer::info *info,
+		ssi_size_t n_frames)
 	{
 		PyObject *pArgs = PyTuple_New(4 + (info ? 1 : 0));
 		int valcount = 0;
@@ -781,6 +888,7 @@ namespace ssi {
 			else
 			{
 				pObject_stream = stream_to_object(&stream_in[i]);
+				((ssipystream *)pObject_stream)->frames = n_frames;
 			}
 			PyTuple_SetItem(pList_stream, i, pObject_stream);
 		}
@@ -798,10 +906,45 @@ namespace ssi {
 		return pArgs;
 	}
 
+	bool PythonHelper::consume_args_reuse(PyObject *pArgs,
+		ssi_size_t stream_in_num,
+		ssi_stream_t stream_in[],
+		IConsumer::info *info,
+		ssi_size_t n_frames)
+	{
+		if (!pArgs || !info || Py_REFCNT(pArgs) != 1 || PyTuple_GET_SIZE(pArgs) != 5)
+		{
+			return false;
+		}
+
+		PyObject *pInfo = PyTuple_GET_ITEM(pArgs, 0);
+		PyObject *pList_stream = PyTuple_GET_ITEM(pArgs, 1);
+		if (Py_REFCNT(pInfo) != 1
+			|| Py_REFCNT(pList_stream) != 1
+			|| PyTuple_GET_SIZE(pList_stream) != (Py_ssize_t)stream_in_num)
+		{
+			return false;
+		}
+
+		for (ssi_size_t i = 0; i < stream_in_num; i++)
+		{
+			if (!stream_rebind_object(PyTuple_GET_ITEM(pList_stream, i), &stream_in[i]))
+			{
+				return false;
+			}
+			((ssipystream *)PyTuple_GET_ITEM(pList_stream, i))->frames = n_frames;
+		}
+
+		ssipyinfo_Init((ssipyinfo *)pInfo, info->time, info->dur, 0, 0);
+
+		return true;
+	}
+
 	bool PythonHelper::consume_help(function_t function,
 		ssi_size_t stream_in_num,
 		ssi_stream_t stream_in[],
-		IConsumer::info *info)
+		IConsumer::info *info,
+		ssi_size_t n_frames)
 	{
 		if (!_pFunctions[function])
 		{
@@ -817,7 +960,22 @@ namespace ssi {
 
 		bool result = false;
 
-		PyObject *pArgs = consume_args(stream_in_num, stream_in, info);
+		PyObject *pArgs = 0;
+		if (function == FUNCTIONS::CONSUME)
+		{
+			// reuse argument tuple of previous call to avoid reallocating it for every frame
+			if (!consume_args_reuse(_pArgs[function], stream_in_num, stream_in, info, n_frames))
+			{
+				Py_XDECREF(_pArgs[function]);
+				_pArgs[function] = consume_args(stream_in_num, stream_in, info, n_frames);
+			}
+			pArgs = _pArgs[function];
+			Py_INCREF(pArgs);
+		}
+		else
+		{
+			pArgs = consume_args(stream_in_num, stream_in, info, n_frames);
+		}
 		PyObject *pValue = call_function(function, pArgs);
 		Py_DECREF(pArgs);
 
@@ -838,9 +996,10 @@ namespace ssi {
 
 	bool PythonHelper::consume(IConsumer::info *info,
 		ssi_size_t stream_in_num,
-		ssi_stream_t stream_in[])
+		ssi_stream_t stream_in[],
+		ssi_size_t n_frames)
 	{
-		return consume_help(FUNCTIONS::CONSUME, stream_in_num, stream_in, info);
+		return consume_help(FUNCTIONS::CONSUME, stream_in_num, stream_in, info, n_frames);
 	}
 
 	bool PythonHelper::consume_flush(ssi_size_t stream_in_num,
@@ -628,13 +628,29 @@ static int ssipystream_getbuffer(PyObject *obj, Py_buffer *view, int flags)
 	view->itemsize = self->byte;
 	view->format = (char *)malloc(strlen(self->type_s)+1 * sizeof(char));
 	strcpy(view->format, self->type_s);	
-	view->ndim = 2;
-	view->shape = (Py_ssize_t*)malloc(2 * sizeof(Py_ssize_t));
-	view->shape[0] = self->num;
-	view->shape[1] = self->dim;
-	view->strides = (Py_ssize_t*)malloc(2 * sizeof(Py_ssize_t)); 
-	view->strides[0] = self->dim * self->byte;
-	view->strides[1] = self->byte;
+	if (self->frames > 1 && self->num % self->frames == 0)
+	{
+		// batch of consecutive frames
+		view->ndim = 3;
+		view->shape = (Py_ssize_t*)malloc(3 * sizeof(Py_ssize_t));
+		view->shape[0] = self->frames;
+		view->shape[1] = self->num / self->frames;
+		view->shape[2] = self->dim;
+		view->strides = (Py_ssize_t*)malloc(3 * sizeof(Py_ssize_t));
+		view->strides[0] = (self->num / self->frames) * self->dim * self->byte;
+		view->strides[1] = self->dim * self->byte;
+		view->strides[2] = self->byte;
+	}
+	else
+	{
+		view->ndim = 2;
+		view->shape = (Py_ssize_t*)malloc(2 * sizeof(Py_ssize_t));
+		view->shape[0] = self->num;
+		view->shape[1] = self->dim;
+		view->strides = (Py_ssize_t*)malloc(2 * sizeof(Py_ssize_t)); 
+		view->strides[0] = self->dim * self->byte;
+		view->strides[1] = self->byte;
+	}
 	view->suboffsets = NULL;
 	view->internal = NULL;
 
@@ -786,6 +802,7 @@ static PyMemberDef ssipystream_members[] =
 	{ "type", T_INT, offsetof(ssipystream, type), READONLY, "Type code" },
 	{ "sr", T_DOUBLE, offsetof(ssipystream, sr), READONLY, "Sample rate in hz" },
 	{ "time", T_DOUBLE, offsetof(ssipystream, time), READONLY, "Time stamp in seconds" },
+	{ "frames", T_PYSSIZET, offsetof(ssipystream, frames), READONLY, "Number of consecutive frames" },
 	{ NULL }
 };
 
@@ -1957,6 +1974,7 @@ void ssipystream_Init(ssipystream *self, Py_ssize_t num, Py_ssize_t dim, Py_ssiz
 		self->tot = self->len * self->byte;
 		self->ptr = 0;
 		self->borrowed = 0;
+		self->frames = 1;
 		if (self->len > 0)
 		{
 			self->ptr = (ssi_byte_t*)malloc(self->tot);
@@ -1995,10 +2013,24 @@ ssipystream *ssipystream_From(Py_ssize_t num, Py_ssize_t dim, Py_ssize_t byte, s
 	self->tot = self->len * self->byte;
 	self->ptr = ptr;
 	self->borrowed = 1;
+	self->frames = 1;
 
 	return self;
 }
 
+void ssipystream_Borrow(ssipystream *self, Py_ssize_t num, ssi_time_t time, ssi_byte_t *ptr)
+{
+	if (self != NULL && self->borrowed)
+	{
+		self->num = num;
+		self->len = num * self->dim;
+		self->tot = self->len * self->byte;
+		self->time = time;
+		self->ptr = ptr;
+		self->frames = 1;
+	}
+}
+
 void ssipystream_Print(ssipystream *self)
 {
 	char *tmp = ssipystream_ToString(self, self->len);
@@ -31,8 +31,10 @@
 
 #include "base/IFilter.h"
 #include "ioput/option/OptionList.h"
+#include "signal/TypeCast.h"
 
 class ExpParser;
+class ExpProgram;
 
 namespace ssi {
 
@@ -121,9 +123,21 @@ protected:
 	bool _single;
 	JOIN::List _join;
 	ExpParser *_parser;
-	ssi_char_t _expression[SSI_MAX_CHAR];
-
-	void insert (ssi_char_t *src, ssi_char_t *dst, ssi_size_t current, ssi_real_t *sample); // returns 0 if nothing to insert
+	ExpProgram *_program;
+
+	// expression is compiled once, 'd' is bound to slot 0 and 'd<i>' to slot 1+i,
+	// each slot points to a column of the current frame
+	static int Resolve (const char name[], void *param);
+	ssi_size_t _dim;
+	ssi_size_t _num;
+	double *_columns;
+	double *_result;
+	double *_output;
+	const double **_slots;
+	void resize (ssi_size_t num);
+
+	// converts results to the output type, resolved in transform_enter()
+	ssi_cast_kernel_t _kernel;
 };
 
 }
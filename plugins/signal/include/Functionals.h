@@ -32,6 +32,7 @@
 #include "base/IFeature.h"
 #include "signal/SignalCons.h"
 #include "ioput/option/OptionList.h"
+#include "thread/WorkerPool.h"
 
 namespace ssi {
 
@@ -76,11 +77,12 @@ public:
 	public:
 
 		Options ()
-			: delta (2) {
+			: delta (2), parallel (false) {
 
 			names[0] = '\0';
 			addOption ("names", names, SSI_MAX_CHAR, SSI_CHAR, "names of functionals separated by comma (mean,energy,std,min,max,range,minpos,maxpos,zeros,peaks,len) or leave empty to select all");		
 			addOption ("delta", &delta, 1, SSI_UCHAR, "zero/peaks search offset");
+			addOption ("parallel", &parallel, 1, SSI_BOOL, "split dimensions of wide input streams among the shared worker pool");
 		};
 
 		void addName (const ssi_char_t *name) {
@@ -100,6 +102,7 @@ public:
 
 		ssi_char_t names[SSI_MAX_CHAR];
 		ssi_size_t delta;
+		bool parallel;
 	};
 
 public:
@@ -152,6 +155,21 @@ protected:
 		ssi_size_t sample_number, 
 		ssi_real_t *data_in, 
 		ssi_real_t *&dstptr);
+	// accumulates statistics of dimensions [from, to)
+	void calc_range (ssi_size_t from,
+		ssi_size_t to,
+		ssi_size_t sample_dimension, 
+		ssi_size_t sample_number, 
+		ssi_real_t *data_in);
+
+	// minimum number of dimensions handed to a worker
+	static const ssi_size_t PARALLEL_MIN_DIM = 32;
+	static void CalcTask (ssi_size_t index, void *arg);
+	WorkerPool			*_pool;
+	ssi_size_t			_n_tasks;
+	ssi_size_t			_task_dim;
+	ssi_size_t			_task_num;
+	ssi_real_t			*_task_src;
 
 	ssi_bitmask_t		_format;
 	ssi_size_t			_delta;
@@ -167,7 +185,6 @@ protected:
 	ssi_size_t			*_peaks;
 	ssi_real_t			*_left_val;
 	ssi_real_t			*_mid_val;
-	ssi_real_t			_val;
 };
 
 }
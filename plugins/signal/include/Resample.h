@@ -0,0 +1,113 @@
+// Resample.h
+// created: 2026/10/19
+// Copyright (C) University of Augsburg, Lab for Human Centered Multimedia
+//
+// *************************************************************************************************
+//
+// This file is part of Social Signal Interpretation (SSI) developed at the 
+// Lab for Human Centered Multimedia of the University of Augsburg
+//
+// This library is free software; you can redistribute itand/or
+// modify it under the terms of the GNU General Public
+// License as published by the Free Software Foundation; either
+// version 3 of the License, or any laterversion.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FORA PARTICULAR PURPOSE.  See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public
+// License along withthis library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+//
+//*************************************************************************************************
+
+#pragma once
+
+#ifndef SSI_SIGNAL_RESAMPLE_H
+#define SSI_SIGNAL_RESAMPLE_H
+
+#include "base/ITransformer.h"
+#include "ioput/option/OptionList.h"
+#include "signal/Resampler.h"
+
+namespace ssi {
+
+class Resample : public ITransformer {
+
+public:
+
+	class Options : public OptionList {
+
+	public:
+
+		Options ()
+			: up (1), down (1), taps (16) {
+
+			addOption ("up", &up, 1, SSI_SIZE, "upsampling factor (> 0)");
+			addOption ("down", &down, 1, SSI_SIZE, "downsampling factor (> 0), frame size * up has to be a multiple of down");
+			addOption ("taps", &taps, 1, SSI_SIZE, "filter length per polyphase branch");
+		};
+
+		ssi_size_t up;
+		ssi_size_t down;
+		ssi_size_t taps;
+	};
+
+public:
+
+	static const ssi_char_t *GetCreateName () { return "Resample"; };
+	static IObject *Create (const ssi_char_t *file) { return new Resample (file); };
+	~Resample ();
+
+	Options *getOptions () { return &_options; };
+	const ssi_char_t *getName () { return GetCreateName (); };
+	const ssi_char_t *getInfo () { return "Changes the sample rate by a rational factor up/down with a polyphase lowpass filter."; };
+
+	ssi_size_t getSampleDimensionOut (ssi_size_t sample_dimension_in) {
+		return sample_dimension_in;
+	}
+	ssi_size_t getSampleNumberOut (ssi_size_t sample_number_in) {
+		ssi_size_t up = _options.up > 0 ? _options.up : 1;
+		ssi_size_t down = _options.down > 0 ? _options.down : 1;
+		return ssi_cast (ssi_size_t, (ssi_cast (uint64_t, sample_number_in) * up) / down);
+	}
+	ssi_size_t getSampleBytesOut (ssi_size_t sample_bytes_in) {
+		return sample_bytes_in;
+	}
+	ssi_type_t getSampleTypeOut (ssi_type_t sample_type_in) {
+		if (sample_type_in != SSI_REAL) {
+			ssi_err ("type %s not supported", SSI_TYPE_NAMES[sample_type_in]);
+		}
+		return SSI_REAL;
+	}
+
+	void transform_enter (ssi_stream_t &stream_in,
+		ssi_stream_t &stream_out,
+		ssi_size_t xtra_stream_in_num = 0,
+		ssi_stream_t xtra_stream_in[] = 0);
+	void transform (ITransformer::info info,
+		ssi_stream_t &stream_in,
+		ssi_stream_t &stream_out,
+		ssi_size_t xtra_stream_in_num = 0,
+		ssi_stream_t xtra_stream_in[] = 0);
+	void transform_flush (ssi_stream_t &stream_in,
+		ssi_stream_t &stream_out,
+		ssi_size_t xtra_stream_in_num = 0,
+		ssi_stream_t xtra_stream_in[] = 0);
+
+protected:
+
+	Resample (const ssi_char_t *file = 0);
+	Options _options;
+	ssi_char_t *_file;
+
+	static char ssi_log_name[];
+
+	Resampler _resampler;
+};
+
+}
+
+#endif
@@ -61,6 +61,8 @@ public:
 	const ssi_char_t *getName () { return GetCreateName (); };
 	const ssi_char_t *getInfo () { return "Sums up sample values along dimensions."; };
 
+	bool isSampleWise () { return true; };
+
 	void transform (ITransformer::info info,
 		ssi_stream_t &stream_in,
 		ssi_stream_t &stream_out,
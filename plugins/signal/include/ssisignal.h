@@ -39,6 +39,7 @@
 #include "Functionals.h"
 #include "FunctionalsEventSender.h"
 #include "DownSample.h"
+#include "Resample.h"
 #include "Normalize.h"
 #include "MvgAvgVar.h"
 #include "MvgMinMax.h"
@@ -59,6 +59,7 @@ DLLEXP bool Register (ssi::Factory *factory, FILE *logfile, ssi::IMessage *messa
 	result = ssi::Factory::Register (ssi::IIR::GetCreateName (),ssi::IIR::Create) && result;
 	result = ssi::Factory::Register (ssi::Spectrogram::GetCreateName (),ssi::Spectrogram::Create) && result;	
 	result = ssi::Factory::Register (ssi::DownSample::GetCreateName (),ssi::DownSample::Create) && result;
+	result = ssi::Factory::Register (ssi::Resample::GetCreateName (),ssi::Resample::Create) && result;
 	result = ssi::Factory::Register (ssi::Normalize::GetCreateName (),ssi::Normalize::Create) && result;	
 	result = ssi::Factory::Register (ssi::MvgAvgVar::GetCreateName (),ssi::MvgAvgVar::Create) && result;
 	result = ssi::Factory::Register (ssi::MvgMinMax::GetCreateName (),ssi::MvgMinMax::Create) && result;
@@ -43,7 +43,15 @@
 
 namespace ssi {
 Expression::Expression (const ssi_char_t *file) 
-	: _file (0) {
+	: _file (0),
+	_program (0),
+	_dim (0),
+	_num (0),
+	_columns (0),
+	_result (0),
+	_output (0),
+	_slots (0),
+	_kernel (0) {
 
 	if (file) {
 		if (!OptionList::LoadXML (file, _options)) {
@@ -53,11 +61,17 @@ Expression::Expression (const ssi_char_t *file)
 	}
 
 	_parser = new ExpParser ();
+	_program = new ExpProgram ();
 }
 
 Expression::~Expression () {
 
 	delete _parser;
+	delete _program;
+	delete[] _columns;
+	delete[] _result;
+	delete[] _output;
+	delete[] _slots;
 
 	if (_file) {
 		OptionList::SaveXML (_file, _options);
@@ -72,6 +86,62 @@ void Expression::transform_enter (ssi_stream_t &stream_in,
 	
 	_single = _options.single;
 	_join = _options.join;
+
+	_dim = stream_in.dim;
+	const ssi_char_t *err = _parser->compile (_options.expression, *_program, Resolve, this);
+	if (err) {
+		ssi_err ("%s", err);
+	}
+
+	delete[] _slots;
+	_slots = new const double *[1 + _dim];
+	_num = 0;
+	resize (stream_in.num);
+
+	_kernel = TypeCast::Resolve (SSI_DOUBLE, stream_out.type);
+	if (!_kernel) {
+		ssi_err ("cast to type '%s' not supported", SSI_TYPE_NAMES[stream_out.type]);
+	}
+}
+
+int Expression::Resolve (const char name[], void *param) {
+
+	Expression *me = ssi_pcast (Expression, param);
+
+	if (name[0] != 'd') {
+		return -1;
+	}
+	if (name[1] == '\0') {
+		return 0;
+	}
+
+	for (const char *c = name + 1; *c != '\0'; c++) {
+		if (!isdigit (*c)) {
+			return -1;
+		}
+	}
+
+	int d = atoi (name + 1);
+	if (d >= (int) me->_dim) {
+		ssi_err ("dimension '%s' exceeds stream dimension %u", name, me->_dim);
+	}
+
+	return 1 + d;
+}
+
+void Expression::resize (ssi_size_t num) {
+
+	if (num <= _num) {
+		return;
+	}
+
+	delete[] _columns;
+	delete[] _result;
+	delete[] _output;
+	_num = num;
+	_columns = new double[_num * _dim];
+	_result = new double[_num];
+	_output = new double[_num * _dim];
 }
 
 void Expression::transform (ITransformer::info info,
@@ -80,55 +150,69 @@ void Expression::transform (ITransformer::info info,
 	ssi_size_t xtra_stream_in_num,
 	ssi_stream_t xtra_stream_in[]) {	
 
+	ssi_size_t num = stream_in.num;
+	ssi_size_t dim = stream_in.dim;
+
+	resize (num);
+
+	// split frame into columns
 	ssi_real_t *srcptr = ssi_pcast (ssi_real_t, stream_in.ptr);
-	ssi_real_t *dstptr = ssi_pcast (ssi_real_t, stream_out.ptr);
-	double result;
+	for (ssi_size_t i = 0; i < num; i++) {
+		for (ssi_size_t j = 0; j < dim; j++) {
+			_columns[j * num + i] = *srcptr++;
+		}
+	}
+	for (ssi_size_t j = 0; j < dim; j++) {
+		_slots[1 + j] = _columns + j * num;
+	}
+
+	const ssi_char_t *err = 0;
 
 	if (_single) {
-		for (ssi_size_t i = 0; i < stream_in.num; i++) {
-			insert (_options.expression,_expression, 0, srcptr);
-			const ssi_char_t *err = _parser->parse (_expression, result);
-			if (err) {
-				ssi_err ("%s", err);
-			}
-			ssi_cast2type (1, &result, dstptr++, ssi_type_t (_options.cast));
-			srcptr += stream_in.dim;
+		_slots[0] = _columns;
+		err = _program->eval (num, _slots, _result);
+		if (err) {
+			ssi_err ("%s", err);
 		}
+		_kernel (num, _result, stream_out.ptr, 1.0f);
 	} else {
 		if (_join == JOIN::OFF) {
-			for (ssi_size_t i = 0; i < stream_in.num; i++) {
-				for (ssi_size_t j = 0; j < stream_in.dim; j++) {
-					insert (_options.expression,_expression, j, srcptr);
-					const ssi_char_t *err = _parser->parse (_expression, result);
-					if (err) {
-						ssi_err ("%s", err);
-					}
-					ssi_cast2type(1, &result, dstptr++, ssi_type_t(_options.cast));
+			for (ssi_size_t j = 0; j < dim; j++) {
+				_slots[0] = _columns + j * num;
+				err = _program->eval (num, _slots, _result);
+				if (err) {
+					ssi_err ("%s", err);
+				}
+				for (ssi_size_t i = 0; i < num; i++) {
+					_output[i * dim + j] = _result[i];
 				}
-				srcptr += stream_in.dim;
 			}
+			_kernel (num * dim, _output, stream_out.ptr, 1.0f);
 		} else {
-			double tmp;
-			for (ssi_size_t i = 0; i < stream_in.num; i++) {
-				tmp = _join == JOIN::SUM ? 0.0f : 1.0f;
-				for (ssi_size_t j = 0; j < stream_in.dim; j++) {
-					insert (_options.expression,_expression, j, srcptr);
-					const ssi_char_t *err = _parser->parse (_expression, result);
-					if (err) {
-						ssi_err ("%s", err);
-					}
-					switch (_join) {
-						case JOIN::SUM:
-							tmp += result;
-							break;
-						case JOIN::MULT:
-							tmp *= result;
-							break;
-					}
+			double init = _join == JOIN::SUM ? 0.0 : 1.0;
+			for (ssi_size_t i = 0; i < num; i++) {
+				_output[i] = init;
+			}
+			for (ssi_size_t j = 0; j < dim; j++) {
+				_slots[0] = _columns + j * num;
+				err = _program->eval (num, _slots, _result);
+				if (err) {
+					ssi_err ("%s", err);
+				}
+				switch (_join) {
+					case JOIN::SUM:
+						for (ssi_size_t i = 0; i < num; i++) {
+							_output[i] += _result[i];
+						}
+						break;
+					case JOIN::MULT:
+						for (ssi_size_t i = 0; i < num; i++) {
+							_output[i] *= _result[i];
+						}
+						break;
 				}
-				ssi_cast2type(1, &tmp, dstptr++, ssi_type_t(_options.cast));
-				srcptr += stream_in.dim;
 			}
+			_kernel (num, _output, stream_out.ptr, 1.0f);
 		}
 	}
 }
@@ -140,28 +224,4 @@ void Expression::transform_flush (ssi_stream_t &stream_in,
 }
 
 
-void Expression::insert (ssi_char_t *src, ssi_char_t *dst, ssi_size_t current, ssi_real_t *sample) {
-	
-	while (*src != '\0') {
-		if (*src == 'd') {
-			if (*(src+1) != '\0' && isdigit (*(src+1))) {
-				int d = atoi (src+1);
-				sprintf (dst, "%f", sample[d]);
-				dst = dst + strlen(dst) - 2;
-				while (isdigit (*(src+1))) {
-					src++;
-				}
-			} else {
-				sprintf (dst, "%f", sample[current]);
-				dst = dst + strlen(dst) - 2;
-			}
-		} else {
-			*dst = *src;
-		}
-		src++;
-		dst++;
-	}
-	*dst = '\0';
-}
-
 }
@@ -108,6 +108,8 @@ Functionals::Functionals (const ssi_char_t *file)
 	_peaks(0),
 	_left_val(0),
 	_mid_val(0),
+	_pool (0),
+	_n_tasks (0),
 	_file (0),
 	_delta (2) {
 
@@ -148,6 +150,16 @@ void Functionals::transform_enter (ssi_stream_t &stream_in,
 	_peaks = new ssi_size_t[sample_dimension];
 	_left_val = new ssi_real_t[sample_dimension];
 	_mid_val = new ssi_real_t[sample_dimension];
+
+	_pool = 0;
+	_n_tasks = 1;
+	if (_options.parallel && sample_dimension >= 2 * PARALLEL_MIN_DIM) {
+		_pool = WorkerPool::GetShared ();
+		_n_tasks = sample_dimension / PARALLEL_MIN_DIM;
+		if (_n_tasks > _pool->size ()) {
+			_n_tasks = _pool->size ();
+		}
+	}
 }
 
 void Functionals::transform (ITransformer::info info,
@@ -199,72 +211,16 @@ void Functionals::calc (ssi_size_t sample_dimension,
 	ssi_real_t *srcptr,
 	ssi_real_t *&dstptr) {
 
-	// calculate mean and std
-	// for performance reasons std is calculated by
-	//
-	// std = sqrt (sum (x*x)/n - mean^2))
-	//
-
-	bool first_call = true;
-	for (ssi_size_t i = 0; i < sample_dimension; i++)
-	{
-        _val = *srcptr;
-        srcptr++;
-		_mean_val[i] = _val;
-		_energy_val[i] = _val * _val;
-		_min_val[i] = _val;
-		_max_val[i] = _val;
-		_min_pos[i] = 0;
-		_max_pos[i] = 0;
-		_zeros[i] = 0;
-		_peaks[i] = 0;
-		_mid_val[i] = _val;
-	}
-	for (ssi_size_t i = 1; i < sample_number; i++)
+	if (_pool && _n_tasks > 1)
 	{
-		for (ssi_size_t j = 0; j < sample_dimension; j++)
-		{
-            _val = *srcptr;
-            srcptr++;
-			_mean_val[j] += _val;
-			_energy_val[j] += _val * _val;
-			if (_val < _min_val[j])
-			{
-				_min_val[j] = _val;
-				_min_pos[j] = i;
-			}
-			else if (_val > _max_val[j])
-			{
-				_max_val[j] = _val;
-				_max_pos[j] = i;
-			}
-			if ((i % _delta) == 0)
-			{
-				if (first_call)
-				{
-					first_call = false;
-				}
-				else
-				{
-					if ((_left_val[j] > 0 && _mid_val[j] < 0) || (_left_val[j] < 0 && _mid_val[j] > 0) )
-					{
-						_zeros[j]++;
-					}
-					if (_left_val[j] < _mid_val[j]  &&  _mid_val[j] > _val)
-					{
-						_peaks[j]++;
-					}
-				}
-				_left_val[j] = _mid_val[j];
-				_mid_val[j] = _val;
-			}
-		}
+		_task_dim = sample_dimension;
+		_task_num = sample_number;
+		_task_src = srcptr;
+		_pool->run (_n_tasks, CalcTask, this);
 	}
-	for (ssi_size_t i = 0; i < sample_dimension; i++)
+	else
 	{
-		_mean_val[i] /= sample_number;
-		_energy_val[i] /= sample_number;
-		_std_val[i] = sqrt (abs (_energy_val[i] - _mean_val[i] * _mean_val[i]));
+		calc_range (0, sample_dimension, sample_dimension, sample_number, srcptr);
 	}
 
 	if (MEAN & _format)
@@ -357,6 +313,89 @@ void Functionals::calc (ssi_size_t sample_dimension,
 
 }
 
+void Functionals::CalcTask (ssi_size_t index, void *arg) {
+
+	Functionals *me = ssi_pcast (Functionals, arg);
+
+	ssi_size_t from = (index * me->_task_dim) / me->_n_tasks;
+	ssi_size_t to = ((index + 1) * me->_task_dim) / me->_n_tasks;
+
+	me->calc_range (from, to, me->_task_dim, me->_task_num, me->_task_src);
+}
+
+void Functionals::calc_range (ssi_size_t from,
+	ssi_size_t to,
+	ssi_size_t sample_dimension,
+	ssi_size_t sample_number,
+	ssi_real_t *srcptr) {
+
+	// calculate mean and std
+	// for performance reasons std is calculated by
+	//
+	// std = sqrt (sum (x*x)/n - mean^2))
+	//
+
+	ssi_real_t val;
+	ssi_real_t *ptr = srcptr;
+
+	for (ssi_size_t j = from; j < to; j++)
+	{
+		val = ptr[j];
+		_mean_val[j] = val;
+		_energy_val[j] = val * val;
+		_min_val[j] = val;
+		_max_val[j] = val;
+		_min_pos[j] = 0;
+		_max_pos[j] = 0;
+		_zeros[j] = 0;
+		_peaks[j] = 0;
+		_mid_val[j] = val;
+	}
+	for (ssi_size_t i = 1; i < sample_number; i++)
+	{
+		ptr += sample_dimension;
+		for (ssi_size_t j = from; j < to; j++)
+		{
+			val = ptr[j];
+			_mean_val[j] += val;
+			_energy_val[j] += val * val;
+			if (val < _min_val[j])
+			{
+				_min_val[j] = val;
+				_min_pos[j] = i;
+			}
+			else if (val > _max_val[j])
+			{
+				_max_val[j] = val;
+				_max_pos[j] = i;
+			}
+			if ((i % _delta) == 0)
+			{
+				// left value is not yet available at the first offset
+				if (i != _delta)
+				{
+					if ((_left_val[j] > 0 && _mid_val[j] < 0) || (_left_val[j] < 0 && _mid_val[j] > 0) )
+					{
+						_zeros[j]++;
+					}
+					if (_left_val[j] < _mid_val[j]  &&  _mid_val[j] > val)
+					{
+						_peaks[j]++;
+					}
+				}
+				_left_val[j] = _mid_val[j];
+				_mid_val[j] = val;
+			}
+		}
+	}
+	for (ssi_size_t j = from; j < to; j++)
+	{
+		_mean_val[j] /= sample_number;
+		_energy_val[j] /= sample_number;
+		_std_val[j] = sqrt (abs (_energy_val[j] - _mean_val[j] * _mean_val[j]));
+	}
+}
+
 const ssi_char_t *Functionals::getName (ssi_size_t index) {
 
 	ssi_bitmask_t format = Names2Format (_options.names);
@@ -0,0 +1,98 @@
+// Resample.cpp
+// created: 2026/10/19
+// Copyright (C) University of Augsburg, Lab for Human Centered Multimedia
+//
+// *************************************************************************************************
+//
+// This file is part of Social Signal Interpretation (SSI) developed at the 
+// Lab for Human Centered Multimedia of the University of Augsburg
+//
+// This library is free software; you can redistribute itand/or
+// modify it under the terms of the GNU General Public
+// License as published by the Free Software Foundation; either
+// version 3 of the License, or any laterversion.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FORA PARTICULAR PURPOSE.  See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public
+// License along withthis library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+//
+//*************************************************************************************************
+
+#include "Resample.h"
+
+#ifdef USE_SSI_LEAK_DETECTOR
+	#include "SSI_LeakWatcher.h"
+	#ifdef _DEBUG
+		#define new DEBUG_NEW
+		#undef THIS_FILE
+		static char THIS_FILE[] = __FILE__;
+	#endif
+#endif
+
+namespace ssi {
+
+char Resample::ssi_log_name[] = "resample__";
+
+Resample::Resample (const ssi_char_t *file)
+	: _file (0) {
+
+	if (file) {
+		if (!OptionList::LoadXML (file, _options)) {
+			OptionList::SaveXML (file, _options);
+		}
+		_file = ssi_strcpy (file);
+	}
+}
+
+Resample::~Resample () {
+
+	if (_file) {
+		OptionList::SaveXML (_file, _options);
+		delete[] _file;
+	}
+}
+
+void Resample::transform_enter (ssi_stream_t &stream_in,
+	ssi_stream_t &stream_out,
+	ssi_size_t xtra_stream_in_num,
+	ssi_stream_t xtra_stream_in[]) {
+
+	if (_options.up == 0) {
+		_options.up = 1;
+	}
+	if (_options.down == 0) {
+		_options.down = 1;
+	}
+
+	_resampler.init (stream_in.dim, _options.up, _options.down, _options.taps);
+}
+
+void Resample::transform (ITransformer::info info,
+	ssi_stream_t &stream_in,
+	ssi_stream_t &stream_out,
+	ssi_size_t xtra_stream_in_num,
+	ssi_stream_t xtra_stream_in[]) {
+
+	if ((ssi_cast (uint64_t, info.frame_num) * _options.up) % _options.down != 0) {
+		ssi_err ("frame size (%u) * up (%u) is not a multiple of down (%u)", info.frame_num, _options.up, _options.down);
+	}
+
+	// delta samples are seen again in the next frame, so only the frame itself is filtered
+	_resampler.push (info.frame_num, ssi_pcast (ssi_real_t, stream_in.ptr));
+	_resampler.pull (stream_out.num, ssi_pcast (ssi_real_t, stream_out.ptr));
+}
+
+void Resample::transform_flush (ssi_stream_t &stream_in,
+	ssi_stream_t &stream_out,
+	ssi_size_t xtra_stream_in_num,
+	ssi_stream_t xtra_stream_in[]) {
+
+	_resampler.release ();
+}
+
+}
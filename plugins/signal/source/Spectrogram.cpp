@@ -27,6 +27,7 @@
 #include "Spectrogram.h"
 #include "FilterTools.h"
 #include "signal/MatrixOps.h"
+#include "signal/SpectrumCache.h"
 #include "FFT.h"
 #include <string>
 
@@ -52,6 +53,9 @@ Spectrogram::Spectrogram (const ssi_char_t *file)
 	_window (0),
 	_filterbank (0),
 	_apply_log (false),
+	_cache_key (SpectrumCache::INVALID_KEY),
+	_frame_size (0),
+	_frame (0),
 	_file (0) {
 
 	if (file) {
@@ -72,6 +76,9 @@ Spectrogram::~Spectrogram () {
 	delete _fft;
 	delete _fftmag;
 	delete _filterbank;
+	delete[] _frame;
+
+	detachCache ();
 }
 
 void Spectrogram::readFilterbank (const ssi_char_t *file, ssi_time_t sr, bool fromFile) {
@@ -171,6 +178,16 @@ void Spectrogram::setFilterbank (const Matrix<ssi_real_t> *filterbank,
 
 	_fft = new FFT (_fft_size, 1);
 	_fftmag = new Matrix<ssi_real_t> (1, _fft->rfft);
+
+	detachCache ();
+}
+
+void Spectrogram::detachCache () {
+
+	if (_cache_key != SpectrumCache::INVALID_KEY) {
+		SpectrumCache::GetShared ()->detach (_cache_key);
+		_cache_key = SpectrumCache::INVALID_KEY;
+	}
 }
 
 void Spectrogram::transform_enter (ssi_stream_t &stream_in,
@@ -238,11 +255,37 @@ void Spectrogram::transform (Matrix<ssi_real_t> *matrix_in,
 		}
 	}
 
-	if (_win_type != WINDOW_TYPE_RECTANGLE) {
-		MatrixOps<ssi_real_t>::Mult (matrix_in, _window);
+	SpectrumCache *cache = SpectrumCache::GetShared ();
+	if (_cache_key == SpectrumCache::INVALID_KEY && _options.cache) {
+		ssi_char_t config[SSI_MAX_CHAR];
+		ssi_sprint (config, "Spectrogram fft=%d window=%d", _fft_size, ssi_cast (int, _win_type));
+		_cache_key = cache->attach (config);
 	}
 
-	_fft->transform (matrix_in, _fftmag);
+	// only single channel frames are shared, and only if another component uses the same fft and window
+	bool shared = matrix_in->cols == 1 && cache->isShared (_cache_key);
+	if (!shared || !cache->get (_cache_key, matrix_in->rows, matrix_in->data, _fftmag->cols, _fftmag->data)) {
+
+		// keep frame before the window is applied
+		if (shared) {
+			if (_frame_size < ssi_cast (ssi_size_t, matrix_in->rows)) {
+				delete[] _frame;
+				_frame_size = matrix_in->rows;
+				_frame = new ssi_real_t[_frame_size];
+			}
+			memcpy (_frame, matrix_in->data, matrix_in->rows * sizeof (ssi_real_t));
+		}
+
+		if (_win_type != WINDOW_TYPE_RECTANGLE) {
+			MatrixOps<ssi_real_t>::Mult (matrix_in, _window);
+		}
+
+		_fft->transform (matrix_in, _fftmag);
+
+		if (shared) {
+			cache->put (_cache_key, matrix_in->rows, _frame, _fftmag->cols, _fftmag->data);
+		}
+	}
 	
 	MatrixOps<ssi_real_t>::MultM (_fftmag, _filterbank, matrix_out);
 
@@ -57,6 +57,7 @@ bool ex_integral(void *args);
 bool ex_remove_trend(void *args);
 bool ex_functionals(void *args);
 bool ex_downsample(void *args);
+bool ex_resample(void *args);
 bool ex_chain(void *args);
 bool ex_moving(void *args);
 bool ex_movingminmax(void *args);
@@ -107,6 +108,7 @@ int main() {
 	ex.add(ex_mfcc, 0, "MFCC", "");
 	ex.add(ex_functionals, 0, "FUNCTIONALS", "");
 	ex.add(ex_downsample, 0, "DOWNSAMPLE", "");
+	ex.add(ex_resample, 0, "RESAMPLE", "");
 	ex.add(ex_selector, 0, "SELECTOR", "");
 	ex.add(ex_chain, 0, "CHAIN", "");
 	ex.add(ex_moving, 0, "MOVING", "");
@@ -940,6 +942,41 @@ bool ex_downsample(void *args) {
 	return true;
 }
 
+bool ex_resample(void *args) {
+
+	ssi_print ("Resample Example ...\n");
+
+	ssi_stream_t signal;
+	ssi_stream_t down, up;
+	load (signal, "rsp");
+
+	// frame size * up has to be a multiple of down
+	ssi_size_t factor = 10;
+	ssi_size_t frame_size = factor * ssi_cast (ssi_size_t, 0.005 * signal.sr + 0.5);
+	ssi_size_t delta_size = 0;
+
+	Resample *resample = ssi_create (Resample, "resample", true);
+	resample->getOptions()->up = 1;
+	resample->getOptions()->down = factor;
+	transform (signal, down, *resample, frame_size, delta_size);
+
+	resample->getOptions()->up = factor;
+	resample->getOptions()->down = 1;
+	transform (down, up, *resample, frame_size / factor, delta_size);
+
+	plot_push (signal, "Signal");
+	plot_push (down, "Resampled (1/10)");
+	plot_push (up, "Resampled (10/1)");
+
+	plot();
+
+	ssi_stream_destroy (signal);
+	ssi_stream_destroy (down);
+	ssi_stream_destroy (up);
+
+	return true;
+}
+
 bool ex_selector(void *args) {
 
 	ssi_print ("Signal Example ...\n");
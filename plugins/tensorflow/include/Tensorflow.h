@@ -90,9 +90,16 @@ public:
 	public:
 
 		Options () 
-			: console(false), merge(false), winner(false), pthres(0) {
+			: console(false), merge(false), winner(false), pthres(0), intra(0), inter(0), batch(1) {
 
 			setAddress("");
+#if __ANDROID__
+			setGraph("/sdcard/android_xmlpipe/frozen_graph.pb");
+#else
+			setGraph("frozen_graph.pb");
+#endif
+			ssi_strcpy(input, "input_TT");
+			ssi_strcpy(output, "output_TT");
 
 			trainer[0] = '\0';
 			ename[0] = '\0';
@@ -109,11 +116,20 @@ public:
 			addOption ("console", &console, 1, SSI_BOOL, "output classification to console");			
 			addOption ("winner", &winner, 1, SSI_BOOL, "send winning class only");		
 			addOption ("select", select, SSI_MAX_CHAR, SSI_CHAR, "foward only specific classes (indices separated by ',') [ignored if winner=true]");
+			addOption ("graph", graph, SSI_MAX_CHAR, SSI_CHAR, "filepath of frozen graph (text format)");
+			addOption ("input", input, SSI_MAX_CHAR, SSI_CHAR, "name of input node");
+			addOption ("output", output, SSI_MAX_CHAR, SSI_CHAR, "name of output node");
+			addOption ("intra", &intra, 1, SSI_INT, "number of intra-op threads (0=tensorflow default)");
+			addOption ("inter", &inter, 1, SSI_INT, "number of inter-op threads (0=tensorflow default)");
+			addOption ("batch", &batch, 1, SSI_SIZE, "number of consecutive frames that are evaluated in a single session call");
 		};
 
 		void setTrainer (const ssi_char_t *filepath) {
 			ssi_strcpy (trainer, filepath);
 		}
+		void setGraph (const ssi_char_t *filepath) {
+			ssi_strcpy (graph, filepath);
+		}
 		void setAddress(const ssi_char_t *address) {
 			if (address) {
 				ssi_strcpy(this->address, address);
@@ -135,6 +151,12 @@ public:
 		ssi_char_t address[SSI_MAX_CHAR];
 		ssi_char_t ename[SSI_MAX_CHAR];
 		ssi_char_t sname[SSI_MAX_CHAR];
+		ssi_char_t graph[SSI_MAX_CHAR];
+		ssi_char_t input[SSI_MAX_CHAR];
+		ssi_char_t output[SSI_MAX_CHAR];
+		int intra;
+		int inter;
+		ssi_size_t batch;
 	};
 
 public:
@@ -184,6 +206,9 @@ template<typename Out>
 void split(const std::string &s, char delim, Out result);
 	std::vector<std::vector<float>> load_input_data(std::string file_name);
 	int callTensorflow();
+	bool createSession();
+	void releaseSession();
+	void runBatch();
 
 protected:
 
@@ -228,6 +253,12 @@ protected:
 	ssi_char_t *const *getClassNames () { return _class_names; };
 	ssi_char_t **_class_names;
 
+	tensorflow::Session *_session;
+	tensorflow::Tensor *_input_tensor;
+	ssi_size_t _batch_count;
+	ssi_time_t *_batch_time;
+	ssi_time_t *_batch_dur;
+
 };
 
 }
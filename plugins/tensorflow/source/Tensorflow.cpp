@@ -59,6 +59,12 @@ namespace ssi {
               _n_metas(0),
               _metas(0),
               _del_trainer(false),
+              _class_names(0),
+              _session(0),
+              _input_tensor(0),
+              _batch_count(0),
+              _batch_time(0),
+              _batch_dur(0),
               ssi_log_level(SSI_LOG_LEVEL_DEFAULT) {
 
         if (file) {
@@ -77,6 +83,7 @@ namespace ssi {
             delete[] _file;
         }
         releaseTrainer();
+        releaseSession();
     }
 
     void Tensorflow::setTrainer(Trainer *trainer) {
@@ -137,6 +144,84 @@ namespace ssi {
         _class_names[1] = ssi_strcpy("Rain");
         _class_names[2] = ssi_strcpy("Running_Water");
         _class_names[3] = ssi_strcpy("Traffic");
+
+        if (stream_in[0].type != SSI_FLOAT) {
+            ssi_wrn("unsupported stream type '%s'", SSI_TYPE_NAMES[stream_in[0].type]);
+            return;
+        }
+
+        _consumer_num = stream_in[0].num;
+        _consumer_dim = stream_in[0].dim;
+        _consumer_sr = stream_in[0].sr;
+        _consumer_byte = stream_in[0].byte;
+
+        createSession();
+    }
+
+    bool Tensorflow::createSession() {
+
+        releaseSession();
+
+        tensorflow::SessionOptions options;
+        if (_options.intra > 0) {
+            options.config.set_intra_op_parallelism_threads(_options.intra);
+        }
+        if (_options.inter > 0) {
+            options.config.set_inter_op_parallelism_threads(_options.inter);
+        }
+
+        tensorflow::Status status = tensorflow::NewSession(options, &_session);
+        if (!status.ok()) {
+            ssi_wrn("status: %s \n", status.ToString().c_str());
+            _session = 0;
+            return false;
+        }
+
+        tensorflow::GraphDef graph_def;
+        status = ReadTextProto(tensorflow::Env::Default(), _options.graph, &graph_def);
+        if (!status.ok()) {
+            ssi_wrn("could not read graph '%s' (%s)", _options.graph, status.ToString().c_str());
+            releaseSession();
+            return false;
+        }
+
+        status = _session->Create(graph_def);
+        if (!status.ok()) {
+            ssi_wrn("status: %s \n", status.ToString().c_str());
+            releaseSession();
+            return false;
+        }
+
+        // input tensor holds 'batch' consecutive frames and is filled in place
+
+        ssi_size_t batch = _options.batch > 0 ? _options.batch : 1;
+        _input_tensor = new tensorflow::Tensor(tensorflow::DT_FLOAT,
+                                               tensorflow::TensorShape({(tensorflow::int64) (batch * _consumer_num),
+                                                                        (tensorflow::int64) _consumer_dim}));
+        _batch_time = new ssi_time_t[batch];
+        _batch_dur = new ssi_time_t[batch];
+        _batch_count = 0;
+
+        ssi_msg(SSI_LOG_LEVEL_BASIC, "loaded graph '%s' (batch=%u)", _options.graph, batch);
+
+        return true;
+    }
+
+    void Tensorflow::releaseSession() {
+
+        if (_session) {
+            _session->Close();
+            delete _session;
+            _session = 0;
+        }
+
+        delete _input_tensor;
+        _input_tensor = 0;
+        delete[] _batch_time;
+        _batch_time = 0;
+        delete[] _batch_dur;
+        _batch_dur = 0;
+        _batch_count = 0;
     }
 
     bool Tensorflow::callTrainer(ssi_time_t time,
@@ -151,91 +236,101 @@ namespace ssi {
                              ssi_size_t stream_in_num,
                              ssi_stream_t stream_in[]) {
 
-        ssi_real_t *dataptr = ssi_pcast(ssi_real_t, stream_in[0].ptr);
+        if (!_session) {
+            return;
+        }
 
-        tensorflow::Session *session;
-        tensorflow::Status status = NewSession(tensorflow::SessionOptions(), &session);
-        if (!status.ok()) {
-            ssi_wrn("status: %s \n", status.ToString().c_str());
+        if (stream_in[0].num != _consumer_num || stream_in[0].dim != _consumer_dim) {
+            ssi_wrn("frame size changed (%u x %u != %u x %u)", stream_in[0].num, stream_in[0].dim, _consumer_num, _consumer_dim);
             return;
         }
 
-        tensorflow::GraphDef graph_def;
+        ssi_size_t n_values = _consumer_num * _consumer_dim;
+        float *dst = _input_tensor->flat<float>().data() + _batch_count * n_values;
+        memcpy(dst, stream_in[0].ptr, n_values * sizeof(float));
 
-#if __ANDROID__
-        status = ReadTextProto(tensorflow::Env::Default(), "/sdcard/android_xmlpipe/frozen_graph.pb", &graph_def);
-#else
-        status = ReadTextProto(tensorflow::Env::Default(),
-                               "/home/mainuser/code/SSI/mobileSSI/plugins/tensorflow/test_files/frozen_graph.pb",
-                               &graph_def);
-#endif
+        _batch_time[_batch_count] = consume_info.time;
+        _batch_dur[_batch_count] = consume_info.dur;
+        _batch_count++;
 
-        if (!status.ok()) {
-            ssi_wrn("status: %s \n", status.ToString().c_str());
-            return;
+        if (_batch_count >= (_options.batch > 0 ? _options.batch : 1)) {
+            runBatch();
         }
+    }
 
-        status = session->Create(graph_def);
-        if (!status.ok()) {
-            ssi_wrn("status: %s \n", status.ToString().c_str());
+    void Tensorflow::runBatch() {
+
+        if (_batch_count == 0) {
             return;
         }
 
-        int number_dim = stream_in[0].dim;
-        int number_test = stream_in[0].num; // 4072
-        int number_classes = 4;
+        int number_test = _consumer_num;
+        int number_classes = _n_classes;
+        int number_rows = _batch_count * number_test;
 
-        tensorflow::Tensor input_tensor(tensorflow::DT_FLOAT, tensorflow::TensorShape({number_test, number_dim}));
-        auto dst = input_tensor.flat<float>().data();
-        for (int i = 0; i < stream_in[0].num; i++) {
-            std::copy_n(dataptr + i * number_dim, number_dim, dst);
-            dst += number_dim;
-        }
+        // a partial batch shares the buffer of the preallocated tensor
+        tensorflow::Tensor input_tensor = number_rows == _input_tensor->dim_size(0)
+                                          ? *_input_tensor
+                                          : _input_tensor->Slice(0, number_rows);
 
-        std::vector<std::pair<std::string, tensorflow::Tensor>> inputs = {{"input_TT", input_tensor}};
+        std::vector<std::pair<std::string, tensorflow::Tensor>> inputs = {{_options.input, input_tensor}};
         std::vector<tensorflow::Tensor> outputs;
-        status = session->Run(inputs, {"output_TT"}, {}, &outputs);
+        tensorflow::Status status = _session->Run(inputs, {_options.output}, {}, &outputs);
+        ssi_size_t n_frames = _batch_count;
+        _batch_count = 0;
         if (!status.ok()) {
             ssi_wrn("status: %s \n", status.ToString().c_str());
             return;
         }
 
-        std::vector<int> number_hits(number_classes, 0);
         for (std::vector<tensorflow::Tensor>::iterator it = outputs.begin(); it != outputs.end(); ++it) {
-            auto items = it->shaped<float, 2>({number_test, number_classes});
-            for (int i = 0; i < number_test; i++) {
-                int arg_max = 0;
-                float val_max = items(i, 0);
-                for (int j = 0; j < number_classes; j++) {
-                    if (items(i, j) > val_max) {
-                        arg_max = j;
-                        val_max = items(i, j);
+            auto items = it->shaped<float, 2>({number_rows, number_classes});
+            for (ssi_size_t n_frame = 0; n_frame < n_frames; n_frame++) {
+
+                std::vector<int> number_hits(number_classes, 0);
+                for (int i = n_frame * number_test; i < (int) (n_frame + 1) * number_test; i++) {
+                    int arg_max = 0;
+                    float val_max = items(i, 0);
+                    for (int j = 0; j < number_classes; j++) {
+                        if (items(i, j) > val_max) {
+                            arg_max = j;
+                            val_max = items(i, j);
+                        }
                     }
+                    number_hits[arg_max]++;
                 }
+
                 for (int i = 0; i < number_classes; i++) {
-                    if (arg_max == i) {
-                        number_hits[i]++;
-                    }
+                    float accuracy = (float) number_hits[i] / number_test;
+                    ssi_msg(SSI_LOG_LEVEL_DEBUG, "accuracy for class %s : %f", _class_names[i], accuracy);
+                    _probs[i] = accuracy;
                 }
-            }
-        }
 
-        std::string classes[] = {"ambient_animals", "rain", "running_water", "traffic"};
-        for (int i = 0; i < number_classes; i++) {
-            float accuracy = (float) number_hits[i] / number_test;
-            ssi_wrn("accuracy for class %s : %f \n", classes[i].c_str(), accuracy);
-            _probs[i] = accuracy;
+                if (_handler) {
+                    _handler->handle(_batch_time[n_frame], _batch_dur[n_frame], _n_classes, 0, _probs, _class_names, 0, 0);
+                }
+            }
         }
-        session->Close();
-
-        _handler->handle(consume_info.time, consume_info.dur, 4, 0, _probs, _class_names, 0, 0);
     }
 
     void Tensorflow::consume_flush(ssi_size_t stream_in_num,
                                    ssi_stream_t stream_in[]) {
 
-        delete _probs;
+        if (_session) {
+            runBatch();
+        }
+        releaseSession();
 
+        delete[] _probs;
+        _probs = 0;
+
+        if (_class_names) {
+            for (ssi_size_t i = 0; i < _n_classes; i++) {
+                delete[] _class_names[i];
+            }
+            delete[] _class_names;
+            _class_names = 0;
+        }
     }
 
     void Tensorflow::listen_enter() {
@@ -76,6 +76,9 @@ public:
 	bool decay();
 	
 	void print();
+
+	// decay factor relative to the norm of the vector (baseline subtracted)
+	static ssi_real_t DecayFactor(EVector::DECAY_TYPE type, ssi_real_t norm, ssi_size_t lifetime, ssi_real_t speed, ssi_real_t gradient);
 	
 protected:
 
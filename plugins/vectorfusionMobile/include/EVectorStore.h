@@ -0,0 +1,124 @@
+// EVectorStore.h
+// created: 2026/10/19
+// Copyright (C) University of Augsburg, Lab for Human Centered Multimedia
+//
+// *************************************************************************************************
+//
+// This file is part of Social Signal Interpretation (SSI) developed at the
+// Lab for Human Centered Multimedia of the University of Augsburg
+//
+// This library is free software; you can redistribute itand/or
+// modify it under the terms of the GNU General Public
+// License as published by the Free Software Foundation; either
+// version 3 of the License, or any laterversion.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FORA PARTICULAR PURPOSE.  See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public
+// License along withthis library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+//
+//*************************************************************************************************
+
+#pragma once
+
+#ifndef SSI_EVECTORSTORE_H
+#define SSI_EVECTORSTORE_H
+
+#include "SSI_Cons.h"
+#include "EVector.h"
+
+namespace ssi {
+
+//! \brief Event vectors of a fusion stored as structure of arrays.
+//
+// Values are kept dimension by dimension, i.e. row d holds dimension d of all
+// vectors, so decay and mass center run over contiguous memory and are done
+// with SSE2 or NEON kernels if available. Slots are allocated once and
+// reused, vectors that no longer contribute are removed by compact(), which
+// keeps the order of the remaining vectors.
+//
+class EVectorStore {
+
+public:
+
+	EVectorStore ();
+	virtual ~EVectorStore ();
+
+	void init (ssi_size_t dim);
+	void release ();
+	void clear ();
+
+	ssi_size_t size () { return _n; };
+	ssi_size_t getDim () { return _dim; };
+
+	// adds a vector and returns its index
+	ssi_size_t add (ssi_real_t weight, ssi_real_t speed, EVector::DECAY_TYPE type, ssi_real_t gradient, ssi_size_t time, bool decay_weight, const ssi_event_map_t *tuples);
+
+	// decays all vectors towards the baseline, see EVector::update()
+	void update (ssi_size_t framework_time, const ssi_real_t *baseline);
+
+	// selects vectors with a weight above threshold, returns number of selected vectors
+	ssi_size_t selectByWeight (ssi_real_t threshold, ssi_real_t &sum_of_weights);
+	// selects vectors that leave baseline +/- threshold in at least one dimension
+	ssi_size_t selectByDistance (const ssi_real_t *baseline, ssi_real_t threshold, ssi_real_t &sum_of_weights);
+	// weighted sum of selected (decayed) values for each dimension
+	void accumulate (bool decayed, ssi_real_t *sum);
+	// removes vectors that are not selected
+	void compact ();
+
+	const ssi_real_t *getRow (ssi_size_t dim) { return _value + dim * _capacity; };
+	const ssi_real_t *getRowDecay (ssi_size_t dim) { return _value_decay + dim * _capacity; };
+	void getValue (ssi_size_t index, ssi_real_t *value);
+	void getValueDecay (ssi_size_t index, ssi_real_t *value);
+
+	ssi_real_t getWeight (ssi_size_t index) { return _weight[index]; };
+	ssi_real_t getSpeed (ssi_size_t index) { return _speed[index]; };
+	ssi_real_t getGradient (ssi_size_t index) { return _gradient[index]; };
+	EVector::DECAY_TYPE getType (ssi_size_t index) { return _type[index]; };
+	ssi_size_t getTime (ssi_size_t index) { return _time[index]; };
+	bool getDoesDecayWeight (ssi_size_t index) { return _decay_weight[index]; };
+
+	void print (ssi_size_t index);
+
+protected:
+
+	// number of slots allocated first, grows by doubling
+	static const ssi_size_t BLOCK = 16;
+
+	struct kernels_t;
+	static const kernels_t *Resolve ();
+
+	void grow ();
+
+	const kernels_t *_kernels;
+
+	ssi_size_t _dim;
+	ssi_size_t _n;
+	ssi_size_t _capacity;
+
+	// _dim rows with _capacity entries
+	ssi_real_t *_value;
+	ssi_real_t *_value_decay;
+
+	ssi_real_t *_starting_weight;
+	ssi_real_t *_weight;
+	ssi_real_t *_speed;
+	ssi_real_t *_gradient;
+	EVector::DECAY_TYPE *_type;
+	ssi_size_t *_time;
+	ssi_size_t *_lifetime;
+	bool *_decay_weight;
+
+	// scratch, one entry per slot
+	ssi_real_t *_factor;
+	ssi_real_t *_selected_weight;
+	uint32_t *_selected;
+};
+
+}
+
+#endif
@@ -33,6 +33,7 @@
 #include "thread/Thread.h"
 #include "thread/Lock.h"
 #include "EVector.h"
+#include "EVectorStore.h"
 
 #include <deque>
 
@@ -51,13 +52,13 @@ public:
 	void close();
 
 	void paint(ssi_handle_t hdc, ssi_rect_t rect);
-	void setData (ssi_size_t Dimension, ssi_real_t *Baseline, ssi_real_t Threshold, std::deque<EVector*> &VectorList, ssi_real_t* FusionPoint, EVector* FusionVector, bool DecayingVectors, bool PaintEvents);
+	void setData (ssi_size_t Dimension, ssi_real_t *Baseline, ssi_real_t Threshold, EVectorStore &VectorStore, ssi_real_t* FusionPoint, EVector* FusionVector, bool DecayingVectors, bool PaintEvents);
 
 	void initAxisCaption(ssi_size_t dim);
 	void setAxisCaption(ssi_size_t dim, ssi_char_t* caption);
 	void setWindowCaption (ssi_char_t *caption);
 
-	void update_evectors(std::deque<EVector*> &VectorList);
+	void update_evectors(EVectorStore &VectorStore);
 	void update_fpoint(ssi_real_t *FusionPoint);
 	void update_fvector(EVector *FusionVector);
 	void update_baseline(ssi_real_t *Baseline);
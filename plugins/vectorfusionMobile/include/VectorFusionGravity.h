@@ -34,6 +34,7 @@
 #include "event/EventAddress.h"
 #include "base/ITheEventBoard.h"
 #include "EVector.h"
+#include "EVectorStore.h"
 #include "VectorFusionDefines.h"
 #if _WIN32||_WIN64
 #include "FusionPainter.h"
@@ -42,7 +43,6 @@
 #endif
 #include "thread/Thread.h"
 #include "thread/Lock.h"
-#include <deque>
 #include <iostream>
 #include <fstream>
 #include <map>
@@ -167,7 +167,7 @@ public:
 
 	bool notify(INotify::COMMAND::List command, const ssi_char_t *message);
 
-	std::deque<EVector*> VectorList;
+	EVectorStore VectorStore;
 	
 	bool transformEventToVector(ssi_event_t *Event);
 	bool combineVectors(ssi_real_t fusion_speed, ssi_real_t delta_t, ssi_real_t threshold);
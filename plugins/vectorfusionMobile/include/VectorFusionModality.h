@@ -34,6 +34,7 @@
 #include "event/EventAddress.h"
 #include "base/ITheEventBoard.h"
 #include "EVector.h"
+#include "EVectorStore.h"
 #if _WIN32||_WIN64
 #include "FusionPainter.h"
 #else
@@ -41,7 +42,6 @@
 #endif
 #include "thread/Thread.h"
 #include "thread/Lock.h"
-#include <deque>
 #include <iostream>
 #include <fstream>
 #include <map>
@@ -164,7 +164,7 @@ public:
 
 	bool notify(INotify::COMMAND::List command, const ssi_char_t *message);
 
-	std::deque<EVector*> VectorList;
+	EVectorStore VectorStore;
 	
 	bool transformEventToVector(ssi_event_t *Event);
 	bool combineVectors(ssi_real_t fusion_speed, ssi_real_t delta_t, ssi_real_t threshold);
@@ -192,31 +192,49 @@ bool EVector::norm_values(){
 
 bool EVector::decay(){
 
-	ssi_real_t param = _gradient;
+	ssi_real_t decay_factor = DecayFactor(_type, _norm, _lifetime, _speed, _gradient);
+
+	for(ssi_size_t i = 0; i < _dim; i++){
+		_value_decay[i] = _value[i] * decay_factor /*+ baseline[i]*/;
+	}
+
+	if(_decay_weight){
+		_current_weight = _starting_weight * decay_factor;
+	}else{
+		_current_weight = _starting_weight;
+	}
+
+	/*ssi_print("\n\nDEBUG::\t_starting_weight\t%.2f\nDEBUG::\t_current_weight\t\t%.2f", _starting_weight, _current_weight);*/
+	return true;
+}
+
+ssi_real_t EVector::DecayFactor(EVector::DECAY_TYPE type, ssi_real_t norm, ssi_size_t lifetime, ssi_real_t speed, ssi_real_t gradient){
+
+	ssi_real_t param = gradient;
 
 	ssi_real_t ground = 0.0f;
 	ssi_real_t tmp = 0.0f;
 
 	ssi_real_t decay_factor = 0.0f;
 
-    ssi_real_t dt = ssi_cast(ssi_real_t, _lifetime)/1000;
-	ssi_real_t dur = 1.0f/_speed;
-	ssi_real_t fac = abs (_norm - ground);
+    ssi_real_t dt = ssi_cast(ssi_real_t, lifetime)/1000;
+	ssi_real_t dur = 1.0f/speed;
+	ssi_real_t fac = abs (norm - ground);
 	ssi_real_t lambda = (10.0f * param) / (fac * dur);
 	
 
 	//decay value berechnen aus _value, DECAY_TYPE und _lifetime
-	switch (_type){
+	switch (type){
 		case DECAY_TYPE_LIN:
-			if(_norm > ground){
-				tmp = _norm - dt * 1.0f/dur;
+			if(norm > ground){
+				tmp = norm - dt * 1.0f/dur;
 				if(tmp < ground){
 					decay_factor = ground;
 				}else{
 					decay_factor = tmp;
 				}
 			}else{
-				tmp = _norm + dt * 1.0f/dur;
+				tmp = norm + dt * 1.0f/dur;
 				if(tmp > ground){
 					decay_factor = ground;
 				}else{
@@ -225,23 +243,23 @@ bool EVector::decay(){
 			}
 			break;
 		case DECAY_TYPE_EXP:
-			decay_factor = _norm * pow(2.71828183f, -lambda * dt);
+			decay_factor = norm * pow(2.71828183f, -lambda * dt);
 			break;
 		case DECAY_TYPE_HYP:
 			dur = 0.5f * fac * dur;
-			decay_factor = ground + ((_norm - ground) / 2.0f) * (1.0f - tanh(lambda * (dt - dur)));
+			decay_factor = ground + ((norm - ground) / 2.0f) * (1.0f - tanh(lambda * (dt - dur)));
 			break;
 		default:
 			//DECAY_TYPE_LIN
-			if(_norm > ground){
-				tmp = _norm - dt * 1.0f/dur;
+			if(norm > ground){
+				tmp = norm - dt * 1.0f/dur;
 				if(tmp < ground){
 					decay_factor = ground;
 				}else{
 					decay_factor = tmp;
 				}
 			}else{
-				tmp = _norm + dt * 1.0f/dur;
+				tmp = norm + dt * 1.0f/dur;
 				if(tmp > ground){
 					decay_factor = ground;
 				}else{
@@ -251,24 +269,13 @@ bool EVector::decay(){
 			break;
 	}
 
-	if(_norm != 0.0f){
-		decay_factor = decay_factor / _norm;
+	if(norm != 0.0f){
+		decay_factor = decay_factor / norm;
 	}else{
 		decay_factor = 0.0f;
 	}
 
-	for(ssi_size_t i = 0; i < _dim; i++){
-		_value_decay[i] = _value[i] * decay_factor /*+ baseline[i]*/;
-	}
-
-	if(_decay_weight){
-		_current_weight = _starting_weight * decay_factor;
-	}else{
-		_current_weight = _starting_weight;
-	}
-
-	/*ssi_print("\n\nDEBUG::\t_starting_weight\t%.2f\nDEBUG::\t_current_weight\t\t%.2f", _starting_weight, _current_weight);*/
-	return true;
+	return decay_factor;
 }
 
 bool EVector::set_values(ssi_size_t dim, ssi_event_map_t* tuples){
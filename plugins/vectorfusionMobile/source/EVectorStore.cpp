@@ -0,0 +1,518 @@
+// EVectorStore.cpp
+// created: 2026/10/19
+// Copyright (C) University of Augsburg, Lab for Human Centered Multimedia
+//
+// *************************************************************************************************
+//
+// This file is part of Social Signal Interpretation (SSI) developed at the
+// Lab for Human Centered Multimedia of the University of Augsburg
+//
+// This library is free software; you can redistribute itand/or
+// modify it under the terms of the GNU General Public
+// License as published by the Free Software Foundation; either
+// version 3 of the License, or any laterversion.
+//
+// This library is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FORA PARTICULAR PURPOSE.  See the GNU
+// General Public License for more details.
+//
+// You should have received a copy of the GNU General Public
+// License along withthis library; if not, write to the Free Software
+// Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+//
+//*************************************************************************************************
+
+#include "../include/EVectorStore.h"
+#include "signal/TypeCast.h"
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__x86_64__) || defined(__i386__)
+	#define SSI_EVECTORSTORE_X86
+	#include <emmintrin.h>
+	#if defined(_MSC_VER)
+		#define SSI_EVECTORSTORE_TARGET(x)
+	#else
+		#define SSI_EVECTORSTORE_TARGET(x) __attribute__((target(x)))
+	#endif
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__) || defined(__aarch64__)
+	#define SSI_EVECTORSTORE_NEON
+	#include <arm_neon.h>
+#endif
+
+#ifdef USE_SSI_LEAK_DETECTOR
+	#include "SSI_LeakWatcher.h"
+	#ifdef _DEBUG
+		#define new DEBUG_NEW
+		#undef THIS_FILE
+		static char THIS_FILE[] = __FILE__;
+	#endif
+#endif
+
+namespace ssi {
+
+// kernels work on one row, i.e. one dimension of n vectors
+struct EVectorStore::kernels_t {
+	// norm2 += (row - b)^2
+	void (*norm) (ssi_size_t n, const ssi_real_t *row, ssi_real_t b, ssi_real_t *norm2);
+	// row_decay = (row - b) * factor + b
+	void (*decay) (ssi_size_t n, const ssi_real_t *row, ssi_real_t *row_decay, const ssi_real_t *factor, ssi_real_t b);
+	// flags |= row < lo || row > hi
+	void (*outside) (ssi_size_t n, const ssi_real_t *row, ssi_real_t lo, ssi_real_t hi, uint32_t *flags);
+	// sum of row * weight
+	ssi_real_t (*dot) (ssi_size_t n, const ssi_real_t *row, const ssi_real_t *weight);
+};
+
+//*************************************************************************************************
+// scalar kernels
+
+static void norm_scalar (ssi_size_t n, const ssi_real_t *row, ssi_real_t b, ssi_real_t *norm2) {
+
+	for (ssi_size_t i = 0; i < n; i++) {
+		ssi_real_t x = row[i] - b;
+		norm2[i] += x * x;
+	}
+}
+
+static void decay_scalar (ssi_size_t n, const ssi_real_t *row, ssi_real_t *row_decay, const ssi_real_t *factor, ssi_real_t b) {
+
+	for (ssi_size_t i = 0; i < n; i++) {
+		row_decay[i] = (row[i] - b) * factor[i] + b;
+	}
+}
+
+static void outside_scalar (ssi_size_t n, const ssi_real_t *row, ssi_real_t lo, ssi_real_t hi, uint32_t *flags) {
+
+	for (ssi_size_t i = 0; i < n; i++) {
+		if (row[i] < lo || row[i] > hi) {
+			flags[i] = 0xffffffff;
+		}
+	}
+}
+
+static ssi_real_t dot_scalar (ssi_size_t n, const ssi_real_t *row, const ssi_real_t *weight) {
+
+	ssi_real_t sum = 0;
+	for (ssi_size_t i = 0; i < n; i++) {
+		sum += row[i] * weight[i];
+	}
+
+	return sum;
+}
+
+//*************************************************************************************************
+// x86 kernels
+
+#ifdef SSI_EVECTORSTORE_X86
+
+SSI_EVECTORSTORE_TARGET("sse2")
+static void norm_sse2 (ssi_size_t n, const ssi_real_t *row, ssi_real_t b, ssi_real_t *norm2) {
+
+	__m128 bb = _mm_set1_ps (b);
+
+	ssi_size_t i = 0;
+	for (; i + 4 <= n; i += 4) {
+		__m128 x = _mm_sub_ps (_mm_loadu_ps (row + i), bb);
+		_mm_storeu_ps (norm2 + i, _mm_add_ps (_mm_loadu_ps (norm2 + i), _mm_mul_ps (x, x)));
+	}
+	norm_scalar (n - i, row + i, b, norm2 + i);
+}
+
+SSI_EVECTORSTORE_TARGET("sse2")
+static void decay_sse2 (ssi_size_t n, const ssi_real_t *row, ssi_real_t *row_decay, const ssi_real_t *factor, ssi_real_t b) {
+
+	__m128 bb = _mm_set1_ps (b);
+
+	ssi_size_t i = 0;
+	for (; i + 4 <= n; i += 4) {
+		__m128 x = _mm_sub_ps (_mm_loadu_ps (row + i), bb);
+		_mm_storeu_ps (row_decay + i, _mm_add_ps (_mm_mul_ps (x, _mm_loadu_ps (factor + i)), bb));
+	}
+	decay_scalar (n - i, row + i, row_decay + i, factor + i, b);
+}
+
+SSI_EVECTORSTORE_TARGET("sse2")
+static void outside_sse2 (ssi_size_t n, const ssi_real_t *row, ssi_real_t lo, ssi_real_t hi, uint32_t *flags) {
+
+	__m128 l = _mm_set1_ps (lo);
+	__m128 h = _mm_set1_ps (hi);
+
+	ssi_size_t i = 0;
+	for (; i + 4 <= n; i += 4) {
+		__m128 x = _mm_loadu_ps (row + i);
+		__m128i m = _mm_castps_si128 (_mm_or_ps (_mm_cmplt_ps (x, l), _mm_cmpgt_ps (x, h)));
+		__m128i *dst = ssi_pcast (__m128i, flags + i);
+		_mm_storeu_si128 (dst, _mm_or_si128 (_mm_loadu_si128 (dst), m));
+	}
+	outside_scalar (n - i, row + i, lo, hi, flags + i);
+}
+
+SSI_EVECTORSTORE_TARGET("sse2")
+static ssi_real_t dot_sse2 (ssi_size_t n, const ssi_real_t *row, const ssi_real_t *weight) {
+
+	__m128 acc = _mm_setzero_ps ();
+
+	ssi_size_t i = 0;
+	for (; i + 4 <= n; i += 4) {
+		acc = _mm_add_ps (acc, _mm_mul_ps (_mm_loadu_ps (row + i), _mm_loadu_ps (weight + i)));
+	}
+
+	float sum[4];
+	_mm_storeu_ps (sum, acc);
+
+	return (sum[0] + sum[1]) + (sum[2] + sum[3]) + dot_scalar (n - i, row + i, weight + i);
+}
+
+#endif
+
+//*************************************************************************************************
+// neon kernels
+
+#ifdef SSI_EVECTORSTORE_NEON
+
+static void norm_neon (ssi_size_t n, const ssi_real_t *row, ssi_real_t b, ssi_real_t *norm2) {
+
+	float32x4_t bb = vdupq_n_f32 (b);
+
+	ssi_size_t i = 0;
+	for (; i + 4 <= n; i += 4) {
+		float32x4_t x = vsubq_f32 (vld1q_f32 (row + i), bb);
+		vst1q_f32 (norm2 + i, vmlaq_f32 (vld1q_f32 (norm2 + i), x, x));
+	}
+	norm_scalar (n - i, row + i, b, norm2 + i);
+}
+
+static void decay_neon (ssi_size_t n, const ssi_real_t *row, ssi_real_t *row_decay, const ssi_real_t *factor, ssi_real_t b) {
+
+	float32x4_t bb = vdupq_n_f32 (b);
+
+	ssi_size_t i = 0;
+	for (; i + 4 <= n; i += 4) {
+		float32x4_t x = vsubq_f32 (vld1q_f32 (row + i), bb);
+		vst1q_f32 (row_decay + i, vmlaq_f32 (bb, x, vld1q_f32 (factor + i)));
+	}
+	decay_scalar (n - i, row + i, row_decay + i, factor + i, b);
+}
+
+static void outside_neon (ssi_size_t n, const ssi_real_t *row, ssi_real_t lo, ssi_real_t hi, uint32_t *flags) {
+
+	float32x4_t l = vdupq_n_f32 (lo);
+	float32x4_t h = vdupq_n_f32 (hi);
+
+	ssi_size_t i = 0;
+	for (; i + 4 <= n; i += 4) {
+		float32x4_t x = vld1q_f32 (row + i);
+		uint32x4_t m = vorrq_u32 (vcltq_f32 (x, l), vcgtq_f32 (x, h));
+		vst1q_u32 (flags + i, vorrq_u32 (vld1q_u32 (flags + i), m));
+	}
+	outside_scalar (n - i, row + i, lo, hi, flags + i);
+}
+
+static ssi_real_t dot_neon (ssi_size_t n, const ssi_real_t *row, const ssi_real_t *weight) {
+
+	float32x4_t acc = vdupq_n_f32 (0);
+
+	ssi_size_t i = 0;
+	for (; i + 4 <= n; i += 4) {
+		acc = vmlaq_f32 (acc, vld1q_f32 (row + i), vld1q_f32 (weight + i));
+	}
+
+	float32x2_t sum = vadd_f32 (vget_low_f32 (acc), vget_high_f32 (acc));
+
+	return vget_lane_f32 (vpadd_f32 (sum, sum), 0) + dot_scalar (n - i, row + i, weight + i);
+}
+
+#endif
+
+//*************************************************************************************************
+
+const EVectorStore::kernels_t *EVectorStore::Resolve () {
+
+#if defined(SSI_EVECTORSTORE_X86)
+	if (TypeCast::GetCpuFeatures () & TypeCast::SSE2) {
+		static const kernels_t kernels = { norm_sse2, decay_sse2, outside_sse2, dot_sse2 };
+		return &kernels;
+	}
+#elif defined(SSI_EVECTORSTORE_NEON)
+	if (TypeCast::GetCpuFeatures () & TypeCast::NEON) {
+		static const kernels_t kernels = { norm_neon, decay_neon, outside_neon, dot_neon };
+		return &kernels;
+	}
+#endif
+
+	static const kernels_t kernels = { norm_scalar, decay_scalar, outside_scalar, dot_scalar };
+	return &kernels;
+}
+
+EVectorStore::EVectorStore ()
+	: _kernels (0),
+	_dim (0),
+	_n (0),
+	_capacity (0),
+	_value (0),
+	_value_decay (0),
+	_starting_weight (0),
+	_weight (0),
+	_speed (0),
+	_gradient (0),
+	_type (0),
+	_time (0),
+	_lifetime (0),
+	_decay_weight (0),
+	_factor (0),
+	_selected_weight (0),
+	_selected (0) {
+}
+
+EVectorStore::~EVectorStore () {
+
+	release ();
+}
+
+void EVectorStore::init (ssi_size_t dim) {
+
+	release ();
+
+	_dim = dim;
+	_kernels = Resolve ();
+}
+
+void EVectorStore::release () {
+
+	delete[] _value; _value = 0;
+	delete[] _value_decay; _value_decay = 0;
+	delete[] _starting_weight; _starting_weight = 0;
+	delete[] _weight; _weight = 0;
+	delete[] _speed; _speed = 0;
+	delete[] _gradient; _gradient = 0;
+	delete[] _type; _type = 0;
+	delete[] _time; _time = 0;
+	delete[] _lifetime; _lifetime = 0;
+	delete[] _decay_weight; _decay_weight = 0;
+	delete[] _factor; _factor = 0;
+	delete[] _selected_weight; _selected_weight = 0;
+	delete[] _selected; _selected = 0;
+
+	_dim = 0;
+	_n = 0;
+	_capacity = 0;
+}
+
+void EVectorStore::clear () {
+
+	_n = 0;
+}
+
+template <typename T>
+static void resize (T *&ptr, ssi_size_t n, ssi_size_t capacity) {
+
+	T *tmp = new T[capacity];
+	for (ssi_size_t i = 0; i < n; i++) {
+		tmp[i] = ptr[i];
+	}
+	delete[] ptr;
+	ptr = tmp;
+}
+
+static void resize_rows (ssi_real_t *&ptr, ssi_size_t dim, ssi_size_t n, ssi_size_t capacity_old, ssi_size_t capacity) {
+
+	ssi_real_t *tmp = new ssi_real_t[dim * capacity];
+	for (ssi_size_t d = 0; d < dim; d++) {
+		if (n > 0) {
+			memcpy (tmp + d * capacity, ptr + d * capacity_old, n * sizeof (ssi_real_t));
+		}
+	}
+	delete[] ptr;
+	ptr = tmp;
+}
+
+void EVectorStore::grow () {
+
+	ssi_size_t capacity = _capacity == 0 ? BLOCK : 2 * _capacity;
+
+	resize_rows (_value, _dim, _n, _capacity, capacity);
+	resize_rows (_value_decay, _dim, _n, _capacity, capacity);
+	resize (_starting_weight, _n, capacity);
+	resize (_weight, _n, capacity);
+	resize (_speed, _n, capacity);
+	resize (_gradient, _n, capacity);
+	resize (_type, _n, capacity);
+	resize (_time, _n, capacity);
+	resize (_lifetime, _n, capacity);
+	resize (_decay_weight, _n, capacity);
+	resize (_selected, _n, capacity);
+	resize (_factor, 0, capacity);
+	resize (_selected_weight, 0, capacity);
+
+	_capacity = capacity;
+}
+
+ssi_size_t EVectorStore::add (ssi_real_t weight, ssi_real_t speed, EVector::DECAY_TYPE type, ssi_real_t gradient, ssi_size_t time, bool decay_weight, const ssi_event_map_t *tuples) {
+
+	if (type > 2) {
+		ssi_wrn ("vector decay type '%u' not defined", type);
+	}
+
+	if (_n == _capacity) {
+		grow ();
+	}
+
+	ssi_size_t index = _n++;
+
+	for (ssi_size_t d = 0; d < _dim; d++) {
+		_value[d * _capacity + index] = tuples[d].value;
+		_value_decay[d * _capacity + index] = 0.0f;
+	}
+	_starting_weight[index] = weight;
+	_weight[index] = weight;
+	_speed[index] = speed;
+	_gradient[index] = gradient;
+	_type[index] = type;
+	_time[index] = time;
+	_lifetime[index] = 0;
+	_decay_weight[index] = decay_weight;
+	_selected[index] = 0xffffffff;
+
+	return index;
+}
+
+void EVectorStore::update (ssi_size_t framework_time, const ssi_real_t *baseline) {
+
+	if (_n == 0) {
+		return;
+	}
+
+	// norm of the vectors relative to the baseline
+	for (ssi_size_t i = 0; i < _n; i++) {
+		_lifetime[i] = framework_time - _time[i];
+		_factor[i] = 0.0f;
+	}
+	for (ssi_size_t d = 0; d < _dim; d++) {
+		_kernels->norm (_n, _value + d * _capacity, baseline[d], _factor);
+	}
+
+	// decay factor and weight
+	for (ssi_size_t i = 0; i < _n; i++) {
+		_factor[i] = EVector::DecayFactor (_type[i], sqrt (_factor[i]), _lifetime[i], _speed[i], _gradient[i]);
+		_weight[i] = _decay_weight[i] ? _starting_weight[i] * _factor[i] : _starting_weight[i];
+	}
+
+	for (ssi_size_t d = 0; d < _dim; d++) {
+		_kernels->decay (_n, _value + d * _capacity, _value_decay + d * _capacity, _factor, baseline[d]);
+	}
+}
+
+ssi_size_t EVectorStore::selectByWeight (ssi_real_t threshold, ssi_real_t &sum_of_weights) {
+
+	ssi_size_t n_selected = 0;
+	sum_of_weights = 0.0f;
+
+	for (ssi_size_t i = 0; i < _n; i++) {
+		if (_weight[i] > threshold) {
+			_selected[i] = 0xffffffff;
+			_selected_weight[i] = _weight[i];
+			sum_of_weights += _weight[i];
+			n_selected++;
+		} else {
+			_selected[i] = 0;
+			_selected_weight[i] = 0.0f;
+		}
+	}
+
+	return n_selected;
+}
+
+ssi_size_t EVectorStore::selectByDistance (const ssi_real_t *baseline, ssi_real_t threshold, ssi_real_t &sum_of_weights) {
+
+	for (ssi_size_t i = 0; i < _n; i++) {
+		_selected[i] = 0;
+	}
+	for (ssi_size_t d = 0; d < _dim && _n > 0; d++) {
+		_kernels->outside (_n, _value_decay + d * _capacity, baseline[d] - threshold, baseline[d] + threshold, _selected);
+	}
+
+	ssi_size_t n_selected = 0;
+	sum_of_weights = 0.0f;
+
+	for (ssi_size_t i = 0; i < _n; i++) {
+		if (_selected[i]) {
+			_selected_weight[i] = _weight[i];
+			sum_of_weights += _weight[i];
+			n_selected++;
+		} else {
+			_selected_weight[i] = 0.0f;
+		}
+	}
+
+	return n_selected;
+}
+
+void EVectorStore::accumulate (bool decayed, ssi_real_t *sum) {
+
+	ssi_real_t *rows = decayed ? _value_decay : _value;
+	for (ssi_size_t d = 0; d < _dim; d++) {
+		sum[d] = _n > 0 ? _kernels->dot (_n, rows + d * _capacity, _selected_weight) : 0.0f;
+	}
+}
+
+void EVectorStore::compact () {
+
+	ssi_size_t n = 0;
+	for (ssi_size_t i = 0; i < _n; i++) {
+		if (!_selected[i]) {
+			continue;
+		}
+		if (n != i) {
+			for (ssi_size_t d = 0; d < _dim; d++) {
+				_value[d * _capacity + n] = _value[d * _capacity + i];
+				_value_decay[d * _capacity + n] = _value_decay[d * _capacity + i];
+			}
+			_starting_weight[n] = _starting_weight[i];
+			_weight[n] = _weight[i];
+			_speed[n] = _speed[i];
+			_gradient[n] = _gradient[i];
+			_type[n] = _type[i];
+			_time[n] = _time[i];
+			_lifetime[n] = _lifetime[i];
+			_decay_weight[n] = _decay_weight[i];
+			_selected[n] = _selected[i];
+			_selected_weight[n] = _selected_weight[i];
+		}
+		n++;
+	}
+
+	_n = n;
+}
+
+void EVectorStore::getValue (ssi_size_t index, ssi_real_t *value) {
+
+	for (ssi_size_t d = 0; d < _dim; d++) {
+		value[d] = _value[d * _capacity + index];
+	}
+}
+
+void EVectorStore::getValueDecay (ssi_size_t index, ssi_real_t *value) {
+
+	for (ssi_size_t d = 0; d < _dim; d++) {
+		value[d] = _value_decay[d * _capacity + index];
+	}
+}
+
+void EVectorStore::print (ssi_size_t index) {
+
+	ssi_real_t norm = 0.0f;
+	ssi_real_t norm_decay = 0.0f;
+	for (ssi_size_t d = 0; d < _dim; d++) {
+		norm += _value[d * _capacity + index] * _value[d * _capacity + index];
+		norm_decay += _value_decay[d * _capacity + index] * _value_decay[d * _capacity + index];
+	}
+
+	ssi_print("'%d'\t\t'%d'\t\t'%0.2f'\t", _time[index], _lifetime[index], sqrt (norm));
+	for (ssi_size_t d = 0; d < _dim; d++) {
+		ssi_print("%0.2f ", _value[d * _capacity + index]);
+	}ssi_print("\n\t\t\t\t\t'%0.2f'\t", sqrt (norm_decay));
+	for (ssi_size_t d = 0; d < _dim; d++) {
+		ssi_print("%0.2f ", _value_decay[d * _capacity + index]);
+	}ssi_print("\n");
+}
+
+}
@@ -161,23 +161,25 @@ void FusionPainter::createBackBrush () {
 	backBrush = ::CreateSolidBrush (backColor);
 }
 
-void FusionPainter::update_evectors(std::deque<EVector*> &VectorList){
+void FusionPainter::update_evectors(EVectorStore &VectorStore){
 
 	for(ssi_size_t i = 0; i < EVectorList.size(); i++){
 		delete EVectorList[i];
 	}
 	EVectorList.clear();
-	for(ssi_size_t i = 0; i < VectorList.size(); i++){
-		if(!VectorList[i]) continue;
-		EVector* vec = new EVector( _dim, VectorList[i]->get_weight(), VectorList[i]->get_speed(), VectorList[i]->get_type(), VectorList[i]->get_gradient(), VectorList[i]->get_time(), VectorList[i]->get_does_decay_weight());
+	ssi_real_t *value = new ssi_real_t[_dim];
+	for(ssi_size_t i = 0; i < VectorStore.size(); i++){
+		EVector* vec = new EVector( _dim, VectorStore.getWeight(i), VectorStore.getSpeed(i), VectorStore.getType(i), VectorStore.getGradient(i), VectorStore.getTime(i), VectorStore.getDoesDecayWeight(i));
 		if(_decaying_vectors){
-			vec->set_values_decay(_dim, VectorList[i]->get_value_decay());
+			VectorStore.getValueDecay(i, value);
 		}else{
-			vec->set_values_decay(_dim, VectorList[i]->get_value());
+			VectorStore.getValue(i, value);
 		}
+		vec->set_values_decay(_dim, value);
 		
 		EVectorList.push_back(vec);
-	}	
+	}
+	delete[] value;
 
 }
 
@@ -211,7 +213,7 @@ void FusionPainter::update_baseline(ssi_real_t *Baseline){
 
 }
 
-void FusionPainter::setData(ssi_size_t Dimension, ssi_real_t *Baseline, ssi_real_t Threshold, std::deque<EVector*> &VectorList, ssi_real_t* FusionPoint, EVector* FusionVector, bool DecayingVectors, bool PaintEvents){
+void FusionPainter::setData(ssi_size_t Dimension, ssi_real_t *Baseline, ssi_real_t Threshold, EVectorStore &VectorStore, ssi_real_t* FusionPoint, EVector* FusionVector, bool DecayingVectors, bool PaintEvents){
 
 	Lock lock(_mutex);
 
@@ -241,7 +243,7 @@ void FusionPainter::setData(ssi_size_t Dimension, ssi_real_t *Baseline, ssi_real
 		}
 	}
 
-	update_evectors(VectorList);
+	update_evectors(VectorStore);
 	update_fpoint(FusionPoint);
 	update_fvector(FusionVector);
 	update_baseline(Baseline);
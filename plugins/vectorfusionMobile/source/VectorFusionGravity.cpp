@@ -124,6 +124,7 @@ bool VectorFusionGravity::setEventListener (IEventListener *listener) {
 void VectorFusionGravity::listen_enter (){
 
 	_dim = _options.dimension;
+	VectorStore.init(_dim);
 	_baseline = new ssi_real_t[_dim];
 	for(ssi_size_t ndim = 0; ndim < _dim; ndim++){
 		_baseline[ndim] = 0.0f;
@@ -240,9 +241,7 @@ bool VectorFusionGravity::update (IEvents &events, ssi_size_t n_new_events, ssi_
 	}
 		
 	//update (decay) vectors
-	for(ssi_size_t i = 0; i < VectorList.size(); i++){
-        VectorList[i]->update(_framework_time, _baseline);
-	}
+	VectorStore.update(_framework_time, _baseline);
 
 	//combine event vectors to fusion vector
 	if(!_fusion_vector){
@@ -261,7 +260,7 @@ bool VectorFusionGravity::update (IEvents &events, ssi_size_t n_new_events, ssi_
 	}
 #if _WIN32||_WIN64
 	if(_paint){
-		_plot->setData(_dim, _baseline, _threshold, VectorList, _fusion_point, _fusion_vector, false, _options.paint_events);
+		_plot->setData(_dim, _baseline, _threshold, VectorStore, _fusion_point, _fusion_vector, false, _options.paint_events);
 		_window->update();
 	}
 #endif
@@ -324,10 +323,7 @@ void VectorFusionGravity::listen_flush (){
 		delete[] _file;
 	}
 
-	for(ssi_size_t i = 0; i < VectorList.size(); i++){		
-		delete VectorList[i];
-	}
-	VectorList.clear();
+	VectorStore.release();
 
 	if(_axis_captions){
 		for(ssi_size_t i = 0; i < _dim; i++){
@@ -404,22 +400,14 @@ bool VectorFusionGravity::transformEventToVector(ssi_event_t *Event){
 				ssi_real_t mSpeed = _modality_map[0][Factory::GetString(Event->sender_id)].speed;
 
 				ssi_size_t time = Event->time;
-				EVector *v = new EVector( dim, mWeight, mSpeed, _decay_type, _gradient, time, true);
-				ssi_event_map_t *tuples = ssi_pcast (ssi_event_map_t, Event->ptr);
-				v->set_values(dim, tuples);
-				tuples = 0;
-				VectorList.push_back(v);
+				VectorStore.add(mWeight, mSpeed, _decay_type, _gradient, time, true, ssi_pcast (ssi_event_map_t, Event->ptr));
 				return true;
 
 			}else{
 
 				ssi_wrn ("modality %s values not specified, using default values", Factory::GetString(Event->sender_id));
 				ssi_size_t time = Event->time;
-				EVector *v = new EVector( dim, 1.0f, _event_speed, _decay_type, _gradient, time, true);
-				ssi_event_map_t *tuples = ssi_pcast (ssi_event_map_t, Event->ptr);
-				v->set_values(dim, tuples);
-				tuples = 0;
-				VectorList.push_back(v);
+				VectorStore.add(1.0f, _event_speed, _decay_type, _gradient, time, true, ssi_pcast (ssi_event_map_t, Event->ptr));
 				return true;
 
 			}	
@@ -427,11 +415,7 @@ bool VectorFusionGravity::transformEventToVector(ssi_event_t *Event){
 		}else{
 
 			ssi_size_t time = Event->time;
-			EVector *v = new EVector( dim, 1.0f, _event_speed, _decay_type, _gradient, time, true);
-			ssi_event_map_t *tuples = ssi_pcast (ssi_event_map_t, Event->ptr);
-			v->set_values(dim, tuples);
-			tuples = 0;
-			VectorList.push_back(v);
+			VectorStore.add(1.0f, _event_speed, _decay_type, _gradient, time, true, ssi_pcast (ssi_event_map_t, Event->ptr));
 			return true;
 
 		}
@@ -468,22 +452,14 @@ bool VectorFusionGravity::transformEventToVector(ssi_event_t *Event){
                 ssi_real_t mSpeed = _modality_map[0][ea.getAddress()].speed;
 
 				ssi_size_t time = Event->time;
-				EVector *v = new EVector( dim, mWeight, mSpeed, _decay_type, _gradient, time, true);
-                ssi_event_map_t *tuples = ssi_pcast (ssi_event_map_t, Event->ptr);
-				v->set_values(dim, tuples);
-				tuples = 0;
-                VectorList.push_back(v);
+				VectorStore.add(mWeight, mSpeed, _decay_type, _gradient, time, true, ssi_pcast (ssi_event_map_t, Event->ptr));
 				return true;
 
 			}else{
 
 				ssi_wrn("modality '%s' values not specified, using default values", ea.getAddress());
 				ssi_size_t time = Event->time;
-				EVector *v = new EVector( dim, 1.0f, _event_speed, _decay_type, _gradient, time, true);
-				ssi_event_map_t *tuples = ssi_pcast (ssi_event_map_t, Event->ptr);
-				v->set_values(dim, tuples);
-				tuples = 0;
-				VectorList.push_back(v);
+				VectorStore.add(1.0f, _event_speed, _decay_type, _gradient, time, true, ssi_pcast (ssi_event_map_t, Event->ptr));
 				return true;
 
 			}	
@@ -491,11 +467,7 @@ bool VectorFusionGravity::transformEventToVector(ssi_event_t *Event){
 		}else{
 
 			ssi_size_t time = Event->time;
-			EVector *v = new EVector( dim, 1.0f, _event_speed, _decay_type, _gradient, time, true);
-			ssi_event_map_t *tuples = ssi_pcast (ssi_event_map_t, Event->ptr);
-			v->set_values(dim, tuples);
-			tuples = 0;
-			VectorList.push_back(v);
+			VectorStore.add(1.0f, _event_speed, _decay_type, _gradient, time, true, ssi_pcast (ssi_event_map_t, Event->ptr));
 			return true;
 
 		}
@@ -507,8 +479,6 @@ bool VectorFusionGravity::transformEventToVector(ssi_event_t *Event){
 bool VectorFusionGravity::combineVectors(ssi_real_t fusion_speed, ssi_real_t delta_t, ssi_real_t threshold){
 
 	//set up
-	ssi_size_t n_vectors = ssi_size_t(VectorList.size());
-	ssi_size_t *indices = new ssi_size_t[n_vectors];
 	ssi_real_t sum_of_weights = 0.0f;
 	ssi_real_t baselinenorm = 0.0f;
 
@@ -519,22 +489,7 @@ bool VectorFusionGravity::combineVectors(ssi_real_t fusion_speed, ssi_real_t del
 	_baseline_norm = baselinenorm;
 	
 	//find contributing values and calculate sum of weights for mass center calculation
-    for(ssi_size_t i = 0; i < n_vectors; i++){
-		if(VectorList[i]->get_weight() > threshold){
-			indices[i] = 1;
-            sum_of_weights += VectorList[i]->get_weight();
-		}else{
-			indices[i] = 0;
-		}
-	}
-	
-	//are there contributing values?
-	ssi_size_t sum = 0;
-	for(ssi_size_t i = 0; i < n_vectors; i++){
-		if(indices[i] == 1){
-			sum = sum++;
-		}
-	}
+	ssi_size_t sum = VectorStore.selectByWeight(threshold, sum_of_weights);
 
 	//combine
 	ssi_real_t *mod_vector = new ssi_real_t[_dim];
@@ -556,12 +511,8 @@ bool VectorFusionGravity::combineVectors(ssi_real_t fusion_speed, ssi_real_t del
 		}
 	}else{
 		//determine fusion point, depending on fusion type
+		VectorStore.accumulate(false, _fusion_point);
 		for(ssi_size_t n_dim = 0; n_dim < _dim; n_dim++){
-			for(ssi_size_t n_vec = 0; n_vec < n_vectors; n_vec++){
-				if(indices[n_vec] == 1){
-					_fusion_point[n_dim] = _fusion_point[n_dim] + (VectorList[n_vec]->get_value()[n_dim] * VectorList[n_vec]->get_weight());
-				}
-			}
 			_fusion_point[n_dim] = _fusion_point[n_dim] + (_baseline[n_dim] * _baseline_weight);
 			sum_of_weights = sum_of_weights + _baseline_weight;
 			_fusion_point[n_dim] = _fusion_point[n_dim] / sum_of_weights;
@@ -608,20 +559,7 @@ bool VectorFusionGravity::combineVectors(ssi_real_t fusion_speed, ssi_real_t del
 	_fusion_vector->set_lifetime(_framework_time);
 
 	//erase vectors not contributing anymore
-	ssi_size_t iterator = 0;
-	for(ssi_size_t i = 0; i < n_vectors; i++){
-		if(indices[i] == 0){
-			delete (*(VectorList.begin() + iterator));
-			VectorList.erase(VectorList.begin() + iterator);
-		}else{
-			iterator++;
-		}
-	}
-
-	if(indices){
-		delete [] indices;
-		indices = 0;
-	}
+	VectorStore.compact();
 
 	if(mod_vector){
 		delete [] mod_vector;
@@ -647,8 +585,8 @@ ssi_real_t VectorFusionGravity::getThreshold(){
 void VectorFusionGravity::print(){
 
 	ssi_print ("#\tcreation time\tlifetime\tnorm\tvalue\n------------------------------------------------------------------------\n");
-	for(ssi_size_t i = 0; i < VectorList.size(); i++){
-		ssi_print("%03d\t", i); VectorList[i]->print();
+	for(ssi_size_t i = 0; i < VectorStore.size(); i++){
+		ssi_print("%03d\t", i); VectorStore.print(i);
 	}ssi_print("\nFUS\t");
 	_fusion_vector->print();
 	ssi_print("\n");
@@ -120,6 +120,7 @@ bool VectorFusionModality::setEventListener (IEventListener *listener) {
 void VectorFusionModality::listen_enter (){
 
 	_dim = _options.dimension;
+	VectorStore.init(_dim);
 	_baseline = new ssi_real_t[_dim];
 	for(ssi_size_t ndim = 0; ndim < _dim; ndim++){
 		_baseline[ndim] = 0.0f;
@@ -236,9 +237,7 @@ bool VectorFusionModality::update (IEvents &events, ssi_size_t n_new_events, ssi
 	}
 		
 	//update (decay) vectors
-	for(ssi_size_t i = 0; i < VectorList.size(); i++){
-		VectorList[i]->update(_framework_time, _baseline);
-	}
+	VectorStore.update(_framework_time, _baseline);
 
 	//combine event vectors to fusion vector
 	if(!_fusion_vector){
@@ -257,7 +256,7 @@ bool VectorFusionModality::update (IEvents &events, ssi_size_t n_new_events, ssi
 	}
 #if _WIN32||_WIN64
 	if(_paint){
-		_plot->setData(_dim, _baseline, _threshold, VectorList, _fusion_point, _fusion_vector, true, _options.paint_events);
+		_plot->setData(_dim, _baseline, _threshold, VectorStore, _fusion_point, _fusion_vector, true, _options.paint_events);
 		_window->update();
 	}
 #endif
@@ -320,10 +319,7 @@ void VectorFusionModality::listen_flush (){
 		delete[] _file;
 	}
 
-	for(ssi_size_t i = 0; i < VectorList.size(); i++){		
-		delete VectorList[i];
-	}
-	VectorList.clear();
+	VectorStore.release();
 
 	if(_axis_captions){
 		for(ssi_size_t i = 0; i < _dim; i++){
@@ -393,22 +389,14 @@ bool VectorFusionModality::transformEventToVector(ssi_event_t *Event){
 				ssi_real_t mSpeed = _modality_map[0][ea.getAddress()].speed;
 
 				ssi_size_t time = Event->time;
-				EVector *v = new EVector( dim, mWeight, mSpeed, _decay_type, _gradient, time, true);
-				ssi_event_map_t *tuples = ssi_pcast (ssi_event_map_t, Event->ptr);
-				v->set_values(dim, tuples);
-				tuples = 0;
-				VectorList.push_back(v);
+				VectorStore.add(mWeight, mSpeed, _decay_type, _gradient, time, true, ssi_pcast (ssi_event_map_t, Event->ptr));
 				return true;
 
 			}else{
 
 				ssi_wrn("modality '%s' values not specified, using default values", ea.getAddress());
 				ssi_size_t time = Event->time;
-				EVector *v = new EVector( dim, 1.0f, _event_speed, _decay_type, _gradient, time, true);
-				ssi_event_map_t *tuples = ssi_pcast (ssi_event_map_t, Event->ptr);
-				v->set_values(dim, tuples);
-				tuples = 0;
-				VectorList.push_back(v);
+				VectorStore.add(1.0f, _event_speed, _decay_type, _gradient, time, true, ssi_pcast (ssi_event_map_t, Event->ptr));
 				return true;
 
 			}	
@@ -416,11 +404,7 @@ bool VectorFusionModality::transformEventToVector(ssi_event_t *Event){
 		}else{
 
 			ssi_size_t time = Event->time;
-			EVector *v = new EVector( dim, 1.0f, _event_speed, _decay_type, _gradient, time, true);
-			ssi_event_map_t *tuples = ssi_pcast (ssi_event_map_t, Event->ptr);
-			v->set_values(dim, tuples);
-			tuples = 0;
-			VectorList.push_back(v);
+			VectorStore.add(1.0f, _event_speed, _decay_type, _gradient, time, true, ssi_pcast (ssi_event_map_t, Event->ptr));
 			return true;
 
 		}
@@ -432,8 +416,6 @@ bool VectorFusionModality::transformEventToVector(ssi_event_t *Event){
 bool VectorFusionModality::combineVectors(ssi_real_t fusion_speed, ssi_real_t delta_t, ssi_real_t threshold){
 
 	//set up
-	ssi_size_t n_vectors = ssi_size_t(VectorList.size());
-	ssi_size_t *indices = new ssi_size_t[n_vectors];
 	ssi_real_t sum_of_weights = 0.0f;
 	ssi_real_t baselinenorm = 0.0f;
 	
@@ -444,22 +426,7 @@ bool VectorFusionModality::combineVectors(ssi_real_t fusion_speed, ssi_real_t de
 	_baseline_norm = baselinenorm;
 	
 	//find contributing values and calculate sum of weights for mass center calculation
-	for(ssi_size_t i = 0; i < n_vectors; i++){
-		if(VectorList[i]->get_weight() > threshold){
-			indices[i] = 1;
-			sum_of_weights += VectorList[i]->get_weight();
-		}else{
-			indices[i] = 0;
-		}
-	}
-	
-	//are there contributing values?
-	ssi_size_t sum = 0;
-	for(ssi_size_t i = 0; i < n_vectors; i++){
-		if(indices[i] == 1){
-			sum = sum++;
-		}
-	}
+	ssi_size_t sum = VectorStore.selectByWeight(threshold, sum_of_weights);
 
 	//combine
 	ssi_real_t *mod_vector = new ssi_real_t[_dim];
@@ -481,12 +448,8 @@ bool VectorFusionModality::combineVectors(ssi_real_t fusion_speed, ssi_real_t de
 		}
 	}else{
 		//determine fusion point, depending on fusion type
+		VectorStore.accumulate(true, _fusion_point);
 		for(ssi_size_t n_dim = 0; n_dim < _dim; n_dim++){
-			for(ssi_size_t n_vec = 0; n_vec < n_vectors; n_vec++){
-				if(indices[n_vec] == 1){
-					_fusion_point[n_dim] = _fusion_point[n_dim] + (VectorList[n_vec]->get_value_decay()[n_dim] * VectorList[n_vec]->get_weight());
-				}
-			}
 			_fusion_point[n_dim] = _fusion_point[n_dim] / sum_of_weights;
 		}
 		//determine modification vector
@@ -531,20 +494,7 @@ bool VectorFusionModality::combineVectors(ssi_real_t fusion_speed, ssi_real_t de
 	_fusion_vector->set_lifetime(_framework_time);
 
 	//erase vectors not contributing anymore
-	ssi_size_t iterator = 0;
-	for(ssi_size_t i = 0; i < n_vectors; i++){
-		if(indices[i] == 0){
-			delete (*(VectorList.begin() + iterator));
-			VectorList.erase(VectorList.begin() + iterator);
-		}else{
-			iterator++;
-		}
-	}
-
-	if(indices){
-		delete [] indices;
-		indices = 0;
-	}
+	VectorStore.compact();
 
 	if(mod_vector){
 		delete [] mod_vector;
@@ -570,8 +520,8 @@ ssi_real_t VectorFusionModality::getThreshold(){
 void VectorFusionModality::print(){
 
 	ssi_print ("#\tcreation time\tlifetime\tnorm\tvalue\n------------------------------------------------------------------------\n");
-	for(ssi_size_t i = 0; i < VectorList.size(); i++){
-		ssi_print("%03d\t", i); VectorList[i]->print();
+	for(ssi_size_t i = 0; i < VectorStore.size(); i++){
+		ssi_print("%03d\t", i); VectorStore.print(i);
 	}ssi_print("\nFUS\t");
 	_fusion_vector->print();
 	ssi_print("\n");
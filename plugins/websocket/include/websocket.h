@@ -49,6 +49,7 @@
 #include <fstream>
 #include <streambuf>
 #include <iomanip>
+#include <vector>
 
 
 namespace ssi {
@@ -61,7 +62,7 @@ namespace ssi {
 
 		public:
 
-			Options() : send_info(false), send_own_events(false) {
+			Options() : send_info(false), send_own_events(false), queue(64), client_bytes(1048576), coalesce(false), msgpack(false) {
 				setSenderName("websocket");
 				setEventName("message");
 				http_port = 8000;
@@ -76,6 +77,11 @@ namespace ssi {
 
 				addOption("send_info", &send_info, 1, SSI_BOOL, "send JSON info about streams as first websocket message to browser");
 				addOption("send_own_events", &send_own_events, 1, SSI_BOOL, "send own events to all clients?");
+
+				addOption("queue", &queue, 1, SSI_SIZE, "maximum number of messages waiting to be sent (if full oldest message is dropped)");
+				addOption("client_bytes", &client_bytes, 1, SSI_SIZE, "stream data is skipped for a client while more bytes than this are pending (0=no limit)");
+				addOption("coalesce", &coalesce, 1, SSI_BOOL, "replace stream data that has not been sent yet by newer data");
+				addOption("msgpack", &msgpack, 1, SSI_BOOL, "send events as binary MessagePack frames instead of JSON");
 			}
 
 			void setSenderName(const ssi_char_t *sname) {
@@ -106,6 +112,11 @@ namespace ssi {
 			bool send_info;
 			bool send_own_events;
 
+			ssi_size_t queue;
+			ssi_size_t client_bytes;
+			bool coalesce;
+			bool msgpack;
+
 		};
 
 	public:
@@ -159,6 +170,16 @@ namespace ssi {
 		ITheFramework *_frame;
 
 		Websockserver *server;
+
+		//buffers are reused for each message
+		void writeJSON(ssi_event_t *e);
+		void writeMsgPack(ssi_event_t *e);
+		rapidjson::StringBuffer _json;
+		std::vector<char> _msgpack;
+		std::vector<char> _base64;
+		ssi_size_t _n_parts;
+		const char **_parts;
+		size_t *_lens;
 	};
 
 }
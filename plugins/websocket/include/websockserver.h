@@ -5,6 +5,7 @@
 
 #include "mongoose.h"
 #include <thread/Thread.h>
+#include <thread/Lock.h>
 
 //class Websocket;
 
@@ -22,21 +23,55 @@ namespace ssi{
 
 
 		void sendEvent(std::string msg);
+		void sendEvent(const char *msg, size_t len, bool binary);
 		void sendRawData(char* data, int len);
+		void sendRawData(ssi_size_t n_parts, const char **parts, const size_t *lens);
 
 		static std::string stream_info_JSON;
 
 	private:
 
+		// outgoing message, buffers are kept and reused
+		struct message_t {
+			int op;
+			bool stream;
+			char *ptr;
+			size_t len;
+			size_t size;
+		};
+
+		// messages are queued by the sending thread and written to the
+		// clients by the server thread, which is woken up on enqueue.
+		// Every message goes to all clients, so one queue is shared by all
+		// connections. The per client queue is the send buffer of the
+		// mongoose connection. Stream frames are skipped for a client while
+		// its send buffer holds more than client_bytes, so a slow client
+		// does not hold back the others.
+		void enqueue(int op, bool stream, ssi_size_t n_parts, const char **parts, const size_t *lens);
+		void drain();
+		static void wakeup_handler(struct mg_connection *nc, int ev, void *ev_data);
+
 		static int is_websocket(const struct mg_connection *nc);
-		static void broadcast(struct mg_connection *nc, const char *msg, size_t len);
-		static void broadcastRaw(struct mg_connection *nc, const char *msg, size_t len);
 		static void ev_handler(struct mg_connection *nc, int ev, void *ev_data);
 
 
 		bool stop;
 
 		ssi::Mutex shutdownMutex;
+
+		ssi::Mutex queueMutex;
+		message_t *queue;
+		message_t *pending; // taken from the queue by drain(), only touched by the server thread
+		ssi_size_t queue_size;
+		ssi_size_t queue_first;
+		ssi_size_t queue_count;
+		ssi_size_t queue_dropped;
+		ssi_size_t client_dropped;
+		size_t client_bytes;
+		bool coalesce;
+
+		sock_t wakeup[2];
+		bool wakeup_pending;
 	};
 
 }
@@ -35,7 +35,7 @@ namespace ssi {
 
 
 	Websocket::Websocket(const ssi_char_t *file)
-		: _file(0), _listener(0), server(0) {
+		: _file(0), _listener(0), server(0), _n_parts(0), _parts(0), _lens(0) {
 
 		if (file) {
 			if (!OptionList::LoadXML(file, _options)) {
@@ -57,6 +57,9 @@ namespace ssi {
 		}
 
 		ssi_event_destroy(_event);
+
+		delete[] _parts; _parts = 0;
+		delete[] _lens; _lens = 0;
 	}
 
 	void Websocket::listen_enter() {
@@ -97,102 +100,233 @@ namespace ssi {
 
 
 				if (sendEvent) {
-					rapidjson::StringBuffer s;
-					rapidjson::Writer<rapidjson::StringBuffer> writer(s);
+					if (_options.msgpack) {
+						writeMsgPack(e);
+						server->sendEvent(&_msgpack[0], _msgpack.size(), true);
+					}
+					else {
+						writeJSON(e);
+						server->sendEvent(_json.GetString(), _json.GetSize(), false);
+					}
+				}
+			}
+		}
+		
+		return true;
+	}
 
-					writer.StartObject();
-				
-				
-					writer.String("type");
-					writer.String(SSI_ETYPE_NAMES[e->type]);
+	void Websocket::writeJSON(ssi_event_t *e) {
 
-					writer.String("sender");
-					writer.String(Factory::GetString(e->sender_id));
+		_json.Clear();
+		rapidjson::Writer<rapidjson::StringBuffer> writer(_json);
 
-					writer.String("name");
-					writer.String(Factory::GetString(e->event_id));
+		writer.StartObject();
+	
+	
+		writer.String("type");
+		writer.String(SSI_ETYPE_NAMES[e->type]);
 
-					writer.String("time");
-					writer.Int(e->time);
+		writer.String("sender");
+		writer.String(Factory::GetString(e->sender_id));
 
-					writer.String("dur");
-					writer.Int(e->dur);
+		writer.String("name");
+		writer.String(Factory::GetString(e->event_id));
 
-					writer.String("tot");
-					writer.Int(e->tot);
+		writer.String("time");
+		writer.Int(e->time);
 
-					writer.String("state");
-					writer.String(SSI_ESTATE_NAMES[e->state]);
+		writer.String("dur");
+		writer.Int(e->dur);
 
-					writer.String("glue");
-					writer.Int(e->glue_id);
+		writer.String("tot");
+		writer.Int(e->tot);
 
-					writer.String("prob");
-					writer.Double(e->prob);
+		writer.String("state");
+		writer.String(SSI_ESTATE_NAMES[e->state]);
 
+		writer.String("glue");
+		writer.Int(e->glue_id);
 
-					writer.String("value");
+		writer.String("prob");
+		writer.Double(e->prob);
 
-					if (e->type == SSI_ETYPE_STRING)
-					{
-						writer.String(e->ptr);
-					}
-					else if (e->type == SSI_ETYPE_TUPLE)
-					{
-						writer.StartArray();
 
-						ssi_real_t *floatptr = ssi_pcast(ssi_real_t, e->ptr);
+		writer.String("value");
 
-						for (int i = 0; i < e->tot / sizeof(ssi_real_t); i++)
-							writer.Double(floatptr[i]);
-					
-						writer.EndArray();
-					}
-					else if (e->type == SSI_ETYPE_EMPTY)
-					{
-						writer.Null();
-					}
-					else if (e->type == SSI_ETYPE_MAP)
-					{
-						writer.StartArray();
-
-						ssi_event_map_t *ptr = ssi_pcast(ssi_event_map_t, e->ptr);
-
-						for (int i = 0; i < e->tot / sizeof(ssi_event_map_t); i++) {
-							
-							writer.StartObject();
-								writer.String(Factory::GetString(ptr[i].id));
-								writer.Double(ptr[i].value);
-							writer.EndObject();
-						
-						}
-
-						writer.EndArray();
-					}
-					else if (e->type == SSI_ETYPE_UNDEF)
-					{
-						unsigned char *convbuf = reinterpret_cast<unsigned char*>(e->ptr);
-						char *base64_buf = new char[4 * (int)ceil(e->tot / 3.0)];				//http://stackoverflow.com/questions/9668863/predict-the-byte-size-of-a-base64-encoded-byte
-
-						mg_base64_encode(convbuf, e->tot, base64_buf);
-					
-						writer.String(e->ptr, strlen(base64_buf));
-					}
-					else // unknown types!
-					{
-						ssi_wrn("unknown event type!");
-						writer.Null();
-					}
+		if (e->type == SSI_ETYPE_STRING)
+		{
+			writer.String(e->ptr);
+		}
+		else if (e->type == SSI_ETYPE_TUPLE)
+		{
+			writer.StartArray();
+
+			ssi_real_t *floatptr = ssi_pcast(ssi_real_t, e->ptr);
 
+			for (int i = 0; i < e->tot / sizeof(ssi_real_t); i++)
+				writer.Double(floatptr[i]);
+		
+			writer.EndArray();
+		}
+		else if (e->type == SSI_ETYPE_EMPTY)
+		{
+			writer.Null();
+		}
+		else if (e->type == SSI_ETYPE_MAP)
+		{
+			writer.StartArray();
 
-					writer.EndObject();
+			ssi_event_map_t *ptr = ssi_pcast(ssi_event_map_t, e->ptr);
 
-					server->sendEvent(s.GetString());
-				}
+			for (int i = 0; i < e->tot / sizeof(ssi_event_map_t); i++) {
+				
+				writer.StartObject();
+					writer.String(Factory::GetString(ptr[i].id));
+					writer.Double(ptr[i].value);
+				writer.EndObject();
+			
 			}
+
+			writer.EndArray();
 		}
+		else if (e->type == SSI_ETYPE_UNDEF)
+		{
+			unsigned char *convbuf = reinterpret_cast<unsigned char*>(e->ptr);
+			_base64.resize(4 * (int)ceil(e->tot / 3.0) + 1);				//http://stackoverflow.com/questions/9668863/predict-the-byte-size-of-a-base64-encoded-byte
+
+			mg_base64_encode(convbuf, e->tot, &_base64[0]);
 		
-		return true;
+			writer.String(&_base64[0], strlen(&_base64[0]));
+		}
+		else // unknown types!
+		{
+			ssi_wrn("unknown event type!");
+			writer.Null();
+		}
+
+
+		writer.EndObject();
+	}
+
+	static void msgpack_byte(std::vector<char> &buf, uint8_t b) {
+		buf.push_back((char)b);
+	}
+
+	static void msgpack_be(std::vector<char> &buf, uint64_t value, int n_bytes) {
+		for (int i = n_bytes - 1; i >= 0; i--) {
+			buf.push_back((char)((value >> (8 * i)) & 0xff));
+		}
+	}
+
+	static void msgpack_header(std::vector<char> &buf, size_t len, uint8_t fix, size_t fix_max, uint8_t op8, uint8_t op16, uint8_t op32) {
+		if (len <= fix_max && fix) {
+			msgpack_byte(buf, (uint8_t)(fix | len));
+		} else if (len <= 0xff && op8) {
+			msgpack_byte(buf, op8);
+			msgpack_be(buf, len, 1);
+		} else if (len <= 0xffff) {
+			msgpack_byte(buf, op16);
+			msgpack_be(buf, len, 2);
+		} else {
+			msgpack_byte(buf, op32);
+			msgpack_be(buf, len, 4);
+		}
+	}
+
+	static void msgpack_str(std::vector<char> &buf, const char *str, size_t len) {
+		msgpack_header(buf, len, 0xa0, 31, 0xd9, 0xda, 0xdb);
+		buf.insert(buf.end(), str, str + len);
+	}
+
+	static void msgpack_str(std::vector<char> &buf, const char *str) {
+		msgpack_str(buf, str ? str : "", str ? strlen(str) : 0);
+	}
+
+	static void msgpack_uint(std::vector<char> &buf, uint32_t value) {
+		msgpack_byte(buf, 0xce);
+		msgpack_be(buf, value, 4);
+	}
+
+	static void msgpack_float(std::vector<char> &buf, float value) {
+		uint32_t bits;
+		memcpy(&bits, &value, sizeof(bits));
+		msgpack_byte(buf, 0xca);
+		msgpack_be(buf, bits, 4);
+	}
+
+	void Websocket::writeMsgPack(ssi_event_t *e) {
+
+		//same fields as JSON, see http://msgpack.org/
+		_msgpack.clear();
+
+		msgpack_header(_msgpack, 10, 0x80, 15, 0, 0xde, 0xdf);
+
+		msgpack_str(_msgpack, "type");
+		msgpack_str(_msgpack, SSI_ETYPE_NAMES[e->type]);
+
+		msgpack_str(_msgpack, "sender");
+		msgpack_str(_msgpack, Factory::GetString(e->sender_id));
+
+		msgpack_str(_msgpack, "name");
+		msgpack_str(_msgpack, Factory::GetString(e->event_id));
+
+		msgpack_str(_msgpack, "time");
+		msgpack_uint(_msgpack, e->time);
+
+		msgpack_str(_msgpack, "dur");
+		msgpack_uint(_msgpack, e->dur);
+
+		msgpack_str(_msgpack, "tot");
+		msgpack_uint(_msgpack, e->tot);
+
+		msgpack_str(_msgpack, "state");
+		msgpack_str(_msgpack, SSI_ESTATE_NAMES[e->state]);
+
+		msgpack_str(_msgpack, "glue");
+		msgpack_uint(_msgpack, e->glue_id);
+
+		msgpack_str(_msgpack, "prob");
+		msgpack_float(_msgpack, e->prob);
+
+		msgpack_str(_msgpack, "value");
+
+		if (e->type == SSI_ETYPE_STRING)
+		{
+			msgpack_str(_msgpack, e->ptr);
+		}
+		else if (e->type == SSI_ETYPE_TUPLE)
+		{
+			ssi_size_t n = e->tot / sizeof(ssi_real_t);
+			ssi_real_t *floatptr = ssi_pcast(ssi_real_t, e->ptr);
+
+			msgpack_header(_msgpack, n, 0x90, 15, 0, 0xdc, 0xdd);
+			for (ssi_size_t i = 0; i < n; i++)
+				msgpack_float(_msgpack, floatptr[i]);
+		}
+		else if (e->type == SSI_ETYPE_MAP)
+		{
+			ssi_size_t n = e->tot / sizeof(ssi_event_map_t);
+			ssi_event_map_t *ptr = ssi_pcast(ssi_event_map_t, e->ptr);
+
+			msgpack_header(_msgpack, n, 0x90, 15, 0, 0xdc, 0xdd);
+			for (ssi_size_t i = 0; i < n; i++) {
+				msgpack_byte(_msgpack, 0x81);
+				msgpack_str(_msgpack, Factory::GetString(ptr[i].id));
+				msgpack_float(_msgpack, ptr[i].value);
+			}
+		}
+		else if (e->type == SSI_ETYPE_UNDEF)
+		{
+			//raw bytes, no need for base64
+			msgpack_header(_msgpack, e->tot, 0, 0, 0xc4, 0xc5, 0xc6);
+			_msgpack.insert(_msgpack.end(), e->ptr, e->ptr + e->tot);
+		}
+		else
+		{
+			if (e->type != SSI_ETYPE_EMPTY)
+				ssi_wrn("unknown event type!");
+			msgpack_byte(_msgpack, 0xc0);
+		}
 	}
 
 	void  Websocket::listen_flush() {
@@ -258,7 +392,11 @@ namespace ssi {
 
 	void Websocket::consume_enter(ssi_size_t stream_in_num, ssi_stream_t stream_in[])
 	{
-
+		delete[] _parts;
+		delete[] _lens;
+		_n_parts = stream_in_num;
+		_parts = new const char *[_n_parts];
+		_lens = new size_t[_n_parts];
 	}
 
 
@@ -315,35 +453,14 @@ namespace ssi {
 
 
 
-		//combine all streams
-		if (stream_in_num > 1)
+		//streams are copied one after another into the message buffer
+		for (ssi_size_t i = 0; i < stream_in_num && i < _n_parts; i++)
 		{
-			//calculate total size of buffer
-			long total_size = 0;
-			for (int i = 0; i < stream_in_num; i++)
-			{
-				total_size += stream_in[i].tot;
-			}
-
-			//allocate buffer
-			char *buffer = new char[total_size];
-
-			//copy data of streams into buffer
-			long offset = 0;
-			for (int i = 0; i < stream_in_num; i++)
-			{
-				memcpy(&buffer[offset], stream_in[i].ptr, stream_in[i].tot);
-				offset += stream_in[i].tot;
-			}
-
-			server->sendRawData(buffer, total_size);
-
-			delete[] buffer;
-
-		}
-		else {
-			server->sendRawData(stream_in[0].ptr, stream_in[0].tot);
+			_parts[i] = stream_in[i].ptr;
+			_lens[i] = stream_in[i].tot;
 		}
+
+		server->sendRawData(stream_in_num < _n_parts ? stream_in_num : _n_parts, _parts, _lens);
 	}
 
 
@@ -3,6 +3,9 @@
 #include "websocket.h"
 #include <stdlib.h>
 #include <sstream>
+#if !(_WIN32||_WIN64)
+#include <netinet/tcp.h>
+#endif
 
 namespace ssi {
 
@@ -21,24 +24,118 @@ namespace ssi {
 		return nc->flags & MG_F_IS_WEBSOCKET;
 	}
 
-	void Websockserver::broadcast(struct mg_connection *nc, const char *msg, size_t len) {
-		if (nc) {
-			struct mg_connection *c;
+	void Websockserver::wakeup_handler(struct mg_connection *nc, int ev, void *ev_data) {
+		if (ev == MG_EV_RECV) {
+			mbuf_remove(&nc->recv_mbuf, nc->recv_mbuf.len);
+			((Websockserver *)nc->user_data)->drain();
+		}
+	}
+
+	void Websockserver::enqueue(int op, bool stream, ssi_size_t n_parts, const char **parts, const size_t *lens) {
+
+		size_t total = 0;
+		for (ssi_size_t i = 0; i < n_parts; i++) {
+			total += lens[i];
+		}
+
+		Lock lock(queueMutex);
+
+		message_t *msg = 0;
+
+		//replace a pending stream frame by the new one?
+		if (stream && coalesce) {
+			for (ssi_size_t i = queue_count; i > 0; i--) {
+				message_t &m = queue[(queue_first + i - 1) % queue_size];
+				if (m.stream) {
+					msg = &m;
+					break;
+				}
+			}
+		}
 
-			for (c = mg_next(nc->mgr, NULL); c != NULL; c = mg_next(nc->mgr, c)) {
-				mg_send_websocket_frame(c, WEBSOCKET_OP_TEXT, msg, len);
+		if (!msg) {
+			//queue is full, drop oldest message
+			if (queue_count == queue_size) {
+				queue_first = (queue_first + 1) % queue_size;
+				queue_count--;
+				queue_dropped++;
 			}
+			msg = &queue[(queue_first + queue_count) % queue_size];
+			queue_count++;
+		}
+
+		if (msg->size < total) {
+			delete[] msg->ptr;
+			msg->ptr = new char[total];
+			msg->size = total;
+		}
+
+		size_t offset = 0;
+		for (ssi_size_t i = 0; i < n_parts; i++) {
+			memcpy(msg->ptr + offset, parts[i], lens[i]);
+			offset += lens[i];
+		}
+		msg->len = total;
+		msg->op = op;
+		msg->stream = stream;
+
+		//wake up server thread
+		if (!wakeup_pending && wakeup[1] != INVALID_SOCKET) {
+			char c = 0;
+			send(wakeup[1], &c, 1, 0);
+			wakeup_pending = true;
 		}
 	}
 
-	void Websockserver::broadcastRaw(struct mg_connection *nc, const char *msg, size_t len) {
-		if (nc) {
+	void Websockserver::drain() {
+
+		ssi_size_t n_pending = 0;
+		ssi_size_t n_queue_dropped = 0;
+
+		//swap pending messages out, buffers of sent messages go back to the queue
+		{
+			Lock lock(queueMutex);
 
-			struct mg_connection *c;
+			wakeup_pending = false;
 
-			for (c = mg_next(nc->mgr, NULL); c != NULL; c = mg_next(nc->mgr, c)) {
-				mg_send_websocket_frame(c, WEBSOCKET_OP_BINARY, msg, len);
+			for (ssi_size_t i = 0; i < queue_count; i++) {
+				message_t &msg = queue[(queue_first + i) % queue_size];
+				message_t tmp = pending[i];
+				pending[i] = msg;
+				msg = tmp;
 			}
+			n_pending = queue_count;
+			queue_first = 0;
+			queue_count = 0;
+
+			n_queue_dropped = queue_dropped;
+			queue_dropped = 0;
+		}
+
+		//send without blocking the sending thread
+		for (ssi_size_t i = 0; i < n_pending; i++) {
+
+			message_t &msg = pending[i];
+
+			for (struct mg_connection *c = mg_next(&mgr, NULL); c != NULL; c = mg_next(&mgr, c)) {
+				if (!is_websocket(c)) {
+					continue;
+				}
+				//slow client, skip stream frames until its buffer has been sent
+				if (msg.stream && client_bytes > 0 && c->send_mbuf.len > client_bytes) {
+					client_dropped++;
+					continue;
+				}
+				mg_send_websocket_frame(c, msg.op, msg.ptr, msg.len);
+			}
+		}
+
+		if (n_queue_dropped > 0) {
+			ssi_wrn("egress queue full, dropped %u messages", n_queue_dropped);
+		}
+		if (client_dropped > 0) {
+			ssi_msg(SSI_LOG_LEVEL_DETAIL, "clients too slow, dropped %u stream frames", client_dropped);
+			client_dropped = 0;
 		}
 	}
 
@@ -99,6 +196,27 @@ namespace ssi {
 		this->_single_execution = true;
 		_wsocket = socket;
 		stop = false;
+
+		queue_size = _wsocket->getOptions()->queue > 0 ? _wsocket->getOptions()->queue : 1;
+		queue = new message_t[queue_size];
+		pending = new message_t[queue_size];
+		for (ssi_size_t i = 0; i < queue_size; i++) {
+			queue[i].op = 0;
+			queue[i].stream = false;
+			queue[i].ptr = 0;
+			queue[i].len = 0;
+			queue[i].size = 0;
+			pending[i] = queue[i];
+		}
+		queue_first = 0;
+		queue_count = 0;
+		queue_dropped = 0;
+		client_dropped = 0;
+		client_bytes = _wsocket->getOptions()->client_bytes;
+		coalesce = _wsocket->getOptions()->coalesce;
+
+		wakeup[0] = wakeup[1] = INVALID_SOCKET;
+		wakeup_pending = false;
 	}
 
 	Websockserver::~Websockserver()
@@ -110,6 +228,13 @@ namespace ssi {
 
 		shutdownMutex.release();
 
+		for (ssi_size_t i = 0; i < queue_size; i++) {
+			delete[] queue[i].ptr;
+			delete[] pending[i].ptr;
+		}
+		delete[] queue; queue = 0;
+		delete[] pending; pending = 0;
+
 		ssi_msg(SSI_LOG_LEVEL_BASIC, "websockserver ready to destroy.");
 	}
 
@@ -133,6 +258,17 @@ namespace ssi {
 
 		mg_set_protocol_http_websocket(nc);
 
+		if (mg_socketpair(wakeup, SOCK_STREAM)) {
+			struct mg_connection *wc = mg_add_sock(&mgr, wakeup[0], wakeup_handler);
+			wc->user_data = this;
+			//wakeup bytes must not be delayed
+			int on = 1;
+			setsockopt(wakeup[1], IPPROTO_TCP, TCP_NODELAY, (const char *)&on, sizeof(on));
+		} else {
+			ssi_wrn("could not create wakeup socket");
+			wakeup[0] = wakeup[1] = INVALID_SOCKET;
+		}
+
         ssi_msg(SSI_LOG_LEVEL_BASIC, "Started on port %s\n", port);
 
         //printf("Started on port %s\n", port);
@@ -145,6 +281,18 @@ namespace ssi {
 
 			while (!stop) {
 				mg_mgr_poll(&mgr, 200);
+				//without wakeup socket messages are sent on each poll
+				if (wakeup[0] == INVALID_SOCKET) {
+					drain();
+				}
+			}
+
+			{
+				Lock lock(queueMutex);
+				if (wakeup[1] != INVALID_SOCKET) {
+					closesocket(wakeup[1]);
+					wakeup[1] = INVALID_SOCKET;
+				}
 			}
 
 			mg_mgr_free(&mgr);
@@ -160,12 +308,26 @@ namespace ssi {
 
 	void Websockserver::sendEvent(std::string msg)
 	{
-		broadcast(nc, msg.c_str(), msg.length());
+		sendEvent(msg.c_str(), msg.length(), false);
+	}
+
+	void Websockserver::sendEvent(const char *msg, size_t len, bool binary)
+	{
+		const char *parts[] = { msg };
+		size_t lens[] = { len };
+		enqueue(binary ? WEBSOCKET_OP_BINARY : WEBSOCKET_OP_TEXT, false, 1, parts, lens);
 	}
 
 	void Websockserver::sendRawData(char* data, int len)
 	{
-		broadcastRaw(nc, data, len);
+		const char *parts[] = { data };
+		size_t lens[] = { (size_t)len };
+		enqueue(WEBSOCKET_OP_BINARY, true, 1, parts, lens);
+	}
+
+	void Websockserver::sendRawData(ssi_size_t n_parts, const char **parts, const size_t *lens)
+	{
+		enqueue(WEBSOCKET_OP_BINARY, true, n_parts, parts, lens);
 	}
 
 }